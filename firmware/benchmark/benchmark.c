@@ -0,0 +1,324 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2024 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Microbenchmarks of the hot paths of the firmware, to be run in simavr (see Makefile).
+//
+// The cycles are counted with Timer1 running at the CPU clock. Overflows are counted
+// in an interrupt. The cycles needed by the measurement itself and by each overflow
+// interrupt are calibrated at the start and subtracted, so the result is the exact
+// cycle count for runs shorter than 65536 cycles. For longer runs, the interrupt
+// latency (which depends on the interrupted instruction) adds up to 3 cycles per
+// 65536 cycles.
+//
+// The stack usage is measured by filling the free RAM with a pattern before the
+// call and searching for the lowest overwritten byte afterwards.
+//
+// The results are written to the simavr console (GPIOR0) as one line per benchmark:
+// BENCH;<name>;<cycles>;<stack bytes>;<symbols>
+// The symbols are the functions and variables which belong to the benchmarked code.
+// Their sizes are taken from the ELF file by the Makefile.
+
+#include <string.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <util/delay_basic.h>
+
+#include <avr/avr_mcu_section.h> // from simavr
+
+#include "../src_common/aes256.h"
+#include "../src_common/e2p_access.h"
+#include "../src_common/util_generic.h"
+#include "../src_common/uart.h"
+
+AVR_MCU(F_CPU, "atmega328");
+AVR_MCU_SIMAVR_CONSOLE(&GPIOR0);
+
+#define STACK_PATTERN 0xc5
+
+// The formatting functions write to uartbuf. It is normally defined in uart.c,
+// which is not linked because it needs the rest of the device code.
+char uartbuf[180];
+
+static volatile uint16_t t1_overflows;
+static uint16_t overhead_cycles;
+static uint16_t overflow_cycles;
+static uint16_t overhead_stack;
+static uint8_t data[64];
+static char hexline[129];
+static uint32_t result; // results are stored here, so that the compiler can't remove the code
+
+extern uint8_t __heap_start;
+
+ISR(TIMER1_OVF_vect)
+{
+	t1_overflows++;
+}
+
+static void console_putstr(const char * s)
+{
+	while (*s)
+	{
+		GPIOR0 = *s++;
+	}
+}
+
+static void timer_init(void)
+{
+	TCCR1A = 0;
+	TCCR1B = (1 << CS10); // no prescaler
+	TIMSK1 = (1 << TOIE1);
+}
+
+// Fill the free RAM between the variables and the current stack with the pattern.
+static void stack_paint(void)
+{
+	uint8_t * p = &__heap_start;
+
+	while (p < (uint8_t *)SP - 16)
+	{
+		*p++ = STACK_PATTERN;
+	}
+}
+
+// Return the number of stack bytes used below the given stack pointer since stack_paint.
+static uint16_t stack_used(uint16_t sp)
+{
+	uint8_t * p = &__heap_start;
+
+	while ((p < (uint8_t *)sp) && (*p == STACK_PATTERN))
+	{
+		p++;
+	}
+
+	return sp - (uint16_t)p;
+}
+
+// Run the function and return the number of cycles including the measurement overhead.
+// The function is called through a pointer, so the call itself is measured the same
+// way for every benchmark and calibrated out.
+static uint32_t measure(void (*func)(void))
+{
+	uint16_t t;
+	uint16_t ovf;
+
+	cli();
+	t1_overflows = 0;
+	TIFR1 = (1 << TOV1);
+	TCNT1 = 0;
+	sei();
+
+	func();
+
+	cli();
+	t = TCNT1;
+	ovf = t1_overflows;
+
+	// overflow which happened after the last sei, but was not handled yet
+	if ((TIFR1 & (1 << TOV1)) && (t < 0x8000))
+	{
+		ovf++;
+	}
+
+	sei();
+
+	return ((uint32_t)ovf << 16) + t;
+}
+
+static void bench_empty(void)
+{
+}
+
+// 65536 loops of 4 cycles, see _delay_loop_2
+static void bench_delay(void)
+{
+	_delay_loop_2(0);
+}
+
+// Run the function and return the cycles and the stack bytes used by it.
+static uint32_t run(void (*func)(void), uint16_t * stack)
+{
+	uint16_t sp = SP;
+	uint32_t cycles;
+
+	stack_paint();
+	cycles = measure(func);
+	*stack = stack_used(sp);
+
+	return cycles;
+}
+
+static void calibrate(void)
+{
+	uint32_t cycles;
+
+	overhead_cycles = run(bench_empty, &overhead_stack);
+
+	// Calling bench_delay takes the same cycles as calling bench_empty,
+	// plus 2 cycles for loading the counter and 65536 * 4 - 1 cycles for the loop.
+	cycles = run(bench_delay, &overflow_cycles) - overhead_cycles - 2 - (65536UL * 4 - 1);
+	overflow_cycles = cycles / 4;
+}
+
+static void bench(const char * name, void (*func)(void), const char * symbols)
+{
+	uint32_t cycles;
+	uint16_t stack;
+	char s[24];
+
+	cycles = run(func, &stack);
+	cycles -= overhead_cycles + (cycles >> 16) * overflow_cycles;
+	stack -= overhead_stack;
+
+	console_putstr("BENCH;");
+	console_putstr(name);
+	sprintf(s, ";%lu;%u;", cycles, stack);
+	console_putstr(s);
+	console_putstr(symbols);
+	console_putstr("\r");
+}
+
+// ---------- benchmarks ----------
+
+static void init_data(void)
+{
+	uint8_t i;
+
+	for (i = 0; i < sizeof(data); i++)
+	{
+		data[i] = i * 37 + 11;
+	}
+
+	for (i = 0; i < 32; i++)
+	{
+		aes_key[i] = i * 13 + 5;
+	}
+}
+
+static void bench_aes_decrypt_16(void)
+{
+	aes256_decrypt_cbc(data, 16);
+}
+
+static void bench_aes_decrypt_64(void)
+{
+	aes256_decrypt_cbc(data, 64);
+}
+
+static void bench_aes_encrypt_64(void)
+{
+	aes256_encrypt_cbc(data, 64);
+}
+
+// CRC of a 64 byte packet, see rfm12_send_bufx
+static void bench_crc32_60(void)
+{
+	result = crc32(data + 4, 60);
+}
+
+// byte aligned 8 bit value, e.g. MessageGroupID
+static void bench_read_uint8_aligned(void)
+{
+	result = _eeprom_read_UIntValue32(72, 8, 0, 255, 8, data);
+}
+
+// 32 bit value at an odd bit position, e.g. an AckPacketCounter
+static void bench_read_uint32_unaligned(void)
+{
+	result = _eeprom_read_UIntValue32(95, 32, 0, UINT32_MAX, 32, data);
+}
+
+// 16 bit value from the EEPROM instead of a buffer
+static void bench_read_uint16_eeprom(void)
+{
+	result = _eeprom_read_UIntValue32(37, 16, 0, 65535, 16, NULL);
+}
+
+static void bench_hex_to_uint8(void)
+{
+	result = hex_to_uint8((uint8_t *)hexline, 6);
+}
+
+// a packet from the PC (64 bytes as 128 hex characters), see process_cmd
+static void bench_hex_line_64(void)
+{
+	uint8_t i;
+
+	for (i = 0; i < 64; i++)
+	{
+		bufx[i] = hex_to_uint8((uint8_t *)hexline, i * 2);
+	}
+}
+
+// the beginning of the "PKT:" line of decode_data
+static void bench_format_pkt_header(void)
+{
+	uartbuf[0] = 0;
+	UART_PUTF_B("SID=%u;", 31);
+	UART_PUTF_B("PC=%lu;", 123456UL);
+	UART_PUTF_B("MT=%u;", 8);
+}
+
+// 32 data bytes in hex, see print_bytearray
+static void bench_format_hex_32(void)
+{
+	uint8_t i;
+
+	uartbuf[0] = 0;
+
+	for (i = 0; i < 32; i++)
+	{
+		UART_PUTF_B("%02x", data[i]);
+	}
+}
+
+int main(void)
+{
+	uint8_t i;
+
+	timer_init();
+	init_data();
+
+	for (i = 0; i < 128; i++)
+	{
+		hexline[i] = "0123456789abcdef"[(i * 7) % 16];
+	}
+
+	calibrate();
+
+	bench("aes256_decrypt_cbc_16", bench_aes_decrypt_16, "aes256_decrypt_cbc aes256_init aes256_dec aes_ctx aes_key");
+	bench("aes256_decrypt_cbc_64", bench_aes_decrypt_64, "aes256_decrypt_cbc aes256_init aes256_dec aes_ctx aes_key");
+	bench("aes256_encrypt_cbc_64", bench_aes_encrypt_64, "aes256_encrypt_cbc aes256_init aes256_enc aes_ctx aes_key");
+	bench("crc32_60", bench_crc32_60, "crc32 crc32_bytecalc");
+	bench("read_uint8_aligned", bench_read_uint8_aligned, "_eeprom_read_UIntValue32");
+	bench("read_uint32_unaligned", bench_read_uint32_unaligned, "_eeprom_read_UIntValue32");
+	bench("read_uint16_eeprom", bench_read_uint16_eeprom, "_eeprom_read_UIntValue32");
+	bench("hex_to_uint8", bench_hex_to_uint8, "hex_to_uint8 hex_to_byte");
+	bench("hex_line_64", bench_hex_line_64, "hex_to_uint8 hex_to_byte");
+	bench("format_pkt_header", bench_format_pkt_header, "sprintf_P vfprintf uartbuf");
+	bench("format_hex_32", bench_format_hex_32, "sprintf_P vfprintf uartbuf");
+
+	console_putstr("BENCH_END\r");
+
+	// simavr stops when the CPU sleeps with interrupts disabled
+	cli();
+	sleep_enable();
+	sleep_cpu();
+
+	return 0;
+}
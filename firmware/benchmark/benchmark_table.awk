@@ -0,0 +1,77 @@
+#
+# This file is part of smarthomatic, http://www.smarthomatic.org.
+# Copyright (c) 2024 Uwe Freese
+#
+# smarthomatic is free software: you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# smarthomatic is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+# Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+#
+
+# Create the result table of the benchmark (see Makefile).
+# Input: the output of "avr-nm -S" for the ELF file, then the simavr output.
+
+function hex(s,    i, v)
+{
+	v = 0
+	s = tolower(s)
+
+	for (i = 1; i <= length(s); i++)
+		v = v * 16 + index("0123456789abcdef", substr(s, i, 1)) - 1
+
+	return v
+}
+
+BEGIN {
+	print "name;cycles;us_20mhz;us_8mhz;stack;flash;ram;symbols"
+}
+
+# symbol table: address, size, type, name (symbols without size have 3 fields)
+NR == FNR {
+	if (NF == 4)
+	{
+		size[$4] = hex($2)
+		type[$4] = tolower($3)
+	}
+
+	next
+}
+
+/BENCH_END/ {
+	done = 1
+}
+
+/BENCH;/ {
+	sub(/.*BENCH;/, "")
+	split($0, b, ";")
+
+	flash = 0
+	ram = 0
+	n = split(b[4], s, " ")
+
+	for (i = 1; i <= n; i++)
+	{
+		if (type[s[i]] == "t")
+			flash += size[s[i]]
+		else
+			ram += size[s[i]]
+	}
+
+	printf "%s;%d;%.1f;%.1f;%d;%d;%d;%s\n", b[1], b[2], b[2] / 20, b[2] / 8, b[3], flash, ram, b[4]
+}
+
+END {
+	if (!done)
+	{
+		print "The benchmark did not finish." > "/dev/stderr"
+		exit 1
+	}
+}
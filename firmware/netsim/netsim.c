@@ -0,0 +1,1239 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2024 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Discrete-event simulator of the RF network: one base station and N devices sharing
+// one channel. It answers the question what happens when more devices are added.
+//
+// Modelled are:
+// - The channel: time on air from the data rate (incl. preamble, sync and length bytes
+//   the rfm12 library adds), collisions of overlapping packets, a random packet loss
+//   and optionally device pairs which can't hear each other (hidden nodes).
+// - The CSMA of rfm12_tick: Called every 5ms, a packet is sent after the channel was
+//   seen free for CHANNEL_FREE_TIME ticks. A carrier is only detected SENSE_US after a
+//   transmission started, so devices starting at almost the same time collide.
+// - The two receive buffers of the rfm12 library (further packets are lost).
+// - The blocking rfm12_send_wait_led (150..300ms) of the base station and the
+//   power switches, in which received packets wait in the receive buffers.
+// - Power switches (always receiving): Status every status cycle, Ack on Set requests.
+// - Environment sensors (battery powered): Status every send interval, afterwards
+//   listening for requests for 250ms (max. 4 times), Get DeviceInfo is answered.
+// - The base station: Requests from the PC (random, for all devices) are queued by the
+//   real request_buffer.c, repeated every second until acknowledged and sent directly
+//   to a device which listens after sending.
+// All packets are built and checked with the real packet codec (without encryption).
+//
+// The results are printed as one line per device count, see usage().
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "../src_common/packet_header.h"
+#include "../src_common/packet_headerext_common.h"
+#include "../src_common/msggrp_generic.h"
+#include "../src_common/msggrp_gpio.h"
+#include "../src_common/msggrp_weather.h"
+#include "../shc_basestation/request_buffer.h"
+
+#define MAX_NODES 256
+#define MAX_ACTIVE_TX 32
+#define MAX_EVENTS 65536
+#define RX_BUFFERS 2            // receive buffers of the rfm12 library
+
+#define TICK_US 5000            // cycle of rfm12_tick
+#define CHANNEL_FREE_TIME 30    // see rfm12_core.h
+#define TX_OVERHEAD_BYTES 8     // preamble (2), sync (2), length, type, checksum, dummy byte (see rfm12_tick)
+#define SEND_WAIT_MIN_US 150000 // see rfm12_send_wait_led
+#define SEND_WAIT_MAX_US 300000
+#define LISTEN_WINDOW_US 250000 // see shc_envsensor.c
+#define LISTEN_MAX_PACKETS 4
+#define BS_LOOP_US 1000000      // the base station checks the request queue every second
+
+typedef enum {
+	NODE_BASESTATION,
+	NODE_POWERSWITCH,
+	NODE_ENVSENSOR
+} NodeTypeEnum;
+
+typedef enum {
+	EV_TICK,         // rfm12_tick of a node with a packet to send
+	EV_TX_END,       // end of a transmission
+	EV_STATUS,       // a device sends its status
+	EV_REQUEST,      // the PC sends a request to the base station
+	EV_BS_LOOP,      // the base station checks the request queue
+	EV_PROCESSED,    // a node finished processing a received packet
+	EV_SEND_WAIT,    // a node waits for its packet to be sent
+	EV_LISTEN_END    // the listen window of an environment sensor ends
+} EventTypeEnum;
+
+typedef struct {
+	uint64_t t;
+	uint32_t seq;   // keeps the order of events at the same time
+	uint8_t type;
+	uint16_t node;
+	uint32_t arg;
+} event_t;
+
+typedef struct {
+	uint8_t buf[BUFX_LENGTH];
+	uint8_t len;
+	uint64_t created;
+	int32_t request;  // index of the request the packet belongs to, -1 if none
+} packet_t;
+
+typedef struct {
+	NodeTypeEnum type;
+	uint16_t device_id;
+	uint32_t packetcounter;
+
+	// transceiver
+	bool tx_pending;
+	bool ticking;
+	bool transmitting;
+	packet_t tx;
+	uint8_t free_count;
+	uint16_t tick_phase;
+	uint64_t heard_busy_until; // when the node last saw a carrier
+	bool listening;
+	uint64_t listening_since;
+	packet_t rx[RX_BUFFERS];
+	uint8_t rx_count;
+
+	// main loop
+	bool busy;
+	uint32_t gen;            // invalidates pending EV_SEND_WAIT / EV_LISTEN_END events
+	uint64_t send_wait_start;
+	uint64_t send_wait_min;
+	packet_t processing;
+	uint8_t listen_count;
+	uint32_t status_gen;     // invalidates a pending EV_STATUS event
+} node_t;
+
+typedef struct {
+	uint16_t node;
+	uint64_t start;
+	uint64_t end;
+	uint8_t overlap[MAX_NODES / 8]; // nodes which transmitted at the same time
+	packet_t pkt;
+} transmission_t;
+
+typedef struct {
+	uint64_t created;
+	uint16_t node;
+	uint8_t transmissions;
+	uint64_t delivered; // received by the device (0 = not yet)
+	uint64_t acked;     // removed from the queue by the base station (0 = not yet)
+} request_info_t;
+
+typedef struct {
+	uint32_t *v;
+	uint32_t count;
+	uint32_t size;
+} samples_t;
+
+// configuration
+static uint32_t bitrate = 9600;
+static double loss = 0.01;
+static double hidden = 0.0;
+static double powerswitch_share = 0.5;
+static uint32_t status_cycle_s = 120;
+static uint32_t env_interval_s = 120;
+static double requests_per_hour = 2;
+static uint32_t sim_s = 3600;
+static uint32_t sense_us = 1000;
+static uint32_t proc_us_bs = 10000;
+static uint32_t proc_us_dev = 20000;
+static uint64_t seed = 1;
+
+// simulation state
+static uint64_t now;
+static uint64_t rng;
+static event_t events[MAX_EVENTS];
+static uint32_t event_count;
+static uint32_t event_seq;
+static node_t nodes[MAX_NODES];
+static uint16_t node_count;
+static uint8_t hears[MAX_NODES][MAX_NODES / 8];
+static transmission_t active[MAX_ACTIVE_TX];
+static uint8_t active_count;
+static uint32_t bs_loop_gen;
+static bool bs_loop_due;
+static request_info_t * requests;
+static uint32_t request_count;
+static uint32_t request_size;
+static int32_t req_fifo[MAX_NODES][REQUEST_QUEUE_PACKETS]; // requests queued per receiver, like request_queue
+static uint8_t req_fifo_len[MAX_NODES];
+
+// results
+static struct {
+	uint32_t tx;
+	uint32_t tx_collided;
+	uint64_t airtime_us;
+	uint32_t tx_occupied;  // packets dropped because the tx buffer was occupied
+	uint32_t rx_lost;      // random loss
+	uint32_t rx_overflow;  // both receive buffers full
+	uint32_t bs_rx_max;
+	uint32_t status_sent;
+	uint32_t status_received;
+	uint32_t requests_rejected;
+	uint64_t queue_sum;
+	uint32_t queue_samples;
+	uint32_t queue_max;
+	samples_t status_latency;
+	samples_t request_latency;
+} stats;
+
+/* ---------- helpers ---------- */
+
+static uint32_t random32(void)
+{
+	// xorshift64*
+	rng ^= rng >> 12;
+	rng ^= rng << 25;
+	rng ^= rng >> 27;
+	return (uint32_t)((rng * 2685821657736338717ULL) >> 32);
+}
+
+static double random_uniform(void)
+{
+	return random32() / 4294967296.0;
+}
+
+// exponentially distributed value with the given mean
+static double random_exp(double mean)
+{
+	return -mean * log1p(-random_uniform());
+}
+
+static void samples_add(samples_t * s, uint32_t v)
+{
+	if (s->count == s->size)
+	{
+		s->size = s->size ? s->size * 2 : 1024;
+		s->v = realloc(s->v, s->size * sizeof(uint32_t));
+	}
+
+	s->v[s->count++] = v;
+}
+
+static int cmp_u32(const void * a, const void * b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+// Return the given percentile of the (sorted) samples.
+static uint32_t percentile(samples_t * s, uint8_t p)
+{
+	if (s->count == 0)
+	{
+		return 0;
+	}
+
+	return s->v[(uint32_t)((uint64_t)(s->count - 1) * p / 100)];
+}
+
+static bool bit_get(const uint8_t * bits, uint16_t i)
+{
+	return bits[i / 8] & (1 << (i % 8));
+}
+
+static void bit_set(uint8_t * bits, uint16_t i, bool on)
+{
+	if (on)
+		bits[i / 8] |= 1 << (i % 8);
+	else
+		bits[i / 8] &= ~(1 << (i % 8));
+}
+
+static uint64_t time_on_air(uint8_t len)
+{
+	return (uint64_t)(len + TX_OVERHEAD_BYTES) * 8 * 1000000 / bitrate;
+}
+
+/* ---------- event queue (binary heap) ---------- */
+
+static bool event_before(const event_t * a, const event_t * b)
+{
+	return (a->t < b->t) || ((a->t == b->t) && (a->seq < b->seq));
+}
+
+static void schedule(uint64_t t, EventTypeEnum type, uint16_t node, uint32_t arg)
+{
+	uint32_t i = event_count++;
+
+	if (event_count > MAX_EVENTS)
+	{
+		fprintf(stderr, "Event queue overflow.\n");
+		exit(1);
+	}
+
+	events[i] = (event_t){ t, event_seq++, type, node, arg };
+
+	while (i > 0)
+	{
+		uint32_t parent = (i - 1) / 2;
+
+		if (!event_before(&events[i], &events[parent]))
+			break;
+
+		event_t tmp = events[i];
+		events[i] = events[parent];
+		events[parent] = tmp;
+		i = parent;
+	}
+}
+
+static event_t next_event(void)
+{
+	event_t res = events[0];
+	uint32_t i = 0;
+
+	events[0] = events[--event_count];
+
+	while (true)
+	{
+		uint32_t l = 2 * i + 1;
+		uint32_t r = l + 1;
+		uint32_t m = i;
+
+		if ((l < event_count) && event_before(&events[l], &events[m]))
+			m = l;
+
+		if ((r < event_count) && event_before(&events[r], &events[m]))
+			m = r;
+
+		if (m == i)
+			break;
+
+		event_t tmp = events[i];
+		events[i] = events[m];
+		events[m] = tmp;
+		i = m;
+	}
+
+	return res;
+}
+
+/* ---------- packets ---------- */
+
+// Truncate trailing 0-bytes, round up to a multiple of 16 bytes and set the CRC,
+// like rfm12_send_bufx does (but without encryption).
+static void packet_finish(packet_t * p, uint8_t size)
+{
+	while ((size > 0) && (p->buf[size - 1] == 0))
+	{
+		size--;
+	}
+
+	size = ((size - 1) / 16 + 1) * 16;
+
+	array_write_UIntValue(0, 32, crc32(p->buf + 4, size - 4), p->buf);
+	p->len = size;
+}
+
+static void packet_set_header(node_t * n, pkg_ctx_t * ctx)
+{
+	n->packetcounter++;
+	pkg_header_ctx_set_senderid(ctx, n->device_id);
+	pkg_header_ctx_set_packetcounter(ctx, n->packetcounter);
+}
+
+/* ---------- transceiver ---------- */
+
+// Return if node a can hear node b (the base station hears all devices).
+static bool node_hears(uint16_t a, uint16_t b)
+{
+	return bit_get(hears[a], b);
+}
+
+// Return if the node sees a carrier (RSSI) now.
+static bool carrier(uint16_t n)
+{
+	uint8_t i;
+
+	for (i = 0; i < active_count; i++)
+	{
+		if ((active[i].node == n) || ((active[i].start + sense_us <= now) && node_hears(n, active[i].node)))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void schedule_tick(uint16_t n)
+{
+	uint64_t t = now - now % TICK_US + nodes[n].tick_phase;
+
+	if (t <= now)
+	{
+		t += TICK_US;
+	}
+
+	schedule(t, EV_TICK, n, 0);
+}
+
+static void start_tx(uint16_t n)
+{
+	node_t * node = &nodes[n];
+	transmission_t * tx = &active[active_count];
+	uint8_t i;
+
+	if (active_count == MAX_ACTIVE_TX)
+	{
+		fprintf(stderr, "Too many simultaneous transmissions.\n");
+		exit(1);
+	}
+
+	memset(tx, 0, sizeof(*tx));
+	tx->node = n;
+	tx->start = now;
+	tx->end = now + time_on_air(node->tx.len);
+	tx->pkt = node->tx;
+
+	for (i = 0; i < active_count; i++)
+	{
+		bit_set(active[i].overlap, n, true);
+		bit_set(tx->overlap, active[i].node, true);
+	}
+
+	active_count++;
+	node->transmitting = true;
+
+	stats.tx++;
+	stats.airtime_us += tx->end - tx->start;
+
+	schedule(tx->end, EV_TX_END, n, 0);
+}
+
+static void rfm12_tick(uint16_t n)
+{
+	node_t * node = &nodes[n];
+
+	if (!node->tx_pending || node->transmitting)
+	{
+		node->ticking = false;
+		return;
+	}
+
+	if (carrier(n))
+	{
+		node->free_count = CHANNEL_FREE_TIME;
+	}
+	else if (--node->free_count == 0)
+	{
+		node->free_count = 1;
+		node->ticking = false;
+		start_tx(n);
+		return;
+	}
+
+	schedule_tick(n);
+}
+
+// Put the packet into the tx buffer, like rfm12_tx. Return false if it is occupied.
+static bool rfm12_tx(uint16_t n, const packet_t * p)
+{
+	node_t * node = &nodes[n];
+
+	if (node->tx_pending)
+	{
+		stats.tx_occupied++;
+		return false;
+	}
+
+	node->tx = *p;
+	node->tx_pending = true;
+
+	// The base station and the power switches call rfm12_tick all the time. Calculate
+	// the counter it would have now instead of simulating all the ticks.
+	if (node->type != NODE_ENVSENSOR)
+	{
+		uint64_t ticks = (now - node->heard_busy_until) / TICK_US;
+
+		if (carrier(n))
+			node->free_count = CHANNEL_FREE_TIME;
+		else if (ticks >= CHANNEL_FREE_TIME - 1)
+			node->free_count = 1;
+		else
+			node->free_count = CHANNEL_FREE_TIME - ticks;
+	}
+
+	if (!node->ticking)
+	{
+		node->ticking = true;
+		schedule_tick(n);
+	}
+
+	return true;
+}
+
+/* ---------- nodes ---------- */
+
+static void node_main(uint16_t n);
+
+// Send the packet and let the main loop wait until it was sent, at least min_us
+// (rfm12_send_wait_led: 150ms, rfm12_listen_window: 0) and max. 300ms.
+static void node_send(uint16_t n, packet_t * p, uint64_t min_us)
+{
+	node_t * node = &nodes[n];
+
+	rfm12_tx(n, p);
+
+	node->busy = true;
+	node->send_wait_start = now;
+	node->send_wait_min = min_us;
+	schedule(now + (min_us ? min_us : TICK_US), EV_SEND_WAIT, n, ++node->gen);
+}
+
+static void envsensor_listen(uint16_t n)
+{
+	node_t * node = &nodes[n];
+
+	if (node->listen_count == 0)
+	{
+		node->listening = false;
+		node->rx_count = 0;
+		return;
+	}
+
+	node->listen_count--;
+
+	if (!node->listening)
+	{
+		node->listening = true;
+		node->listening_since = now;
+	}
+
+	schedule(now + LISTEN_WINDOW_US, EV_LISTEN_END, n, ++node->gen);
+}
+
+static void send_wait_done(uint16_t n)
+{
+	node_t * node = &nodes[n];
+
+	node->busy = false;
+
+	if (node->type == NODE_ENVSENSOR)
+	{
+		envsensor_listen(n);
+	}
+
+	node_main(n);
+}
+
+static void send_status(uint16_t n)
+{
+	node_t * node = &nodes[n];
+	packet_t p = { .created = now, .request = -1 };
+	pkg_ctx_t ctx = { p.buf };
+
+	if (node->type == NODE_POWERSWITCH)
+	{
+		uint8_t i;
+
+		pkg_header_ctx_init_gpio_digitalporttimeout_status(&ctx);
+
+		for (i = 0; i < 3; i++)
+		{
+			msg_gpio_digitalporttimeout_ctx_set_on(&ctx, i, random32() & 1);
+		}
+	}
+	else
+	{
+		pkg_header_ctx_init_weather_temperature_status(&ctx);
+		msg_weather_temperature_ctx_set_temperature(&ctx, 1800 + random32() % 800);
+	}
+
+	packet_set_header(node, &ctx);
+	packet_finish(&p, ctx.packetsizebytes);
+
+	stats.status_sent++;
+
+	if (node->type == NODE_ENVSENSOR)
+	{
+		node->listen_count = LISTEN_MAX_PACKETS;
+		node_send(n, &p, 0);
+	}
+	else
+	{
+		node_send(n, &p, SEND_WAIT_MIN_US);
+	}
+}
+
+// Answer a request with Ack (power switch) or AckStatus with DeviceInfo (environment sensor).
+static void device_answer(uint16_t n, pkg_ctx_t * req, int32_t request)
+{
+	node_t * node = &nodes[n];
+	packet_t p = { .created = now, .request = request };
+	pkg_ctx_t ctx = { p.buf };
+
+	if (node->type == NODE_POWERSWITCH)
+	{
+		pkg_header_ctx_init_gpio_digitalporttimeout_ack(&ctx);
+	}
+	else
+	{
+		pkg_header_ctx_init_generic_deviceinfo_ackstatus(&ctx);
+		msg_generic_deviceinfo_ctx_set_devicetype(&ctx, DEVICETYPE_ENVSENSOR);
+	}
+
+	packet_set_header(node, &ctx);
+	pkg_headerext_common_ctx_set_acksenderid(&ctx, pkg_header_ctx_get_senderid(req));
+	pkg_headerext_common_ctx_set_ackpacketcounter(&ctx, pkg_header_ctx_get_packetcounter(req));
+	pkg_headerext_common_ctx_set_error(&ctx, false);
+	packet_finish(&p, ctx.packetsizebytes);
+
+	if (node->type == NODE_POWERSWITCH)
+	{
+		node_send(n, &p, SEND_WAIT_MIN_US);
+
+		// the power switch sends its status 5s after a request
+		schedule(now + 5000000, EV_STATUS, n, ++node->status_gen);
+	}
+	else
+	{
+		node_send(n, &p, 0);
+	}
+}
+
+static void record_request_transmission(uint16_t receiver, request_t * r, packet_t * p)
+{
+	int32_t req = req_fifo[receiver][0];
+
+	p->request = req;
+	requests[req].transmissions++;
+
+	// The request is removed from the queue when it is sent the last time.
+	if (r->message_type == MESSAGETYPE_UNUSED)
+	{
+		memmove(&req_fifo[receiver][0], &req_fifo[receiver][1], (REQUEST_QUEUE_PACKETS - 1) * sizeof(int32_t));
+		req_fifo_len[receiver]--;
+	}
+}
+
+// Send the request, which request_buffer.c wrote to bufx, like send_packet of the base station.
+static void bs_send_request(uint16_t receiver, request_t * r)
+{
+	node_t * bs = &nodes[0];
+	packet_t p = { .created = now };
+
+	bs->packetcounter++;
+	memcpy(p.buf, bufx, BUFX_LENGTH);
+	record_request_transmission(receiver, r, &p);
+	packet_finish(&p, r->data_bytes + 9); // header size = 9 bytes
+
+	node_send(0, &p, SEND_WAIT_MIN_US);
+}
+
+static uint16_t node_by_id(uint16_t device_id)
+{
+	return device_id; // device IDs are the node indices
+}
+
+static void bs_process(pkg_ctx_t * ctx, packet_t * p)
+{
+	MessageTypeEnum messagetype = ctx->messagetype;
+	uint16_t senderid = pkg_header_ctx_get_senderid(ctx);
+
+	if (messagetype == MESSAGETYPE_STATUS)
+	{
+		stats.status_received++;
+		samples_add(&stats.status_latency, (now - p->created) / 1000);
+	}
+	else if ((messagetype == MESSAGETYPE_ACK) || (messagetype == MESSAGETYPE_ACKSTATUS))
+	{
+		uint16_t n = node_by_id(senderid);
+		int32_t req = req_fifo_len[n] ? req_fifo[n][0] : -1;
+		uint8_t before = 0, after = 0, i;
+
+		for (i = 0; i < REQUEST_BUFFER_SIZE; i++)
+			before += request_buffer[i].message_type != MESSAGETYPE_UNUSED;
+
+		remove_request(senderid, pkg_headerext_common_ctx_get_acksenderid(ctx), pkg_headerext_common_ctx_get_ackpacketcounter(ctx));
+
+		for (i = 0; i < REQUEST_BUFFER_SIZE; i++)
+			after += request_buffer[i].message_type != MESSAGETYPE_UNUSED;
+
+		if ((after < before) && (req >= 0))
+		{
+			requests[req].acked = now;
+			samples_add(&stats.request_latency, (now - requests[req].created) / 1000);
+			memmove(&req_fifo[n][0], &req_fifo[n][1], (REQUEST_QUEUE_PACKETS - 1) * sizeof(int32_t));
+			req_fifo_len[n]--;
+		}
+	}
+	else
+	{
+		return;
+	}
+
+	// get_listening_sender() / send_request_to_listening_sender()
+	if (senderid != 0)
+	{
+		request_t * r = find_request_for_receiver(senderid, nodes[0].packetcounter + 1);
+
+		if (r != 0)
+		{
+			bs_send_request(node_by_id(senderid), r);
+		}
+	}
+}
+
+static void device_process(uint16_t n, pkg_ctx_t * ctx, packet_t * p)
+{
+	node_t * node = &nodes[n];
+	MessageTypeEnum messagetype = ctx->messagetype;
+
+	if ((pkg_header_ctx_get_senderid(ctx) != 0)
+		|| ((messagetype != MESSAGETYPE_GET) && (messagetype != MESSAGETYPE_SET) && (messagetype != MESSAGETYPE_SETGET))
+		|| (pkg_headerext_common_ctx_get_receiverid(ctx) != node->device_id))
+	{
+		return; // not a request from the base station to this device
+	}
+
+	if ((p->request >= 0) && (requests[p->request].delivered == 0))
+	{
+		requests[p->request].delivered = now;
+	}
+
+	device_answer(n, ctx, p->request);
+}
+
+// Process the packet in node->processing (decryption and handling is done now).
+static void node_processed(uint16_t n)
+{
+	node_t * node = &nodes[n];
+	packet_t * p = &node->processing;
+	pkg_ctx_t ctx = { p->buf };
+
+	node->busy = false;
+
+	if (!pkg_header_ctx_check_crc32(&ctx, p->len))
+	{
+		fprintf(stderr, "CRC error in simulated packet.\n");
+		exit(1);
+	}
+
+	pkg_header_ctx_adjust_offset(&ctx);
+
+	if (node->type == NODE_BASESTATION)
+	{
+		bs_process(&ctx, p);
+	}
+	else
+	{
+		device_process(n, &ctx, p);
+	}
+
+	// the environment sensor opens the next listen window after every received packet
+	if ((node->type == NODE_ENVSENSOR) && !node->busy)
+	{
+		envsensor_listen(n);
+	}
+
+	node_main(n);
+}
+
+static void bs_loop(void)
+{
+	uint8_t used = 0, i;
+
+	bs_loop_due = false;
+
+	for (i = 0; i < REQUEST_BUFFER_SIZE; i++)
+	{
+		used += request_buffer[i].message_type != MESSAGETYPE_UNUSED;
+	}
+
+	stats.queue_sum += used;
+	stats.queue_samples++;
+
+	if (used > stats.queue_max)
+	{
+		stats.queue_max = used;
+	}
+
+	request_t * r = find_request_to_repeat(nodes[0].packetcounter + 1);
+
+	schedule(now + BS_LOOP_US, EV_BS_LOOP, 0, ++bs_loop_gen);
+
+	if (r != 0)
+	{
+		// find the receiver by the queue that was served
+		uint16_t receiver = 0;
+
+		for (i = 0; i < REQUEST_QUEUE_RECEIVERS; i++)
+		{
+			uint8_t j;
+
+			for (j = 1; j <= REQUEST_QUEUE_PACKETS; j++)
+			{
+				if ((request_queue[i][j] != SLOT_UNUSED) && (&request_buffer[request_queue[i][j]] == r))
+				{
+					receiver = request_queue[i][0];
+				}
+			}
+		}
+
+		// the request was removed after the last transmission, find it in the sim queues
+		if (receiver == 0)
+		{
+			for (i = 1; i < node_count; i++)
+			{
+				if (req_fifo_len[i] && (requests[req_fifo[i][0]].transmissions == REQUEST_RETRY_COUNT))
+				{
+					receiver = i;
+				}
+			}
+		}
+
+		bs_send_request(receiver, r);
+	}
+}
+
+// Main loop: Process the next received packet, if the node is not busy.
+static void node_main(uint16_t n)
+{
+	node_t * node = &nodes[n];
+
+	if (node->busy)
+	{
+		return;
+	}
+
+	if (node->rx_count > 0)
+	{
+		node->processing = node->rx[0];
+		node->rx[0] = node->rx[1];
+		node->rx_count--;
+		node->busy = true;
+		schedule(now + (node->type == NODE_BASESTATION ? proc_us_bs : proc_us_dev), EV_PROCESSED, n, 0);
+	}
+	else if ((n == 0) && bs_loop_due)
+	{
+		bs_loop();
+	}
+}
+
+static void tx_end(uint16_t n)
+{
+	node_t * sender = &nodes[n];
+	transmission_t tx;
+	uint16_t r;
+	uint8_t i;
+	bool collided = false;
+
+	for (i = 0; active[i].node != n; i++);
+
+	tx = active[i];
+	active[i] = active[--active_count];
+
+	sender->transmitting = false;
+	sender->tx_pending = false;
+
+	for (r = 0; r < node_count; r++)
+	{
+		node_t * rcv = &nodes[r];
+		uint16_t o;
+		bool ok = true;
+
+		if (r == n)
+		{
+			continue;
+		}
+
+		if (node_hears(r, n))
+		{
+			rcv->heard_busy_until = now;
+		}
+
+		if (!node_hears(r, n) || !rcv->listening || (rcv->listening_since > tx.start) || bit_get(tx.overlap, r))
+		{
+			continue;
+		}
+
+		// collision with another packet the receiver can hear
+		for (o = 0; o < node_count; o++)
+		{
+			if (bit_get(tx.overlap, o) && node_hears(r, o))
+			{
+				ok = false;
+			}
+		}
+
+		if (!ok)
+		{
+			collided = true;
+			continue;
+		}
+
+		if (random_uniform() < loss)
+		{
+			stats.rx_lost++;
+			continue;
+		}
+
+		if (rcv->rx_count == RX_BUFFERS)
+		{
+			stats.rx_overflow++;
+			continue;
+		}
+
+		rcv->rx[rcv->rx_count++] = tx.pkt;
+
+		if ((r == 0) && (rcv->rx_count > stats.bs_rx_max))
+		{
+			stats.bs_rx_max = rcv->rx_count;
+		}
+
+		node_main(r);
+	}
+
+	if (collided)
+	{
+		stats.tx_collided++;
+	}
+}
+
+static void pc_request(void)
+{
+	uint16_t n = 1 + random32() % (node_count - 1);
+	node_t * node = &nodes[n];
+	pkg_ctx_t ctx = { bufx };
+	request_info_t * req;
+
+	schedule(now + (uint64_t)(random_exp(3600.0 / requests_per_hour / (node_count - 1)) * 1000000), EV_REQUEST, 0, 0);
+
+	if (node->type == NODE_POWERSWITCH)
+	{
+		pkg_header_ctx_init_gpio_digitalporttimeout_set(&ctx);
+		msg_gpio_digitalporttimeout_ctx_set_on(&ctx, 0, true);
+		msg_gpio_digitalporttimeout_ctx_set_timeoutsec(&ctx, 0, 600);
+	}
+	else
+	{
+		pkg_header_ctx_init_generic_deviceinfo_get(&ctx);
+	}
+
+	pkg_headerext_common_ctx_set_receiverid(&ctx, node->device_id);
+
+	if ((req_fifo_len[n] == REQUEST_QUEUE_PACKETS)
+		|| !queue_request(node->device_id, ctx.messagetype, 0, bufx + 9, ctx.packetsizebytes - 9))
+	{
+		stats.requests_rejected++;
+		return;
+	}
+
+	if (request_count == request_size)
+	{
+		request_size = request_size ? request_size * 2 : 1024;
+		requests = realloc(requests, request_size * sizeof(request_info_t));
+	}
+
+	req = &requests[request_count];
+	memset(req, 0, sizeof(*req));
+	req->created = now;
+	req->node = n;
+	req_fifo[n][req_fifo_len[n]++] = request_count++;
+
+	// the base station checks the queue immediately (loop = LOOP_CNT_QUEUE)
+	bs_loop_gen++;
+	bs_loop_due = true;
+	node_main(0);
+}
+
+/* ---------- simulation ---------- */
+
+static void handle_event(event_t * e)
+{
+	node_t * node = &nodes[e->node];
+
+	switch (e->type)
+	{
+		case EV_TICK:
+			rfm12_tick(e->node);
+			break;
+		case EV_TX_END:
+			tx_end(e->node);
+			break;
+		case EV_STATUS:
+			if (e->arg != node->status_gen)
+				break;
+
+			if (node->type == NODE_POWERSWITCH)
+			{
+				schedule(now + (uint64_t)status_cycle_s * 1000000, EV_STATUS, e->node, node->status_gen);
+			}
+			else
+			{
+				// the send interval varies with the measurement and averaging intervals
+				schedule(now + (uint64_t)(env_interval_s * (0.9 + 0.2 * random_uniform()) * 1000000), EV_STATUS, e->node, node->status_gen);
+			}
+
+			// a device which is still busy sends its status in the next cycle
+			if (!node->busy)
+			{
+				send_status(e->node);
+			}
+			break;
+		case EV_REQUEST:
+			pc_request();
+			break;
+		case EV_BS_LOOP:
+			if (e->arg == bs_loop_gen)
+			{
+				bs_loop_due = true;
+				node_main(0);
+			}
+			break;
+		case EV_PROCESSED:
+			node_processed(e->node);
+			break;
+		case EV_SEND_WAIT:
+			if (e->arg != node->gen)
+				break;
+
+			if ((!node->tx_pending && (now - node->send_wait_start >= node->send_wait_min))
+				|| (now - node->send_wait_start >= SEND_WAIT_MAX_US))
+			{
+				send_wait_done(e->node);
+			}
+			else
+			{
+				schedule(now + TICK_US, EV_SEND_WAIT, e->node, node->gen);
+			}
+			break;
+		case EV_LISTEN_END:
+			if ((e->arg == node->gen) && !node->busy && (node->rx_count == 0))
+			{
+				node->listen_count = 0;
+				envsensor_listen(e->node);
+			}
+			break;
+	}
+}
+
+static void run(uint16_t devices)
+{
+	uint16_t i, j;
+
+	memset(&stats, 0, sizeof(stats));
+	memset(nodes, 0, sizeof(nodes));
+	memset(req_fifo_len, 0, sizeof(req_fifo_len));
+	request_count = 0;
+	event_count = 0;
+	active_count = 0;
+	now = 0;
+	rng = seed * 0x9e3779b97f4a7c15ULL + devices;
+	bs_loop_gen = 0;
+	bs_loop_due = false;
+	node_count = devices + 1;
+
+	request_queue_init();
+
+	for (i = 0; i < node_count; i++)
+	{
+		node_t * node = &nodes[i];
+
+		node->device_id = i;
+		node->type = (i == 0) ? NODE_BASESTATION : (i <= devices * powerswitch_share + 0.5) ? NODE_POWERSWITCH : NODE_ENVSENSOR;
+		node->free_count = 1;
+		node->tick_phase = random32() % TICK_US;
+		node->listening = node->type != NODE_ENVSENSOR;
+		node->packetcounter = random32() % 100000;
+
+		for (j = 0; j < node_count; j++)
+		{
+			// Only devices may not hear each other. The symmetric matrix is set for j < i.
+			bool h = (i == 0) || (j == 0) || (i == j) || (j > i) || (random_uniform() >= hidden);
+
+			bit_set(hears[i], j, h);
+
+			if (j < i)
+			{
+				bit_set(hears[j], i, h);
+			}
+		}
+
+		if (i > 0)
+		{
+			uint32_t cycle = (node->type == NODE_POWERSWITCH) ? status_cycle_s : env_interval_s;
+
+			schedule((uint64_t)(random_uniform() * cycle * 1000000), EV_STATUS, i, 0);
+		}
+	}
+
+	schedule(random32() % BS_LOOP_US, EV_BS_LOOP, 0, 0);
+
+	if ((requests_per_hour > 0) && (devices > 0))
+	{
+		schedule((uint64_t)(random_exp(3600.0 / requests_per_hour / devices) * 1000000), EV_REQUEST, 0, 0);
+	}
+
+	while (event_count > 0)
+	{
+		event_t e = next_event();
+
+		if (e.t > (uint64_t)sim_s * 1000000)
+		{
+			break;
+		}
+
+		now = e.t;
+		handle_event(&e);
+	}
+}
+
+static void print_results(uint16_t devices)
+{
+	uint32_t delivered = 0, acked = 0, transmissions = 0, i;
+
+	for (i = 0; i < request_count; i++)
+	{
+		if (requests[i].delivered)
+			delivered++;
+
+		if (requests[i].acked)
+		{
+			acked++;
+			transmissions += requests[i].transmissions;
+		}
+	}
+
+	qsort(stats.status_latency.v, stats.status_latency.count, sizeof(uint32_t), cmp_u32);
+	qsort(stats.request_latency.v, stats.request_latency.count, sizeof(uint32_t), cmp_u32);
+
+	printf("%7u %6.1f %6.1f %7u %6.1f %5u %5u %5u %6u %5u %6.1f %6.1f %6u %6u %6u %6.2f %5.2f %4u %4u %6u %6u\n",
+		devices,
+		100.0 * stats.airtime_us / ((uint64_t)sim_s * 1000000),
+		stats.tx ? 100.0 * stats.tx_collided / stats.tx : 0.0,
+		stats.status_sent,
+		stats.status_sent ? 100.0 * stats.status_received / stats.status_sent : 0.0,
+		percentile(&stats.status_latency, 50),
+		percentile(&stats.status_latency, 90),
+		percentile(&stats.status_latency, 99),
+		request_count + stats.requests_rejected,
+		stats.requests_rejected,
+		request_count ? 100.0 * delivered / request_count : 0.0,
+		request_count ? 100.0 * acked / request_count : 0.0,
+		percentile(&stats.request_latency, 50),
+		percentile(&stats.request_latency, 90),
+		percentile(&stats.request_latency, 99),
+		acked ? (double)(transmissions - acked) / acked : 0.0,
+		stats.queue_samples ? (double)stats.queue_sum / stats.queue_samples : 0.0,
+		stats.queue_max,
+		stats.bs_rx_max,
+		stats.rx_overflow,
+		stats.tx_occupied);
+}
+
+static void usage(void)
+{
+	printf("Usage: netsim [options] [device counts, default: 5 10 20 40 80]\n");
+	printf("  -t <s>     simulated time per run (%u)\n", sim_s);
+	printf("  -b <bps>   data rate (%u)\n", bitrate);
+	printf("  -l <p>     probability of a packet loss at a receiver (%.3f)\n", loss);
+	printf("  -H <p>     probability that two devices can't hear each other (%.3f)\n", hidden);
+	printf("  -p <p>     share of power switches, the rest are environment sensors (%.2f)\n", powerswitch_share);
+	printf("  -c <s>     status cycle of power switches (%u)\n", status_cycle_s);
+	printf("  -e <s>     mean send interval of environment sensors (%u)\n", env_interval_s);
+	printf("  -r <n>     requests from the PC per device and hour (%.1f)\n", requests_per_hour);
+	printf("  -s <seed>  random seed (%llu)\n", (unsigned long long)seed);
+	printf("\n");
+	printf("Output columns:\n");
+	printf("  util%%   channel utilization\n");
+	printf("  coll%%   transmissions that collided at a receiver\n");
+	printf("  st_*    status packets sent, delivery ratio to the base station, latency percentiles (ms)\n");
+	printf("  rq_*    requests from the PC, rejected by the full queue, delivered to the device,\n");
+	printf("          acknowledged, latency until acknowledged (ms)\n");
+	printf("  retry   retries per acknowledged request\n");
+	printf("  q_avg/q_max  used request buffer slots (of %u)\n", REQUEST_BUFFER_SIZE);
+	printf("  rx_max  used receive buffers of the base station, rx_ovf packets lost because both were used\n");
+	printf("  tx_occ  packets lost because the tx buffer was occupied\n");
+}
+
+int main(int argc, char ** argv)
+{
+	uint16_t counts[32] = { 5, 10, 20, 40, 80 };
+	uint8_t count_num = 5;
+	uint8_t c = 0;
+	int i;
+
+	for (i = 1; i < argc; i++)
+	{
+		const char * a = argv[i];
+		const char * v = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+		if ((a[0] == '-') && (strlen(a) == 2) && (v != NULL) && (a[1] != 'h'))
+		{
+			i++;
+
+			switch (a[1])
+			{
+				case 't': sim_s = atoi(v); break;
+				case 'b': bitrate = atoi(v); break;
+				case 'l': loss = atof(v); break;
+				case 'H': hidden = atof(v); break;
+				case 'p': powerswitch_share = atof(v); break;
+				case 'c': status_cycle_s = atoi(v); break;
+				case 'e': env_interval_s = atoi(v); break;
+				case 'r': requests_per_hour = atof(v); break;
+				case 's': seed = strtoull(v, NULL, 0); break;
+				default: usage(); return 1;
+			}
+		}
+		else if ((a[0] >= '0') && (a[0] <= '9') && (c < 32))
+		{
+			counts[c++] = atoi(a);
+			count_num = c;
+		}
+		else
+		{
+			usage();
+			return a[1] != 'h';
+		}
+	}
+
+	printf("# %us per run, %u bps, loss %.3f, hidden %.3f, %.0f%% power switches (status %us), "
+		"environment sensors (status %us), %.1f requests/device/h, seed %llu\n",
+		sim_s, bitrate, loss, hidden, powerswitch_share * 100, status_cycle_s, env_interval_s,
+		requests_per_hour, (unsigned long long)seed);
+	printf("devices  util%%  coll%% st_sent  st_dr st_50 st_90 st_99 rq_sent rq_rej rq_dr rq_ack rq_50 rq_90 rq_99 retry q_avg q_max rx_max rx_ovf tx_occ\n");
+
+	for (i = 0; i < count_num; i++)
+	{
+		if ((counts[i] < 1) || (counts[i] >= MAX_NODES))
+		{
+			fprintf(stderr, "Device count has to be 1..%u.\n", MAX_NODES - 1);
+			return 1;
+		}
+
+		run(counts[i]);
+		print_results(counts[i]);
+	}
+
+	return 0;
+}
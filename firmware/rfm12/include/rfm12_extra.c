@@ -259,6 +259,34 @@
 		rfm12_data(RFM12_CMD_PWRMGT | (PWRMGT_DEFAULT & ~RFM12_PWRMGT_EW));
 		rfm12_data(RFM12_CMD_PWRMGT |  PWRMGT_DEFAULT);		
 	}
+
+	#if !(RFM12_TRANSMIT_ONLY)
+	//! This function switches off the receiver, but keeps the wakeup timer running.
+	/** After a packet was sent, the receiver is switched on again. Battery powered
+	* devices which only listen for a short time after sending call this function
+	* before going to sleep. The shadow register is updated as well, so the receiver
+	* is not switched on again by the next wakeup interrupt.
+	* The receiver is switched on again automatically after the next transmission.
+	* A reception which is still in progress is aborted.
+	*/
+	void rfm12_rx_off(void)
+	{
+		RFM12_INT_OFF();
+
+		ctrl.pwrmgt_shadow = (RFM12_CMD_PWRMGT | PWRMGT_DEFAULT);
+		rfm12_data(RFM12_CMD_PWRMGT | PWRMGT_DEFAULT);
+
+		//abort a started reception, otherwise rfm12_tick() would never start transmitting again
+		if (ctrl.rfm12_state == STATE_RX_ACTIVE)
+		{
+			ctrl.rfm12_state = STATE_RX_IDLE;
+			rfm12_data(RFM12_CMD_FIFORESET | CLEAR_FIFO_INLINE);
+			rfm12_data(RFM12_CMD_FIFORESET | ACCEPT_DATA_INLINE);
+		}
+
+		RFM12_INT_ON();
+	}
+	#endif /* !(RFM12_TRANSMIT_ONLY) */
 #endif /* RFM12_USE_WAKEUP_TIMER */
 
 
@@ -118,6 +118,12 @@
 	//(see datasheet for values)
 	//see rfm12_extra.c for more documentation
 	void rfm12_set_wakeup_timer(uint16_t val);
+
+	#if !(RFM12_TRANSMIT_ONLY)
+	//switch off the receiver until the next transmission
+	//see rfm12_extra.c for more documentation
+	void rfm12_rx_off(void);
+	#endif /* !(RFM12_TRANSMIT_ONLY) */
 #endif /* RFM12_USE_WAKEUP_TIMER */
 
 
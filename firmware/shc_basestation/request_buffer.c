@@ -31,13 +31,29 @@ request_t request_buffer[];
 // items request_queue[DEVICEID][x] with x > 0 hold the indices to the request buffer.
 uint16_t request_queue[REQUEST_QUEUE_RECEIVERS][REQUEST_QUEUE_PACKETS + 1];
 
+// The timeouts of the requests, ticked once per second by find_request_to_repeat.
+static struct timer_wheel_t request_timers;
+
+// Bit i is set if the first request of request_queue[i] is to be sent (again).
+static uint8_t request_queue_due;
+
+// Called by the timer wheel when no acknowledge was received in time.
+static void request_timeout_expired(uint8_t rq_slot)
+{
+	request_queue_due |= 1 << rq_slot;
+}
+
 void request_queue_init(void)
 {
 	uint8_t i, j;
 	
+	timer_wheel_init(&request_timers);
+	request_queue_due = 0;
+
 	for (i = 0; i < REQUEST_BUFFER_SIZE; i++)
 	{
 		request_buffer[i].message_type = MESSAGETYPE_UNUSED;
+		sw_timer_init(&request_buffer[i].timeout, request_timeout_expired, 0);
 	}
 
 	for (i = 0; i < REQUEST_QUEUE_RECEIVERS; i++)
@@ -109,8 +125,14 @@ bool queue_request(uint16_t receiver_id, uint8_t message_type, uint8_t aes_key,
 	request_buffer[rb_slot].packet_counter = 0;
 	memcpy(request_buffer[rb_slot].data, data, data_bytes);
 	request_buffer[rb_slot].data_bytes = data_bytes;
-	request_buffer[rb_slot].timeout = 1;
+	request_buffer[rb_slot].timeout.arg = rs_slot;
 	request_buffer[rb_slot].retry_count = 0;
+
+	// the first request of a queue is sent with the next call of find_request_to_repeat
+	if (msg_slot == 1)
+	{
+		request_queue_due |= 1 << rs_slot;
+	}
 	
 	return true; // success!
 }
@@ -127,7 +149,7 @@ void print_request_queue(void)
 		if (request_buffer[i].message_type != MESSAGETYPE_UNUSED)
 		{
 			UART_PUTF("Request Buffer %u: ", i);
-			UART_PUTF4("MessageType %u, PacketCounter %lu, Timeout %u, Retry %u, Data", request_buffer[i].message_type, request_buffer[i].packet_counter, request_buffer[i].timeout, request_buffer[i].retry_count);
+			UART_PUTF4("MessageType %u, PacketCounter %lu, Timeout %u, Retry %u, Data", request_buffer[i].message_type, request_buffer[i].packet_counter, sw_timer_remaining(&request_timers, &request_buffer[i].timeout), request_buffer[i].retry_count);
 			
 			// TODO: only show bytes of real data length
 			for (j = 0; j < request_buffer[i].data_bytes; j++)
@@ -172,84 +194,124 @@ void print_request_queue(void)
 	UART_PUTS("\r\n");
 }
 
+// Timeout in seconds after the n-th transmission of a request.
+static inline uint8_t request_timeout(uint8_t retry_count)
+{
+	return (retry_count - 1) * REQUEST_ADDITIONAL_TIMEOUT_S + REQUEST_INITIAL_TIMEOUT_S;
+}
+
+// Write the first request of the given request queue to the send buffer bufx and count the
+// transmission. Delete the request if it is sent the last time and cleanup the queue and
+// request_buffer accordingly.
+static request_t * prepare_request(uint8_t rq_slot, uint32_t packet_counter)
+{
+	uint8_t slot = request_queue[rq_slot][1];
+	request_t * res = &request_buffer[slot];
+
+	// Init header
+	memset(&bufx[0], 0, sizeof(bufx));
+	pkg_header_set_senderid(0); // FIXME: Use DeviceID instead?!
+	pkg_header_set_packetcounter(packet_counter);
+
+	// set message type
+	pkg_header_set_messagetype(request_buffer[slot].message_type);
+
+	// set header extension (incl. receiver_id) + data
+	memcpy(bufx + 9, request_buffer[slot].data, request_buffer[slot].data_bytes); // header size = 9 bytes
+
+	// remember packet counter
+	request_buffer[slot].packet_counter = packet_counter;
+
+	request_buffer[slot].retry_count++;
+
+	request_queue_due &= ~(1 << rq_slot);
+
+	if (request_buffer[slot].retry_count > REQUEST_RETRY_COUNT)
+	{
+		// delete request from queue
+		request_buffer[slot].message_type = MESSAGETYPE_UNUSED;
+		sw_timer_stop(&request_buffer[slot].timeout);
+
+		uint8_t x;
+
+		for (x = 1; x < REQUEST_QUEUE_PACKETS; x++)
+		{
+			request_queue[rq_slot][x] = request_queue[rq_slot][x + 1];
+		}
+
+		request_queue[rq_slot][REQUEST_QUEUE_PACKETS] = SLOT_UNUSED;
+
+		// delete request queue completely (if no requests are in the queue)
+		if (request_queue[rq_slot][1] == SLOT_UNUSED)
+		{
+			request_queue[rq_slot][0] = SLOT_UNUSED;
+		}
+		else // send the next request with the next call of find_request_to_repeat
+		{
+			request_queue_due |= 1 << rq_slot;
+		}
+	}
+	else
+	{
+		sw_timer_start(&request_timers, &request_buffer[slot].timeout, request_timeout(request_buffer[slot].retry_count));
+	}
+
+	return res;
+}
+
 // Search for a request to repeat (with timeout reached) and write the data to the send buffer bufx.
 // Return a pointer to the request if successful, 0 if no request to repeat was found.
-// Automatically decrease timeout counters for all waiting requests in the queue,
+// Automatically advance the timeouts of all waiting requests in the queue,
 // delete a request if it is repeated the last time and cleanup the queue and repeat_buffer accordingly.
 // This function has to be called once a second, because the timeout values represent the amount of seconds.
 //
 // TODO (optimization): Change the behaviour so that a new packet can be sent out of the queue without a delay (currently, we have ~0.5s delay in average).
-// So check the queue for "timeout 0" packets more often, but don't reduce the timeout in this case.
+// So check request_queue_due more often, but don't tick the timers in this case.
 request_t * find_request_to_repeat(uint32_t packet_counter)
 {
 	uint8_t i;
-	uint8_t slot;
-	request_t * res = 0;
 
-	for (i = 0; i < REQUEST_QUEUE_RECEIVERS; i++)
+	timer_wheel_tick(&request_timers);
+
+	if (request_queue_due == 0)
 	{
-		if (request_queue[i][0] != SLOT_UNUSED)
-		{
-			// count down timeout from first element per queue
-			slot = request_queue[i][1];
-			
-			if (request_buffer[slot].timeout > 0)
-			{
-				request_buffer[slot].timeout--;
-			}
-			
-			// set bufx to the request to retry, if timeout is reached
-			if ((request_buffer[slot].timeout == 0) && (res == 0))
-			{
-				res = &request_buffer[slot];
+		return 0;
+	}
 
-				// Init header
-				memset(&bufx[0], 0, sizeof(bufx));
-				pkg_header_set_senderid(0); // FIXME: Use DeviceID instead?!
-				pkg_header_set_packetcounter(packet_counter);
+	for (i = 0; !(request_queue_due & (1 << i)); i++)
+	{
+	}
 
-				// set message type
-				pkg_header_set_messagetype(request_buffer[slot].message_type);
+	return prepare_request(i, packet_counter);
+}
 
-				// set header extension (incl. receiver_id) + data
-				memcpy(bufx + 9, request_buffer[slot].data, request_buffer[slot].data_bytes); // header size = 9 bytes
-				
-				// remember packet counter
-				request_buffer[slot].packet_counter = packet_counter;
-				
-				request_buffer[slot].retry_count++;
-				
-				if (request_buffer[slot].retry_count > REQUEST_RETRY_COUNT)
-				{
-					// delete request from queue
-					request_buffer[slot].message_type = MESSAGETYPE_UNUSED;
+// Search for a request to the given receiver and write the data to the send buffer bufx.
+// This is used to send requests immediately after a packet from the receiver was received,
+// because battery powered devices only listen for a short time after sending.
+// A request that was already sent within the last second is not sent again, because the
+// answer of the receiver may still be on its way.
+// Return a pointer to the request if successful, 0 if no request was found.
+request_t * find_request_for_receiver(uint16_t receiver_id, uint32_t packet_counter)
+{
+	uint8_t i;
 
-					uint8_t x;
-					
-					for (x = 1; x < REQUEST_QUEUE_PACKETS; x++)
-					{
-						request_queue[i][x] = request_queue[i][x + 1];
-					}
-					
-					request_queue[i][REQUEST_QUEUE_PACKETS] = SLOT_UNUSED;
-					
-					// delete request queue completely (if no requests are in the queue)
-					if (request_queue[i][1] == SLOT_UNUSED)
-					{
-						request_queue[i][0] = SLOT_UNUSED;
-					}
-				}
-				else
-				{
-					request_buffer[slot].timeout = (request_buffer[slot].retry_count - 1) * REQUEST_ADDITIONAL_TIMEOUT_S + REQUEST_INITIAL_TIMEOUT_S;
-				}
+	for (i = 0; i < REQUEST_QUEUE_RECEIVERS; i++)
+	{
+		if (request_queue[i][0] == receiver_id)
+		{
+			uint8_t slot = request_queue[i][1];
+
+			if ((request_buffer[slot].retry_count > 0)
+				&& (sw_timer_remaining(&request_timers, &request_buffer[slot].timeout) >= request_timeout(request_buffer[slot].retry_count)))
+			{
+				return 0;
 			}
-		}
 
-		//UART_PUTS("\r\n");
+			return prepare_request(i, packet_counter);
+		}
 	}
-	
-	return res;
+
+	return 0;
 }
 
 // Assume a request as acknowledged and delete it from the request_buffer and request_queue.
@@ -279,6 +341,7 @@ void remove_request(uint16_t sender_id, uint16_t request_sender_id, uint32_t pac
 					
 					// remove from request buffer
 					request_buffer[rb_slot].message_type = MESSAGETYPE_UNUSED;
+					sw_timer_stop(&request_buffer[rb_slot].timeout);
 					
 					// remove from request queue
 					for (i = 1; i < REQUEST_QUEUE_PACKETS; i++)
@@ -293,6 +356,11 @@ void remove_request(uint16_t sender_id, uint16_t request_sender_id, uint32_t pac
 					{
 						UART_PUTF("Request Queue %u is now empty.\r\n", rq_slot);
 						request_queue[rq_slot][0] = SLOT_UNUSED;
+						request_queue_due &= ~(1 << rq_slot);
+					}
+					else // send the next request with the next call of find_request_to_repeat
+					{
+						request_queue_due |= 1 << rq_slot;
 					}
 					
 					print_request_queue();
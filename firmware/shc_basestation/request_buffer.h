@@ -22,6 +22,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "../src_common/util_timer.h"
+
 // The request buffer is used to remember requests that were sent until an acknowledge
 // for the request is received. After a timeout, the request is then repeated.
 // The request buffer can queue only 6 byte-messages currently (there are no longer
@@ -45,7 +47,7 @@ typedef struct {
 	uint8_t data[REQUEST_DATA_BYTES_MAX];
 	uint8_t data_bytes;
 
-	uint8_t timeout;
+	struct sw_timer_t timeout; // running until the request is repeated (in seconds)
 	uint8_t retry_count;
 } request_t;
 
@@ -61,6 +63,7 @@ void request_queue_init(void);
 void print_request_queue(void);
 bool queue_request(uint16_t receiver_id, uint8_t message_type, uint8_t aes_key, uint8_t * data, uint8_t data_len);
 request_t * find_request_to_repeat(uint32_t packet_counter);
+request_t * find_request_for_receiver(uint16_t receiver_id, uint32_t packet_counter);
 void remove_request(uint16_t sender_id, uint16_t request_sender_id, uint32_t packet_counter);
 
 #endif
@@ -16,17 +16,16 @@
 * with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <avr/io.h>
-#include <avr/interrupt.h>
-#include <util/delay.h>
 #include <string.h>
 
+#include "../src_common/hal.h"
 #include "rfm12.h"
 #include "../src_common/uart.h"
 
 #include "../src_common/msggrp_generic.h"
 #include "../src_common/msggrp_weather.h"
 #include "../src_common/msggrp_gpio.h"
+#include "../src_common/packet_dispatch.h"
 
 #include "../src_common/e2p_hardware.h"
 #include "../src_common/e2p_generic.h"
@@ -38,8 +37,7 @@
 #include "version.h"
 
 #define LED_PIN 7
-#define LED_PORT PORTD
-#define LED_DDR DDRD
+#define LED_PORT D
 
 #define LOOP_CNT_QUEUE 50 // cycle in which the request queue is checked for a request (don't change! it's 1s)
 
@@ -57,20 +55,90 @@
 uint16_t device_id;
 uint8_t aes_key_count;
 
+// Functions to additionally decode the message data for a small number of messages.
+void decode_generic_deviceinfo(MessageTypeEnum messagetype)
+{
+	UART_PUTF("Detected Generic_DeviceInfo_Status: DeviceType=%u;", msg_generic_deviceinfo_get_devicetype());
+	UART_PUTF("VersionMajor=%u;", msg_generic_deviceinfo_get_versionmajor());
+	UART_PUTF("VersionMinor=%u;", msg_generic_deviceinfo_get_versionminor());
+	UART_PUTF("VersionPatch=%u;", msg_generic_deviceinfo_get_versionpatch());
+	UART_PUTF("VersionHash=%08lx;\r\n", msg_generic_deviceinfo_get_versionhash());
+}
+
+void decode_generic_batterystatus(MessageTypeEnum messagetype)
+{
+	UART_PUTF("Detected Generic_BatteryStatus_Status: Percentage=%u;\r\n", msg_generic_batterystatus_get_percentage());
+}
+
+/*DateTime Status:
+UART_PUTS("Command Name=DateTime Status;");
+UART_PUTF3("Date=%u-%02u-%02u;", bufx[6] + 2000, bufx[7], bufx[8]);
+UART_PUTF3("Time=%02u:%02u:%02u", bufx[9], bufx[10], bufx[11]);*/
+
+void decode_weather_temperature(MessageTypeEnum messagetype)
+{
+	UART_PUTS("Detected Weather_Temperature_Status: Temperature=");
+	print_signed(msg_weather_temperature_get_temperature());
+	UART_PUTS(";\r\n");
+}
+
+void decode_weather_humiditytemperature(MessageTypeEnum messagetype)
+{
+	uint16_t u16 = msg_weather_humiditytemperature_get_humidity();
+	UART_PUTF2("Detected Weather_HumidityTemperature_Status: Humidity=%u.%u;Temperature=", u16 / 10, u16 % 10);
+	print_signed(msg_weather_humiditytemperature_get_temperature());
+	UART_PUTS(";\r\n");
+}
+
+void decode_gpio_digitalport(MessageTypeEnum messagetype)
+{
+	uint16_t u16;
+
+	UART_PUTS("Detected GPIO_DigitalPort_Status: ");
+	for (u16 = 0; u16 < 8; u16++)
+	{
+		UART_PUTF2("On[%u]=%u;", u16, msg_gpio_digitalport_get_on(u16));
+	}
+	UART_PUTS("\r\n");
+}
+
+void decode_gpio_digitalporttimeout(MessageTypeEnum messagetype)
+{
+	uint16_t u16;
+
+	UART_PUTS("Detected GPIO_DigitalPortTimeout_Status: ");
+	for (u16 = 0; u16 < 8; u16++)
+	{
+		UART_PUTF2("On[%u]=%u;", u16, msg_gpio_digitalporttimeout_get_on(u16));
+		UART_PUTF2("TimeoutSec[%u]=%u;", u16, msg_gpio_digitalporttimeout_get_timeoutsec(u16));
+	}
+	UART_PUTS("\r\n");
+}
+
+// Decode functions, indexed by the slot in the dispatch table.
+const pkg_handler_t decode_handlers[MSGSLOT_COUNT] PROGMEM = {
+	[MSGSLOT_GENERIC_DEVICEINFO] = decode_generic_deviceinfo,
+	[MSGSLOT_GENERIC_BATTERYSTATUS] = decode_generic_batterystatus,
+	[MSGSLOT_WEATHER_TEMPERATURE] = decode_weather_temperature,
+	[MSGSLOT_WEATHER_HUMIDITYTEMPERATURE] = decode_weather_humiditytemperature,
+	[MSGSLOT_GPIO_DIGITALPORT] = decode_gpio_digitalport,
+	[MSGSLOT_GPIO_DIGITALPORTTIMEOUT] = decode_gpio_digitalporttimeout
+};
+
 // Show info about the received packets.
 // This is only for debugging and only few messages are supported. The definition
 // of all packets must be known at the PC program that's processing the data.
-void decode_data(uint8_t len)
+// The message data is only decoded for packets in bufx.
+void decode_data_ctx(pkg_ctx_t * ctx, uint8_t len)
 {
 	uint32_t messagegroupid = 0;
 	uint32_t messageid = 0;
-	uint16_t u16;
 
-	pkg_header_adjust_offset();
+	pkg_header_ctx_adjust_offset(ctx);
 
-	uint16_t senderid = pkg_header_get_senderid();
-	uint32_t packetcounter = pkg_header_get_packetcounter();
-	MessageTypeEnum messagetype = pkg_header_get_messagetype();
+	uint16_t senderid = pkg_header_ctx_get_senderid(ctx);
+	uint32_t packetcounter = pkg_header_ctx_get_packetcounter(ctx);
+	MessageTypeEnum messagetype = pkg_header_ctx_get_messagetype(ctx);
 
 	UART_PUTS("PKT:");
 
@@ -83,7 +151,7 @@ void decode_data(uint8_t len)
 	// show ReceiverID for all requests
 	if ((messagetype == MESSAGETYPE_GET) || (messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET) || (messagetype == MESSAGETYPE_DELIVER))
 	{
-		uint16_t receiverid = pkg_headerext_common_get_receiverid();
+		uint16_t receiverid = pkg_headerext_common_ctx_get_receiverid(ctx);
 		UART_PUTF_B("RID=%u;", receiverid);
 	}
 
@@ -93,9 +161,9 @@ void decode_data(uint8_t len)
 	// show AckSenderID, AckPacketCounter and Error for "Ack" and "AckStatus"
 	if ((messagetype == MESSAGETYPE_ACK) || (messagetype == MESSAGETYPE_ACKSTATUS))
 	{
-		acksenderid = pkg_headerext_common_get_acksenderid();
-		ackpacketcounter = pkg_headerext_common_get_ackpacketcounter();
-		uint8_t error = pkg_headerext_common_get_error();
+		acksenderid = pkg_headerext_common_ctx_get_acksenderid(ctx);
+		ackpacketcounter = pkg_headerext_common_ctx_get_ackpacketcounter(ctx);
+		uint8_t error = pkg_headerext_common_ctx_get_error(ctx);
 		UART_PUTF_B("ASID=%u;", acksenderid);
 		UART_PUTF_B("APC=%lu;", ackpacketcounter);
 		UART_PUTF_B("E=%u;", error);
@@ -104,8 +172,8 @@ void decode_data(uint8_t len)
 	// show MessageGroupID and MessageID for all MessageTypes except "Ack"
 	if (messagetype != MESSAGETYPE_ACK)
 	{
-		messagegroupid = pkg_headerext_common_get_messagegroupid();
-		messageid = pkg_headerext_common_get_messageid();
+		messagegroupid = pkg_headerext_common_ctx_get_messagegroupid(ctx);
+		messageid = pkg_headerext_common_ctx_get_messageid(ctx);
 		UART_PUTF_B("MGID=%u;", messagegroupid);
 		UART_PUTF_B("MID=%u;", messageid);
 	}
@@ -114,7 +182,7 @@ void decode_data(uint8_t len)
 	if ((messagetype != MESSAGETYPE_GET) && (messagetype != MESSAGETYPE_ACK))
 	{
 		uint16_t i;
-		uint16_t count = (((uint16_t)len * 8) - __HEADEROFFSETBITS + 7) / 8;
+		uint16_t count = (((uint16_t)len * 8) - ctx->headeroffsetbits + 7) / 8;
 
 		//UART_PUTF4("\r\n\r\nLEN=%u, START=%u, SHIFT=%u, COUNT=%u\r\n\r\n", len, start, shift, count);
 
@@ -123,7 +191,7 @@ void decode_data(uint8_t len)
 
 		while (count > 1)
 		{
-			if (array_read_UIntValue8(__HEADEROFFSETBITS + (count - 1) * 8, 8, 0, 255, bufx) == 0)
+			if (array_read_UIntValue8(ctx->headeroffsetbits + (count - 1) * 8, 8, 0, 255, ctx->buf) == 0)
 			{
 				count--;
 			}
@@ -135,7 +203,7 @@ void decode_data(uint8_t len)
 
 		for (i = 0; i < count; i++)
 		{
-			UART_PUTF_B("%02x", array_read_UIntValue8(__HEADEROFFSETBITS + i * 8, 8, 0, 255, bufx));
+			UART_PUTF_B("%02x", array_read_UIntValue8(ctx->headeroffsetbits + i * 8, 8, 0, 255, ctx->buf));
 		}
 
 		UART_PUTS_B(";");
@@ -146,85 +214,11 @@ void decode_data(uint8_t len)
 		UART_PUTF("%08lx\r\n", crc); // print CRC32
 
 		// additionally decode the message data for a small number of messages
-		switch (messagegroupid)
+		// (the decode functions use bufx and the global header state)
+		if (ctx->buf == bufx)
 		{
-			case MESSAGEGROUP_GENERIC:
-
-				switch (messageid)
-				{
-					case MESSAGEID_GENERIC_DEVICEINFO:
-						UART_PUTF("Detected Generic_DeviceInfo_Status: DeviceType=%u;", msg_generic_deviceinfo_get_devicetype());
-						UART_PUTF("VersionMajor=%u;", msg_generic_deviceinfo_get_versionmajor());
-						UART_PUTF("VersionMinor=%u;", msg_generic_deviceinfo_get_versionminor());
-						UART_PUTF("VersionPatch=%u;", msg_generic_deviceinfo_get_versionpatch());
-						UART_PUTF("VersionHash=%08lx;\r\n", msg_generic_deviceinfo_get_versionhash());
-						break;
-
-					case MESSAGEID_GENERIC_BATTERYSTATUS:
-						UART_PUTF("Detected Generic_BatteryStatus_Status: Percentage=%u;\r\n", msg_generic_batterystatus_get_percentage());
-						break;
-
-					/*DateTime Status:
-					UART_PUTS("Command Name=DateTime Status;");
-					UART_PUTF3("Date=%u-%02u-%02u;", bufx[6] + 2000, bufx[7], bufx[8]);
-					UART_PUTF3("Time=%02u:%02u:%02u", bufx[9], bufx[10], bufx[11]);*/
-
-					default:
-						break;
-				}
-
-				break;
-
-			case MESSAGEGROUP_WEATHER:
-
-				switch (messageid)
-				{
-					case MESSAGEID_WEATHER_TEMPERATURE:
-						UART_PUTS("Detected Weather_Temperature_Status: Temperature=");
-						print_signed(msg_weather_temperature_get_temperature());
-						UART_PUTS(";\r\n");
-						break;
-					case MESSAGEID_WEATHER_HUMIDITYTEMPERATURE:
-						u16 = msg_weather_humiditytemperature_get_humidity();
-						UART_PUTF2("Detected Weather_HumidityTemperature_Status: Humidity=%u.%u;Temperature=", u16 / 10, u16 % 10);
-						print_signed(msg_weather_humiditytemperature_get_temperature());
-						UART_PUTS(";\r\n");
-						break;
-					default:
-						break;
-				}
-
-				break;
-
-			case MESSAGEGROUP_GPIO:
-
-				switch (messageid)
-				{
-					case MESSAGEID_GPIO_DIGITALPORT:
-						UART_PUTS("Detected GPIO_DigitalPort_Status: ");
-						for (u16 = 0; u16 < 8; u16++)
-						{
-							UART_PUTF2("On[%u]=%u;", u16, msg_gpio_digitalport_get_on(u16));
-						}
-						UART_PUTS("\r\n");
-						break;
-					case MESSAGEID_GPIO_DIGITALPORTTIMEOUT:
-						UART_PUTS("Detected GPIO_DigitalPortTimeout_Status: ");
-						for (u16 = 0; u16 < 8; u16++)
-						{
-							UART_PUTF2("On[%u]=%u;", u16, msg_gpio_digitalporttimeout_get_on(u16));
-							UART_PUTF2("TimeoutSec[%u]=%u;", u16, msg_gpio_digitalporttimeout_get_timeoutsec(u16));
-						}
-						UART_PUTS("\r\n");
-						break;
-					default:
-						break;
-				}
-
-				break;
-
-			default:
-				break;
+			pkg_ctx_store_global(ctx);
+			pkg_dispatch(len, decode_handlers);
 		}
 	}
 
@@ -238,13 +232,20 @@ void decode_data(uint8_t len)
 	}
 }
 
-// Set senderid, packetcounter and CRC into the partly filled packet, encrypt it using the given AES key number and send it.
-void send_packet(uint8_t aes_key_nr, uint8_t packet_len)
+void decode_data(uint8_t len)
 {
-	pkg_header_set_senderid(device_id);
+	pkg_header_adjust_offset();
+	decode_data_ctx(PKG_CTX_GLOBAL, len);
+}
+
+// Set senderid, packetcounter and CRC into the partly filled packet in the buffer of the
+// context, encrypt it using the given AES key number and send it.
+void send_packet_ctx(pkg_ctx_t * ctx, uint8_t aes_key_nr, uint8_t packet_len)
+{
+	pkg_header_ctx_set_senderid(ctx, device_id);
 
 	inc_packetcounter();
-	pkg_header_set_packetcounter(packetcounter);
+	pkg_header_ctx_set_packetcounter(ctx, packetcounter);
 
 	// load AES key (0 is first AES key)
 	if (aes_key_nr >= aes_key_count)
@@ -255,43 +256,89 @@ void send_packet(uint8_t aes_key_nr, uint8_t packet_len)
 	e2p_basestation_get_aeskey(aes_key_nr, aes_key);
 
 	// show info
-	decode_data(packet_len);
+	decode_data_ctx(ctx, packet_len);
 
 	// encrypt and send
-	__PACKETSIZEBYTES = packet_len;
-	rfm12_send_bufx();
+	ctx->packetsizebytes = rfm12_send_buf(ctx->buf, packet_len);
+}
+
+void send_packet(uint8_t aes_key_nr, uint8_t packet_len)
+{
+	pkg_ctx_t ctx = *PKG_CTX_GLOBAL;
+
+	send_packet_ctx(&ctx, aes_key_nr, packet_len);
+	pkg_ctx_store_global(&ctx);
 }
 
 void send_deliver_ack(int aes_key_nr)
 {
-	pkg_header_adjust_offset();
+	// Interpret the received packet without changing the global header state.
+	pkg_ctx_t rx = { bufx };
+	pkg_header_ctx_adjust_offset(&rx);
 
-	if (pkg_header_get_messagetype() == MESSAGETYPE_DELIVER)
+	if (rx.messagetype == MESSAGETYPE_DELIVER)
 	{
-		if (pkg_headerext_common_get_receiverid() == device_id)
+		if (pkg_headerext_common_ctx_get_receiverid(&rx) == device_id)
 		{
+			uint8_t ackbuf[BUFX_LENGTH];
+			pkg_ctx_t ack = { ackbuf };
+
 			UART_PUTS("Sending Deliver Ack: ");
-			uint16_t senderid = pkg_header_get_senderid();
-			uint32_t packetcounter = pkg_header_get_packetcounter();
+			uint16_t senderid = pkg_header_ctx_get_senderid(&rx);
+			uint32_t packetcounter = pkg_header_ctx_get_packetcounter(&rx);
 			UART_PUTF("SID=%u;", senderid);
 			UART_PUTF("PC=%lu\r\n", packetcounter);
 
-			// init packet buffer
-			memset(&bufx[0], 0, sizeof(bufx));
+			// Prepare and send the ack in a separate buffer, so the received
+			// packet in bufx stays intact.
+			memset(ackbuf, 0, sizeof(ackbuf));
 
 			// set message type
-			pkg_header_set_messagetype(MESSAGETYPE_ACK);
-			pkg_header_adjust_offset();
-			pkg_headerext_common_set_acksenderid(senderid);
-			pkg_headerext_common_set_ackpacketcounter(packetcounter);
-			pkg_headerext_common_set_error(0);
+			pkg_header_ctx_set_messagetype(&ack, MESSAGETYPE_ACK);
+			pkg_header_ctx_adjust_offset(&ack);
+			pkg_headerext_common_ctx_set_acksenderid(&ack, senderid);
+			pkg_headerext_common_ctx_set_ackpacketcounter(&ack, packetcounter);
+			pkg_headerext_common_ctx_set_error(&ack, 0);
 
-			send_packet(aes_key_nr, 16);
+			send_packet_ctx(&ack, aes_key_nr, 16);
 			UART_PUTF("Sending took %ums\r\n", rfm12_send_wait_led());
 		}
 	}
 }
 
+// Battery powered devices switch on their receiver only for a short time after sending.
+// Return the SenderID of the received packet if the sender is such a device and waits for
+// requests now, 0 otherwise. The packet has to be decoded before.
+uint16_t get_listening_sender(void)
+{
+	MessageTypeEnum messagetype = pkg_header_get_messagetype();
+	uint16_t senderid = pkg_header_get_senderid();
+
+	if ((senderid == device_id)
+		|| ((messagetype != MESSAGETYPE_STATUS) && (messagetype != MESSAGETYPE_ACK)
+		&& (messagetype != MESSAGETYPE_ACKSTATUS) && (messagetype != MESSAGETYPE_DELIVER)))
+	{
+		return 0;
+	}
+
+	return senderid;
+}
+
+// Send the first queued request for the given device immediately, so that it arrives
+// while the device is still listening.
+void send_request_to_listening_sender(uint16_t senderid)
+{
+	request_t* request = find_request_for_receiver(senderid, packetcounter + 1);
+
+	if (request != 0)
+	{
+		send_packet((*request).aes_key, (*request).data_bytes + 9); // header size = 9 bytes!
+		UART_PUTF("Sending request to listening device (took %ums).\r\n", rfm12_send_wait_led());
+
+		print_request_queue();
+	}
+}
+
 int main(void)
 {
 	uint8_t aes_key_nr;
@@ -299,7 +346,7 @@ int main(void)
 	bool uart_high_speed;
 
 	// delay 1s to avoid further communication with uart or RFM12 when my programmer resets the MC after 500ms...
-	_delay_ms(1000);
+	hal_delay_ms(1000);
 
 	util_init();
 
@@ -308,8 +355,7 @@ int main(void)
 	request_queue_init();
 
 	// read packetcounter, increase by cycle and write back
-	packetcounter = e2p_generic_get_packetcounter() + PACKET_COUNTER_WRITE_CYCLE;
-	e2p_generic_set_packetcounter(packetcounter);
+	init_packetcounter();
 
 	// read device specific config
 	aes_key_count = e2p_basestation_get_aeskeycount();
@@ -363,7 +409,7 @@ int main(void)
 
 	rfm_watchdog_init(device_id, e2p_basestation_get_transceiverwatchdogtimeout(), RFM_RESET_PORT_NR, RFM_RESET_PIN, RFM_RESET_PIN_STATE);
 	rfm12_init();
-	sei();
+	hal_irq_enable();
 
 	// ENCODE TEST (Move to unit test some day...)
 	/*
@@ -411,6 +457,7 @@ int main(void)
 		if (rfm12_rx_status() == STATUS_COMPLETE)
 		{
 			uint8_t len = rfm12_rx_len();
+			uint16_t listening_sender = 0;
 
 			rfm_watchdog_alive();
 
@@ -457,6 +504,8 @@ int main(void)
 						UART_PUTF("Received (AES key %u): ", aes_key_nr);
 						print_bytearray(bufx, len);
 
+						listening_sender = get_listening_sender();
+
 						// Send deliver ack immediately (not using request buffer)
 						send_deliver_ack(aes_key_nr);
 
@@ -479,6 +528,11 @@ int main(void)
 
 			// tell the implementation that the buffer can be reused for the next data.
 			rfm12_rx_clear();
+
+			if (listening_sender != 0)
+			{
+				send_request_to_listening_sender(listening_sender);
+			}
 		}
 
 		// send data, if waiting in send buffer
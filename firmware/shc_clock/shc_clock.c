@@ -306,8 +306,7 @@ int main(void)
 	//check_eeprom_compatibility(DEVICETYPE_POWERSWITCH);
 
 	// read packetcounter, increase by cycle and write back
-	packetcounter = e2p_generic_get_packetcounter() + PACKET_COUNTER_WRITE_CYCLE;
-	e2p_generic_set_packetcounter(packetcounter);
+	init_packetcounter();
 
 	// read device id
 	device_id = e2p_generic_get_deviceid();
@@ -30,6 +30,7 @@
 #include "../src_common/msggrp_display.h"
 #include "../src_common/msggrp_controller.h"
 #include "../src_common/msggrp_gpio.h"
+#include "../src_common/packet_dispatch.h"
 
 #include "../src_common/e2p_hardware.h"
 #include "../src_common/e2p_generic.h"
@@ -47,8 +48,7 @@
 #define RFM_RESET_PIN_STATE 1
 
 #define LED_PIN 7
-#define LED_PORT PORTD
-#define LED_DDR DDRD
+#define LED_PORT D
 
 #define LCD_BACKLIGHT_PORT  PORTC
 #define LCD_BACKLIGHT_DDR   DDRC
@@ -78,6 +78,37 @@ typedef enum {
 	KEY_CANCEL = 6
 } MenuKeyEnum;
 
+typedef enum {
+	KEY_EVENT_PRESS = 0,
+	KEY_EVENT_REPEAT = 1,
+	KEY_EVENT_RELEASE = 2
+} KeyEventEnum;
+
+// The keys are scanned in the timer 0 interrupt (~610 Hz at 20 MHz, see PWM_init) and the
+// debounced key events are put into a FIFO, which is read by the main loop.
+#define KEY_SCAN_DIVIDER (F_CPU / 64 / 510 / 100) // timer 0 overflows per key scan (~10ms)
+#define KEY_DEBOUNCE_SCANS 2       // a key has to be stable for this number of scans
+#define KEY_REPEAT_DELAY_SCANS 50  // first repeat event after ~500ms
+#define KEY_REPEAT_SCANS 15        // further repeat events every ~150ms
+#define KEY_FIFO_SIZE 8            // has to be a power of 2
+
+uint8_t key_scan_divider = KEY_SCAN_DIVIDER;
+MenuKeyEnum key_sample = KEY_NONE;
+MenuKeyEnum key_pressed = KEY_NONE;
+uint8_t key_stable_scans = 0;
+uint8_t key_repeat_scans = 0;
+
+// The FIFO is written only by the ISR and read only by the main loop, so no locking is needed.
+volatile uint8_t key_fifo[KEY_FIFO_SIZE]; // key | (KeyEventEnum << 4)
+volatile uint8_t key_fifo_head = 0;
+volatile uint8_t key_fifo_tail = 0;
+
+// RAM copy of the used part of the device specific e2p block (see e2p_controller.h),
+// so that reading the menu texts and options doesn't access the EEPROM.
+#define E2P_SHADOW_START (512 / 8)
+#define E2P_SHADOW_BYTES ((16752 - 512) / 8)
+
+uint8_t e2p_shadow_buf[E2P_SHADOW_BYTES];
 uint16_t device_id;
 uint32_t station_packetcounter;
 uint32_t deliver_packetcounter;
@@ -116,8 +147,96 @@ uint8_t max8(uint8_t a, uint8_t b)
 		return b;
 }
 
+// Wait 20ms (see rfm12_delay20) and write some changed characters to the LCD before.
+// Use this instead of rfm12_delay20 so that the LCD is updated while waiting.
+void delay20_vlcd_flush(void)
+{
+	vlcd_flush(VLCD_FLUSH_SLICE);
+	rfm12_delay20();
+}
+
+MenuKeyEnum detect_key(void);
+
+// Put the event into the key FIFO. It is lost if the FIFO is full.
+void key_event_put(MenuKeyEnum key, KeyEventEnum event)
+{
+	uint8_t head = (key_fifo_head + 1) & (KEY_FIFO_SIZE - 1);
+
+	if (head != key_fifo_tail)
+	{
+		key_fifo[key_fifo_head] = key | (event << 4);
+		key_fifo_head = head;
+	}
+}
+
+// Get the next event from the key FIFO. Return false if there is none.
+bool key_event_get(MenuKeyEnum * key, KeyEventEnum * event)
+{
+	if (key_fifo_tail == key_fifo_head)
+		return false;
+
+	uint8_t e = key_fifo[key_fifo_tail];
+
+	key_fifo_tail = (key_fifo_tail + 1) & (KEY_FIFO_SIZE - 1);
+	*key = e & 0x0f;
+	*event = e >> 4;
+
+	return true;
+}
+
+// Scan the keys and create the key events. Called every ~10ms by the timer interrupt.
+void key_scan(void)
+{
+	MenuKeyEnum key = detect_key();
+
+	if (key != key_sample)
+	{
+		key_sample = key;
+		key_stable_scans = 1;
+		return;
+	}
+
+	if (key_stable_scans < KEY_DEBOUNCE_SCANS)
+	{
+		key_stable_scans++;
+
+		if (key_stable_scans < KEY_DEBOUNCE_SCANS)
+			return;
+	}
+
+	if (key != key_pressed)
+	{
+		if (key_pressed != KEY_NONE)
+			key_event_put(key_pressed, KEY_EVENT_RELEASE);
+
+		key_pressed = key;
+
+		if (key != KEY_NONE)
+		{
+			key_event_put(key, KEY_EVENT_PRESS);
+			key_repeat_scans = KEY_REPEAT_DELAY_SCANS;
+		}
+	}
+	else if (key != KEY_NONE)
+	{
+		if (--key_repeat_scans == 0)
+		{
+			key_event_put(key, KEY_EVENT_REPEAT);
+			key_repeat_scans = KEY_REPEAT_SCANS;
+		}
+	}
+}
+
 ISR (TIMER0_OVF_vect)
 {
+	key_scan_divider--;
+
+	if (key_scan_divider == 0)
+	{
+		key_scan_divider = KEY_SCAN_DIVIDER;
+		key_scan();
+	}
+
 	timer1_tick_divider--;
 
 	if (timer1_tick_divider == 0)
@@ -180,6 +299,7 @@ void vlcd_blink_text(uint8_t y, uint8_t x, char * s, bool error_beep)
 			speaker_set_fixed_tone(13);
 
 		vlcd_puts(s);
+		vlcd_flush_all();
 
 		for (j = 0; j < 25; j++)
 			rfm12_delay20();
@@ -192,6 +312,8 @@ void vlcd_blink_text(uint8_t y, uint8_t x, char * s, bool error_beep)
 		for (j = 0; j < len; j++)
 			vlcd_putc(' ');
 
+		vlcd_flush_all();
+
 		for (j = 0; j < 25; j++)
 			rfm12_delay20();
 	}
@@ -317,190 +439,232 @@ void send_ack(uint32_t acksenderid, uint32_t ackpacketcounter, bool error)
 	rfm12_send_bufx();
 }
 
-// Process a request to this device.
-// React accordingly on the MessageType, MessageGroup and MessageID
-// and send an Ack in any case. It may be an error ack if request is not supported.
-void process_request(MessageTypeEnum messagetype, uint32_t messagegroupid, uint32_t messageid)
+// process request "dimmer brightness"
+void process_dimmer_brightness(MessageTypeEnum messagetype)
 {
-	// remember some values before the packet buffer is destroyed
-	uint32_t acksenderid = pkg_header_get_senderid();
-	uint32_t ackpacketcounter = pkg_header_get_packetcounter();
+	// "Set" or "SetGet" -> modify brightness
+	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
+	{
+		msg_dimmer_brightness_t msg;
+
+		msg_dimmer_brightness_unpack(bufx, &msg);
+		rgb_led_user_brightness_factor = msg.brightness;
+		UART_PUTF("Brightness:%u;", rgb_led_user_brightness_factor);
+		rgb_led_update_current_col();
+	}
+
+	// "Set" -> send "Ack"
+	if (messagetype == MESSAGETYPE_SET)
+	{
+		pkg_header_init_dimmer_brightness_ack();
+	}
+	// "Get" or "SetGet" -> send "AckStatus"
+	else
+	{
+		msg_dimmer_brightness_t msg = { rgb_led_user_brightness_factor };
+
+		pkg_header_init_dimmer_brightness_ackstatus();
+		msg_dimmer_brightness_pack(&msg, bufx);
+	}
+}
+
+// process request "dimmer color"
+void process_dimmer_color(MessageTypeEnum messagetype)
+{
+	// "Set" or "SetGet" -> modify color
+	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
+	{
+		msg_dimmer_color_t msg;
+
+		msg_dimmer_color_unpack(bufx, &msg);
+		UART_PUTF("Color:%u;", msg.color);
+		rgb_led_set_fixed_color(msg.color);
+	}
+
+	// "Set" -> send "Ack"
+	if (messagetype == MESSAGETYPE_SET)
+	{
+		pkg_header_init_dimmer_color_ack();
+	}
+	// "Get" or "SetGet" -> send "AckStatus"
+	else
+	{
+		msg_dimmer_color_t msg = { anim_colors_orig[0] };
+
+		pkg_header_init_dimmer_color_ackstatus();
+		msg_dimmer_color_pack(&msg, bufx);
+	}
+}
+
+// process request "dimmer color animation"
+void process_dimmer_coloranimation(MessageTypeEnum messagetype)
+{
+	msg_dimmer_coloranimation_t msg;
+	uint8_t i;
 
-	// An ACK doesn't contain message group and message id. So only check it for other message types.
-	if (messagetype != MESSAGETYPE_ACK)
+	// "Set" or "SetGet" -> start new animation
+	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
 	{
-		UART_PUTF("MessageGroupID:%u;", messagegroupid);
+		msg_dimmer_coloranimation_unpack(bufx, &msg);
+
+		cli();
+
+		animation.repeat = msg.repeat;
+		animation.autoreverse = msg.autoreverse;
 
-		if ((messagegroupid != MESSAGEGROUP_DISPLAY) && (messagegroupid != MESSAGEGROUP_AUDIO) && (messagegroupid != MESSAGEGROUP_DIMMER) && (messagegroupid != MESSAGEGROUP_CONTROLLER))
+		UART_PUTF2("Repeat:%u;AutoReverse:%u;", animation.repeat, animation.autoreverse);
+
+		for (i = 0; i < ANIM_COL_ORIG_MAX; i++)
 		{
-			UART_PUTS("\r\nERR: Unsupported MessageGroupID.\r\n");
-			send_ack(acksenderid, ackpacketcounter, true);
-			return;
+			anim_time[i] = msg.time[i];
+			anim_colors_orig[i] = msg.color[i];
+
+			UART_PUTF2("Time[%u]:%u;", i, anim_time[i]);
+			UART_PUTF2("Color[%u]:%u;", i, anim_colors_orig[i]);
 		}
 
-		UART_PUTF("MessageID:%u;", messageid);
-
-		if (((messagegroupid == MESSAGEGROUP_DISPLAY)
-			&& (messageid != MESSAGEID_DISPLAY_TEXT)
-			&& (messageid != MESSAGEID_DISPLAY_BACKLIGHT))
-			||
-			((messagegroupid == MESSAGEGROUP_AUDIO)
-			&& (messageid != MESSAGEID_AUDIO_TONE)
-			&& (messageid != MESSAGEID_AUDIO_MELODY))
-			||
-			((messagegroupid == MESSAGEGROUP_CONTROLLER)
-			&& (messageid != MESSAGEID_CONTROLLER_MENUSELECTION))
-			||
-			((messagegroupid == MESSAGEGROUP_DIMMER)
-			&& (messageid != MESSAGEID_DIMMER_BRIGHTNESS)
-			&& (messageid != MESSAGEID_DIMMER_COLOR)
-			&& (messageid != MESSAGEID_DIMMER_COLORANIMATION)))
+		init_animation(true);
+		rgb_led_update_current_col();
+
+		sei();
+	}
+
+	// "Set" -> send "Ack"
+	if (messagetype == MESSAGETYPE_SET)
+	{
+		pkg_header_init_dimmer_coloranimation_ack();
+	}
+	// "Get" or "SetGet" -> send "AckStatus"
+	else
+	{
+		memset(&msg, 0, sizeof(msg));
+
+		for (i = 0; i < ANIM_COL_ORIG_MAX; i++)
 		{
-			UART_PUTS("\r\nERR: Unsupported MessageID.\r\n");
-			send_ack(acksenderid, ackpacketcounter, true);
-			return;
+			msg.color[i] = anim_colors_orig[i];
+			msg.time[i] = anim_time[i];
 		}
+
+		msg.repeat = animation.repeat;
+		msg.autoreverse = animation.autoreverse;
+
+		pkg_header_init_dimmer_coloranimation_ackstatus();
+		msg_dimmer_coloranimation_pack(&msg, bufx);
 	}
+}
 
-	// "Set" or "SetGet" -> modify brightness/color/animation
+// process request "audio tone"
+void process_audio_tone(MessageTypeEnum messagetype)
+{
+	// "Set" or "SetGet" -> play tone
 	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
 	{
-		if (messagegroupid == MESSAGEGROUP_DIMMER)
-		{
-			if (messageid == MESSAGEID_DIMMER_BRIGHTNESS)
-			{
-				rgb_led_user_brightness_factor = msg_dimmer_brightness_get_brightness();
-				UART_PUTF("Brightness:%u;", rgb_led_user_brightness_factor);
-				rgb_led_update_current_col();
-			}
-			else if (messageid == MESSAGEID_DIMMER_COLOR)
-			{
-				uint8_t color = msg_dimmer_color_get_color();
-				UART_PUTF("Color:%u;", color);
-				rgb_led_set_fixed_color(color);
-			}
-			else // MESSAGEID_DIMMER_COLORANIMATION
-			{
-				uint8_t i;
+		msg_audio_tone_t msg;
 
-				cli();
+		msg_audio_tone_unpack(bufx, &msg);
+		UART_PUTF("Tone:%u;", msg.tone);
+		speaker_set_fixed_tone(msg.tone);
+	}
 
-				animation.repeat = msg_dimmer_coloranimation_get_repeat();
-				animation.autoreverse = msg_dimmer_coloranimation_get_autoreverse();
+	// "Set" -> send "Ack"
+	if (messagetype == MESSAGETYPE_SET)
+	{
+		pkg_header_init_audio_tone_ack();
+	}
+	// "Get" or "SetGet" -> send "AckStatus"
+	else
+	{
+		msg_audio_tone_t msg = { melody_tones_orig[0] };
 
-				UART_PUTF2("Repeat:%u;AutoReverse:%u;", animation.repeat, animation.autoreverse);
+		pkg_header_init_audio_tone_ackstatus();
+		msg_audio_tone_pack(&msg, bufx);
+	}
+}
 
-				for (i = 0; i < ANIM_COL_ORIG_MAX; i++)
-				{
-					anim_time[i] = msg_dimmer_coloranimation_get_time(i);
-					anim_colors_orig[i] = msg_dimmer_coloranimation_get_color(i);
+// process request "audio melody"
+void process_audio_melody(MessageTypeEnum messagetype)
+{
+	msg_audio_melody_t msg;
+	uint8_t i;
 
-					UART_PUTF2("Time[%u]:%u;", i, anim_time[i]);
-					UART_PUTF2("Color[%u]:%u;", i, anim_colors_orig[i]);
-				}
+	// "Set" or "SetGet" -> start new melody
+	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
+	{
+		msg_audio_melody_unpack(bufx, &msg);
 
-				init_animation(true);
-				rgb_led_update_current_col();
+		cli();
 
-				sei();
-			}
-		}
-		else if (messagegroupid == MESSAGEGROUP_AUDIO)
-		{
-			if (messageid == MESSAGEID_AUDIO_TONE)
-			{
-				uint8_t tone = msg_audio_tone_get_tone();
-				UART_PUTF("Tone:%u;", tone);
-				speaker_set_fixed_tone(tone);
-			}
-			else // MESSAGEID_AUDIO_MELODY
-			{
-				uint8_t i;
+		melody.repeat = msg.repeat;
+		melody.autoreverse = msg.autoreverse;
 
-				cli();
+		UART_PUTF2("Repeat:%u;AutoReverse:%u;", melody.repeat, melody.autoreverse);
 
-				melody.repeat = msg_audio_melody_get_repeat();
-				melody.autoreverse = msg_audio_melody_get_autoreverse();
+		for (i = 0; i < MELODY_TONE_ORIG_MAX; i++)
+		{
+			melody_time[i] = msg.time[i];
+			melody_effect[i] = msg.effect[i];
+			melody_tones_orig[i] = msg.tone[i];
 
-				UART_PUTF2("Repeat:%u;AutoReverse:%u;", melody.repeat, melody.autoreverse);
+			UART_PUTF2("Time[%u]:%u;", i, melody_time[i]);
+			UART_PUTF2("Effect[%u]:%u;", i, melody_effect[i]);
+			UART_PUTF2("Tone[%u]:%u;", i, melody_tones_orig[i]);
+		}
 
-				for (i = 0; i < MELODY_TONE_ORIG_MAX; i++)
-				{
-					melody_time[i] = msg_audio_melody_get_time(i);
-					melody_effect[i] = msg_audio_melody_get_effect(i);
-					melody_tones_orig[i] = msg_audio_melody_get_tone(i);
+		init_animation(false);
+		speaker_update_current_tone();
 
-					UART_PUTF2("Time[%u]:%u;", i, melody_time[i]);
-					UART_PUTF2("Effect[%u]:%u;", i, melody_effect[i]);
-					UART_PUTF2("Tone[%u]:%u;", i, melody_tones_orig[i]);
-				}
+		sei();
+	}
 
-				init_animation(false);
-				speaker_update_current_tone();
+	// "Set" -> send "Ack"
+	if (messagetype == MESSAGETYPE_SET)
+	{
+		pkg_header_init_audio_melody_ack();
+	}
+	// "Get" or "SetGet" -> send "AckStatus"
+	else
+	{
+		memset(&msg, 0, sizeof(msg));
 
-				sei();
-			}
-		}
-		else if (messagegroupid == MESSAGEGROUP_CONTROLLER)
+		for (i = 0; i < MELODY_TONE_ORIG_MAX; i++)
 		{
-			if (messageid == MESSAGEID_CONTROLLER_MENUSELECTION)
-			{
-				uint8_t i, x, value_count;
+			msg.time[i] = melody_time[i];
+			msg.effect[i] = melody_effect[i];
+			msg.tone[i] = melody_tones_orig[i];
+		}
 
-				for (i = 0; i <= menu_item_max; i++)
-				{
-					x = msg_controller_menuselection_get_index(i);
-					UART_PUTF2("Index[%u]:%u;", i, x);
+		msg.repeat = melody.repeat;
+		msg.autoreverse = melody.autoreverse;
 
-					if (x != 0) { // 0 = not to be updated
-						e2p_controller_get_menuoption(i, text);
+		pkg_header_init_audio_melody_ackstatus();
+		msg_audio_melody_pack(&msg, bufx);
+	}
+}
 
-						value_count = find_char_count(text, '|');
+// process request "controller menu selection"
+void process_controller_menuselection(MessageTypeEnum messagetype)
+{
+	uint8_t i;
 
-						if (x <= value_count) // within range of available options?
-						{
-							menu_value[i] = x - 1;
-							e2p_controller_set_menuoptionindex(i, menu_value[i]);
-						}
-					}
-				}
-			}
-		}
-		else // MESSAGEGROUP_DISPLAY
+	// "Set" or "SetGet" -> change the selected menu options
+	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
+	{
+		uint8_t x, value_count;
+
+		for (i = 0; i <= menu_item_max; i++)
 		{
-			if (messageid == MESSAGEID_DISPLAY_TEXT)
-			{
-				uint8_t y = msg_display_text_get_posy();
-				uint8_t x = msg_display_text_get_posx();
-				// Note: "Format" is not supported.
-				msg_display_text_get_text(text);
-				text[40] = 0; // set last character to zero byte in case the text in the message is 40 bytes long
-
-				UART_PUTF("PosY:%u;", y);
-				UART_PUTF("PosX:%u;", x);
-				UART_PUTS("Text:");
-				uart_putstr(text);
-
-				if (first_lcd_text)
-				{
-					first_lcd_text = false;
-					vlcd_clear();
-				}
+			x = msg_controller_menuselection_get_index(i);
+			UART_PUTF2("Index[%u]:%u;", i, x);
 
-				vlcd_gotoyx(y, x);
-				vlcd_puts(text);
-			}
-			else if (messageid == MESSAGEID_DISPLAY_BACKLIGHT)
-			{
-				backlight_mode = msg_display_backlight_get_mode();
-				UART_PUTF("Mode:%u;", backlight_mode);
-				lcd_backlight(backlight_mode == BACKLIGHTMODE_ON);
+			if (x != 0) { // 0 = not to be updated
+				e2p_controller_get_menuoption(i, text);
 
-				uint8_t t = msg_display_backlight_get_autotimeoutsec();
+				value_count = find_char_count(text, '|');
 
-				if (t != 0) {
-					auto_backlight_time_sec = t;
-					UART_PUTF("AutoBacklightTimeSec:%u;", t);
+				if (x <= value_count) // within range of available options?
+				{
+					menu_value[i] = x - 1;
+					e2p_controller_set_menuoptionindex(i, menu_value[i]);
 				}
 			}
 		}
@@ -509,179 +673,193 @@ void process_request(MessageTypeEnum messagetype, uint32_t messagegroupid, uint3
 	// "Set" -> send "Ack"
 	if (messagetype == MESSAGETYPE_SET)
 	{
-		if (messagegroupid == MESSAGEGROUP_DIMMER)
-		{
-			if (messageid == MESSAGEID_DIMMER_BRIGHTNESS)
-			{
-				pkg_header_init_dimmer_brightness_ack();
-			}
-			else if (messageid == MESSAGEID_DIMMER_COLOR)
-			{
-				pkg_header_init_dimmer_color_ack();
-			}
-			else // MESSAGEID_DIMMER_COLORANIMATION
-			{
-				pkg_header_init_dimmer_coloranimation_ack();
-			}
-		}
-		else if (messagegroupid == MESSAGEGROUP_AUDIO)
-		{
-			if (messageid == MESSAGEID_AUDIO_TONE)
-			{
-				pkg_header_init_audio_tone_ack();
-			}
-			else // MESSAGEID_AUDIO_MELODY
-			{
-				pkg_header_init_audio_melody_ack();
-			}
-		}
-		else if (messagegroupid == MESSAGEGROUP_CONTROLLER)
+		pkg_header_init_controller_menuselection_ack();
+	}
+	// "Get" or "SetGet" -> send "AckStatus"
+	else
+	{
+		pkg_header_init_controller_menuselection_ackstatus();
+
+		for (i = 0; i <= menu_item_max; i++)
 		{
-			if (messageid == MESSAGEID_CONTROLLER_MENUSELECTION)
-			{
-				pkg_header_init_controller_menuselection_ack();
-			}
+			msg_controller_menuselection_set_index(i, menu_value[i] + 1);
 		}
-		else if (messagegroupid == MESSAGEGROUP_DISPLAY)
+	}
+}
+
+// process request "display text"
+void process_display_text(MessageTypeEnum messagetype)
+{
+	// "Set" or "SetGet" -> show text
+	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
+	{
+		uint8_t y = msg_display_text_get_posy();
+		uint8_t x = msg_display_text_get_posx();
+		// Note: "Format" is not supported.
+		msg_display_text_get_text(text);
+		text[40] = 0; // set last character to zero byte in case the text in the message is 40 bytes long
+
+		UART_PUTF("PosY:%u;", y);
+		UART_PUTF("PosX:%u;", x);
+		UART_PUTS("Text:");
+		uart_putstr(text);
+
+		if (first_lcd_text)
 		{
-			if (messageid == MESSAGEID_DISPLAY_TEXT)
-			{
-				pkg_header_init_display_text_ack();
-			}
-			else if (messageid == MESSAGEID_DISPLAY_BACKLIGHT)
-			{
-				pkg_header_init_display_backlight_ack();
-			}
+			first_lcd_text = false;
+			vlcd_clear();
 		}
 
-		UART_PUTS("\r\nSending Ack\r\n");
-		send_ack(acksenderid, ackpacketcounter, false);
+		vlcd_gotoyx(y, x);
+		vlcd_puts(text);
+	}
+
+	// "Set" -> send "Ack"
+	if (messagetype == MESSAGETYPE_SET)
+	{
+		pkg_header_init_display_text_ack();
 	}
 	// "Get" or "SetGet" -> send "AckStatus"
-	else if ((messagetype == MESSAGETYPE_GET) || (messagetype == MESSAGETYPE_SETGET))
+	else
 	{
-		if (messagegroupid == MESSAGEGROUP_DIMMER)
-		{
-			if (messageid == MESSAGEID_DIMMER_BRIGHTNESS)
-			{
-				pkg_header_init_dimmer_brightness_ackstatus();
-				msg_dimmer_brightness_set_brightness(rgb_led_user_brightness_factor);
-			}
-			else if (messageid == MESSAGEID_DIMMER_COLOR)
-			{
-				pkg_header_init_dimmer_color_ackstatus();
-				msg_dimmer_color_set_color(anim_colors_orig[0]);
-			}
-			else // MESSAGEID_DIMMER_COLORANIMATION
-			{
-				uint8_t i;
+		// Irregularly answer with an ackstatus with empty data.
+		// (We don't want to repeat the text.)
+		pkg_header_init_display_text_ackstatus();
+		// ... setting content skipped!
+	}
+}
 
-				pkg_header_init_dimmer_coloranimation_ackstatus();
+// process request "display backlight"
+void process_display_backlight(MessageTypeEnum messagetype)
+{
+	// "Set" or "SetGet" -> change backlight mode
+	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
+	{
+		backlight_mode = msg_display_backlight_get_mode();
+		UART_PUTF("Mode:%u;", backlight_mode);
+		lcd_backlight(backlight_mode == BACKLIGHTMODE_ON);
 
-				for (i = 0; i < ANIM_COL_ORIG_MAX; i++)
-				{
-					msg_dimmer_coloranimation_set_color(i, anim_colors_orig[i]);
-					msg_dimmer_coloranimation_set_time(i, anim_time[i]);
-				}
+		uint8_t t = msg_display_backlight_get_autotimeoutsec();
 
-				msg_dimmer_coloranimation_set_repeat(animation.repeat);
-				msg_dimmer_coloranimation_set_autoreverse(animation.autoreverse);
-			}
+		if (t != 0) {
+			auto_backlight_time_sec = t;
+			UART_PUTF("AutoBacklightTimeSec:%u;", t);
 		}
-		else if (messagegroupid == MESSAGEGROUP_CONTROLLER)
-		{
-			if (messageid == MESSAGEID_CONTROLLER_MENUSELECTION)
-			{
-				pkg_header_init_controller_menuselection_ackstatus();
+	}
 
-				for (uint8_t i = 0; i <= menu_item_max; i++)
-				{
-					msg_controller_menuselection_set_index(i, menu_value[i] + 1);
-				}
-			}
-		}
-		else if (messagegroupid == MESSAGEGROUP_DISPLAY)
-		{
-			if (messageid == MESSAGEID_DISPLAY_TEXT)
-			{
-				// Irregularly answer with an ackstatus with empty data.
-				// (We don't want to repeat the text.)
-				pkg_header_init_display_text_ackstatus();
-				// ... setting content skipped!
-			}
-			else if (messageid == MESSAGEID_DISPLAY_BACKLIGHT)
-			{
-				pkg_header_init_display_backlight_ackstatus();
-				msg_display_backlight_set_mode(backlight_mode);
-				msg_display_backlight_set_autotimeoutsec(auto_backlight_time_sec);
-			}
-		}
-		else if (messagegroupid == MESSAGEGROUP_AUDIO)
-		{
-			if (messageid == MESSAGEID_AUDIO_TONE)
-			{
-				pkg_header_init_audio_tone_ackstatus();
-				msg_audio_tone_set_tone(melody_tones_orig[0]);
-			}
-			else // MESSAGEID_AUDIO_MELODY
-			{
-				uint8_t i;
+	// "Set" -> send "Ack"
+	if (messagetype == MESSAGETYPE_SET)
+	{
+		pkg_header_init_display_backlight_ack();
+	}
+	// "Get" or "SetGet" -> send "AckStatus"
+	else
+	{
+		pkg_header_init_display_backlight_ackstatus();
+		msg_display_backlight_set_mode(backlight_mode);
+		msg_display_backlight_set_autotimeoutsec(auto_backlight_time_sec);
+	}
+}
 
-				pkg_header_init_audio_melody_ackstatus();
+// Handlers for the supported messages, indexed by the slot in the dispatch table.
+// They process the request and prepare the Ack or AckStatus in the packet buffer.
+const pkg_handler_t pkg_handlers[MSGSLOT_COUNT] PROGMEM = {
+	[MSGSLOT_DISPLAY_TEXT] = process_display_text,
+	[MSGSLOT_DISPLAY_BACKLIGHT] = process_display_backlight,
+	[MSGSLOT_CONTROLLER_MENUSELECTION] = process_controller_menuselection,
+	[MSGSLOT_AUDIO_TONE] = process_audio_tone,
+	[MSGSLOT_AUDIO_MELODY] = process_audio_melody,
+	[MSGSLOT_DIMMER_BRIGHTNESS] = process_dimmer_brightness,
+	[MSGSLOT_DIMMER_COLOR] = process_dimmer_color,
+	[MSGSLOT_DIMMER_COLORANIMATION] = process_dimmer_coloranimation
+};
+
+// ACK for a previous "deliver" message?
+void process_deliver_ack(void)
+{
+	uint32_t ackpacketcounter = pkg_headerext_common_get_ackpacketcounter();
+	uint8_t error = pkg_headerext_common_get_error();
+	UART_PUTF("AckPacketCounter=%lu;", ackpacketcounter);
+	UART_PUTF("Error=%u;\r\n", error);
 
-				for (i = 0; i < MELODY_TONE_ORIG_MAX; i++)
-				{
-					msg_audio_melody_set_time(i, melody_time[i]);
-					msg_audio_melody_set_effect(i, melody_effect[i]);
-					msg_audio_melody_set_tone(i, melody_tones_orig[i]);
-				}
+	if (deliver_ack_retries == 0)
+	{
+		UART_PUTS("Ack received, but not expected. Ignoring!\r\n");
+	}
+	else if ((ackpacketcounter < deliver_packetcounter - DELIVER_ACK_RETRIES / 2) || (ackpacketcounter > deliver_packetcounter))
+	{
+		UART_PUTF("Ack received, but packetcounter is wrong (expected %lu). Ignoring!\r\n", deliver_packetcounter);
+	}
+	else if (error != 0)
+	{
+		UART_PUTS("Ack received, but error bit set. Ignoring!\r\n");
+	}
+	else
+	{
+		UART_PUTF("Deliver message successfully acknowledged after %u sec!\r\n", DELIVER_ACK_RETRIES - deliver_ack_retries);
 
-				msg_audio_melody_set_repeat(melody.repeat);
-				msg_audio_melody_set_autoreverse(melody.autoreverse);
-			}
+		// store selected values in main array and e2p
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			menu_value[i] = menu_value_tmp[i];
+			e2p_controller_set_menuoptionindex(i, menu_value[i]);
 		}
 
-		UART_PUTS("\r\nSending AckStatus\r\n");
-		send_ack(acksenderid, ackpacketcounter, false);
+		deliver_ack_retries = 0;
+		melody_async(true);
+		e2p_controller_get_menutextsuccess(text);
+		vlcd_blink_text((VIRTUAL_LCD_PAGES - 1) * 4 + 2, (vlcd_chars_per_line - strlen(text)) / 2, text, false);
+		vlcd_set_page(0);
 	}
-	// ACK for a previous "deliver" message?
-	else if (messagetype == MESSAGETYPE_ACK)
+}
+
+// Process a request to this device.
+// React accordingly on the MessageType, MessageGroup and MessageID
+// and send an Ack in any case. It may be an error ack if request is not supported.
+void process_request(MessageTypeEnum messagetype, uint8_t len)
+{
+	// An ACK doesn't contain message group and message id.
+	if (messagetype == MESSAGETYPE_ACK)
 	{
-		ackpacketcounter = pkg_headerext_common_get_ackpacketcounter();
-		uint8_t error = pkg_headerext_common_get_error();
-		UART_PUTF("AckPacketCounter=%lu;", ackpacketcounter);
-		UART_PUTF("Error=%u;\r\n", error);
+		process_deliver_ack();
+		return;
+	}
 
-		if (deliver_ack_retries == 0)
-		{
-			UART_PUTS("Ack received, but not expected. Ignoring!\r\n");
-		}
-		else if ((ackpacketcounter < deliver_packetcounter - DELIVER_ACK_RETRIES / 2) || (ackpacketcounter > deliver_packetcounter))
-		{
-			UART_PUTF("Ack received, but packetcounter is wrong (expected %lu). Ignoring!\r\n", deliver_packetcounter);
-		}
-		else if (error != 0)
+	// remember some values before the packet buffer is destroyed
+	uint32_t acksenderid = pkg_header_get_senderid();
+	uint32_t ackpacketcounter = pkg_header_get_packetcounter();
+
+	UART_PUTF("MessageGroupID:%u;", pkg_headerext_common_get_messagegroupid());
+	UART_PUTF("MessageID:%u;", pkg_headerext_common_get_messageid());
+
+	PkgDispatchResultEnum result = pkg_dispatch(len, pkg_handlers);
+
+	if (result != PKG_DISPATCH_OK)
+	{
+		if (result == PKG_DISPATCH_PACKET_TOO_SHORT)
 		{
-			UART_PUTS("Ack received, but error bit set. Ignoring!\r\n");
+			UART_PUTS("\r\nERR: Packet too short.\r\n");
 		}
 		else
 		{
-			UART_PUTF("Deliver message successfully acknowledged after %u sec!\r\n", DELIVER_ACK_RETRIES - deliver_ack_retries);
+			UART_PUTS("\r\nERR: Unsupported MessageGroupID / MessageID.\r\n");
+		}
 
-			// store selected values in main array and e2p
-			for (uint8_t i = 0; i < 4; i++)
-			{
-				menu_value[i] = menu_value_tmp[i];
-				e2p_controller_set_menuoptionindex(i, menu_value[i]);
-			}
+		send_ack(acksenderid, ackpacketcounter, true);
+		return;
+	}
 
-			deliver_ack_retries = 0;
-			melody_async(true);
-			e2p_controller_get_menutextsuccess(text);
-			vlcd_blink_text((VIRTUAL_LCD_PAGES - 1) * 4 + 2, (vlcd_chars_per_line - strlen(text)) / 2, text, false);
-			vlcd_set_page(0);
-		}
+	// "Set" -> send "Ack", "Get" or "SetGet" -> send "AckStatus"
+	if (messagetype == MESSAGETYPE_SET)
+	{
+		UART_PUTS("\r\nSending Ack\r\n");
+	}
+	else
+	{
+		UART_PUTS("\r\nSending AckStatus\r\n");
 	}
+
+	send_ack(acksenderid, ackpacketcounter, false);
 }
 
 // Check if incoming message is a legitimate request for this device.
@@ -747,22 +925,7 @@ void process_packet(uint8_t len)
 		return;
 	}
 
-	// check MessageGroup + MessageID
-	uint32_t messagegroupid = pkg_headerext_common_get_messagegroupid();
-	uint32_t messageid = pkg_headerext_common_get_messageid();
-
-	if (messagetype == MESSAGETYPE_ACK)
-	{
-		messagegroupid = 0;
-		messageid = 0;
-	}
-	else
-	{
-		messagegroupid = pkg_headerext_common_get_messagegroupid();
-		messageid = pkg_headerext_common_get_messageid();
-	}
-
-	process_request(messagetype, messagegroupid, messageid);
+	process_request(messagetype, len);
 }
 
 // return first position of character in string
@@ -1111,7 +1274,7 @@ void io_init(void)
 	MCUCR = (1<<JTD);
 	MCUCR = (1<<JTD);
 
-	util_init_led(&LED_DDR, &LED_PORT, LED_PIN);
+	util_init_led(HAL_PORT(LED_PORT), LED_PIN);
 
 	// LCD backlight
 	sbi(LCD_BACKLIGHT_DDR, LCD_BACKLIGHT_PIN);
@@ -1169,34 +1332,6 @@ MenuKeyEnum detect_key(void)
 		return KEY_NONE;
 }
 
-MenuKeyEnum detect_key_debounced(void)
-{
-	uint8_t ms = 0;
-	MenuKeyEnum key;
-	MenuKeyEnum last_key = KEY_NONE;
-
-	while (1)
-	{
-		key = detect_key();
-
-		if (key == KEY_NONE)
-			return key;
-
-		if (key == last_key)
-			ms += 20;
-		else
-		{
-			last_key = key;
-			ms = 0;
-		}
-
-		if (ms >= 20)
-			return key;
-
-		rfm12_delay20();
-	}
-}
-
 int main(void)
 {
 	uint8_t loop = 0;
@@ -1209,11 +1344,13 @@ int main(void)
 	uint8_t lcd_type;
 
 	MenuKeyEnum key;
+	KeyEventEnum key_event;
 
 	// delay 1s to avoid further communication with UART or RFM12 when my programmer resets the MC after 500ms...
 	_delay_ms(1000);
 
 	check_eeprom_compatibility(DEVICETYPE_CONTROLLER);
+	e2p_shadow_init(e2p_shadow_buf, E2P_SHADOW_START, E2P_SHADOW_BYTES);
 	lcd_type = e2p_controller_get_lcdtype();
 	device_id = e2p_generic_get_deviceid();
 	jump_back_sec_menu = e2p_controller_get_pagejumpbackseconds();
@@ -1247,14 +1384,14 @@ int main(void)
 		VLCD_PUTF4("v%u.%u.%u (%08lx)", VERSION_MAJOR, VERSION_MINOR, VERSION_PATCH, VERSION_HASH);
 		vlcd_gotoyx(3, 0);
 		VLCD_PUTF("DeviceID: %u", device_id);
+		vlcd_flush_all();
 	}
 
 	for (i = 0; i < 4; i++)
 		menu_value[i] = e2p_controller_get_menuoptionindex(i);
 
 	// read packetcounter, increase by cycle and write back
-	packetcounter = e2p_generic_get_packetcounter() + PACKET_COUNTER_WRITE_CYCLE;
-	e2p_generic_set_packetcounter(packetcounter);
+	init_packetcounter();
 
 	// read last received station packetcounter
 	station_packetcounter = e2p_controller_get_basestationpacketcounter();
@@ -1437,32 +1574,28 @@ int main(void)
 		}
 		else
 		{
-			rfm12_delay20();
+			delay20_vlcd_flush();
 		}
 
-		// Key handling is enabled only when not waiting for a deliver ack from basestation
-		if (deliver_ack_retries == 0)
+		// Key handling is enabled only when not waiting for a deliver ack from basestation.
+		// Keys pressed while waiting are discarded.
+		while (key_event_get(&key, &key_event))
 		{
-			key = detect_key_debounced();
-
-			if (key != KEY_NONE)
-			{
-				if (backlight_mode == BACKLIGHTMODE_AUTO) {
-					if (auto_backlight_timeout == 0)
-						lcd_backlight(true);
-
-					auto_backlight_timeout = auto_backlight_time_sec;
-				}
+			if ((deliver_ack_retries > 0) || (key_event == KEY_EVENT_RELEASE))
+				continue;
 
-				handle_key(key);
+			// only the cursor keys are repeated when held down
+			if ((key_event == KEY_EVENT_REPEAT) && ((key == KEY_SET) || (key == KEY_CANCEL)))
+				continue;
 
-				while ((~MENU_CURSOR_PINREG & ((1 << MENU_UP_PIN) | (1 << MENU_DOWN_PIN) | (1 << MENU_LEFT_PIN) | (1 << MENU_RIGHT_PIN)))
-					| (~MENU_SET_PINREG & ((1 << MENU_SET_PIN) | (1 << MENU_CANCEL_PIN))))
-					rfm12_delay20();
+			if (backlight_mode == BACKLIGHTMODE_AUTO) {
+				if (auto_backlight_timeout == 0)
+					lcd_backlight(true);
 
-				for (i = 0; i < 5; i++)
-					rfm12_delay20();
+				auto_backlight_timeout = auto_backlight_time_sec;
 			}
+
+			handle_key(key);
 		}
 
 		loop++;
@@ -30,6 +30,15 @@ char* vlcdbuf = "*l*c*d**b*u*f*f*e*r**l*c*d**b*u*f*f*e*r*";
 #define VIRTUAL_LCD_SCREEN_WIDTH  40
 char lcd_data[VIRTUAL_LCD_SCREEN_HEIGHT][VIRTUAL_LCD_SCREEN_WIDTH];
 
+// The vlcd functions only change lcd_data. The characters of the current page
+// which differ from what the physical LCD shows are marked as dirty and written
+// to the LCD by vlcd_flush, so that writing to the LCD doesn't block the caller.
+char lcd_shadow[4][VIRTUAL_LCD_SCREEN_WIDTH]; // what the physical LCD shows
+uint8_t lcd_dirty[4][VIRTUAL_LCD_SCREEN_WIDTH / 8];
+uint8_t lcd_dirty_count = 0;
+uint8_t lcd_cursor_y, lcd_cursor_x; // position of the LCD cursor, y = 255 if unknown
+bool lcd_present = false;
+
 uint8_t vlcd_chars_per_line = 20;
 uint8_t current_page = 0;
 
@@ -42,6 +51,35 @@ void clear_lcd_data(void)
 			lcd_data[y][x] = '\x20';
 }
 
+// Set or clear the dirty flag of the cell in lcd_data, if it is on the current page.
+void update_dirty(uint8_t y, uint8_t x)
+{
+	if (y / 4 != current_page)
+		return;
+
+	uint8_t mask = 1 << (x % 8);
+	uint8_t * d = &lcd_dirty[y % 4][x / 8];
+	bool dirty = lcd_data[y][x] != lcd_shadow[y % 4][x];
+
+	if (dirty && !(*d & mask))
+	{
+		*d |= mask;
+		lcd_dirty_count++;
+	}
+	else if (!dirty && (*d & mask))
+	{
+		*d &= ~mask;
+		lcd_dirty_count--;
+	}
+}
+
+void update_dirty_page(void)
+{
+	for (uint8_t y = 0; y < 4; y++)
+		for (uint8_t x = 0; x < vlcd_chars_per_line; x++)
+			update_dirty(current_page * 4 + y, x);
+}
+
 void vlcd_init(bool big4x40)
 {
 	clear_lcd_data();
@@ -52,12 +90,20 @@ void vlcd_init(bool big4x40)
 		vlcd_chars_per_line = 20;
 
 	lcd_init(big4x40);
+
+	// lcd_init clears the LCD
+	for (uint8_t y = 0; y < 4; y++)
+		for (uint8_t x = 0; x < VIRTUAL_LCD_SCREEN_WIDTH; x++)
+			lcd_shadow[y][x] = '\x20';
+
+	lcd_cursor_y = 255;
+	lcd_present = true;
 }
 
 void vlcd_clear(void)
 {
 	clear_lcd_data();
-	lcd_clear();
+	update_dirty_page();
 }
 
 void vlcd_clear_page(uint8_t page)
@@ -67,7 +113,7 @@ void vlcd_clear_page(uint8_t page)
 			lcd_data[page * 4 + y][x] = '\x20';
 
 	if (page == current_page)
-		lcd_clear();
+		update_dirty_page();
 }
 
 void vlcd_putc(char c)
@@ -75,10 +121,7 @@ void vlcd_putc(char c)
 	if (vlcd_x < vlcd_chars_per_line)
 	{
 		lcd_data[vlcd_y][vlcd_x] = c;
-
-		if (vlcd_y / 4 == current_page)
-			lcd_putc(c);
-
+		update_dirty(vlcd_y, vlcd_x);
 		vlcd_x++;
 	}
 }
@@ -92,14 +135,9 @@ void vlcd_puts(const char* s)
 			if (vlcd_y < VIRTUAL_LCD_SCREEN_HEIGHT)
 				vlcd_gotoyx(vlcd_y + 1, vlcd_lastx);
 		}
-		else if (vlcd_x < vlcd_chars_per_line)
+		else
 		{
-			lcd_data[vlcd_y][vlcd_x] = *s;
-
-			if (vlcd_y / 4 == current_page)
-				lcd_putc(*s);
-
-			vlcd_x++;
+			vlcd_putc(*s);
 		}
 
 		s++;
@@ -110,9 +148,6 @@ void vlcd_gotoyx(uint8_t y, uint8_t x)
 {
 	vlcd_y = y;
 	vlcd_lastx = vlcd_x = x;
-
-	if (y / 4 == current_page)
-		lcd_gotoyx(y % 4, x);
 }
 
 void vlcd_set_page(uint8_t page)
@@ -120,18 +155,61 @@ void vlcd_set_page(uint8_t page)
 	if ((page < VIRTUAL_LCD_PAGES) && (current_page != page))
 	{
 		current_page = page;
+		update_dirty_page();
+	}
+}
 
-		for (uint8_t y = 0; y < 4; y++)
+uint8_t vlcd_get_page(void)
+{
+	return current_page;
+}
+
+// Write dirty cells to the LCD, using max. the given number of transfers to the LCD
+// (one per character and one per cursor movement, ~70us each). The LCD moves the
+// cursor to the right after each character, so only the first cell of a sequence
+// of dirty cells needs a cursor movement.
+// Return if there are dirty cells left.
+bool vlcd_flush(uint8_t max_transfers)
+{
+	if (!lcd_present)
+		return false;
+
+	for (uint8_t y = 0; (y < 4) && lcd_dirty_count; y++)
+	{
+		for (uint8_t x = 0; (x < vlcd_chars_per_line) && lcd_dirty_count; x++)
 		{
-			lcd_gotoyx(y, 0);
+			if (!(lcd_dirty[y][x / 8] & (1 << (x % 8))))
+				continue;
+
+			bool move = (lcd_cursor_y != y) || (lcd_cursor_x != x);
+
+			if (max_transfers < 1 + move)
+				return true;
+
+			if (move)
+			{
+				lcd_gotoyx(y, x);
+				max_transfers--;
+			}
 
-			for (uint8_t x = 0; x < vlcd_chars_per_line; x++)
-				lcd_putc(lcd_data[page * 4 + y][x]);
+			char c = lcd_data[current_page * 4 + y][x];
+
+			lcd_putc(c);
+			lcd_shadow[y][x] = c;
+			lcd_dirty[y][x / 8] &= ~(1 << (x % 8));
+			lcd_dirty_count--;
+			max_transfers--;
+
+			// after the last character of a line, the cursor is not in the next line
+			lcd_cursor_y = y;
+			lcd_cursor_x = x + 1;
 		}
 	}
+
+	return lcd_dirty_count > 0;
 }
 
-uint8_t vlcd_get_page(void)
+void vlcd_flush_all(void)
 {
-	return current_page;
+	while (vlcd_flush(255));
 }
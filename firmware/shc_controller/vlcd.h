@@ -27,6 +27,7 @@
 #include <stdbool.h>
 
 #define VIRTUAL_LCD_PAGES 9
+#define VLCD_FLUSH_SLICE 16 // LCD transfers per call of vlcd_flush in the main loop (~1.1ms)
 
 extern char* vlcdbuf;
 extern uint8_t vlcd_chars_per_line;
@@ -46,5 +47,7 @@ void vlcd_puts(const char* s);
 void vlcd_gotoyx(uint8_t y, uint8_t x);
 void vlcd_set_page(uint8_t page);
 uint8_t vlcd_get_page(void);
+bool vlcd_flush(uint8_t max_transfers);
+void vlcd_flush_all(void);
 
 #endif /* _VLCD_H */
@@ -19,6 +19,7 @@
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include <util/delay.h>
+#include <util/atomic.h>
 #include <string.h>
 
 #include "rfm12.h"
@@ -26,6 +27,7 @@
 
 #include "../src_common/msggrp_generic.h"
 #include "../src_common/msggrp_dimmer.h"
+#include "../src_common/packet_dispatch.h"
 
 #include "../src_common/e2p_hardware.h"
 #include "../src_common/e2p_generic.h"
@@ -73,20 +75,36 @@ static uint16_t pwm_lookup [] = { 119, 199, 265, 325, 376, 421, 462, 498, 528, 5
 
 static uint8_t brightness_translation[101];
 
-#define ANIMATION_CYCLE_MS 32.768   // make one animation step every 32,768 ms, triggered by timer 0
-#define ANIMATION_UPDATE_MS 200     // update the brightness every ANIMATION_UPDATE_MS ms, done by the main loop
+// The translation table converted to positions in pwm_lookup (8.8 fixed point),
+// so that the brightness can be converted to the PWM value with integer operations only.
+static uint16_t brightness_pos[101];
+
+// Make one animation step every 1/8000000 * 256 * 256 s = 8.192 ms, triggered by timer 0.
+// The number of steps for a time is calculated as sec * 1000 / 8.192 = sec * 15625 / 128.
+#define ANIMATION_TICKS_PER_SEC_NUM 15625
+#define ANIMATION_TICKS_PER_SEC_DEN 128
+#define UPDATE_MS 200               // update the button, relais and status every UPDATE_MS ms, done by the main loop
 
 #define SWITCH_OFF_TIMEOUT_MS 3000  // If 0% brightness is reached, switch off power (relais) with a delay to
                                     // 1) dim down before switching off and to
                                     // 2) avoid switching power off at manual dimming.
 
-// variables used for the animation
+// Ease in / ease out curve (smoothstep 3x^2 - 2x^3) for ANIMATIONMODE_EASE,
+// 0..65535 for 17 equidistant positions of the animation.
+static const uint16_t ease_curve[] = { 0, 736, 2816, 6048, 10240, 15200, 20736, 26656, 32768,
+	38879, 44799, 50335, 55295, 59487, 62719, 64799, 65535 };
+
+// variables used for the animation, the brightness is changed by the timer 0 interrupt
 uint8_t animation_mode;
-uint32_t animation_length = 0;   // if > 0, an animation is running
-uint32_t animation_position = 0; // current position in the animation, from 0 to animation_length
+uint16_t animation_timeout_sec = 0;
+volatile uint32_t animation_ticks = 0; // remaining animation steps, if > 0, an animation is running
+uint32_t animation_phase;              // current position in the animation, 0..2^32 - 1
+uint32_t animation_phase_step;         // added to animation_phase in every step
+int16_t animation_delta;               // end - start brightness in 1/256 %
+volatile bool animation_finished = false;
 uint8_t start_brightness = 0;
 uint8_t end_brightness = 0;
-float current_brightness = 0;
+volatile uint16_t current_brightness = 0; // in 1/256 %
 
 uint16_t device_id;
 uint8_t use_pwm_translation = 1;
@@ -123,11 +141,11 @@ void PWM_init(void)
 	TCCR1B = (1 << CS11); // Clock source = I/O clock, 1/8 prescaler
 }
 
-// Timer0 is used for accurate counting of the animation time.
+// Timer0 is used for the animation steps.
 void timer0_init(void)
 {
-	// Clock source = I/O clock, 1/1024 prescaler
-	TCCR0B = (1 << CS02) | (1 << CS00);
+	// Clock source = I/O clock, 1/256 prescaler
+	TCCR0B = (1 << CS02);
 
 	// Timer/Counter0 Overflow Interrupt Enable
 	TIMSK0 = (1 << TOIE0);
@@ -142,11 +160,24 @@ void io_init(void)
 	sbi(BUTTON_PORTPORT, BUTTON_PIN);
 }
 
+// Return the current brightness, which is changed by the timer interrupt during an animation.
+uint16_t get_brightness(void)
+{
+	uint16_t brightness;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		brightness = current_brightness;
+	}
+
+	return brightness;
+}
+
 void checkSwitchOff(void)
 {
-	if (current_brightness == 0)
+	if (get_brightness() == 0)
 	{
-		if (switch_off_counter < (SWITCH_OFF_TIMEOUT_MS / ANIMATION_UPDATE_MS))
+		if (switch_off_counter < (SWITCH_OFF_TIMEOUT_MS / UPDATE_MS))
 		{
 			switch_off_counter++;
 		}
@@ -158,64 +189,95 @@ void checkSwitchOff(void)
 	else
 	{
 		switch_off_counter = 0;
-		switchRelais(1);
-		
-		// Switching on relais (and lamp) leads to interferences.
-		// Avoid sending with RFM12 directly afterwards by making a short delay.
-		_delay_ms(250);
+
+		if (!(RELAIS_PORT & (1 << RELAIS_PIN)))
+		{
+			switchRelais(1);
+
+			// Switching on relais (and lamp) leads to interferences.
+			// Avoid sending with RFM12 directly afterwards by making a short delay.
+			_delay_ms(250);
+		}
 	}
 }
 
-void setPWMDutyCyclePercent(float percent)
+// Read the translation table from the EEPROM and convert it to positions in pwm_lookup.
+void brightness_translation_init(void)
 {
-	uint8_t index, index2;
-	float modulo;
+	// pwm translation table is not used if first byte is 0xFF
+	e2p_dimmer_get_brightnesstranslationtable(brightness_translation);
+	use_pwm_translation = (0xFF != brightness_translation[0]);
 
-	if (percent > 100)
-	{
-		percent = 100;
-	}
+	translation_to_pos16(brightness_translation, brightness_pos, 101, 100);
+}
 
-	current_brightness = percent; // used for status packet
+// Convert the brightness in 1/256 % (0..25600) to the PWM value.
+// This is also called from the timer interrupt, so it must not print anything.
+static uint16_t brightness_to_pwm(uint16_t percent)
+{
+	uint16_t pos = percent;
 
-#ifdef UART_DEBUG_CALCULATIONS
-	UART_PUTF2 ("Percent requested: %d.%02d\r\n", (uint16_t)percent, (uint16_t)(percent * 100) % 100);
-#endif
-	
 	// My OSRAM CFL lamp does not react to the 1..10V input in a linear way.
-	// So translate promille to the translated promille value first (if enabled).
+	// So translate the percentage to the translated percentage first (if enabled).
 	if (use_pwm_translation)
 	{
-		index = (uint8_t)percent;
-		index2 = index >= 100 ? 100 : index + 1;
-		modulo = percent - index; // decimal places only, e.g. 0.12 when percent is 73.12
-		
-		uint8_t t1 = brightness_translation[index];
-		uint8_t t2 = brightness_translation[index2];
-		
-		percent = linear_interpolate_f(modulo, 0.0, 1.0, t1, t2) * 100 / 255;
-		
-#ifdef UART_DEBUG_CALCULATIONS	
-		UART_PUTF ("  Index 1: %u\r\n", index);
-		UART_PUTF ("  Index 2: %u\r\n", index2);
-		UART_PUTF ("  Translation value 1: %u\r\n", t1);
-		UART_PUTF ("  Translation value 2: %u\r\n", t2);
-		UART_PUTF ("  Modulo: 0.%003u\r\n", (uint16_t)(modulo * 1000));
-		UART_PUTF2 ("  Percent corrected: %d.%02d\r\n", (uint16_t)percent, (uint16_t)(percent * 100) % 100);
-#endif
+		pos = interpolate_table16(brightness_pos, percent);
 	}
 	
-	// convert percentage to corrected percentage
-	index = (uint8_t)percent;
-	index2 = index >= 100 ? 100 : index + 1;
-	modulo = percent - index; // decimal places only, e.g. 0.12 when percent is 73.12
+	// convert percentage to PWM value
+	return interpolate_table16(pwm_lookup, pos);
+}
 
-	uint32_t pwm = (uint32_t)linear_interpolate_f(modulo, 0.0, 1.0, pwm_lookup[index], pwm_lookup[index2]);
+// Stop a running animation and leave the brightness as it is.
+void animation_stop(void)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		animation_ticks = 0;
+	}
+}
+
+// Start the animation from start_brightness to end_brightness with the given
+// animation_mode. The increments are calculated here, so that the timer interrupt
+// only has to add them.
+void animation_start(uint16_t timeout_sec)
+{
+	uint32_t ticks = (uint32_t)timeout_sec * ANIMATION_TICKS_PER_SEC_NUM / ANIMATION_TICKS_PER_SEC_DEN;
+
+	animation_stop();
 
-#ifdef UART_DEBUG_CALCULATIONS	
-	UART_PUTF ("    PWM value 1: %u\r\n", pwm_lookup[index]);
-	UART_PUTF ("    PWM value 2: %u\r\n", pwm_lookup[index2]);
-	UART_PUTF ("    Modulo: 0.%003u\r\n", (uint16_t)(modulo * 1000));
+	if (ticks == 0)
+	{
+		return;
+	}
+
+	animation_phase = 0;
+	animation_phase_step = UINT32_MAX / ticks;
+	animation_delta = ((int16_t)end_brightness - start_brightness) << 8;
+	animation_finished = false;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		animation_ticks = ticks;
+	}
+}
+
+// Set the brightness, given in 1/256 % (0..25600), and stop a running animation.
+void setPWMDutyCyclePercent(uint16_t percent)
+{
+	animation_stop();
+
+	if (percent > 100 << 8)
+	{
+		percent = 100 << 8;
+	}
+
+	current_brightness = percent; // used for status packet
+
+	uint16_t pwm = brightness_to_pwm(percent);
+
+#ifdef UART_DEBUG_CALCULATIONS
+	UART_PUTF2 ("Percent requested: %u.%02u\r\n", percent >> 8, (percent & 0xff) * 100 / 256);
 	UART_PUTF ("    PWM value interpolated: %u\r\n", pwm);
 #else
 	UART_PUTF ("PWM=%u\r\n", pwm);
@@ -224,14 +286,44 @@ void setPWMDutyCyclePercent(float percent)
 	OCR1A = pwm;
 }
 
-// Count up the animation_position every 1/8000000 * 1024 * 256 ms = 32,768 ms,
-// if animation is running.
+// Make one animation step every 8.192 ms, if an animation is running.
+// The position in the animation is counted up by a constant step, the brightness
+// is calculated from it according to the animation mode without any division.
 ISR (TIMER0_OVF_vect)
 {
-	if (animation_position < animation_length)
+	uint16_t progress;
+
+	if (animation_ticks == 0)
 	{
-		animation_position++;
+		return;
 	}
+
+	if (--animation_ticks == 0)
+	{
+		current_brightness = end_brightness << 8;
+		animation_finished = true;
+	}
+	else
+	{
+		animation_phase += animation_phase_step;
+		progress = animation_phase >> 16;
+
+		switch (animation_mode)
+		{
+			case ANIMATIONMODE_LINEAR:
+				break;
+			case ANIMATIONMODE_EASE:
+				progress = interpolate_table16(ease_curve, progress >> 4);
+				break;
+			default: // stay at the start brightness
+				progress = 0;
+				break;
+		}
+
+		current_brightness = (start_brightness << 8) + ((int32_t)animation_delta * progress >> 16);
+	}
+
+	OCR1A = brightness_to_pwm(current_brightness);
 }
 
 void send_dimmer_status(void)
@@ -239,7 +331,7 @@ void send_dimmer_status(void)
 	UART_PUTS("Sending Dimmer Status:\r\n");
 
 	inc_packetcounter();
-	uint8_t bri = (uint8_t)current_brightness;
+	uint8_t bri = get_brightness() >> 8;
 	
 	// Set packet content
 	pkg_header_init_dimmer_brightness_status();
@@ -301,15 +393,17 @@ void process_brightness(MessageTypeEnum messagetype)
 	// "Set" or "SetGet" -> modify dimmer state and abort any running animation
 	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
 	{
-		start_brightness = end_brightness = msg_dimmer_brightness_get_brightness();
+		msg_dimmer_brightness_t msg;
+
+		msg_dimmer_brightness_unpack(bufx, &msg);
+		start_brightness = end_brightness = msg.brightness;
 
 		UART_PUTF("Requested Brightness: %u%%;", start_brightness);
 		
-		animation_length = 0;
 		animation_mode = 0;
-		animation_position = 0;
+		animation_timeout_sec = 0;
 
-		setPWMDutyCyclePercent(start_brightness);
+		setPWMDutyCyclePercent(start_brightness << 8);
 						
 		/* TODO: Write to EEPROM (?)
 		// write back switch state to EEPROM
@@ -334,10 +428,12 @@ void process_brightness(MessageTypeEnum messagetype)
 	// "Get" or "SetGet" -> send "AckStatus"
 	else
 	{
+		msg_dimmer_brightness_t msg = { start_brightness };
+
 		pkg_header_init_dimmer_brightness_ackstatus();
 		
 		// set message data
-		msg_dimmer_brightness_set_brightness(start_brightness);
+		msg_dimmer_brightness_pack(&msg, bufx);
 
 		UART_PUTS("Sending AckStatus\r\n");
 	}
@@ -351,20 +447,21 @@ void process_animation(MessageTypeEnum messagetype)
 	// "Set" or "SetGet" -> modify dimmer state and start new animation
 	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
 	{
-		animation_mode = msg_dimmer_animation_get_animationmode();
-		animation_length = msg_dimmer_animation_get_timeoutsec();
-		start_brightness = msg_dimmer_animation_get_startbrightness();
-		end_brightness = msg_dimmer_animation_get_endbrightness();
+		msg_dimmer_animation_t msg;
+
+		msg_dimmer_animation_unpack(bufx, &msg);
+		animation_mode = msg.animationmode;
+		animation_timeout_sec = msg.timeoutsec;
+		start_brightness = msg.startbrightness;
+		end_brightness = msg.endbrightness;
 
 		UART_PUTF("   Animation Mode: %u\r\n", animation_mode);
-		UART_PUTF("   Animation Time: %us\r\n", animation_length);
+		UART_PUTF("   Animation Time: %us\r\n", animation_timeout_sec);
 		UART_PUTF(" Start Brightness: %u%%\r\n", start_brightness);
 		UART_PUTF("   End Brightness: %u%%\r\n", end_brightness);
 		
-		animation_length = (uint32_t)((float)animation_length * 1000 / ANIMATION_CYCLE_MS);
-		animation_position = 0;
-		
-		setPWMDutyCyclePercent(start_brightness);
+		setPWMDutyCyclePercent(start_brightness << 8);
+		animation_start(animation_timeout_sec);
 		
 		/* TODO: Write to EEPROM (?)
 		// write back switch state to EEPROM
@@ -389,13 +486,12 @@ void process_animation(MessageTypeEnum messagetype)
 	// "Get" or "SetGet" -> send "AckStatus"
 	else
 	{
+		msg_dimmer_animation_t msg = { animation_mode, animation_timeout_sec, start_brightness, end_brightness };
+
 		pkg_header_init_dimmer_animation_ackstatus();
 		
 		// set message data
-		msg_dimmer_animation_set_animationmode(animation_mode);
-		msg_dimmer_animation_set_timeoutsec(animation_length);
-		msg_dimmer_animation_set_startbrightness(start_brightness);
-		msg_dimmer_animation_set_endbrightness(end_brightness);
+		msg_dimmer_animation_pack(&msg, bufx);
 
 		UART_PUTS("Sending AckStatus\r\n");
 	}
@@ -403,6 +499,12 @@ void process_animation(MessageTypeEnum messagetype)
 	send_ack(acksenderid, ackpacketcounter, false);
 }
 
+// Handlers for the supported messages, indexed by the slot in the dispatch table.
+const pkg_handler_t pkg_handlers[MSGSLOT_COUNT] PROGMEM = {
+	[MSGSLOT_DIMMER_BRIGHTNESS] = process_brightness,
+	[MSGSLOT_DIMMER_ANIMATION] = process_animation
+};
+
 void process_packet(uint8_t len)
 {
 	pkg_header_adjust_offset();
@@ -463,28 +565,19 @@ void process_packet(uint8_t len)
 	uint32_t messageid = pkg_headerext_common_get_messageid();
 	
 	UART_PUTF("MessageGroupID:%u;", messagegroupid);
-	
-	if (messagegroupid != MESSAGEGROUP_DIMMER)
+	UART_PUTF("MessageID:%u;\r\n", messageid);
+
+	PkgDispatchResultEnum result = pkg_dispatch(len, pkg_handlers);
+
+	if (result == PKG_DISPATCH_PACKET_TOO_SHORT)
 	{
-		UART_PUTS("\r\nERR: Unsupported MessageGroupID.\r\n");
+		UART_PUTS("ERR: Packet too short.\r\n");
 		send_ack(acksenderid, ackpacketcounter, true);
-		return;
 	}
-	
-	UART_PUTF("MessageID:%u;\r\n", messageid);
-
-	switch (messageid)
+	else if (result != PKG_DISPATCH_OK)
 	{
-		case MESSAGEID_DIMMER_BRIGHTNESS:
-			process_brightness(messagetype);
-			break;
-		case MESSAGEID_DIMMER_ANIMATION:
-			process_animation(messagetype);
-			break;
-		default:
-			UART_PUTS("ERR: Unsupported MessageID.\r\n");
-			send_ack(acksenderid, ackpacketcounter, true);
-			break;
+		UART_PUTS("ERR: Unsupported MessageGroupID / MessageID.\r\n");
+		send_ack(acksenderid, ackpacketcounter, true);
 	}
 	
 	UART_PUTS("\r\n");
@@ -493,7 +586,7 @@ void process_packet(uint8_t len)
 int main(void)
 {
 	uint16_t send_status_timeout = 25;
-	uint32_t pos;
+	uint8_t update_cycle = 0;
 	uint8_t button_state = 0;
 	uint8_t manual_dim_direction = 0;
 
@@ -505,15 +598,12 @@ int main(void)
 	check_eeprom_compatibility(DEVICETYPE_DIMMER);
 	
 	// read packetcounter, increase by cycle and write back
-	packetcounter = e2p_generic_get_packetcounter() + PACKET_COUNTER_WRITE_CYCLE;
-	e2p_generic_set_packetcounter(packetcounter);
+	init_packetcounter();
 
 	// read device id
 	device_id = e2p_generic_get_deviceid();
 
-	// pwm translation table is not used if first byte is 0xFF
-	e2p_dimmer_get_brightnesstranslationtable(brightness_translation);
-	use_pwm_translation = (0xFF != brightness_translation[0]);
+	brightness_translation_init();
 	
 	// TODO: read (saved) dimmer state from before the eventual powerloss
 	/*for (i = 0; i < SWITCH_COUNT; i++)
@@ -567,18 +657,18 @@ int main(void)
 	// DEMO 0..100..0%, using the pwm_lookup table and the translation table in EEPROM.
 	/*while (42)
 	{
-		float i;
+		uint16_t i;
 		
-		for (i = 0; i <= 100; i = i + 0.05)
+		for (i = 0; i <= 100 << 8; i = i + 13)
 		{
 			led_blink(10, 10, 1);
-			setPWMDutyCycle(i);
+			setPWMDutyCyclePercent(i);
 		}
 		
-		for (i = 99.95; i > 0; i = i - 0.05)
+		for (i = 100 << 8; i > 0; i = i - 13)
 		{
 			led_blink(10, 10, 1);
-			setPWMDutyCycle(i);
+			setPWMDutyCyclePercent(i);
 		}
 	}*/
 
@@ -591,11 +681,10 @@ int main(void)
 	sei();
 
 	// DEMO 30s
-	/*animation_length = 30;
-	animation_length = (uint32_t)((float)animation_length * 1000 / ANIMATION_CYCLE_MS);
+	/*animation_mode = ANIMATIONMODE_LINEAR;
 	start_brightness = 0;
-	end_brightness = 255;
-	animation_position = 0;*/
+	end_brightness = 100;
+	animation_start(30);*/
 	
 	while (42)
 	{
@@ -636,7 +725,15 @@ int main(void)
 			rfm12_rx_clear();
 		}
 
-		_delay_ms(ANIMATION_UPDATE_MS);
+		rfm12_delay20();
+
+		// update the button, relais and status every UPDATE_MS only
+		if (++update_cycle < UPDATE_MS / 20)
+		{
+			continue;
+		}
+
+		update_cycle = 0;
 		
 		// React on button press.
 		// - abort animation
@@ -647,8 +744,7 @@ int main(void)
 			if (button_state == 0)
 			{
 				UART_PUTS("Button pressed\r\n");
-				animation_length = 0;
-				animation_position = 0;
+				animation_stop();
 			}
 			
 			if (button_state < 5)
@@ -659,10 +755,9 @@ int main(void)
 			{
 				if (manual_dim_direction) // UP
 				{
-					if (current_brightness < 100)
+					if (get_brightness() < 100 << 8)
 					{
-						current_brightness = (uint8_t)current_brightness / 2 * 2 + 2;
-						setPWMDutyCyclePercent(current_brightness);
+						setPWMDutyCyclePercent(((get_brightness() >> 8) / 2 * 2 + 2) << 8);
 					}
 					else
 					{
@@ -672,10 +767,9 @@ int main(void)
 				}
 				else // DOWN
 				{
-					if (current_brightness > 0)
+					if (get_brightness() > 0)
 					{
-						current_brightness = (((uint8_t)current_brightness - 1) / 2) * 2;
-						setPWMDutyCyclePercent(current_brightness);
+						setPWMDutyCyclePercent((((get_brightness() >> 8) - 1) / 2 * 2) << 8);
 					}
 					else
 					{
@@ -692,7 +786,7 @@ int main(void)
 			
 			if (button_state < 5) // short button press
 			{
-				if (current_brightness > 0)
+				if (get_brightness() > 0)
 				{
 					UART_PUTS(" -> 0%\r\n");
 					setPWMDutyCyclePercent(0);
@@ -700,7 +794,7 @@ int main(void)
 				else
 				{
 					UART_PUTS(" -> 100%\r\n");
-					setPWMDutyCyclePercent(100);
+					setPWMDutyCyclePercent(100 << 8);
 				}
 			}
 			else
@@ -713,34 +807,20 @@ int main(void)
 			button_state = 0;
 		}
 				
-		// update brightness according animation_position, updated by timer0
-		if (animation_length > 0)
+		// the brightness is changed by the timer 0 interrupt, only report the end of the animation
+		if (animation_finished)
 		{
-			pos = animation_position; // copy value to avoid that it changes in between by timer interrupt
-			UART_PUTF2("%lu/%lu, ", pos, animation_length);
-			
-			if (pos == animation_length)
-			{
-				UART_PUTF("END Brightness %u%%, ", end_brightness);
-				setPWMDutyCyclePercent((float)end_brightness);
-				send_status_timeout = 10;
-				animation_length = 0;
-				animation_position = 0;
-			}
-			else
-			{			
-				float brightness = (start_brightness + ((float)end_brightness - start_brightness) * pos / animation_length);
-				UART_PUTF("Br.%u%%, ", (uint32_t)(brightness));
-				setPWMDutyCyclePercent(brightness);
-			}
-		}			
+			animation_finished = false;
+			UART_PUTF("END Brightness %u%%\r\n", end_brightness);
+			send_status_timeout = 10;
+		}
 		
 		// send status from time to time
 		if (!send_startup_reason(&mcusr_mirror))
 		{
 			if (send_status_timeout == 0)
 			{
-				send_status_timeout = SEND_STATUS_EVERY_SEC * (1000 / ANIMATION_UPDATE_MS);
+				send_status_timeout = SEND_STATUS_EVERY_SEC * (1000 / UPDATE_MS);
 				send_dimmer_status();
 				led_blink(200, 0, 1);
 			}
@@ -754,9 +834,6 @@ int main(void)
 
 		checkSwitchOff();
 
-		rfm_watchdog_count(ANIMATION_UPDATE_MS);
-
-		rfm12_tick();
 		send_status_timeout--;
 	}
 	
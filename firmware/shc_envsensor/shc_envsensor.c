@@ -60,6 +60,9 @@
 #define BATTERY_MEASURING_INTERVAL_SEC 28500 // about every 8 hours
 #define BATTERY_AVERAGING_INTERVAL 3
 
+// Maximum number of configured wake-up intervals the scheduler lets the device sleep at once.
+#define MAX_SLEEP_TICKS 255
+
 uint8_t temperature_sensor_type = 0;
 uint8_t humidity_sensor_type = 0;
 uint8_t barometric_sensor_type = 0;
@@ -67,8 +70,10 @@ uint8_t brightness_sensor_type = 0;
 uint8_t distance_sensor_type = 0;
 uint8_t particulate_matter_sensor_type = 0;
 uint8_t power_pin_mode = 0;
-uint32_t version_measInt;
-uint32_t version_wupCnt;
+uint16_t device_id = 0;
+uint16_t listen_window_ms; // time the receiver stays on after sending, see rfm12_listen_after_send
+uint16_t version_measInt;
+uint32_t version_nextDue;
 uint16_t vempty = 1100; // 1.1V * 2 cells = 2.2V = min. voltage for RFM12B
 uint8_t rom_id[8]; // for 1-wire
 
@@ -79,11 +84,18 @@ bool di_change = false;
 bool ai_change = false;
 bool pin_wakeup = false; // remember if wakeup was done by pin change (or by RFM12B)
 
+// Time base of the measurement scheduler. One tick is one configured wake-up interval
+// (e.g. 8s). The RFM12B wake-up timer is programmed to a multiple of it to skip
+// wake-ups where nothing is due.
+uint16_t wakeup_interval;  // wake-up interval as configured in e2p (RFM12B register format)
+uint32_t now_ticks = 0;    // ticks since power up at the current wake-up
+uint16_t sleep_ticks = 1;  // ticks the RFM12B wake-up timer is currently programmed to
+
 struct measurement_t
 {
 	int32_t val;      // stores the accumulated value
-	uint16_t wupCnt;  // Amount of wake-up cycles counting from the last time a measurement was done.
-	uint16_t measInt; // The number of times the device wakes up before this value is measured.
+	uint32_t nextDue; // The tick at which the value is measured the next time.
+	uint16_t measInt; // The number of ticks (configured wake-up intervals) between two measurements.
 	uint8_t measCnt;  // The number of measurements that were taken since the last time the average was sent.
 	uint8_t avgInt;   // The number of values whose average is calculated before sending.
 } temperature, humidity, barometric_pressure, distance, battery_voltage, brightness;
@@ -92,11 +104,13 @@ struct pm_measurement_t
 {
 	// The values are currently based on the SPS30.
 	// If other particulate matter sensors would be supported, the structure has to be changed accordingly.
-	float typicalParticleSize;
-	float massConcentration[4];
-	float numberConcentration[5];
-	uint16_t wupCnt;  // Amount of wake-up cycles counting from the last time a measurement was done.
-	uint16_t measInt; // The number of times the device wakes up before this value is measured.
+	// The values are accumulated in fixed point, in the unit used in the message
+	// (1/10 for concentrations, 1/100 for the particle size).
+	uint32_t typicalParticleSize;
+	uint32_t massConcentration[4];
+	uint32_t numberConcentration[5];
+	uint32_t nextDue; // The tick at which the value is measured the next time.
+	uint16_t measInt; // The number of ticks (configured wake-up intervals) between two measurements.
 	uint8_t measCnt;  // The number of measurements that were taken since the last time the average was sent.
 	uint8_t avgInt;   // The number of values whose average is calculated before sending.
 } particulate_matter;
@@ -224,7 +238,7 @@ void init_di_sensor(void)
 		uint8_t pin = e2p_envsensor_get_digitalinputpin(i);
 
 		di[i].meas.val = 0;
-		di[i].meas.wupCnt = 0;
+		di[i].meas.nextDue = measInt;
 		di[i].meas.measInt = measInt;
 		di[i].meas.measCnt = 0;
 		di[i].meas.avgInt = avgInt;
@@ -282,7 +296,7 @@ void init_ai_sensor(void)
 		uint8_t pin = e2p_envsensor_get_analoginputpin(i);
 
 		ai[i].meas.val = 0;
-		ai[i].meas.wupCnt = 0;
+		ai[i].meas.nextDue = measInt;
 		ai[i].meas.measInt = measInt;
 		ai[i].meas.measCnt = 0;
 		ai[i].meas.avgInt = avgInt;
@@ -384,6 +398,7 @@ uint16_t init_wakeup(void)
 		interval = WAKEUPINTERVAL_105S;
 	}
 
+	wakeup_interval = interval;
 	rfm12_set_wakeup_timer(interval);
 
 	// Calculate wake-up time in seconds according RFM12B datasheet and round the value to seconds.
@@ -393,21 +408,59 @@ uint16_t init_wakeup(void)
 	return sec;
 }
 
+// Program the RFM12B wake-up timer to the given number of ticks (multiples of the
+// configured wake-up interval). The timer value is M * 2^R with an 8 bit M, so not
+// every multiple can be represented exactly. In this case, the next smaller multiple
+// that can be represented is used, so the device never wakes up too late.
+// Return the number of ticks the timer was set to.
+uint16_t set_wakeup_ticks(uint16_t ticks)
+{
+	while (ticks > 1)
+	{
+		uint32_t m = (uint32_t)(wakeup_interval & 0xff) * ticks;
+		uint8_t r = (wakeup_interval >> 8) & 0b11111;
+
+		while ((m > 255) && ((m & 1) == 0) && (r < 31))
+		{
+			m >>= 1;
+			r++;
+		}
+
+		if (m <= 255)
+		{
+			rfm12_set_wakeup_timer(((uint16_t)r << 8) | m);
+			return ticks;
+		}
+
+		ticks--;
+	}
+
+	rfm12_set_wakeup_timer(wakeup_interval);
+	return 1;
+}
+
 // ---------- functions to measure values from sensors ----------
 
-// count wake-up and return true if the measurement interval is reached
-bool countWakeup(struct measurement_t * m)
+// Return true if the given due tick is reached at the current wake-up.
+static inline bool tick_reached(uint32_t due)
 {
-	m->wupCnt++;
+	return (int32_t)(now_ticks - due) >= 0;
+}
 
-	if (m->wupCnt >= m->measInt)
+// Return true if the measurement is due at the current wake-up and
+// schedule the next measurement in this case.
+// The next due tick is always a multiple of measInt, so that measurements
+// with related intervals fall onto the same wake-up.
+bool countWakeup(struct measurement_t * m)
+{
+	if (!tick_reached(m->nextDue))
 	{
-		m->wupCnt = 0;
-		m->measCnt++;
-		return true;
+		return false;
 	}
 
-	return false;
+	m->nextDue = (now_ticks / m->measInt + 1) * m->measInt;
+	m->measCnt++;
+	return true;
 }
 
 void measure_digital_input(void)
@@ -717,14 +770,12 @@ void measure_particulatematter_i2c(void)
 	if (particulate_matter_sensor_type == PARTICULATEMATTERSENSORTYPE_NOSENSOR)
 		return;
 
-	particulate_matter.wupCnt++;
-
 	// start measuring?
-	if (particulate_matter.wupCnt >= particulate_matter.measInt)
+	if (tick_reached(particulate_matter.nextDue))
 	{
 		switch_i2c(true);
 
-		particulate_matter.wupCnt = 0;
+		particulate_matter.nextDue = (now_ticks / particulate_matter.measInt + 1) * particulate_matter.measInt;
 
 		UART_PUTS("Start PM sensor\r\n");
 		sps30_start_measurement();
@@ -748,15 +799,26 @@ void measure_particulatematter_i2c(void)
 
 			if (sps30_read_measured_values())
 			{
+				uint32_t val;
+
+				// Limit single values to 16 bits, which is far more than can be sent,
+				// to make sure the sums can't overflow.
 				for (j = 0; j <= 3; j++)
-					particulate_matter.massConcentration[j] += sps30_get_measured_value(j);
+				{
+					val = sps30_get_measured_value_scaled(j, 10);
+					particulate_matter.massConcentration[j] += MIN(val, UINT16_MAX);
+				}
 
 				for (j = 0; j <= 4; j++)
-					particulate_matter.numberConcentration[j] += sps30_get_measured_value(j + 4);
+				{
+					val = sps30_get_measured_value_scaled(j + 4, 10);
+					particulate_matter.numberConcentration[j] += MIN(val, UINT16_MAX);
+				}
 
-				particulate_matter.typicalParticleSize += sps30_get_measured_value(9);
+				val = sps30_get_measured_value_scaled(9, 100);
+				particulate_matter.typicalParticleSize += MIN(val, UINT16_MAX);
 
-				UART_PUTF("success, PM2.5 * 10 = %d\r\n", (int)(sps30_get_measured_value(1) * 10));
+				UART_PUTF("success, PM2.5 * 10 = %lu\r\n", sps30_get_measured_value_scaled(1, 10));
 				i++;
 			}
 		}
@@ -791,11 +853,10 @@ void measure_brightness(void)
 
 // ---------- functions to prepare a message filled with sensor data ----------
 
-// Calculate the average value and reset wake-up and measurement counter.
+// Calculate the average value and reset the measurement counter.
 void average(struct measurement_t *m)
 {
 	m->val /= m->measCnt;
-	m->wupCnt = 0;
 	m->measCnt = 0;
 }
 
@@ -824,7 +885,6 @@ void prepare_digitalport(void)
 
 	UART_PUTS("\r\n");
 
-	di[0].meas.wupCnt = 0;
 	di[0].meas.measCnt = 0;
 	di_change = false;
 }
@@ -862,7 +922,6 @@ void prepare_analogport(void)
 
 	UART_PUTS("\r\n");
 
-	ai[0].meas.wupCnt = 0;
 	ai[0].meas.measCnt = 0;
 	ai_change = false;
 }
@@ -927,19 +986,13 @@ void prepare_distance(void)
 	distance.val = 0;
 }
 
-// Round the float value used for pm sensors to an uint.
-// Multiply the value before with 10 or 100 to create the
+// Calculate the rounded average of the accumulated pm values (4 measurements
+// per averaging interval). The values are already scaled to the
 // 1/10 µm / 1/100 µm values as defined in the message.
-// Return UINT16_MAX-1 as maximum value, since UINT16_MAX
-// is used to indicate an invalid value.
-uint16_t pm_float2uint(float f, uint16_t max)
+// Return max as maximum value, since max + 1 is used to indicate an invalid value.
+uint16_t pm_average(uint32_t sum, uint16_t max)
 {
-	f += 0.5; // for rounding
-
-	if (f >= max)
-		return max;
-	else
-		return (uint16_t)f;
+	return average_round16(sum, 4 * particulate_matter.avgInt, max);
 }
 
 void prepare_particulate_matter(void)
@@ -960,19 +1013,19 @@ void prepare_particulate_matter(void)
 
 	for (i = 0; i <= 3; i++)
 	{
-		msg_environment_particulatematter_set_massconcentration(i + 1, pm_float2uint(particulate_matter.massConcentration[i] / 4 / particulate_matter.avgInt * 10, 1022));
+		msg_environment_particulatematter_set_massconcentration(i + 1, pm_average(particulate_matter.massConcentration[i], 1022));
 		particulate_matter.massConcentration[i] = 0; // reset value
 	}
 
 	// set number concentration
 	for (i = 0; i <= 4; i++)
 	{
-		msg_environment_particulatematter_set_numberconcentration(i, pm_float2uint(particulate_matter.numberConcentration[i] / 4 / particulate_matter.avgInt * 10, 4094));
+		msg_environment_particulatematter_set_numberconcentration(i, pm_average(particulate_matter.numberConcentration[i], 4094));
 		particulate_matter.numberConcentration[i] = 0; // reset value
 	}
 
 	// set typical particle size
-	msg_environment_particulatematter_set_typicalparticlesize(pm_float2uint(particulate_matter.typicalParticleSize / 4 / particulate_matter.avgInt * 100, 1022));
+	msg_environment_particulatematter_set_typicalparticlesize(pm_average(particulate_matter.typicalParticleSize, 1022));
 	particulate_matter.typicalParticleSize = 0; // reset value
 
 	UART_PUTF("Send PM: %d\r\n", 1234);
@@ -1006,10 +1059,18 @@ void prepare_battery_voltage(void)
 	battery_voltage.val = 0;
 }
 
-void prepare_deviceinfo(void)
+void prepare_deviceinfo(bool ackstatus)
 {
 	// Set packet content
-	pkg_header_init_generic_deviceinfo_status();
+	if (ackstatus)
+	{
+		pkg_header_init_generic_deviceinfo_ackstatus();
+	}
+	else
+	{
+		pkg_header_init_generic_deviceinfo_status();
+	}
+
 	msg_generic_deviceinfo_set_devicetype(DEVICETYPE_ENVSENSOR);
 	msg_generic_deviceinfo_set_versionmajor(VERSION_MAJOR);
 	msg_generic_deviceinfo_set_versionminor(VERSION_MINOR);
@@ -1019,14 +1080,127 @@ void prepare_deviceinfo(void)
 	UART_PUTF("Send DeviceInfo: DeviceType %u,", DEVICETYPE_ENVSENSOR);
 	UART_PUTF4(" v%u.%u.%u (%08lx)\r\n", VERSION_MAJOR, VERSION_MINOR, VERSION_PATCH, VERSION_HASH);
 
-	version_wupCnt = 0;
+	if (!ackstatus)
+	{
+		version_nextDue = now_ticks + version_measInt;
+	}
+}
+
+// Search for one value to send with avgInt reached and prepare the packet.
+// Return false if nothing has to be sent (anymore).
+bool prepare_next_packet(void)
+{
+	if (pin_wakeup && !di_change) // don't send update if pin level changed in "wrong" direction
+	{
+		return false;
+	}
+	else if (di_change)
+	{
+		prepare_digitalport();
+	}
+	else if (ai_change)
+	{
+		prepare_analogport();
+	}
+	else if (humidity.measCnt >= humidity.avgInt)
+	{
+		prepare_humiditytemperature();
+	}
+	else if (barometric_pressure.measCnt >= barometric_pressure.avgInt)
+	{
+		prepare_barometricpressuretemperature();
+	}
+	else if (temperature.measCnt >= temperature.avgInt)
+	{
+		prepare_temperature();
+	}
+	else if (distance.measCnt >= distance.avgInt)
+	{
+		prepare_distance();
+	}
+	else if (particulate_matter.measCnt >= particulate_matter.avgInt)
+	{
+		prepare_particulate_matter();
+	}
+	else if (brightness.measCnt >= brightness.avgInt)
+	{
+		prepare_brightness();
+	}
+	else if (battery_voltage.measCnt >= battery_voltage.avgInt)
+	{
+		prepare_battery_voltage();
+	}
+	else if (tick_reached(version_nextDue))
+	{
+		prepare_deviceinfo(false);
+	}
+	else
+	{
+		return false;
+	}
+
+	return true;
+}
+
+// ---------- measurement scheduler ----------
+
+// Lower the given earliest due tick to the one of the measurement.
+static void schedule_min(uint32_t * next, uint32_t due)
+{
+	if ((int32_t)(due - *next) < 0)
+	{
+		*next = due;
+	}
+}
+
+// Calculate the tick at which the next measurement or report is due and
+// program the RFM12B wake-up timer so that the device sleeps until then.
+// Wake-ups where nothing would have to be done are skipped this way.
+void schedule_wakeup(void)
+{
+	uint32_t next = now_ticks + MAX_SLEEP_TICKS;
+
+	schedule_min(&next, battery_voltage.nextDue);
+	schedule_min(&next, version_nextDue);
+
+	if (temperature_sensor_type != TEMPERATURESENSORTYPE_NOSENSOR)
+		schedule_min(&next, temperature.nextDue);
+
+	if (humidity_sensor_type != HUMIDITYSENSORTYPE_NOSENSOR)
+		schedule_min(&next, humidity.nextDue);
+
+	if (barometric_sensor_type != BAROMETRICSENSORTYPE_NOSENSOR)
+		schedule_min(&next, barometric_pressure.nextDue);
+
+	if (brightness_sensor_type != BRIGHTNESSSENSORTYPE_NOSENSOR)
+		schedule_min(&next, brightness.nextDue);
+
+	if (distance_sensor_type != DISTANCESENSORTYPE_NOSENSOR)
+		schedule_min(&next, distance.nextDue);
+
+	if (particulate_matter_sensor_type != PARTICULATEMATTERSENSORTYPE_NOSENSOR)
+		schedule_min(&next, particulate_matter.nextDue);
+
+	if (di_sensor_used)
+		schedule_min(&next, di[0].meas.nextDue);
+
+	if (ai_sensor_used)
+		schedule_min(&next, ai[0].meas.nextDue);
+
+	uint16_t ticks = (int32_t)(next - now_ticks) > 0 ? (uint16_t)(next - now_ticks) : 1;
+
+	// Reprogramming restarts the timer, so only do it if the interval changes.
+	if (ticks != sleep_ticks)
+	{
+		sleep_ticks = set_wakeup_ticks(ticks);
+		UART_PUTF("Sleep %u ticks\r\n", sleep_ticks);
+	}
 }
 
 // ---------- main loop ----------
 
 int main(void)
 {
-	uint16_t device_id = 0;
 	uint16_t wakeup_sec;
 
 	// delay 1s to avoid further communication with uart or RFM12 when my programmer resets the MC after 500ms...
@@ -1042,8 +1216,7 @@ int main(void)
 	uart_init();
 
 	// read packetcounter, increase by cycle and write back
-	packetcounter = e2p_generic_get_packetcounter() + PACKET_COUNTER_WRITE_CYCLE;
-	e2p_generic_set_packetcounter(packetcounter);
+	init_packetcounter();
 
 	// read device specific config
 	temperature_sensor_type = e2p_envsensor_get_temperaturesensortype();
@@ -1054,6 +1227,12 @@ int main(void)
 	particulate_matter_sensor_type = e2p_envsensor_get_particulatemattersensortype();
 	power_pin_mode = e2p_envsensor_get_powerpinmode();
 
+	listen_window_ms = e2p_envsensor_get_listenwindowms();
+	if (listen_window_ms > LISTEN_WINDOW_MS_MAX) // set default value if never initialized
+	{
+		listen_window_ms = LISTEN_WINDOW_MS_DEFAULT;
+	}
+
 	// read device id
 	device_id = e2p_generic_get_deviceid();
 
@@ -1063,6 +1242,7 @@ int main(void)
 	osccal_info();
 	UART_PUTF ("Device ID: %u\r\n", device_id);
 	UART_PUTF ("Packet counter: %lu\r\n", packetcounter);
+	UART_PUTF ("Listen window: %ums\r\n", listen_window_ms);
 
 	init_di_sensor();
 	init_ai_sensor();
@@ -1071,6 +1251,7 @@ int main(void)
 	e2p_generic_get_aeskey(aes_key);
 
 	rfm12_init();
+	rfm12_rx_off(); // only listen after sending
 	wakeup_sec = init_wakeup();
 
 	// Configure measurement and averaging intervals.
@@ -1082,7 +1263,24 @@ int main(void)
 	particulate_matter.measInt = e2p_envsensor_get_particulatemattermeasuringinterval();
 	battery_voltage.measInt = BATTERY_MEASURING_INTERVAL_SEC / wakeup_sec;
 	version_measInt = VERSION_MEASURING_INTERVAL_SEC / wakeup_sec;
-	version_wupCnt = version_measInt - 1; // send right after startup
+
+	// Avoid division by zero in the scheduler if the wake-up interval is very long.
+	if (battery_voltage.measInt == 0)
+		battery_voltage.measInt = 1;
+
+	if (version_measInt == 0)
+		version_measInt = 1;
+
+	// The first wake-up is tick 1, so every value is measured for the first time
+	// at the same wake-up as with counting wake-ups.
+	temperature.nextDue = temperature.measInt;
+	humidity.nextDue = humidity.measInt;
+	barometric_pressure.nextDue = barometric_pressure.measInt;
+	brightness.nextDue = brightness.measInt;
+	distance.nextDue = distance.measInt;
+	particulate_matter.nextDue = particulate_matter.measInt;
+	battery_voltage.nextDue = battery_voltage.measInt;
+	version_nextDue = 1; // send right after startup
 
 	temperature.avgInt = e2p_envsensor_get_temperatureaveraginginterval();
 	humidity.avgInt = e2p_envsensor_get_humidityaveraginginterval();
@@ -1152,8 +1350,10 @@ int main(void)
 		{
 			measure_digital_input();
 		}
-		else // wakeup by RFM12B -> measure everything
+		else // wakeup by RFM12B -> measure everything that is due
 		{
+			now_ticks += sleep_ticks;
+
 			// measure ADC dependant values
 			adc_on(true);
 			sbi(ADC_PULLUP_PORT, ADC_PULLUP_PIN);
@@ -1180,64 +1380,16 @@ int main(void)
 			measure_temperature_1wire();
 			measure_temperature_other();
 			measure_humidity_other();
-
-			version_wupCnt++;
 		}
 
-		// search for value to send with avgInt reached
-		bool send = true;
+		bool sent = false;
 
-		if (pin_wakeup && !di_change) // don't send update if pin level changed in "wrong" direction
+		// Send all values with avgInt reached in this wake-up, so that the device
+		// doesn't have to wake up again only to send the remaining ones.
+		while (prepare_next_packet())
 		{
-			send = false;
-		}
-		else if (di_change)
-		{
-			prepare_digitalport();
-		}
-		else if (ai_change)
-		{
-			prepare_analogport();
-		}
-		else if (humidity.measCnt >= humidity.avgInt)
-		{
-			prepare_humiditytemperature();
-		}
-		else if (barometric_pressure.measCnt >= barometric_pressure.avgInt)
-		{
-			prepare_barometricpressuretemperature();
-		}
-		else if (temperature.measCnt >= temperature.avgInt)
-		{
-			prepare_temperature();
-		}
-		else if (distance.measCnt >= distance.avgInt)
-		{
-			prepare_distance();
-		}
-		else if (particulate_matter.measCnt >= particulate_matter.avgInt)
-		{
-			prepare_particulate_matter();
-		}
-		else if (brightness.measCnt >= brightness.avgInt)
-		{
-			prepare_brightness();
-		}
-		else if (battery_voltage.measCnt >= battery_voltage.avgInt)
-		{
-			prepare_battery_voltage();
-		}
-		else if (version_wupCnt >= version_measInt)
-		{
-			prepare_deviceinfo();
-		}
-		else
-		{
-			send = false;
-		}
+			sent = true;
 
-		if (send)
-		{
 			inc_packetcounter();
 
 			pkg_header_set_senderid(device_id);
@@ -1249,6 +1401,18 @@ int main(void)
 			led_blink(200, 0, 1);
 		}
 
+		if (sent)
+		{
+			rfm12_listen_after_send(device_id, listen_window_ms, prepare_deviceinfo, 0);
+		}
+
+		// The RFM12B timer keeps running during a pin wakeup, so only reprogram it
+		// after a wakeup by the timer itself.
+		if (!pin_wakeup)
+		{
+			schedule_wakeup();
+		}
+
 		cli();
 		pin_wakeup = false;
 		remember_di_state();
@@ -130,13 +130,16 @@ bool sps30_read_measured_values(void)
 	return true;
 }
 
-float sps30_get_measured_value(uint8_t pos)
+// Return the measured value at the given position, multiplied by scale and rounded.
+// The sensor delivers float values. They are converted to fixed point right
+// here, so that no floating point calculation is needed for averaging.
+uint32_t sps30_get_measured_value_scaled(uint8_t pos, uint8_t scale)
 {
-	float2uint32.uint32Val =
+	uint32_t bits =
 		(((uint32_t)sps30_data[pos * 6]) << 24)
 		| (((uint32_t)sps30_data[pos * 6 + 1]) << 16)
 		| (((uint32_t)sps30_data[pos * 6 + 3]) << 8)
 		| (((uint32_t)sps30_data[pos * 6 + 4]) << 0);
 
-	return float2uint32.floatVal;
+	return float_bits_to_fixed(bits, scale);
 }
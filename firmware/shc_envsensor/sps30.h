@@ -24,4 +24,4 @@ void sps30_start_measurement(void);
 void sps30_stop_measurement(void);
 bool sps30_read_data_ready(void);
 bool sps30_read_measured_values(void);
-float sps30_get_measured_value(uint8_t pos);
+uint32_t sps30_get_measured_value_scaled(uint8_t pos, uint8_t scale);
@@ -16,16 +16,15 @@
 * with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <avr/io.h>
-#include <avr/interrupt.h>
-#include <util/delay.h>
 #include <string.h>
 
+#include "../src_common/hal.h"
 #include "rfm12.h"
 #include "../src_common/uart.h"
 
 #include "../src_common/msggrp_generic.h"
 #include "../src_common/msggrp_gpio.h"
+#include "../src_common/packet_dispatch.h"
 
 #include "../src_common/e2p_hardware.h"
 #include "../src_common/e2p_generic.h"
@@ -42,17 +41,13 @@
 //          The behaviour depends on the according E2P setting.
 
 #define RELAIS_COUNT 3 // Don't change! (PC0 to PC2 are supported)
-#define RELAIS_PORT PORTC // TODO: Configurable pins like in env sensor
+#define RELAIS_PORT C // TODO: Configurable pins like in env sensor
 #define RELAIS_PIN_START 0
 
-#define BUTTON_DDR DDRD // TODO: Configurable pins like in env sensor
-#define BUTTON_PORT PORTD
-#define BUTTON_PINPORT PIND
+#define BUTTON_PORT D // TODO: Configurable pins like in env sensor
 #define BUTTON_PIN 3
 
-#define SWITCH_DDR DDRB // TODO: Configurable pins like in env sensor
-#define SWITCH_PORT PORTB
-#define SWITCH_PINPORT PINB
+#define SWITCH_PORT B // TODO: Configurable pins like in env sensor
 #define SWITCH_PIN 7
 
 // Power of RFM12B (since PCB rev 1.1) or RFM12 NRES (Reset) pin may be connected to PC3.
@@ -63,6 +58,12 @@
 
 #include "../src_common/util_watchdog_init.h"
 
+// RAM copy of the used part of the device specific e2p block (see e2p_powerswitch.h),
+// so that reading the configuration in the main loop doesn't access the EEPROM.
+#define E2P_SHADOW_START (512 / 8)
+#define E2P_SHADOW_BYTES ((1072 - 512) / 8)
+
+uint8_t e2p_shadow_buf[E2P_SHADOW_BYTES];
 uint16_t device_id;
 uint32_t station_packetcounter;
 
@@ -70,12 +71,12 @@ bool cmd_state[RELAIS_COUNT];             // state as requested by command
 bool switch_state_physical[RELAIS_COUNT]; // the physical state of the manual switch according I/O pin voltage level
 bool switch_state_logical[RELAIS_COUNT];  // the logical switch state, considering the on/off delays
 bool relais_state[RELAIS_COUNT];          // resulting relais state as combination of cmd_state and switch_state_logical
-uint16_t cmd_timeout[RELAIS_COUNT];       // timeout as requested by command
+struct sw_timer_t cmd_timer[RELAIS_COUNT]; // timeout as requested by command
 uint8_t switch_mode[RELAIS_COUNT];        // defines how cmd_state and switch_state_logical are combined to set relais state
 uint16_t switch_on_delay[RELAIS_COUNT];   // delay until switch 'on' state is considered
 uint16_t switch_off_delay[RELAIS_COUNT];  // delay until switch 'off' state is considered
-uint16_t switch_on_delay_counter[RELAIS_COUNT];  // count the seconds until switch state change is considered
-uint16_t switch_off_delay_counter[RELAIS_COUNT]; // count the seconds until switch state change is considered
+struct sw_timer_t switch_delay_timer[RELAIS_COUNT]; // runs until the physical switch state change is considered
+struct timer_wheel_t timers;              // timers in seconds, ticked once per second in the main loop
 uint16_t port_status_cycle;
 uint16_t version_status_cycle;            // send version status x times less than switch status (~once per day)
 uint16_t version_status_cycle_counter;    // send early after startup
@@ -98,9 +99,9 @@ void print_states(void)
 			UART_PUTS("OFF");
 		}
 
-		if (cmd_timeout[i - 1])
+		if (sw_timer_running(&cmd_timer[i - 1]))
 		{
-			UART_PUTF(" (Timeout: %us)", cmd_timeout[i - 1]);
+			UART_PUTF(" (Timeout: %us)", sw_timer_remaining(&timers, &cmd_timer[i - 1]));
 		}
 
 		UART_PUTS(", SWITCH PHY=");
@@ -159,12 +160,12 @@ void send_gpio_digitalporttimeout_status(void)
 	{
 		// set command state incl. current timeout
 		msg_gpio_digitalporttimeout_set_on(i, cmd_state[i]);
-		msg_gpio_digitalporttimeout_set_timeoutsec(i, cmd_timeout[i]);
+		msg_gpio_digitalporttimeout_set_timeoutsec(i, sw_timer_remaining(&timers, &cmd_timer[i]));
 
 		// set physical manual switch states incl. current timeout with offset 3
 		msg_gpio_digitalporttimeout_set_on(i + 3, switch_state_physical[i]);
 		msg_gpio_digitalporttimeout_set_timeoutsec(i + 3,
-				switch_state_physical[i] ? switch_on_delay_counter[i] : switch_off_delay_counter[i]);
+				sw_timer_remaining(&timers, &switch_delay_timer[i]));
 
 		// set relais state with offset 6
 		if (i < 2)
@@ -240,7 +241,7 @@ void update_relais_states(void)
 		{
 			if (relais_state[i])
 			{
-				sbi(RELAIS_PORT, RELAIS_PIN_START + i);
+				hal_gpio_write(HAL_PORT(RELAIS_PORT), RELAIS_PIN_START + i, true);
 
 				if (i == 0)
 				{
@@ -249,7 +250,7 @@ void update_relais_states(void)
 			}
 			else
 			{
-				cbi(RELAIS_PORT, RELAIS_PIN_START + i);
+				hal_gpio_write(HAL_PORT(RELAIS_PORT), RELAIS_PIN_START + i, false);
 
 				if (i == 0)
 				{
@@ -275,7 +276,7 @@ void set_cmd_state(int8_t num, bool on, uint16_t timeout, bool dbgmsg)
 	}
 
 	cmd_state[num] = on;
-	cmd_timeout[num] = timeout;
+	sw_timer_start(&timers, &cmd_timer[num], timeout);
 
 	if (e2p_powerswitch_get_cmdstate(num) != on)
 	{
@@ -299,32 +300,25 @@ bool update_switch_states(bool ignore_delay)
 	if (switch_mode[0] != SWITCHMODE_CMD)
 	{
 		oldState = switch_state_physical[0];
-		switch_state_physical[0] = !(SWITCH_PINPORT & (1 << SWITCH_PIN));
+		switch_state_physical[0] = !hal_gpio_read(HAL_PORT(SWITCH_PORT), SWITCH_PIN);
 
 		if (oldState != switch_state_physical[0]) {
 			change = true;
 
-			if (switch_state_physical[0]) { // ON
-				if (switch_off_delay_counter[0]) // off delay still running, phy switch still on
-					switch_off_delay_counter[0] = 0;
-				else
-				{
-					if (ignore_delay || (switch_on_delay[0] == 0))
-						switch_state_logical[0] = switch_state_physical[0];
-					else
-						switch_on_delay_counter[0] = switch_on_delay[0];
-				}
-			}
+			// A running delay belongs to the previous physical state, which is
+			// still the logical state. Cancelling it is all to do then.
+			if (sw_timer_running(&switch_delay_timer[0]))
+				sw_timer_stop(&switch_delay_timer[0]);
 			else
-			{ // OFF
-				if (switch_on_delay_counter[0]) // on delay still running, phy switch still off
-					switch_on_delay_counter[0] = 0;
+			{
+				uint16_t delay = switch_state_physical[0] ? switch_on_delay[0] : switch_off_delay[0];
+
+				if (ignore_delay || (delay == 0))
+					switch_state_logical[0] = switch_state_physical[0];
 				else
 				{
-					if (ignore_delay || (switch_off_delay[0] == 0))
-						switch_state_logical[0] = switch_state_physical[0];
-					else
-						switch_off_delay_counter[0] = switch_off_delay[0];
+					sw_timer_start(&timers, &switch_delay_timer[0], delay);
+					UART_PUTF2("Switch %s in %us\r\n", switch_state_physical[0] ? "on" : "off", delay);
 				}
 			}
 		}
@@ -333,19 +327,39 @@ bool update_switch_states(bool ignore_delay)
 	return change;
 }
 
+// Called by the timer wheel when the on/off delay of the manual switch is over.
+void switch_delay_expired(uint8_t num)
+{
+	switch_state_logical[num] = switch_state_physical[num];
+	UART_PUTF("Logical switch state changed to %u\r\n", switch_state_logical[num]);
+	update_relais_states();
+	send_status_timeout = 1;
+}
+
+// Called by the timer wheel when the timeout requested by command is over.
+void cmd_timeout_expired(uint8_t num)
+{
+	UART_PUTS("Timeout! ");
+	set_cmd_state(num, !cmd_state[num], 0, true);
+	update_relais_states();
+	send_status_timeout = 1;
+}
+
 void process_gpio_digitalport(MessageTypeEnum messagetype)
 {
 	// "Set" or "SetGet" -> modify switch state
 	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
 	{
+		msg_gpio_digitalport_t msg;
 		uint8_t i;
 
+		msg_gpio_digitalport_unpack(bufx, &msg);
+
 		// react on changed state (version for more than one switch...)
 		for (i = 0; i < RELAIS_COUNT; i++)
 		{
-			bool req_on = msg_gpio_digitalport_get_on(i);
-			UART_PUTF2("On[%u]:%u;", i, req_on);
-			set_cmd_state(i, req_on, 0, false);
+			UART_PUTF2("On[%u]:%u;", i, msg.on[i]);
+			set_cmd_state(i, msg.on[i], 0, false);
 			update_relais_states();
 		}
 	}
@@ -356,10 +370,11 @@ void process_gpio_digitalpin(MessageTypeEnum messagetype)
 	// "Set" or "SetGet" -> modify switch state
 	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
 	{
-		uint8_t req_pos = msg_gpio_digitalpin_get_pos();
-		bool req_on = msg_gpio_digitalpin_get_on();
-		UART_PUTF2("Pos:%u;On:%u;", req_pos, req_on);
-		set_cmd_state(req_pos, req_on, 0, false);
+		msg_gpio_digitalpin_t msg;
+
+		msg_gpio_digitalpin_unpack(bufx, &msg);
+		UART_PUTF2("Pos:%u;On:%u;", msg.pos, msg.on);
+		set_cmd_state(msg.pos, msg.on, 0, false);
 		update_relais_states();
 	}
 }
@@ -369,18 +384,18 @@ void process_gpio_digitalporttimeout(MessageTypeEnum messagetype)
 	// "Set" or "SetGet" -> modify switch state
 	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
 	{
+		msg_gpio_digitalporttimeout_t msg;
 		uint8_t i;
 
+		msg_gpio_digitalporttimeout_unpack(bufx, &msg);
+
 		// react on changed state (version for more than one switch...)
 		for (i = 0; i < RELAIS_COUNT; i++)
 		{
-			bool req_on = msg_gpio_digitalporttimeout_get_on(i);
-			uint16_t req_timeout = msg_gpio_digitalporttimeout_get_timeoutsec(i);
+			UART_PUTF2("On[%u]:%u;", i, msg.on[i]);
+			UART_PUTF2("TimeoutSec[%u]:%u;", i, msg.timeoutsec[i]);
 
-			UART_PUTF2("On[%u]:%u;", i, req_on);
-			UART_PUTF2("TimeoutSec[%u]:%u;", i, req_timeout);
-
-			set_cmd_state(i, req_on, req_timeout, false);
+			set_cmd_state(i, msg.on[i], msg.timeoutsec[i], false);
 			update_relais_states();
 		}
 	}
@@ -391,16 +406,24 @@ void process_gpio_digitalpintimeout(MessageTypeEnum messagetype)
 	// "Set" or "SetGet" -> modify switch state
 	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
 	{
-		uint8_t req_pos = msg_gpio_digitalpintimeout_get_pos();
-		bool req_on = msg_gpio_digitalpintimeout_get_on();
-		uint16_t req_timeout = msg_gpio_digitalpintimeout_get_timeoutsec();
-		UART_PUTF2("Pos:%u;On:%u;", req_pos, req_on);
-		UART_PUTF("TimeoutSec:%u;", req_timeout);
-		set_cmd_state(req_pos, req_on, req_timeout, false);
+		msg_gpio_digitalpintimeout_t msg;
+
+		msg_gpio_digitalpintimeout_unpack(bufx, &msg);
+		UART_PUTF2("Pos:%u;On:%u;", msg.pos, msg.on);
+		UART_PUTF("TimeoutSec:%u;", msg.timeoutsec);
+		set_cmd_state(msg.pos, msg.on, msg.timeoutsec, false);
 		update_relais_states();
 	}
 }
 
+// Handlers for the supported messages, indexed by the slot in the dispatch table.
+const pkg_handler_t pkg_handlers[MSGSLOT_COUNT] PROGMEM = {
+	[MSGSLOT_GPIO_DIGITALPORT] = process_gpio_digitalport,
+	[MSGSLOT_GPIO_DIGITALPIN] = process_gpio_digitalpin,
+	[MSGSLOT_GPIO_DIGITALPORTTIMEOUT] = process_gpio_digitalporttimeout,
+	[MSGSLOT_GPIO_DIGITALPINTIMEOUT] = process_gpio_digitalpintimeout
+};
+
 void send_ack(uint32_t acksenderid, uint32_t ackpacketcounter, bool error)
 {
 	// any message can be used as ack, because they are the same anyway
@@ -426,45 +449,33 @@ void send_ack(uint32_t acksenderid, uint32_t ackpacketcounter, bool error)
 // Process a request to this device.
 // React accordingly on the MessageType, MessageGroup and MessageID
 // and send an Ack in any case. It may be an error ack if request is not supported.
-void process_request(MessageTypeEnum messagetype, uint32_t messagegroupid, uint32_t messageid)
+void process_request(MessageTypeEnum messagetype, uint32_t messagegroupid, uint32_t messageid, uint8_t len)
 {
 	// remember some values before the packet buffer is destroyed
 	uint32_t acksenderid = pkg_header_get_senderid();
 	uint32_t ackpacketcounter = pkg_header_get_packetcounter();
 
 	UART_PUTF("MessageGroupID:%u;", messagegroupid);
+	UART_PUTF("MessageID:%u;", messageid);
+
+	PkgDispatchResultEnum result = pkg_dispatch(len, pkg_handlers);
 
-	if (messagegroupid != MESSAGEGROUP_GPIO)
+	if (result != PKG_DISPATCH_OK)
 	{
-		UART_PUTS("\r\nERR: Unsupported MessageGroupID.\r\n");
+		if (result == PKG_DISPATCH_PACKET_TOO_SHORT)
+		{
+			UART_PUTS("\r\nERR: Packet too short.\r\n");
+		}
+		else
+		{
+			UART_PUTS("\r\nERR: Unsupported MessageGroupID / MessageID.\r\n");
+		}
+
 		send_ack(acksenderid, ackpacketcounter, true);
 		rfm12_send_wait_led();
 		return;
 	}
 
-	UART_PUTF("MessageID:%u;", messageid);
-
-	switch (messageid)
-	{
-		case MESSAGEID_GPIO_DIGITALPORT:
-			process_gpio_digitalport(messagetype);
-			break;
-		case MESSAGEID_GPIO_DIGITALPIN:
-			process_gpio_digitalpin(messagetype);
-			break;
-		case MESSAGEID_GPIO_DIGITALPORTTIMEOUT:
-			process_gpio_digitalporttimeout(messagetype);
-			break;
-		case MESSAGEID_GPIO_DIGITALPINTIMEOUT:
-			process_gpio_digitalpintimeout(messagetype);
-			break;
-		default:
-			UART_PUTS("\r\nERR: Unsupported MessageID.");
-			send_ack(acksenderid, ackpacketcounter, true);
-			rfm12_send_wait_led();
-			return;
-	}
-
 	UART_PUTS("\r\n");
 
 	// In all cases, use the digitalporttimeout message as answer.
@@ -485,22 +496,26 @@ void process_request(MessageTypeEnum messagetype, uint32_t messagegroupid, uint3
 		uint8_t i;
 
 		// react on changed state (version for more than one switch...)
+		msg_gpio_digitalporttimeout_t msg;
+		memset(&msg, 0, sizeof(msg));
+
 		for (i = 0; i < RELAIS_COUNT; i++)
 		{
 			// set command state incl. current timeout
-			msg_gpio_digitalporttimeout_set_on(i, cmd_state[i]);
-			msg_gpio_digitalporttimeout_set_timeoutsec(i, cmd_timeout[i]);
+			msg.on[i] = cmd_state[i];
+			msg.timeoutsec[i] = sw_timer_remaining(&timers, &cmd_timer[i]);
 
 			// set physical manual switch states incl. current timeout with offset 3
-			msg_gpio_digitalporttimeout_set_on(i + 3, switch_state_physical[i]);
-			msg_gpio_digitalporttimeout_set_timeoutsec(i + 3,
-				switch_state_physical[i] ? switch_on_delay_counter[i] : switch_off_delay_counter[i]);
+			msg.on[i + 3] = switch_state_physical[i];
+			msg.timeoutsec[i + 3] = sw_timer_remaining(&timers, &switch_delay_timer[i]);
 
 			// set relais state with offset 6
 			if (i < 2)
-				msg_gpio_digitalporttimeout_set_on(i + 6, relais_state[i]);
+				msg.on[i + 6] = relais_state[i];
 		}
 
+		msg_gpio_digitalporttimeout_pack(&msg, bufx);
+
 		UART_PUTS("Sending AckStatus\r\n");
 	}
 
@@ -566,7 +581,7 @@ void process_packet(uint8_t len)
 	uint32_t messagegroupid = pkg_headerext_common_get_messagegroupid();
 	uint32_t messageid = pkg_headerext_common_get_messageid();
 
-	process_request(messagetype, messagegroupid, messageid);
+	process_request(messagetype, messagegroupid, messageid, len);
 }
 
 int main(void)
@@ -578,49 +593,51 @@ int main(void)
 	uint8_t button_debounce = 0;
 
 	// delay 1s to avoid further communication with uart or RFM12 when my programmer resets the MC after 500ms...
-	_delay_ms(1000);
+	hal_delay_ms(1000);
 
 	util_init();
 
 	check_eeprom_compatibility(DEVICETYPE_POWERSWITCH);
+	e2p_shadow_init(e2p_shadow_buf, E2P_SHADOW_START, E2P_SHADOW_BYTES);
 
 	for (i = 0; i < RELAIS_COUNT; i++)
 	{
-		sbi(DDRC, RELAIS_PIN_START + i);
+		hal_gpio_output(HAL_PORT(RELAIS_PORT), RELAIS_PIN_START + i);
 	}
 
 	// init button input
-	cbi(BUTTON_DDR, BUTTON_PIN);
-	sbi(BUTTON_PORT, BUTTON_PIN);
+	hal_gpio_input(HAL_PORT(BUTTON_PORT), BUTTON_PIN, true);
 
 	// read packetcounter, increase by cycle and write back
-	packetcounter = e2p_generic_get_packetcounter() + PACKET_COUNTER_WRITE_CYCLE;
-	e2p_generic_set_packetcounter(packetcounter);
+	init_packetcounter();
 
 	// read last received station packetcounter
 	station_packetcounter = e2p_powerswitch_get_basestationpacketcounter();
 
 	port_status_cycle = (uint16_t)e2p_powerswitch_get_statuscycle() * 60;
-	version_status_cycle = (uint16_t)(90000UL / port_status_cycle); // once every 25 hours
+	version_status_cycle = port_status_cycle ? (uint16_t)(90000UL / port_status_cycle) : 0xffff; // once every 25 hours
 	version_status_cycle_counter = version_status_cycle - 1; // send right after startup
 
 	// read device id
 	device_id = e2p_generic_get_deviceid();
 
+	timer_wheel_init(&timers);
+
 	// read switch mode
 	for (i = 0; i < RELAIS_COUNT; i++)
 	{
 		switch_mode[i] = e2p_powerswitch_get_switchmode(i);
 		switch_on_delay[i] = e2p_powerswitch_get_switchondelay(i);
 		switch_off_delay[i] = e2p_powerswitch_get_switchoffdelay(i);
+		sw_timer_init(&cmd_timer[i], cmd_timeout_expired, i);
+		sw_timer_init(&switch_delay_timer[i], switch_delay_expired, i);
 	}
 
 	// Init IO pin(s) for switches.
 	// Only one switch is currently supported!
 	if (switch_mode[0] != SWITCHMODE_CMD)
 	{
-		cbi(SWITCH_DDR, SWITCH_PIN);
-		sbi(SWITCH_PORT, SWITCH_PIN);
+		hal_gpio_input(HAL_PORT(SWITCH_PORT), SWITCH_PIN, true);
 	}
 
 	osccal_init();
@@ -657,7 +674,7 @@ int main(void)
 	rfm_watchdog_init(device_id, e2p_powerswitch_get_transceiverwatchdogtimeout(), RFM_RESET_PORT_NR, RFM_RESET_PIN, RFM_RESET_PIN_STATE);
 	rfm12_init();
 
-	sei();
+	hal_irq_enable();
 
 	while (42)
 	{
@@ -704,7 +721,7 @@ int main(void)
 			loop = 0;
 
 			// when timeout active, flash LED
-			if (cmd_timeout[0])
+			if (sw_timer_running(&cmd_timer[0]))
 			{
 				rfm12_delay10_led();
 			}
@@ -713,50 +730,8 @@ int main(void)
 				rfm12_delay20();
 			}
 
-			// Count down switch delays
-			for (i = 0; i < RELAIS_COUNT; i++)
-			{
-				if (switch_on_delay_counter[i] > 0) {
-					switch_on_delay_counter[i]--;
-					UART_PUTF("Switch on in %us\r\n", switch_on_delay_counter[0]);
-
-					if (switch_on_delay_counter[i] == 0) {
-						switch_state_logical[i] = switch_state_physical[i];
-						UART_PUTF("Logical switch state changed to %u\r\n", switch_state_logical[0]);
-						update_relais_states();
-						send_status_timeout = 1;
-					}
-				}
-
-				if (switch_off_delay_counter[i] > 0) {
-					switch_off_delay_counter[i]--;
-					UART_PUTF("Switch off in %us\r\n", switch_off_delay_counter[0]);
-
-					if (switch_off_delay_counter[i] == 0) {
-						switch_state_logical[i] = switch_state_physical[i];
-						UART_PUTF("Logical switch state changed to %u\r\n", switch_state_logical[0]);
-						update_relais_states();
-						send_status_timeout = 1;
-					}
-				}
-			}
-
-			// Check timeouts and toggle switches
-			for (i = 0; i < RELAIS_COUNT; i++)
-			{
-				if (cmd_timeout[i])
-				{
-					cmd_timeout[i]--;
-
-					if (cmd_timeout[i] == 0)
-					{
-						UART_PUTS("Timeout! ");
-						set_cmd_state(i, !cmd_state[i], 0, true);
-						update_relais_states();
-						send_status_timeout = 1;
-					}
-				}
-			}
+			// switch delays and timeouts
+			timer_wheel_tick(&timers);
 
 			// send status from time to time
 			if (!send_startup_reason(&mcusr_mirror))
@@ -786,7 +761,7 @@ int main(void)
 
 		switch_led(cmd_state[0]);
 
-		button = !(BUTTON_PINPORT & (1 << BUTTON_PIN));
+		button = !hal_gpio_read(HAL_PORT(BUTTON_PORT), BUTTON_PIN);
 
 		if (button_debounce > 0)
 		{
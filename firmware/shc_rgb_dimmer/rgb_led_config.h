@@ -25,3 +25,7 @@
 #define RGBLED_GRN_DDR DDRD
 #define RGBLED_BLU_DDR DDRD
 #define SPEAKER_DDR    DDRB
+
+// Use 10 bit PWM for the LEDs by dithering the 8 bit timers.
+// rgb_led_dither() has to be called on every Timer0 overflow.
+#define RGBLED_DITHER
@@ -27,6 +27,7 @@
 #include "../src_common/msggrp_generic.h"
 #include "../src_common/msggrp_dimmer.h"
 #include "../src_common/msggrp_audio.h"
+#include "../src_common/packet_dispatch.h"
 
 #include "../src_common/e2p_hardware.h"
 #include "../src_common/e2p_generic.h"
@@ -55,11 +56,13 @@ uint32_t station_packetcounter;
 uint16_t send_status_timeout = 15;
 uint8_t version_status_cycle = SEND_VERSION_STATUS_CYCLE - 1; // send promptly after startup
 
-#define TIMER1_TICK_DIVIDER (F_CPU / 1000000) // 244 Hz / 8 = 32ms per animation_tick
+#define TIMER1_TICK_DIVIDER (F_CPU / 125000) // 1960 Hz / 64 = 32ms per animation_tick
 uint8_t timer1_tick_divider = TIMER1_TICK_DIVIDER;
 
 ISR (TIMER0_OVF_vect)
 {
+	rgb_led_dither();
+
 	timer1_tick_divider--;
 
 	if (timer1_tick_divider == 0)
@@ -168,211 +171,256 @@ void send_ack(uint32_t acksenderid, uint32_t ackpacketcounter, bool error)
 	rfm12_send_bufx();
 }
 
-// Process a request to this device.
-// React accordingly on the MessageType, MessageGroup and MessageID
-// and send an Ack in any case. It may be an error ack if request is not supported.
-void process_request(MessageTypeEnum messagetype, uint32_t messagegroupid, uint32_t messageid)
+// process request "dimmer brightness"
+void process_dimmer_brightness(MessageTypeEnum messagetype)
 {
-	// remember some values before the packet buffer is destroyed
-	uint32_t acksenderid = pkg_header_get_senderid();
-	uint32_t ackpacketcounter = pkg_header_get_packetcounter();
+	// "Set" or "SetGet" -> modify brightness
+	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
+	{
+		msg_dimmer_brightness_t msg;
 
-	UART_PUTF("MessageGroupID:%u;", messagegroupid);
+		msg_dimmer_brightness_unpack(bufx, &msg);
+		rgb_led_user_brightness_factor = msg.brightness;
+		UART_PUTF("Brightness:%u;", rgb_led_user_brightness_factor);
+		rgb_led_update_current_col();
+	}
 
-	if ((messagegroupid != MESSAGEGROUP_DIMMER) && (messagegroupid != MESSAGEGROUP_AUDIO))
+	// "Set" -> send "Ack"
+	if (messagetype == MESSAGETYPE_SET)
 	{
-		UART_PUTS("\r\nERR: Unsupported MessageGroupID.\r\n");
-		send_ack(acksenderid, ackpacketcounter, true);
-		return;
+		pkg_header_init_dimmer_brightness_ack();
 	}
+	// "Get" or "SetGet" -> send "AckStatus"
+	else
+	{
+		msg_dimmer_brightness_t msg = { rgb_led_user_brightness_factor };
 
-	UART_PUTF("MessageID:%u;", messageid);
+		pkg_header_init_dimmer_brightness_ackstatus();
+		msg_dimmer_brightness_pack(&msg, bufx);
+	}
+}
 
-	if (((messagegroupid == MESSAGEGROUP_DIMMER)
-		&& (messageid != MESSAGEID_DIMMER_BRIGHTNESS)
-		&& (messageid != MESSAGEID_DIMMER_COLOR)
-		&& (messageid != MESSAGEID_DIMMER_COLORANIMATION))
-		||
-		((messagegroupid == MESSAGEGROUP_AUDIO)
-		&& (messageid != MESSAGEID_AUDIO_TONE)
-		&& (messageid != MESSAGEID_AUDIO_MELODY)))
+// process request "dimmer color"
+void process_dimmer_color(MessageTypeEnum messagetype)
+{
+	// "Set" or "SetGet" -> modify color
+	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
 	{
-		UART_PUTS("\r\nERR: Unsupported MessageID.\r\n");
-		send_ack(acksenderid, ackpacketcounter, true);
-		return;
+		msg_dimmer_color_t msg;
+
+		msg_dimmer_color_unpack(bufx, &msg);
+		UART_PUTF("Color:%u;", msg.color);
+		rgb_led_set_fixed_color(msg.color);
 	}
 
-	// "Set" or "SetGet" -> modify brightness/color/animation
-	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
+	// "Set" -> send "Ack"
+	if (messagetype == MESSAGETYPE_SET)
 	{
-		if (messagegroupid == MESSAGEGROUP_DIMMER)
-		{
-			if (messageid == MESSAGEID_DIMMER_BRIGHTNESS)
-			{
-				rgb_led_user_brightness_factor = msg_dimmer_brightness_get_brightness();
-				UART_PUTF("Brightness:%u;", rgb_led_user_brightness_factor);
-				rgb_led_update_current_col();
-			}
-			else if (messageid == MESSAGEID_DIMMER_COLOR)
-			{
-				uint8_t color = msg_dimmer_color_get_color();
-				UART_PUTF("Color:%u;", color);
-				rgb_led_set_fixed_color(color);
-			}
-			else // MESSAGEID_DIMMER_COLORANIMATION
-			{
-				uint8_t i;
+		pkg_header_init_dimmer_color_ack();
+	}
+	// "Get" or "SetGet" -> send "AckStatus"
+	else
+	{
+		msg_dimmer_color_t msg = { anim_colors_orig[0] };
 
-				cli();
+		pkg_header_init_dimmer_color_ackstatus();
+		msg_dimmer_color_pack(&msg, bufx);
+	}
+}
 
-				animation.repeat = msg_dimmer_coloranimation_get_repeat();
-				animation.autoreverse = msg_dimmer_coloranimation_get_autoreverse();
+// process request "dimmer color animation"
+void process_dimmer_coloranimation(MessageTypeEnum messagetype)
+{
+	msg_dimmer_coloranimation_t msg;
+	uint8_t i;
 
-				UART_PUTF2("Repeat:%u;AutoReverse:%u;", animation.repeat, animation.autoreverse);
+	// "Set" or "SetGet" -> start new animation
+	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
+	{
+		msg_dimmer_coloranimation_unpack(bufx, &msg);
 
-				for (i = 0; i < ANIM_COL_ORIG_MAX; i++)
-				{
-					anim_time[i] = msg_dimmer_coloranimation_get_time(i);
-					anim_colors_orig[i] = msg_dimmer_coloranimation_get_color(i);
+		cli();
 
-					UART_PUTF2("Time[%u]:%u;", i, anim_time[i]);
-					UART_PUTF2("Color[%u]:%u;", i, anim_colors_orig[i]);
-				}
+		animation.repeat = msg.repeat;
+		animation.autoreverse = msg.autoreverse;
 
-				init_animation(true);
-				rgb_led_update_current_col();
+		UART_PUTF2("Repeat:%u;AutoReverse:%u;", animation.repeat, animation.autoreverse);
 
-				sei();
-			}
-		}
-		else // MESSAGEGROUP_AUDIO
+		for (i = 0; i < ANIM_COL_ORIG_MAX; i++)
 		{
-			if (messageid == MESSAGEID_AUDIO_TONE)
-			{
-				uint8_t tone = msg_audio_tone_get_tone();
-				UART_PUTF("Tone:%u;", tone);
-				speaker_set_fixed_tone(tone);
-			}
-			else // MESSAGEID_AUDIO_MELODY
-			{
-				uint8_t i;
+			anim_time[i] = msg.time[i];
+			anim_colors_orig[i] = msg.color[i];
 
-				cli();
+			UART_PUTF2("Time[%u]:%u;", i, anim_time[i]);
+			UART_PUTF2("Color[%u]:%u;", i, anim_colors_orig[i]);
+		}
 
-				melody.repeat = msg_audio_melody_get_repeat();
-				melody.autoreverse = msg_audio_melody_get_autoreverse();
+		init_animation(true);
+		rgb_led_update_current_col();
 
-				UART_PUTF2("Repeat:%u;AutoReverse:%u;", melody.repeat, melody.autoreverse);
+		sei();
+	}
 
-				for (i = 0; i < MELODY_TONE_ORIG_MAX; i++)
-				{
-					melody_time[i] = msg_audio_melody_get_time(i);
-					melody_effect[i] = msg_audio_melody_get_effect(i);
-					melody_tones_orig[i] = msg_audio_melody_get_tone(i);
+	// "Set" -> send "Ack"
+	if (messagetype == MESSAGETYPE_SET)
+	{
+		pkg_header_init_dimmer_coloranimation_ack();
+	}
+	// "Get" or "SetGet" -> send "AckStatus"
+	else
+	{
+		memset(&msg, 0, sizeof(msg));
 
-					UART_PUTF2("Time[%u]:%u;", i, melody_time[i]);
-					UART_PUTF2("Effect[%u]:%u;", i, melody_effect[i]);
-					UART_PUTF2("Tone[%u]:%u;", i, melody_tones_orig[i]);
-				}
+		for (i = 0; i < ANIM_COL_ORIG_MAX; i++)
+		{
+			msg.color[i] = anim_colors_orig[i];
+			msg.time[i] = anim_time[i];
+		}
 
-				init_animation(false);
-				speaker_update_current_tone();
+		msg.repeat = animation.repeat;
+		msg.autoreverse = animation.autoreverse;
 
-				sei();
-			}
-		}
+		pkg_header_init_dimmer_coloranimation_ackstatus();
+		msg_dimmer_coloranimation_pack(&msg, bufx);
 	}
+}
 
-	UART_PUTS("\r\n");
+// process request "audio tone"
+void process_audio_tone(MessageTypeEnum messagetype)
+{
+	// "Set" or "SetGet" -> play tone
+	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
+	{
+		msg_audio_tone_t msg;
+
+		msg_audio_tone_unpack(bufx, &msg);
+		UART_PUTF("Tone:%u;", msg.tone);
+		speaker_set_fixed_tone(msg.tone);
+	}
 
 	// "Set" -> send "Ack"
 	if (messagetype == MESSAGETYPE_SET)
 	{
-		if (messagegroupid == MESSAGEGROUP_DIMMER)
-		{
-			if (messageid == MESSAGEID_DIMMER_BRIGHTNESS)
-			{
-				pkg_header_init_dimmer_brightness_ack();
-			}
-			else if (messageid == MESSAGEID_DIMMER_COLOR)
-			{
-				pkg_header_init_dimmer_color_ack();
-			}
-			else // MESSAGEID_DIMMER_COLORANIMATION
-			{
-				pkg_header_init_dimmer_coloranimation_ack();
-			}
-		}
-		else // MESSAGEGROUP_AUDIO
+		pkg_header_init_audio_tone_ack();
+	}
+	// "Get" or "SetGet" -> send "AckStatus"
+	else
+	{
+		msg_audio_tone_t msg = { melody_tones_orig[0] };
+
+		pkg_header_init_audio_tone_ackstatus();
+		msg_audio_tone_pack(&msg, bufx);
+	}
+}
+
+// process request "audio melody"
+void process_audio_melody(MessageTypeEnum messagetype)
+{
+	msg_audio_melody_t msg;
+	uint8_t i;
+
+	// "Set" or "SetGet" -> start new melody
+	if ((messagetype == MESSAGETYPE_SET) || (messagetype == MESSAGETYPE_SETGET))
+	{
+		msg_audio_melody_unpack(bufx, &msg);
+
+		cli();
+
+		melody.repeat = msg.repeat;
+		melody.autoreverse = msg.autoreverse;
+
+		UART_PUTF2("Repeat:%u;AutoReverse:%u;", melody.repeat, melody.autoreverse);
+
+		for (i = 0; i < MELODY_TONE_ORIG_MAX; i++)
 		{
-			if (messageid == MESSAGEID_AUDIO_TONE)
-			{
-				pkg_header_init_audio_tone_ack();
-			}
-			else // MESSAGEID_AUDIO_MELODY
-			{
-				pkg_header_init_audio_melody_ack();
-			}
+			melody_time[i] = msg.time[i];
+			melody_effect[i] = msg.effect[i];
+			melody_tones_orig[i] = msg.tone[i];
+
+			UART_PUTF2("Time[%u]:%u;", i, melody_time[i]);
+			UART_PUTF2("Effect[%u]:%u;", i, melody_effect[i]);
+			UART_PUTF2("Tone[%u]:%u;", i, melody_tones_orig[i]);
 		}
 
-		UART_PUTS("Sending Ack\r\n");
+		init_animation(false);
+		speaker_update_current_tone();
+
+		sei();
+	}
+
+	// "Set" -> send "Ack"
+	if (messagetype == MESSAGETYPE_SET)
+	{
+		pkg_header_init_audio_melody_ack();
 	}
 	// "Get" or "SetGet" -> send "AckStatus"
 	else
 	{
-		if (messagegroupid == MESSAGEGROUP_DIMMER)
+		memset(&msg, 0, sizeof(msg));
+
+		for (i = 0; i < MELODY_TONE_ORIG_MAX; i++)
 		{
-			if (messageid == MESSAGEID_DIMMER_BRIGHTNESS)
-			{
-				pkg_header_init_dimmer_brightness_ackstatus();
-				msg_dimmer_brightness_set_brightness(rgb_led_user_brightness_factor);
-			}
-			else if (messageid == MESSAGEID_DIMMER_COLOR)
-			{
-				pkg_header_init_dimmer_color_ackstatus();
-				msg_dimmer_color_set_color(anim_colors_orig[0]);
-			}
-			else // MESSAGEID_DIMMER_COLORANIMATION
-			{
-				uint8_t i;
+			msg.time[i] = melody_time[i];
+			msg.effect[i] = melody_effect[i];
+			msg.tone[i] = melody_tones_orig[i];
+		}
 
-				pkg_header_init_dimmer_coloranimation_ackstatus();
+		msg.repeat = melody.repeat;
+		msg.autoreverse = melody.autoreverse;
 
-				for (i = 0; i < ANIM_COL_ORIG_MAX; i++)
-				{
-					msg_dimmer_coloranimation_set_color(i, anim_colors_orig[i]);
-					msg_dimmer_coloranimation_set_time(i, anim_time[i]);
-				}
+		pkg_header_init_audio_melody_ackstatus();
+		msg_audio_melody_pack(&msg, bufx);
+	}
+}
 
-				msg_dimmer_coloranimation_set_repeat(animation.repeat);
-				msg_dimmer_coloranimation_set_autoreverse(animation.autoreverse);
-			}
-		}
-		else // MESSAGEGROUP_AUDIO
-		{
-			if (messageid == MESSAGEID_AUDIO_TONE)
-			{
-				pkg_header_init_audio_tone_ackstatus();
-				msg_audio_tone_set_tone(melody_tones_orig[0]);
-			}
-			else // MESSAGEID_AUDIO_MELODY
-			{
-				uint8_t i;
+// Handlers for the supported messages, indexed by the slot in the dispatch table.
+// They process the request and prepare the Ack or AckStatus in the packet buffer.
+const pkg_handler_t pkg_handlers[MSGSLOT_COUNT] PROGMEM = {
+	[MSGSLOT_AUDIO_TONE] = process_audio_tone,
+	[MSGSLOT_AUDIO_MELODY] = process_audio_melody,
+	[MSGSLOT_DIMMER_BRIGHTNESS] = process_dimmer_brightness,
+	[MSGSLOT_DIMMER_COLOR] = process_dimmer_color,
+	[MSGSLOT_DIMMER_COLORANIMATION] = process_dimmer_coloranimation
+};
+
+// Process a request to this device.
+// React accordingly on the MessageType, MessageGroup and MessageID
+// and send an Ack in any case. It may be an error ack if request is not supported.
+void process_request(MessageTypeEnum messagetype, uint8_t len)
+{
+	// remember some values before the packet buffer is destroyed
+	uint32_t acksenderid = pkg_header_get_senderid();
+	uint32_t ackpacketcounter = pkg_header_get_packetcounter();
 
-				pkg_header_init_audio_melody_ackstatus();
+	UART_PUTF("MessageGroupID:%u;", pkg_headerext_common_get_messagegroupid());
+	UART_PUTF("MessageID:%u;", pkg_headerext_common_get_messageid());
 
-				for (i = 0; i < MELODY_TONE_ORIG_MAX; i++)
-				{
-					msg_audio_melody_set_time(i, melody_time[i]);
-					msg_audio_melody_set_effect(i, melody_effect[i]);
-					msg_audio_melody_set_tone(i, melody_tones_orig[i]);
-				}
+	PkgDispatchResultEnum result = pkg_dispatch(len, pkg_handlers);
 
-				msg_audio_melody_set_repeat(melody.repeat);
-				msg_audio_melody_set_autoreverse(melody.autoreverse);
-			}
+	if (result != PKG_DISPATCH_OK)
+	{
+		if (result == PKG_DISPATCH_PACKET_TOO_SHORT)
+		{
+			UART_PUTS("\r\nERR: Packet too short.\r\n");
 		}
+		else
+		{
+			UART_PUTS("\r\nERR: Unsupported MessageGroupID / MessageID.\r\n");
+		}
+
+		send_ack(acksenderid, ackpacketcounter, true);
+		return;
+	}
 
+	UART_PUTS("\r\n");
+
+	// "Set" -> send "Ack", "Get" or "SetGet" -> send "AckStatus"
+	if (messagetype == MESSAGETYPE_SET)
+	{
+		UART_PUTS("Sending Ack\r\n");
+	}
+	else
+	{
 		UART_PUTS("Sending AckStatus\r\n");
 	}
 
@@ -434,11 +482,7 @@ void process_packet(uint8_t len)
 		return;
 	}
 
-	// check MessageGroup + MessageID
-	uint32_t messagegroupid = pkg_headerext_common_get_messagegroupid();
-	uint32_t messageid = pkg_headerext_common_get_messageid();
-
-	process_request(messagetype, messagegroupid, messageid);
+	process_request(messagetype, len);
 }
 
 // Show colors shortly to tell user that power is connected (status LED may not be visible).
@@ -480,8 +524,7 @@ int main(void)
 	check_eeprom_compatibility(DEVICETYPE_RGBDIMMER);
 
 	// read packetcounter, increase by cycle and write back
-	packetcounter = e2p_generic_get_packetcounter() + PACKET_COUNTER_WRITE_CYCLE;
-	e2p_generic_set_packetcounter(packetcounter);
+	init_packetcounter();
 
 	// read last received station packetcounter
 	station_packetcounter = e2p_rgbdimmer_get_basestationpacketcounter();
@@ -490,6 +533,12 @@ int main(void)
 	device_id = e2p_generic_get_deviceid();
 
 	rgb_led_brightness_factor = e2p_rgbdimmer_get_brightnessfactor();
+	rgb_led_gamma_curve = e2p_rgbdimmer_get_gammacurve();
+
+	if (rgb_led_gamma_curve >= RGBLED_GAMMA_CURVES)
+	{
+		rgb_led_gamma_curve = 0;
+	}
 
 	osccal_init();
 
@@ -503,6 +552,7 @@ int main(void)
 	UART_PUTF ("PacketCounter: %lu\r\n", packetcounter);
 	UART_PUTF ("Last received base station PacketCounter: %u\r\n\r\n", station_packetcounter);
 	UART_PUTF ("E2P brightness factor: %u%%\r\n", rgb_led_brightness_factor);
+	UART_PUTF ("E2P gamma curve: %u\r\n", rgb_led_gamma_curve);
 
 	// init AES key
 	e2p_generic_get_aeskey(aes_key);
@@ -136,7 +136,7 @@ This is a bitmask that defines how "rude" this library behaves
 #define RFM12_LIVECTRL 0
 #define RFM12_NORETURNS 0
 #define RFM12_USE_WAKEUP_TIMER 1 // Do not use - it leads to problems... Use Timer2 Power Safe mode of ATMega88 instead.
-#define RFM12_TRANSMIT_ONLY 1
+#define RFM12_TRANSMIT_ONLY 0 // receive requests shortly after sending, see listen_after_send()
 #define RFM12_NOCOLLISIONDETECTION 0
 #define RFM12_USE_POLLING 0
 #define RFM12_LOW_POWER 0
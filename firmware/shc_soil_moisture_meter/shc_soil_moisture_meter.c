@@ -50,7 +50,26 @@
 #define SEND_VERSION_STATUS_CYCLE 50    // send version status every x wake ups
 #define SEND_BATTERY_STATUS_CYCLE 25    // send battery status every x wake ups
 
+// The gate time for counting the Schmitt trigger edges is generated by Timer2
+// (prescaler 1024) while the CPU sleeps in idle mode. All counter values are
+// normalized to the reference gate time of 100ms, so the dry threshold and min
+// value stored in e2p keep their meaning.
+#define TIMER2_TICKS_PER_SEC (F_CPU / 1024)
+#define TIMER2_TICKS(ms) (((ms) * TIMER2_TICKS_PER_SEC + 500) / 1000)
+#define MS_TO_TIMER2_TICKS(ms) ((uint8_t)TIMER2_TICKS((uint32_t)(ms)))
+#define GATE_MS_LONG     200
+#define GATE_TICKS_REF   MS_TO_TIMER2_TICKS(100)
+#define GATE_TICKS_SHORT MS_TO_TIMER2_TICKS(25)  // used when the value is far away from the dry threshold
+#define GATE_TICKS_LONG  MS_TO_TIMER2_TICKS(GATE_MS_LONG) // used near the dry threshold and in init mode
+#define SETTLE_TICKS     MS_TO_TIMER2_TICKS(10)  // time for the Schmitt trigger to power up
+
+// The 8 bit timer counts up to 255 ticks, which limits the longest gate time.
+#if TIMER2_TICKS(GATE_MS_LONG) > 255
+	#error "The gate time doesn't fit into Timer2 with this F_CPU. Use a bigger prescaler or shorter gate times."
+#endif
+
 uint16_t device_id;
+uint16_t listen_window_ms; // time the receiver stays on after sending, see rfm12_listen_after_send
 uint32_t station_packetcounter;
 
 uint8_t version_status_cycle = SEND_VERSION_STATUS_CYCLE;
@@ -68,6 +87,10 @@ uint16_t avgIntInit = 3;
 int32_t reported_result = 0;
 bool direction_up = true;
 
+uint32_t last_avg = 0;            // last (normalized) average, used to choose the gate time
+volatile bool timer2_done;        // set by Timer2 compare match ISR when the gate time is over
+volatile uint16_t timer1_ovf_cnt; // upper 16 bits of the edge counter
+
 uint8_t smoothing_percentage;
 
 // TODO: Move to util
@@ -119,14 +142,22 @@ void switch_schmitt_trigger(bool b_on)
 	}
 }
 
-// Prepare message with device info
-void prepare_deviceinfo_status(void)
+// Prepare message with device info, either as Status or as AckStatus to a request
+void prepare_deviceinfo_status(bool ackstatus)
 {
 	UART_PUTF("Send DeviceInfo: DeviceType %u,", DEVICETYPE_SOILMOISTUREMETER);
 	UART_PUTF4(" v%u.%u.%u (%08lx)\r\n", VERSION_MAJOR, VERSION_MINOR, VERSION_PATCH, VERSION_HASH);
 
 	// Set packet content
-	pkg_header_init_generic_deviceinfo_status();
+	if (ackstatus)
+	{
+		pkg_header_init_generic_deviceinfo_ackstatus();
+	}
+	else
+	{
+		pkg_header_init_generic_deviceinfo_status();
+	}
+
 	msg_generic_deviceinfo_set_devicetype(DEVICETYPE_SOILMOISTUREMETER);
 	msg_generic_deviceinfo_set_versionmajor(VERSION_MAJOR);
 	msg_generic_deviceinfo_set_versionminor(VERSION_MINOR);
@@ -171,46 +202,135 @@ void prepare_humidity_status_RAW_DBG(uint16_t hum, int16_t raw)
 	msg_weather_humiditytemperature_set_temperature(raw);
 }
 
+ISR (TIMER2_COMPA_vect)
+{
+	timer2_done = true;
+}
+
+ISR (TIMER1_OVF_vect)
+{
+	timer1_ovf_cnt++;
+}
+
+// Start Timer2 in CTC mode with prescaler 1024 to fire once after the given amount of ticks.
+void timer2_start(uint8_t ticks)
+{
+	timer2_done = false;
+	TCCR2B = 0;
+	TCNT2 = 0;
+	OCR2A = ticks - 1;
+	TCCR2A = (1 << WGM21);
+	sbi(TIFR2, OCF2A); // clear pending compare match
+	sbi(TIMSK2, OCIE2A);
+	TCCR2B = (1 << CS22) | (1 << CS21) | (1 << CS20);
+}
+
+// Sleep in idle mode until Timer2 signals the end of the period.
+// Timer1 (counting external edges) and Timer2 keep running in idle mode.
+// Other interrupts (RFM12, button) may wake up the CPU before, so check the flag.
+void timer2_wait(void)
+{
+	set_sleep_mode(SLEEP_MODE_IDLE);
+
+	while (!timer2_done)
+	{
+		cli();
+
+		if (!timer2_done)
+		{
+			sleep_enable();
+			sei();
+			sleep_cpu();
+			sleep_disable();
+		}
+
+		sei();
+	}
+
+	TCCR2B = 0; // turn timer off
+	cbi(TIMSK2, OCIE2A);
+}
+
+// Choose the gate time for the next measurement.
+// Far away from the dry threshold, a short gate time gives enough resolution.
+// Near the threshold (or if no value is known yet), use a longer gate time
+// to get a higher resolution for the decision if watering is needed.
+uint8_t choose_gate_ticks(void)
+{
+	if (init_mode || (last_avg == 0))
+	{
+		return GATE_TICKS_LONG;
+	}
+
+	uint32_t diff = last_avg > dry_thr ? last_avg - dry_thr : dry_thr - last_avg;
+
+	if (diff > dry_thr / 4)
+	{
+		return GATE_TICKS_SHORT;
+	}
+	else if (diff > dry_thr / 16)
+	{
+		return GATE_TICKS_REF;
+	}
+	else
+	{
+		return GATE_TICKS_LONG;
+	}
+}
+
 // Measure humidity, calculate relative value in permill and return it.
 // Return true, if humidity was sent.
 bool measure_humidity(void)
 {
 	bool res = false;
-	uint16_t cnt;
+	uint32_t cnt;
+	uint8_t gate_ticks = choose_gate_ticks();
 
 	switch_schmitt_trigger(true);
-	_delay_ms(10);
 
 	// make PD5 an input and disable pull-ups
 	DDRD &= ~(1 << 5);
 	PORTD &= ~(1 << 5);
 
+	timer2_start(SETTLE_TICKS);
+	timer2_wait();
+
 	// clear counter
 	TCNT1 = 0x00;
+	timer1_ovf_cnt = 0;
+	sbi(TIFR1, TOV1); // clear pending overflow
+	sbi(TIMSK1, TOIE1);
 
 	// configure counter and use external clock source, rising edge
 	TCCR1A = 0x00;
 	TCCR1B |= (1 << CS12) | (1 << CS11) | (1 << CS10);
 
-	_delay_ms(100);
-
-	//cnt = (TCNT1H << 8) | TCNT1L;
-	cnt = TCNT1;
+	timer2_start(gate_ticks);
+	timer2_wait();
 
 	TCCR1B = 0x00; // turn counter off
+	cbi(TIMSK1, TOIE1);
+
+	cnt = ((uint32_t)timer1_ovf_cnt << 16) | TCNT1;
 
 	switch_schmitt_trigger(false);
 
+	// normalize to reference gate time
+	cnt = (cnt * GATE_TICKS_REF + gate_ticks / 2) / gate_ticks;
+
 	counter_meas += cnt;
 	wupCnt++;
 
-	UART_PUTF4("Init mode %u, Measurement %u/%u, Counter %u\r\n",
+	UART_PUTF4("Init mode %u, Measurement %u/%u, Counter %lu",
 		init_mode, wupCnt, init_mode ? avgIntInit : avgInt , cnt);
+	UART_PUTF(" (gate %u ticks)\r\n", gate_ticks);
 
 	if ((init_mode && (wupCnt == avgIntInit)) || (!init_mode && (wupCnt == avgInt)))
 	{
 		uint32_t avg = init_mode ? counter_meas / avgIntInit : counter_meas / avgInt;
 
+		last_avg = avg;
+
 		if (init_mode)
 		{
 			UART_PUTF("Init: Save avg %u as dry threshold.\r\n", avg);
@@ -285,10 +405,10 @@ bool measure_humidity(void)
 		counter_meas = 0;
 	}
 
-	_delay_ms(10);
 	return res;
 }
 
+
 void send_prepared_message(void)
 {
 	inc_packetcounter();
@@ -300,6 +420,8 @@ void send_prepared_message(void)
 	rfm12_tick(); // send packet, and then WAIT SOME TIME BEFORE GOING TO SLEEP (otherwise packet would not be sent)
 
 	led_blink(200, 0, 1);
+
+	rfm12_listen_after_send(device_id, listen_window_ms, prepare_deviceinfo_status, &station_packetcounter);
 }
 
 ISR (INT1_vect)
@@ -323,8 +445,7 @@ int main(void)
 	sbi(TRIGGERPWR_DDR, TRIGGERPWR_PIN);
 
 	// read packetcounter, increase by cycle and write back
-	packetcounter = e2p_generic_get_packetcounter() + PACKET_COUNTER_WRITE_CYCLE;
-	e2p_generic_set_packetcounter(packetcounter);
+	init_packetcounter();
 
 	// read device id
 	device_id = e2p_generic_get_deviceid();
@@ -344,6 +465,11 @@ int main(void)
 	avgIntInit = e2p_soilmoisturemeter_get_averagingintervalinit();
 	avgInt = e2p_soilmoisturemeter_get_averaginginterval();
 	smoothing_percentage = e2p_soilmoisturemeter_get_smoothingpercentage();
+	listen_window_ms = e2p_soilmoisturemeter_get_listenwindowms();
+	if (listen_window_ms > LISTEN_WINDOW_MS_MAX) // set default value if never initialized
+	{
+		listen_window_ms = LISTEN_WINDOW_MS_DEFAULT;
+	}
 
 	osccal_init();
 
@@ -360,6 +486,7 @@ int main(void)
 	UART_PUTF ("Dry threshold: %u\r\n", dry_thr);
 	UART_PUTF ("Min value: %u\r\n", counter_min);
 	UART_PUTF ("Smoothing percentage: %u\r\n", smoothing_percentage);
+	UART_PUTF ("Listen window: %ums\r\n", listen_window_ms);
 
 	adc_init();
 
@@ -400,6 +527,7 @@ int main(void)
 	led_blink(500, 500, 3);
 
 	rfm12_init();
+	rfm12_rx_off(); // only listen after sending
 	wakeup_sec = init_wakeup();
 
 	// init interrupt for button (falling edge)
@@ -408,7 +536,7 @@ int main(void)
 
 	sei();
 
-	prepare_deviceinfo_status();
+	prepare_deviceinfo_status(false);
 	send_prepared_message();
 	_delay_ms(1000);
 	prepare_battery_status();
@@ -465,7 +593,7 @@ int main(void)
 				if (version_status_cycle == 0)
 				{
 					version_status_cycle = SEND_VERSION_STATUS_CYCLE;
-					prepare_deviceinfo_status();
+					prepare_deviceinfo_status(false);
 				}
 				else if (battery_status_cycle == 0)
 				{
@@ -122,8 +122,7 @@ int main(void)
 	check_eeprom_compatibility(DEVICETYPE_THERMOSTAT);
 	
 	// read packetcounter, increase by cycle and write back
-	packetcounter = e2p_generic_get_packetcounter() + PACKET_COUNTER_WRITE_CYCLE;
-	e2p_generic_set_packetcounter(packetcounter);
+	init_packetcounter();
 
 	// read device specific config
 
@@ -19,6 +19,11 @@
 #include "e2p_access.h"
 #include "util_generic.h"
 
+#if defined(E2P_ASYNC_WRITE) && !defined(UNITTEST) && !defined(SHC_HOST)
+#include <avr/interrupt.h>
+#include <string.h>
+#endif
+
 // #define MIN(X,Y) ((X) < (Y) ? (X) : (Y))
 
 #ifdef UNITTEST
@@ -27,16 +32,14 @@
 
 uint8_t e2p[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 255, 254, 253, 252, 251, 250, 249, 248 };
 
-uint8_t eeprom_read_byte(const uint8_t *_p)
+uint8_t hal_eeprom_read_byte(uint16_t addr)
 {
-	uint32_t p = (uint32_t)_p;
-	return e2p[p];
+	return e2p[addr];
 }
 
-void eeprom_write_byte(const uint8_t *_p, uint8_t byte)
+void hal_eeprom_write_byte(uint16_t addr, uint8_t val)
 {
-	uint32_t p = (uint32_t)_p;
-	e2p[p] = byte;
+	e2p[addr] = val;
 }
 
 void signal_error_state(void)
@@ -48,6 +51,49 @@ void signal_error_state(void)
 
 /* ---------- internal functions ---------- */
 
+// Optional RAM copy of a part of the EEPROM, see e2p_shadow_init.
+uint8_t * e2p_shadow = NULL;
+uint16_t e2p_shadow_start = 0;
+uint16_t e2p_shadow_bytes = 0;
+
+static inline bool e2p_in_shadow(uint16_t addr)
+{
+	return (uint16_t)(addr - e2p_shadow_start) < e2p_shadow_bytes;
+}
+
+// Read one byte from the RAM copy or from the EEPROM.
+uint8_t e2p_read_byte(uint16_t addr)
+{
+	if (e2p_in_shadow(addr))
+	{
+		return e2p_shadow[addr - e2p_shadow_start];
+	}
+
+	e2p_wait_async();
+	return hal_eeprom_read_byte(addr);
+}
+
+// Write one byte to the RAM copy and to the EEPROM, but only if it changed.
+void e2p_write_byte(uint16_t addr, uint8_t b)
+{
+	if (e2p_in_shadow(addr))
+	{
+		if (e2p_shadow[addr - e2p_shadow_start] == b)
+		{
+			return;
+		}
+
+		e2p_shadow[addr - e2p_shadow_start] = b;
+	}
+
+	e2p_wait_async();
+
+	if (hal_eeprom_read_byte(addr) != b)
+	{
+		hal_eeprom_write_byte(addr, b);
+	}
+}
+
 // Limit the value the pointer directs to between minval and maxval.
 void __limitUIntValue32(uint32_t *val, uint32_t minval, uint32_t maxval)
 {
@@ -109,7 +155,7 @@ uint32_t __eeprom_read_UIntValue32(uint16_t bit, uint16_t length, uint16_t max_b
 	while (length + bit > byres_read * 8)
 	{
 		shift = length + bit - byres_read * 8 - 8;
-		uint32_t zz = (NULL == array) ? eeprom_read_byte((uint8_t*)(byte + byres_read)) : array[byte + byres_read];
+		uint32_t zz = (NULL == array) ? e2p_read_byte(byte + byres_read) : array[byte + byres_read];
 
 		if (shift >= 0)
 		{
@@ -145,7 +191,7 @@ void __eeprom_write_bits(uint16_t bit, uint16_t length, uint8_t val, uint8_t * a
 	// if length is smaller than 8 bits, get the old value from eeprom
 	if (length < 8)
 	{
-		b = (NULL == array) ? eeprom_read_byte((uint8_t*)(byte + 0)) : array[byte];	
+		b = (NULL == array) ? e2p_read_byte(byte) : array[byte];	
 		b = __clear_bits(b, bit, length);
 	}
 	
@@ -154,7 +200,7 @@ void __eeprom_write_bits(uint16_t bit, uint16_t length, uint8_t val, uint8_t * a
 
 	if (NULL == array)
 	{
-		eeprom_write_byte((uint8_t*)(byte + 0), b);
+		e2p_write_byte(byte, b);
 	}
 	else
 	{
@@ -164,6 +210,41 @@ void __eeprom_write_bits(uint16_t bit, uint16_t length, uint8_t val, uint8_t * a
 
 /* ---------- exported functions ---------- */
 
+// Use the given buffer as RAM copy of the EEPROM bytes [start, start + bytes) and load it.
+// All reads of this area are then done from RAM, writes are done to RAM and to the EEPROM.
+// Call with bytes = 0 to disable the RAM copy again.
+void e2p_shadow_init(uint8_t * shadow, uint16_t start, uint16_t bytes)
+{
+	e2p_shadow_bytes = 0;
+	e2p_read_block(shadow, start, bytes);
+
+	e2p_shadow = shadow;
+	e2p_shadow_start = start;
+	e2p_shadow_bytes = bytes;
+}
+
+// Read a block of bytes, used for ByteArray values.
+void e2p_read_block(void * dst, uint16_t addr, uint16_t len)
+{
+	uint8_t * d = dst;
+
+	while (len--)
+	{
+		*d++ = e2p_read_byte(addr++);
+	}
+}
+
+// Write a block of bytes, used for ByteArray values. Only changed bytes are written.
+void e2p_write_block(const void * src, uint16_t addr, uint16_t len)
+{
+	const uint8_t * s = src;
+
+	while (len--)
+	{
+		e2p_write_byte(addr++, *s++);
+	}
+}
+
 // Read UIntValue from EEPROM and limit it into the given boundaries.
 uint32_t _eeprom_read_UIntValue32(uint16_t bit, uint16_t length, uint32_t minval, uint32_t maxval, uint16_t max_bits_for_type, uint8_t * array)
 {
@@ -228,3 +309,161 @@ void _eeprom_write_UIntValue(uint16_t bit, uint16_t length, uint32_t val, uint8_
 		src_start += len;
 	}
 }
+
+// Read the next length bits (max. 32) from the bit stream.
+uint32_t bitstream_read_bits(bitstream_t * bs, uint8_t length)
+{
+	uint32_t val = 0;
+
+	while (length)
+	{
+		uint8_t avail = 8 - bs->bit;
+		uint8_t len = MIN(length, avail);
+
+		val = (val << len) | ((*bs->pos >> (avail - len)) & ((1 << len) - 1));
+		length -= len;
+		bs->bit += len;
+
+		if (bs->bit == 8)
+		{
+			bs->bit = 0;
+			bs->pos++;
+		}
+	}
+
+	return val;
+}
+
+// Write the lowest length bits (max. 32) of val to the bit stream. Other bits within
+// the touched bytes are kept.
+void bitstream_write_bits(bitstream_t * bs, uint8_t length, uint32_t val)
+{
+	while (length)
+	{
+		uint8_t avail = 8 - bs->bit;
+		uint8_t len = MIN(length, avail);
+		uint8_t shift = avail - len;
+		uint8_t mask = ((1 << len) - 1) << shift;
+
+		length -= len;
+		*bs->pos = (*bs->pos & ~mask) | (((uint8_t)(val >> length) << shift) & mask);
+		bs->bit += len;
+
+		if (bs->bit == 8)
+		{
+			bs->bit = 0;
+			bs->pos++;
+		}
+	}
+}
+
+// Read UIntValue from the bit stream and limit it into the given boundaries.
+uint32_t bitstream_read_UIntValue32(bitstream_t * bs, uint8_t length, uint32_t minval, uint32_t maxval)
+{
+	uint32_t x = bitstream_read_bits(bs, length);
+
+	__limitUIntValue32(&x, minval, maxval);
+	return x;
+}
+
+// Read IntValue from the bit stream and limit it into the given boundaries.
+int32_t bitstream_read_IntValue32(bitstream_t * bs, uint8_t length, int32_t minval, int32_t maxval)
+{
+	uint32_t x = bitstream_read_bits(bs, length);
+
+	// If MSB is 1 (value is negative interpreted as signed int),
+	// set all higher bits also to 1.
+	if (((x >> (length - 1)) & 1) == 1)
+	{
+		x = x | ~(((uint32_t)1 << (length - 1)) - 1);
+	}
+
+	int32_t y = (int32_t)x;
+
+	__limitIntValue32(&y, minval, maxval);
+	return y;
+}
+
+/* ---------- writing in the background ---------- */
+
+#if defined(E2P_ASYNC_WRITE) && !defined(UNITTEST) && !defined(SHC_HOST)
+
+uint8_t e2p_async_buf[E2P_ASYNC_BUF_SIZE];
+uint16_t e2p_async_addr;
+uint8_t e2p_async_len;
+volatile uint8_t e2p_async_pos;
+
+// Write the next byte which differs from the EEPROM content and disable the interrupt
+// again when all bytes are written. The EEPROM has to be ready when this is called.
+static void e2p_async_next(void)
+{
+	while (e2p_async_pos < e2p_async_len)
+	{
+		uint8_t b = e2p_async_buf[e2p_async_pos];
+
+		EEAR = e2p_async_addr + e2p_async_pos;
+		e2p_async_pos++;
+
+		// read old value
+		EECR |= (1 << EERE);
+
+		if (EEDR != b)
+		{
+			EEDR = b;
+			EECR |= (1 << EEMPE);
+			EECR |= (1 << EEPE);
+			return;
+		}
+	}
+
+	EECR &= ~(1 << EERIE);
+}
+
+// The interrupt occurs as long as the EEPROM is ready and the interrupt is enabled.
+ISR(EE_READY_vect)
+{
+	e2p_async_next();
+}
+
+void e2p_wait_async(void)
+{
+	while (EECR & (1 << EERIE))
+	{
+		// continue writing without the interrupt if interrupts are disabled
+		if (!(SREG & (1 << SREG_I)) && !(EECR & (1 << EEPE)))
+		{
+			e2p_async_next();
+		}
+	}
+}
+
+void e2p_write_block_async(const uint8_t * src, uint16_t addr, uint8_t len)
+{
+	uint8_t i;
+
+	e2p_wait_async();
+
+	for (i = 0; i < len; i++)
+	{
+		if (e2p_in_shadow(addr + i))
+		{
+			e2p_shadow[addr + i - e2p_shadow_start] = src[i];
+		}
+	}
+
+	memcpy(e2p_async_buf, src, len);
+	e2p_async_addr = addr;
+	e2p_async_len = len;
+	e2p_async_pos = 0;
+
+	EECR |= (1 << EERIE);
+}
+
+#else
+
+void e2p_write_block_async(const uint8_t * src, uint16_t addr, uint8_t len)
+{
+	e2p_write_block(src, addr, len);
+}
+
+#endif
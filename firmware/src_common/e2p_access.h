@@ -19,16 +19,11 @@
 #ifndef E2P_ACCESS_H
 #define E2P_ACCESS_H
 
-#ifndef UNITTEST
-#include <avr/eeprom.h>
-#endif
-
 #include <stdint.h>
+#include "hal.h"
 
 #ifdef UNITTEST
 
-uint8_t eeprom_read_byte (const uint8_t *_p);
-void eeprom_write_byte (const uint8_t *_p, uint8_t byte);
 void signal_error_state(void);
 
 #endif
@@ -42,6 +37,15 @@ int32_t _eeprom_read_IntValue32(uint16_t bit, uint16_t length, int32_t minval, i
 
 void _eeprom_write_UIntValue(uint16_t bit, uint16_t length, uint32_t val, uint8_t * array);
 
+// Block access for ByteArray values and an optional RAM copy of a part of the EEPROM
+// (usually the used part of the device specific block), so that reading the configuration
+// in the main loop doesn't need an EEPROM access.
+uint8_t e2p_read_byte(uint16_t addr);
+void e2p_write_byte(uint16_t addr, uint8_t b);
+void e2p_read_block(void * dst, uint16_t addr, uint16_t len);
+void e2p_write_block(const void * src, uint16_t addr, uint16_t len);
+void e2p_shadow_init(uint8_t * shadow, uint16_t start, uint16_t bytes);
+
 // function wrappers for EEPROM access
 static inline uint8_t eeprom_read_UIntValue8(uint16_t bit, uint16_t length, uint32_t minval, uint32_t maxval)
 {
@@ -111,19 +115,22 @@ static inline void array_write_IntValue(uint16_t bit, uint16_t length, int32_t v
 }
 
 // Union for reinterpretation (not casting) of float as unit32_t and vice versa.
-union {
+// Used as local variable only, so the functions below are reentrant.
+typedef union {
     float floatVal;
     uint32_t uint32Val;
-  } float2uint32;
+  } float2uint32_t;
 
 static inline void array_write_FloatValue(uint16_t bit, float val, uint8_t * array)
 {
+	float2uint32_t float2uint32;
 	float2uint32.floatVal = val;
 	_eeprom_write_UIntValue(bit, 32, float2uint32.uint32Val, array);
 }
 
 static inline float array_read_FloatValue(uint16_t bit, uint8_t * array)
 {
+	float2uint32_t float2uint32;
 	float2uint32.uint32Val = _eeprom_read_UIntValue32(bit, 32, 0, UINT32_MAX, 32, array);
 	return float2uint32.floatVal;
 }
@@ -147,4 +154,84 @@ static inline void array_read_ByteArray(uint16_t bit, uint16_t lengthBytes, uint
 	}
 }
 
+// Cursor for reading / writing consecutive values from / to a byte array in one pass,
+// used by the generated functions to unpack / pack complete messages. Values are
+// stored MSB first, like with the array_read_* / array_write_* functions.
+typedef struct {
+	uint8_t * pos; // byte containing the next bit
+	uint8_t bit;   // next bit within this byte, 0 = MSB
+} bitstream_t;
+
+static inline void bitstream_init(bitstream_t * bs, uint8_t * array, uint16_t bit)
+{
+	bs->pos = array + bit / 8;
+	bs->bit = bit % 8;
+}
+
+static inline void bitstream_skip(bitstream_t * bs, uint16_t bits)
+{
+	bits += bs->bit;
+	bs->pos += bits / 8;
+	bs->bit = bits % 8;
+}
+
+uint32_t bitstream_read_bits(bitstream_t * bs, uint8_t length);
+void bitstream_write_bits(bitstream_t * bs, uint8_t length, uint32_t val);
+uint32_t bitstream_read_UIntValue32(bitstream_t * bs, uint8_t length, uint32_t minval, uint32_t maxval);
+int32_t bitstream_read_IntValue32(bitstream_t * bs, uint8_t length, int32_t minval, int32_t maxval);
+
+static inline void bitstream_write_IntValue(bitstream_t * bs, uint8_t length, int32_t val)
+{
+	// move the sign bit of the standard int type to the sign bit position of our variable-sized int type
+	bitstream_write_bits(bs, length,
+		(((val >> 31) & 1) << (length - 1)) | (val & (((uint32_t)1 << (length - 1)) - 1)));
+}
+
+static inline float bitstream_read_FloatValue(bitstream_t * bs)
+{
+	float2uint32_t float2uint32;
+	float2uint32.uint32Val = bitstream_read_bits(bs, 32);
+	return float2uint32.floatVal;
+}
+
+static inline void bitstream_write_FloatValue(bitstream_t * bs, float val)
+{
+	float2uint32_t float2uint32;
+	float2uint32.floatVal = val;
+	bitstream_write_bits(bs, 32, float2uint32.uint32Val);
+}
+
+static inline void bitstream_read_ByteArray(bitstream_t * bs, uint16_t lengthBytes, uint8_t * dst)
+{
+	while (lengthBytes--)
+	{
+		*dst++ = (uint8_t)bitstream_read_bits(bs, 8);
+	}
+}
+
+static inline void bitstream_write_ByteArray(bitstream_t * bs, uint16_t lengthBytes, const uint8_t * src)
+{
+	while (lengthBytes--)
+	{
+		bitstream_write_bits(bs, 8, *src++);
+	}
+}
+
+// Size of the buffer for writing to the EEPROM in the background.
+#define E2P_ASYNC_BUF_SIZE 4
+
+// Write a block of max. E2P_ASYNC_BUF_SIZE bytes to the EEPROM. Only bytes which differ from
+// the EEPROM content are written. If E2P_ASYNC_WRITE is defined, the bytes are written in the
+// background by the EEPROM ready interrupt, otherwise the function returns when they are written.
+void e2p_write_block_async(const uint8_t * src, uint16_t addr, uint8_t len);
+
+#if defined(E2P_ASYNC_WRITE) && !defined(UNITTEST) && !defined(SHC_HOST)
+// Wait until a write in the background is finished. The functions in this file do this
+// automatically, but it has to be called before accessing the EEPROM directly (e.g. with
+// eeprom_read_block) and before going to power down mode, which the interrupt can't wake up from.
+void e2p_wait_async(void);
+#else
+static inline void e2p_wait_async(void) {}
+#endif
+
 #endif // E2P_ACCESS
@@ -55,14 +55,14 @@ static inline uint8_t e2p_basestation_get_aeskeycount(void)
 // Offset: 520, length bits 256
 static inline void e2p_basestation_set_aeskey(uint8_t index, void *src)
 {
-  eeprom_write_block(src, (uint8_t *)((520 + (uint16_t)index * 256) / 8), 32);
+  e2p_write_block(src, (520 + (uint16_t)index * 256) / 8, 32);
 }
 
 // Get AesKey (ByteArray)
 // Offset: 520, length bits 256
 static inline void e2p_basestation_get_aeskey(uint8_t index, void *dst)
 {
-  eeprom_read_block(dst, (uint8_t *)((520 + (uint16_t)index * 256) / 8), 32);
+  e2p_read_block(dst, (520 + (uint16_t)index * 256) / 8, 32);
 }
 
 // UartBaudRate (EnumValue)
@@ -270,14 +270,14 @@ static inline uint8_t e2p_controller_get_autobacklighttimesec(void)
 // Offset: 624, length bits 960
 static inline void e2p_controller_set_menuoption(uint8_t index, void *src)
 {
-  eeprom_write_block(src, (uint8_t *)((624 + (uint16_t)index * 960) / 8), 120);
+  e2p_write_block(src, (624 + (uint16_t)index * 960) / 8, 120);
 }
 
 // Get MenuOption (ByteArray)
 // Offset: 624, length bits 960
 static inline void e2p_controller_get_menuoption(uint8_t index, void *dst)
 {
-  eeprom_read_block(dst, (uint8_t *)((624 + (uint16_t)index * 960) / 8), 120);
+  e2p_read_block(dst, (624 + (uint16_t)index * 960) / 8, 120);
 }
 
 // MenuOptionIndex (UIntValue[16])
@@ -304,14 +304,14 @@ static inline uint8_t e2p_controller_get_menuoptionindex(uint8_t index)
 // Offset: 16112, length bits 160
 static inline void e2p_controller_set_menutextsendoptions(void *src)
 {
-  eeprom_write_block(src, (uint8_t *)((16112) / 8), 20);
+  e2p_write_block(src, (16112) / 8, 20);
 }
 
 // Get MenuTextSendOptions (ByteArray)
 // Offset: 16112, length bits 160
 static inline void e2p_controller_get_menutextsendoptions(void *dst)
 {
-  eeprom_read_block(dst, (uint8_t *)((16112) / 8), 20);
+  e2p_read_block(dst, (16112) / 8, 20);
 }
 
 // MenuTextSuccess (ByteArray)
@@ -321,14 +321,14 @@ static inline void e2p_controller_get_menutextsendoptions(void *dst)
 // Offset: 16272, length bits 160
 static inline void e2p_controller_set_menutextsuccess(void *src)
 {
-  eeprom_write_block(src, (uint8_t *)((16272) / 8), 20);
+  e2p_write_block(src, (16272) / 8, 20);
 }
 
 // Get MenuTextSuccess (ByteArray)
 // Offset: 16272, length bits 160
 static inline void e2p_controller_get_menutextsuccess(void *dst)
 {
-  eeprom_read_block(dst, (uint8_t *)((16272) / 8), 20);
+  e2p_read_block(dst, (16272) / 8, 20);
 }
 
 // MenuTextFailed (ByteArray)
@@ -338,14 +338,14 @@ static inline void e2p_controller_get_menutextsuccess(void *dst)
 // Offset: 16432, length bits 160
 static inline void e2p_controller_set_menutextfailed(void *src)
 {
-  eeprom_write_block(src, (uint8_t *)((16432) / 8), 20);
+  e2p_write_block(src, (16432) / 8, 20);
 }
 
 // Get MenuTextFailed (ByteArray)
 // Offset: 16432, length bits 160
 static inline void e2p_controller_get_menutextfailed(void *dst)
 {
-  eeprom_read_block(dst, (uint8_t *)((16432) / 8), 20);
+  e2p_read_block(dst, (16432) / 8, 20);
 }
 
 // MenuTextCancel (ByteArray)
@@ -355,14 +355,14 @@ static inline void e2p_controller_get_menutextfailed(void *dst)
 // Offset: 16592, length bits 160
 static inline void e2p_controller_set_menutextcancel(void *src)
 {
-  eeprom_write_block(src, (uint8_t *)((16592) / 8), 20);
+  e2p_write_block(src, (16592) / 8, 20);
 }
 
 // Get MenuTextCancel (ByteArray)
 // Offset: 16592, length bits 160
 static inline void e2p_controller_get_menutextcancel(void *dst)
 {
-  eeprom_read_block(dst, (uint8_t *)((16592) / 8), 20);
+  e2p_read_block(dst, (16592) / 8, 20);
 }
 
 // Reserved area with 16016 bits
@@ -55,14 +55,14 @@ static inline uint32_t e2p_dimmer_get_basestationpacketcounter(void)
 // Offset: 536, length bits 808
 static inline void e2p_dimmer_set_brightnesstranslationtable(void *src)
 {
-  eeprom_write_block(src, (uint8_t *)((536) / 8), 101);
+  e2p_write_block(src, (536) / 8, 101);
 }
 
 // Get BrightnessTranslationTable (ByteArray)
 // Offset: 536, length bits 808
 static inline void e2p_dimmer_get_brightnesstranslationtable(void *dst)
 {
-  eeprom_read_block(dst, (uint8_t *)((536) / 8), 101);
+  e2p_read_block(dst, (536) / 8, 101);
 }
 
 // TransceiverWatchdogTimeout (UIntValue)
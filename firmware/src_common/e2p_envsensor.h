@@ -707,8 +707,25 @@ static inline uint16_t e2p_envsensor_get_analoginputtriggerhysteresis(uint8_t in
   return eeprom_read_UIntValue16(2208 + (uint16_t)index * 16, 16, 0, 1100);
 }
 
-// Reserved area with 272 bits
-// Offset: 2288
+// ListenWindowMs (UIntValue)
+// Description: Time in ms the receiver stays on after sending. The base station sends queued requests for this device as soon as it receives a packet from it, so they have to arrive within this time. Set 0 to disable receiving requests (saves battery). The max. value is 1000. Bigger values (like 65535 of a never initialized EEPROM) select the default of 250.
+
+// Set ListenWindowMs (UIntValue)
+// Offset: 2288, length bits 16, min val 0, max val 65535
+static inline void e2p_envsensor_set_listenwindowms(uint16_t val)
+{
+  eeprom_write_UIntValue(2288, 16, val);
+}
+
+// Get ListenWindowMs (UIntValue)
+// Offset: 2288, length bits 16, min val 0, max val 65535
+static inline uint16_t e2p_envsensor_get_listenwindowms(void)
+{
+  return eeprom_read_UIntValue16(2288, 16, 0, 65535);
+}
+
+// Reserved area with 256 bits
+// Offset: 2304
 
 // Reserved area with 5632 bits
 // Offset: 2560
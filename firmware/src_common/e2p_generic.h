@@ -68,9 +68,26 @@ static inline uint32_t e2p_generic_get_packetcounter(void)
   return eeprom_read_UIntValue32(80, 24, 0, 16777215);
 }
 
-// Reserved area with 152 bits
+// Reserved area with 24 bits
 // Offset: 104
 
+// PacketCounterRing (ByteArray)
+// Description: Ring of 3 slots (5 bytes each, the last byte is unused) the PacketCounter is written to alternately to distribute the EEPROM wear. Each slot holds the 24 bit PacketCounter (LSB first), a sequence number increased with every write and a CRC8 over both. The valid slot with the newest sequence number is used at startup. The PacketCounter field above is used instead if it is higher or if no slot is valid yet. Set all bytes to 0 to start with the PacketCounter field.
+
+// Set PacketCounterRing (ByteArray)
+// Offset: 128, length bits 128
+static inline void e2p_generic_set_packetcounterring(void *src)
+{
+  e2p_write_block(src, (128) / 8, 16);
+}
+
+// Get PacketCounterRing (ByteArray)
+// Offset: 128, length bits 128
+static inline void e2p_generic_get_packetcounterring(void *dst)
+{
+  e2p_read_block(dst, (128) / 8, 16);
+}
+
 // AesKey (ByteArray)
 // Description: This key is used to encrypt packets before sending and also used as primary key to decrypt packets. Special devices may have additional keys in their device specific block.
 
@@ -78,14 +95,14 @@ static inline uint32_t e2p_generic_get_packetcounter(void)
 // Offset: 256, length bits 256
 static inline void e2p_generic_set_aeskey(void *src)
 {
-  eeprom_write_block(src, (uint8_t *)((256) / 8), 32);
+  e2p_write_block(src, (256) / 8, 32);
 }
 
 // Get AesKey (ByteArray)
 // Offset: 256, length bits 256
 static inline void e2p_generic_get_aeskey(void *dst)
 {
-  eeprom_read_block(dst, (uint8_t *)((256) / 8), 32);
+  e2p_read_block(dst, (256) / 8, 32);
 }
 
 
@@ -82,8 +82,35 @@ static inline uint8_t e2p_rgbdimmer_get_transceiverwatchdogtimeout(void)
   return eeprom_read_UIntValue8(544, 8, 0, 255);
 }
 
-// Reserved area with 7640 bits
-// Offset: 552
+// GammaCurve (EnumValue)
+// Description: The curve to translate the color values to the LED brightness. Smarthomatic is the curve used by former firmware versions. The other curves are gamma curves with the given exponent (1.8, 2.2, 2.8). A higher exponent results in a darker display of the middle color values.
+
+#ifndef _ENUM_GammaCurve
+#define _ENUM_GammaCurve
+typedef enum {
+  GAMMACURVE_SMARTHOMATIC = 0,
+  GAMMACURVE_GAMMA18 = 1,
+  GAMMACURVE_GAMMA22 = 2,
+  GAMMACURVE_GAMMA28 = 3
+} GammaCurveEnum;
+#endif /* _ENUM_GammaCurve */
+
+// Set GammaCurve (EnumValue)
+// Offset: 552, length bits 8
+static inline void e2p_rgbdimmer_set_gammacurve(GammaCurveEnum val)
+{
+  eeprom_write_UIntValue(552, 8, val);
+}
+
+// Get GammaCurve (EnumValue)
+// Offset: 552, length bits 8
+static inline GammaCurveEnum e2p_rgbdimmer_get_gammacurve(void)
+{
+  return eeprom_read_UIntValue8(552, 8, 0, 255);
+}
+
+// Reserved area with 7632 bits
+// Offset: 560
 
 
 #endif /* _E2P_RGBDIMMER_H */
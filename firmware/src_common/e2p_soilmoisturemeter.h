@@ -194,8 +194,25 @@ static inline uint8_t e2p_soilmoisturemeter_get_smoothingpercentage(void)
   return eeprom_read_UIntValue8(592, 8, 0, 30);
 }
 
-// Reserved area with 7592 bits
-// Offset: 600
+// ListenWindowMs (UIntValue)
+// Description: Time in ms the receiver stays on after sending. The base station sends queued requests for this device as soon as it receives a packet from it, so they have to arrive within this time. Set 0 to disable receiving requests (saves battery). The max. value is 1000. Bigger values (like 65535 of a never initialized EEPROM) select the default of 250.
+
+// Set ListenWindowMs (UIntValue)
+// Offset: 600, length bits 16, min val 0, max val 65535
+static inline void e2p_soilmoisturemeter_set_listenwindowms(uint16_t val)
+{
+  eeprom_write_UIntValue(600, 16, val);
+}
+
+// Get ListenWindowMs (UIntValue)
+// Offset: 600, length bits 16, min val 0, max val 65535
+static inline uint16_t e2p_soilmoisturemeter_get_listenwindowms(void)
+{
+  return eeprom_read_UIntValue16(600, 16, 0, 65535);
+}
+
+// Reserved area with 7576 bits
+// Offset: 616
 
 
 #endif /* _E2P_SOILMOISTUREMETER_H */
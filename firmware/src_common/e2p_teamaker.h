@@ -55,14 +55,14 @@ static inline uint32_t e2p_teamaker_get_basestationpacketcounter(void)
 // Offset: 536, length bits 256
 static inline void e2p_teamaker_set_startupconfirmationmessage(void *src)
 {
-  eeprom_write_block(src, (uint8_t *)((536) / 8), 32);
+  e2p_write_block(src, (536) / 8, 32);
 }
 
 // Get StartupConfirmationMessage (ByteArray)
 // Offset: 536, length bits 256
 static inline void e2p_teamaker_get_startupconfirmationmessage(void *dst)
 {
-  eeprom_read_block(dst, (uint8_t *)((536) / 8), 32);
+  e2p_read_block(dst, (536) / 8, 32);
 }
 
 // Reserved area with 1280 bits
@@ -92,14 +92,14 @@ static inline uint8_t e2p_teamaker_get_presetcount(void)
 // Offset: 2080, length bits 128
 static inline void e2p_teamaker_set_presetname(uint8_t index, void *src)
 {
-  eeprom_write_block(src, (uint8_t *)((2080 + (uint16_t)index * 128) / 8), 16);
+  e2p_write_block(src, (2080 + (uint16_t)index * 128) / 8, 16);
 }
 
 // Get PresetName (ByteArray)
 // Offset: 2080, length bits 128
 static inline void e2p_teamaker_get_presetname(uint8_t index, void *dst)
 {
-  eeprom_read_block(dst, (uint8_t *)((2080 + (uint16_t)index * 128) / 8), 16);
+  e2p_read_block(dst, (2080 + (uint16_t)index * 128) / 8, 16);
 }
 
 // HeatingTemperature (UIntValue[9])
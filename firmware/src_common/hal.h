@@ -0,0 +1,56 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2024 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Hardware abstraction layer (HAL).
+//
+// Code which should also run on a PC includes this file instead of the avr-libc
+// headers and uses the following functions instead of accessing the registers:
+//
+// Delays:      hal_delay_ms(ms), hal_delay_us(us)
+// Interrupts:  hal_irq_enable(), hal_irq_disable()
+// GPIO:        hal_port_t port = HAL_PORT(D);
+//              hal_gpio_output(port, pin), hal_gpio_input(port, pin, pullup),
+//              hal_gpio_write(port, pin, on), hal_gpio_read(port, pin),
+//              hal_gpio_output_state(port, pin)
+// UART:        hal_uart_init(ubrr, rx_irq), hal_uart_putc(c)
+//              Received bytes are passed to the handler HAL_UART_RX_ISR(c) { ... }
+//              (AVR: USART_RX_vect).
+// EEPROM:      hal_eeprom_read_byte(addr), hal_eeprom_write_byte(addr, val)
+// Sleep:       hal_power_down(bod_disable)
+// Reset:       hal_reset() (by watchdog), hal_reset_reason() (MCUSR bits)
+// Program memory: PROGMEM, PSTR, PGM_P, pgm_read_*, sprintf_P as in avr-libc
+//
+// The RFM12 is accessed by SPI within the rfm12 library. On the host, the library
+// is replaced as a whole by hal_linux_rfm12.c, which provides the same API.
+//
+// On the AVR, the functions are mapped to avr-libc by macros (hal_avr.h), so the
+// firmware is the same as when accessing the registers directly.
+// If SHC_HOST is defined, the firmware is built as Linux program and the functions
+// are implemented by hal_linux.c (see hal_linux.h). The unit test uses the host
+// definitions as well, but implements only the EEPROM functions.
+
+#ifndef _HAL_H
+#define _HAL_H
+
+#if defined(SHC_HOST) || defined(UNITTEST)
+#include "hal_linux.h"
+#else
+#include "hal_avr.h"
+#endif
+
+#endif /* _HAL_H */
@@ -0,0 +1,172 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2024 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// AVR implementation of the HAL (see hal.h). Don't include this file directly.
+// All functions are macros or inline functions, so with constant parameters the
+// compiler generates the same code as for direct register access.
+
+#ifndef _HAL_AVR_H
+#define _HAL_AVR_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <avr/eeprom.h>
+#include <avr/sleep.h>
+#include <avr/wdt.h>
+#include <util/delay.h>
+
+// ---------- delays ----------
+
+#define hal_delay_ms(ms) _delay_ms(ms)
+#define hal_delay_us(us) _delay_us(us)
+
+// ---------- interrupts ----------
+
+#define hal_irq_enable() sei()
+#define hal_irq_disable() cli()
+
+// ---------- GPIO ----------
+
+// A port is given by the address of its PINx register. DDRx and PORTx follow
+// at the next two addresses on all supported ATMegas.
+typedef volatile uint8_t * hal_port_t;
+
+#define HAL_PORT(x) _HAL_PORT(x)
+#define _HAL_PORT(x) (&PIN##x)
+
+static inline void hal_gpio_output(hal_port_t port, uint8_t pin)
+{
+	port[1] |= (1 << pin);
+}
+
+static inline void hal_gpio_input(hal_port_t port, uint8_t pin, bool pullup)
+{
+	port[1] &= ~(1 << pin);
+
+	if (pullup)
+		port[2] |= (1 << pin);
+	else
+		port[2] &= ~(1 << pin);
+}
+
+static inline void hal_gpio_write(hal_port_t port, uint8_t pin, bool on)
+{
+	if (on)
+		port[2] |= (1 << pin);
+	else
+		port[2] &= ~(1 << pin);
+}
+
+// Return the level of the pin.
+static inline bool hal_gpio_read(hal_port_t port, uint8_t pin)
+{
+	return (port[0] & (1 << pin)) ? true : false;
+}
+
+// Return the value last written with hal_gpio_write.
+static inline bool hal_gpio_output_state(hal_port_t port, uint8_t pin)
+{
+	return (port[2] & (1 << pin)) ? true : false;
+}
+
+// ---------- UART ----------
+
+static inline void hal_uart_init(uint16_t ubrr_val, bool rx_irq)
+{
+	PORTD |= 0x01;                          // switch on pull-up on RXD
+
+	UCSR0B |= (1 << TXEN0);                 // turn on UART TX
+	UCSR0C |= (1 << USBS0) | (3 << UCSZ00); // asynchronous mode 8N1
+	UCSR0B |= (1 << RXEN0 );                // turn on UART RX
+
+	UBRR0H = (uint8_t)(ubrr_val >> 8);
+	UBRR0L = (uint8_t)(ubrr_val & 0xFF);
+
+	if (rx_irq)
+	{
+		UCSR0B |= (1 << RXCIE0);            // activate rx IRQ
+	}
+}
+
+static inline void hal_uart_putc(char c)
+{
+	while (!(UCSR0A & (1<<UDRE0))); /* warten bis Senden moeglich                   */
+	UDR0 = c;                       /* schreibt das Zeichen x auf die Schnittstelle */
+}
+
+// Define the handler for received bytes, which is inlined into the UART interrupt.
+// Usage: HAL_UART_RX_ISR(c) { ... use c ... }
+#define HAL_UART_RX_ISR(c) \
+	static inline void hal_uart_rx_isr(uint8_t c); \
+	ISR(USART_RX_vect) { hal_uart_rx_isr(UDR0); } \
+	static inline void hal_uart_rx_isr(uint8_t c)
+
+// ---------- EEPROM ----------
+
+static inline uint8_t hal_eeprom_read_byte(uint16_t addr)
+{
+	return eeprom_read_byte((const uint8_t *)addr);
+}
+
+static inline void hal_eeprom_write_byte(uint16_t addr, uint8_t val)
+{
+	eeprom_write_byte((uint8_t *)addr, val);
+}
+
+// ---------- sleep ----------
+
+// Go to power down mode until an interrupt wakes up the MCU.
+// Disable BOD according recommended procedure in sleep.h if selected.
+static inline void hal_power_down(bool bod_disable)
+{
+	set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+	cli();
+	sleep_enable();
+
+// ATMega329 (thermostat) does not support BOD disable.
+#if ! defined (__AVR_ATmega329__)
+	if (bod_disable)
+	{
+		sleep_bod_disable();
+	}
+#endif
+
+	sei();
+	sleep_cpu();
+	sleep_disable();
+	sei();
+}
+
+// ---------- reset ----------
+
+// Reset the ATMega by enabling the watchdog and waiting infinitely by purpose.
+static inline void hal_reset(void)
+{
+	wdt_enable(WDTO_15MS);
+
+	while (1)
+	{ }
+}
+
+// MCUSR bits PORF, EXTRF, BORF and WDRF tell the reason of the last reset.
+#define hal_reset_reason() MCUSR
+
+#endif /* _HAL_AVR_H */
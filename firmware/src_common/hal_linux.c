@@ -0,0 +1,600 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2024 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Linux implementation of the HAL. See hal_linux.h for a description.
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <termios.h>
+#include <stdarg.h>
+
+#include "hal.h"
+
+// The largest EEPROM of the supported ATMegas (ATMega1284P).
+#define EEPROM_SIZE 4096
+
+#define MAX_IRQ 4
+
+static struct
+{
+	// virtual clock in us, and the real time it started (at SHC_SPEED)
+	uint64_t virtual_us;
+	struct timespec start;
+	double speed;
+	uint64_t run_us;
+
+	bool irq_enabled;
+	bool in_isr;
+	struct pollfd irq_fd[MAX_IRQ];
+	void (*irq_isr[MAX_IRQ])(void);
+	uint8_t irq_count;
+
+	uint8_t ddr[HAL_PORT_COUNT];
+	uint8_t port[HAL_PORT_COUNT];
+	uint8_t input_set[HAL_PORT_COUNT]; // pins which are driven by hal_linux_gpio_set_input
+	uint8_t input_val[HAL_PORT_COUNT];
+	bool trace_gpio;
+
+	uint8_t eeprom[EEPROM_SIZE];
+	int eeprom_fd;
+
+	int uart_in;
+	int uart_out;
+	uint8_t uart_irq;
+	char uart_link[256];
+	uint32_t uart_byte_us; // time to transfer one byte at the configured baud rate
+	uint64_t uart_rx_us;   // virtual time up to which bytes were received
+	char uart_buf[4096];   // output buffer, written at the end of each line
+	uint16_t uart_buf_len;
+	uint32_t uart_dropped;
+
+	uint8_t reset_reason;
+	char ** argv;
+} hal = { .uart_in = -1, .uart_out = -1, .eeprom_fd = -1 };
+
+static uint64_t real_us(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)(now.tv_sec - hal.start.tv_sec) * 1000000 + (now.tv_nsec - hal.start.tv_nsec) / 1000;
+}
+
+static void uart_flush(void)
+{
+	uint16_t pos = 0;
+
+	while (pos < hal.uart_buf_len)
+	{
+		ssize_t n = write(hal.uart_out, hal.uart_buf + pos, hal.uart_buf_len - pos);
+
+		if (n < 0)
+		{
+			if (errno == EINTR)
+				continue;
+
+			// nobody reads the pty (EAGAIN) or it is closed: the data is lost as on a real UART
+			hal.uart_dropped += hal.uart_buf_len - pos;
+			break;
+		}
+
+		pos += n;
+	}
+
+	hal.uart_buf_len = 0;
+}
+
+static void hal_linux_exit(void)
+{
+	if (hal.uart_out >= 0)
+	{
+		uart_flush();
+	}
+
+	if (hal.uart_link[0])
+	{
+		unlink(hal.uart_link);
+	}
+
+	fprintf(stderr, "HAL: exit after %.3fs virtual time, %.3fs real time",
+		hal.virtual_us / 1e6, real_us() / 1e6);
+
+	if (hal.uart_dropped)
+	{
+		fprintf(stderr, ", %u UART bytes dropped", hal.uart_dropped);
+	}
+
+	fprintf(stderr, "\n");
+}
+
+static void signal_exit(int sig)
+{
+	exit(0);
+}
+
+// Called before main (glibc passes the program arguments to constructors) and before
+// the constructors of the firmware, which may use the HAL (e.g. wdt_init).
+static void __attribute__((constructor(101))) hal_linux_init(int argc, char ** argv)
+{
+	const char * s;
+
+	hal.argv = argv;
+	clock_gettime(CLOCK_MONOTONIC, &hal.start);
+
+	s = getenv("SHC_SPEED");
+	hal.speed = s ? atof(s) : 1.0;
+
+	s = getenv("SHC_RUN_MS");
+	hal.run_us = s ? (uint64_t)atol(s) * 1000 : 0;
+
+	s = getenv("SHC_MCUSR");
+	hal.reset_reason = s ? atoi(s) : (1 << PORF);
+
+	hal.trace_gpio = getenv("SHC_TRACE_GPIO") != NULL;
+
+	// an empty EEPROM is read as 0xff
+	memset(hal.eeprom, 0xff, sizeof(hal.eeprom));
+	s = getenv("SHC_EEPROM");
+
+	if (s)
+	{
+		hal.eeprom_fd = open(s, O_RDWR | O_CLOEXEC);
+
+		if (hal.eeprom_fd < 0)
+		{
+			perror(s);
+			exit(1);
+		}
+
+		if (read(hal.eeprom_fd, hal.eeprom, sizeof(hal.eeprom)) < 0)
+		{
+			perror(s);
+			exit(1);
+		}
+	}
+	else
+	{
+		fprintf(stderr, "HAL: SHC_EEPROM not set, using an empty EEPROM\n");
+	}
+
+	signal(SIGINT, signal_exit);
+	signal(SIGTERM, signal_exit);
+	signal(SIGPIPE, SIG_IGN);
+	atexit(hal_linux_exit);
+}
+
+/* ---------- program memory ---------- */
+
+// The firmware prints 32 bit values with "%lu" or "%lx". Remove the "l" length
+// modifier, so that they are printed as int, which is 32 bits wide here as well.
+int hal_linux_sprintf_P(char * buf, const char * fmt, ...)
+{
+	char f[256];
+	uint16_t i = 0;
+	bool conv = false;
+	va_list ap;
+	int res;
+
+	for (; *fmt && (i < sizeof(f) - 1); fmt++)
+	{
+		if (conv && (*fmt == 'l'))
+		{
+			continue;
+		}
+
+		if (*fmt == '%')
+		{
+			conv = !conv;
+		}
+		else if (conv && strchr("diouxXcsp", *fmt))
+		{
+			conv = false;
+		}
+
+		f[i++] = *fmt;
+	}
+
+	f[i] = 0;
+
+	va_start(ap, fmt);
+	res = vsprintf(buf, f, ap);
+	va_end(ap);
+
+	return res;
+}
+
+/* ---------- interrupts ---------- */
+
+void hal_irq_enable(void)
+{
+	hal.irq_enabled = true;
+}
+
+void hal_irq_disable(void)
+{
+	hal.irq_enabled = false;
+}
+
+void hal_linux_add_irq(int fd, void (*isr)(void))
+{
+	if (hal.irq_count < MAX_IRQ)
+	{
+		hal.irq_fd[hal.irq_count].fd = fd;
+		hal.irq_fd[hal.irq_count].events = POLLIN;
+		hal.irq_isr[hal.irq_count] = isr;
+		hal.irq_count++;
+	}
+}
+
+// Wait max. timeout_ms (-1 = infinite) for one of the "interrupts" and call the
+// interrupt routines. As on the AVR, interrupts are disabled while they run.
+static bool handle_irqs(int timeout_ms)
+{
+	uint8_t i;
+	int n;
+
+	if (!hal.irq_enabled || hal.in_isr)
+	{
+		return false;
+	}
+
+	uart_flush();
+	n = poll(hal.irq_fd, hal.irq_count, timeout_ms);
+
+	if (n <= 0)
+	{
+		return false;
+	}
+
+	hal.in_isr = true;
+
+	for (i = 0; i < hal.irq_count; i++)
+	{
+		if (hal.irq_fd[i].revents & (POLLIN | POLLHUP | POLLERR))
+		{
+			hal.irq_isr[i]();
+		}
+	}
+
+	hal.in_isr = false;
+	return true;
+}
+
+/* ---------- delays and virtual clock ---------- */
+
+// Advance the virtual clock. Wait until the same real time passed (considering SHC_SPEED)
+// and handle the interrupts which occured meanwhile.
+static void advance(uint64_t us)
+{
+	hal.virtual_us += us;
+
+	if (hal.run_us && (hal.virtual_us >= hal.run_us))
+	{
+		exit(0);
+	}
+
+	if (hal.speed > 0)
+	{
+		uint64_t target = hal.virtual_us / hal.speed;
+		uint64_t now = real_us();
+
+		if (target > now)
+		{
+			struct timespec ts = { (target - now) / 1000000, ((target - now) % 1000000) * 1000 };
+
+			uart_flush();
+			nanosleep(&ts, NULL);
+		}
+	}
+
+	handle_irqs(0);
+}
+
+void hal_delay_ms(double ms)
+{
+	advance(ms * 1000);
+}
+
+void hal_delay_us(double us)
+{
+	advance(us);
+}
+
+uint32_t hal_linux_millis(void)
+{
+	return hal.virtual_us / 1000;
+}
+
+/* ---------- GPIO ---------- */
+
+static void trace_gpio(hal_port_t port, uint8_t pin, bool on)
+{
+	if (hal.trace_gpio)
+	{
+		fprintf(stderr, "%10.3f GPIO P%c%u = %u\n", hal.virtual_us / 1e6, 'A' + port, pin, on);
+	}
+}
+
+void hal_gpio_output(hal_port_t port, uint8_t pin)
+{
+	hal.ddr[port] |= (1 << pin);
+}
+
+void hal_gpio_input(hal_port_t port, uint8_t pin, bool pullup)
+{
+	hal.ddr[port] &= ~(1 << pin);
+
+	if (pullup)
+		hal.port[port] |= (1 << pin);
+	else
+		hal.port[port] &= ~(1 << pin);
+}
+
+void hal_gpio_write(hal_port_t port, uint8_t pin, bool on)
+{
+	bool old = hal_gpio_output_state(port, pin);
+
+	if (on)
+		hal.port[port] |= (1 << pin);
+	else
+		hal.port[port] &= ~(1 << pin);
+
+	if ((old != on) && (hal.ddr[port] & (1 << pin)))
+	{
+		trace_gpio(port, pin, on);
+	}
+}
+
+// Outputs have the written level, inputs the level set by hal_linux_gpio_set_input or
+// the level of the pull-up.
+bool hal_gpio_read(hal_port_t port, uint8_t pin)
+{
+	uint8_t mask = 1 << pin;
+
+	if (!(hal.ddr[port] & mask) && (hal.input_set[port] & mask))
+	{
+		return (hal.input_val[port] & mask) ? true : false;
+	}
+
+	return (hal.port[port] & mask) ? true : false;
+}
+
+bool hal_gpio_output_state(hal_port_t port, uint8_t pin)
+{
+	return (hal.port[port] & (1 << pin)) ? true : false;
+}
+
+void hal_linux_gpio_set_input(hal_port_t port, uint8_t pin, bool on)
+{
+	hal.input_set[port] |= (1 << pin);
+
+	if (on)
+		hal.input_val[port] |= (1 << pin);
+	else
+		hal.input_val[port] &= ~(1 << pin);
+}
+
+/* ---------- ADC ---------- */
+
+uint16_t hal_adc_read(uint8_t channel)
+{
+	if (channel == 14)
+	{
+		return (uint32_t)1100 * 1024 / 3000;
+	}
+
+	return 0;
+}
+
+/* ---------- UART ---------- */
+
+// Receive the bytes which could have been transferred since the last call at the configured
+// baud rate. The rest stays in the pty (or pipe) for later.
+static void uart_isr(void)
+{
+	uint8_t buf[256];
+	uint64_t count = (hal.virtual_us - hal.uart_rx_us) / hal.uart_byte_us;
+	ssize_t n, i;
+
+	if (count == 0)
+	{
+		return;
+	}
+
+	n = read(hal.uart_in, buf, count < sizeof(buf) ? count : sizeof(buf));
+
+	if ((n == 0) || ((n < 0) && (errno != EAGAIN) && (errno != EINTR)))
+	{
+		// end of input, stop polling it
+		hal.irq_fd[hal.uart_irq].fd = -1;
+		return;
+	}
+
+	if (n < 0)
+	{
+		return;
+	}
+
+	// an idle line doesn't allow to receive more bytes later
+	hal.uart_rx_us = ((uint64_t)n < count) ? hal.virtual_us : hal.uart_rx_us + n * hal.uart_byte_us;
+
+	for (i = 0; i < n; i++)
+	{
+		hal_uart_rx_isr(buf[i]);
+	}
+}
+
+// Create a pseudo terminal. The program keeps the slave side open itself, so that writing
+// doesn't fail when no other program has opened it.
+static void uart_open_pty(const char * link)
+{
+	struct termios tio;
+	int slave;
+
+	hal.uart_in = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+
+	if ((hal.uart_in < 0) || grantpt(hal.uart_in) || unlockpt(hal.uart_in))
+	{
+		perror("posix_openpt");
+		exit(1);
+	}
+
+	slave = open(ptsname(hal.uart_in), O_RDWR | O_NOCTTY | O_CLOEXEC);
+
+	if ((slave < 0) || tcgetattr(slave, &tio))
+	{
+		perror(ptsname(hal.uart_in));
+		exit(1);
+	}
+
+	cfmakeraw(&tio);
+	tcsetattr(slave, TCSANOW, &tio);
+
+	hal.uart_out = hal.uart_in;
+
+	unlink(link);
+
+	if (symlink(ptsname(hal.uart_in), link))
+	{
+		perror(link);
+		exit(1);
+	}
+
+	strncpy(hal.uart_link, link, sizeof(hal.uart_link) - 1);
+	fprintf(stderr, "HAL: UART is %s (%s)\n", ptsname(hal.uart_in), link);
+}
+
+void hal_uart_init(uint16_t ubrr_val, bool rx_irq)
+{
+	const char * link = getenv("SHC_UART");
+
+	if (hal.uart_out < 0)
+	{
+		if (link)
+		{
+			uart_open_pty(link);
+		}
+		else
+		{
+			hal.uart_in = STDIN_FILENO;
+			hal.uart_out = STDOUT_FILENO;
+			fcntl(hal.uart_in, F_SETFL, fcntl(hal.uart_in, F_GETFL) | O_NONBLOCK);
+		}
+	}
+
+	// 10 bits per byte (8N1)
+	hal.uart_byte_us = 10UL * 1000000 / (F_CPU / (16UL * (ubrr_val + 1)));
+	hal.uart_rx_us = hal.virtual_us;
+
+	if (rx_irq)
+	{
+		hal.uart_irq = hal.irq_count;
+		hal_linux_add_irq(hal.uart_in, uart_isr);
+	}
+}
+
+// Sending a byte takes its time, but as on the AVR, the program only waits for the
+// previous byte. The output is written line by line.
+void hal_uart_putc(char c)
+{
+	hal.virtual_us += hal.uart_byte_us;
+	hal.uart_buf[hal.uart_buf_len++] = c;
+
+	if ((c == '\n') || (hal.uart_buf_len == sizeof(hal.uart_buf)))
+	{
+		uart_flush();
+	}
+}
+
+// Weak default for firmwares without UART RX.
+void __attribute__((weak)) hal_uart_rx_isr(uint8_t c)
+{
+}
+
+/* ---------- EEPROM ---------- */
+
+uint8_t hal_eeprom_read_byte(uint16_t addr)
+{
+	return addr < EEPROM_SIZE ? hal.eeprom[addr] : 0xff;
+}
+
+void hal_eeprom_write_byte(uint16_t addr, uint8_t val)
+{
+	if (addr < EEPROM_SIZE)
+	{
+		hal.eeprom[addr] = val;
+
+		if ((hal.eeprom_fd >= 0) && (pwrite(hal.eeprom_fd, &val, 1, addr) != 1))
+		{
+			perror("EEPROM write");
+		}
+	}
+
+	// writing takes 3.3ms
+	hal.virtual_us += 3300;
+}
+
+/* ---------- sleep ---------- */
+
+// Wait for the next "interrupt". The virtual clock advances by the real time that passed.
+void hal_power_down(bool bod_disable)
+{
+	uint64_t t = real_us();
+
+	hal_irq_enable();
+
+	while (!handle_irqs(-1))
+	{
+		if (hal.irq_count == 0)
+		{
+			fprintf(stderr, "HAL: power down without wakeup source\n");
+			exit(1);
+		}
+	}
+
+	hal.virtual_us += (real_us() - t) * (hal.speed > 0 ? hal.speed : 1);
+}
+
+/* ---------- reset ---------- */
+
+void hal_reset(void)
+{
+	char buf[8];
+
+	fprintf(stderr, "HAL: watchdog reset\n");
+	hal_linux_exit();
+
+	sprintf(buf, "%u", 1 << WDRF);
+	setenv("SHC_MCUSR", buf, 1);
+	execv("/proc/self/exe", hal.argv);
+
+	perror("execv");
+	_exit(1);
+}
+
+uint8_t hal_reset_reason(void)
+{
+	return hal.reset_reason;
+}
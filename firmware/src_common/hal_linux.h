@@ -0,0 +1,131 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2024 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Linux implementation of the HAL (see hal.h). Don't include this file directly.
+//
+// The firmware runs as a normal, single threaded process:
+// - Time is a virtual clock, which is advanced by the delay functions. By default,
+//   the delays also take the same real time. With SHC_SPEED=n, the firmware runs
+//   n times faster, with SHC_SPEED=0 as fast as possible.
+// - "Interrupts" (received UART bytes and RFM12 packets) are only handled while the
+//   firmware waits in a delay or in hal_power_down, and only when enabled.
+// - The UART is a pseudo terminal. Its name is printed to stderr and a symlink to it is
+//   created at the path given in SHC_UART. Without SHC_UART, stdin/stdout are used.
+// - The EEPROM is the file given in SHC_EEPROM, which is written through.
+// - The RFM12 sends and receives packets over a local "air" bus, see hal_linux_rfm12.c.
+// - GPIO ports are simulated. Changes of output pins are logged to stderr if
+//   SHC_TRACE_GPIO is set. Inputs are high (pull-up) unless set by hal_linux_gpio_set_input.
+// - The run ends after SHC_RUN_MS milliseconds of virtual time, if given.
+
+#ifndef _HAL_LINUX_H
+#define _HAL_LINUX_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+// ---------- program memory ----------
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(void * const *)(addr))
+#define sprintf_P hal_linux_sprintf_P
+#define strlen_P strlen
+#define memcpy_P memcpy
+
+// sprintf for format strings written for the AVR, where long is 32 bits wide.
+int hal_linux_sprintf_P(char * buf, const char * fmt, ...);
+
+// ---------- delays and virtual clock ----------
+
+void hal_delay_ms(double ms);
+void hal_delay_us(double us);
+
+// Return the virtual time since start in ms.
+uint32_t hal_linux_millis(void);
+
+// ---------- interrupts ----------
+
+void hal_irq_enable(void);
+void hal_irq_disable(void);
+
+// Register an "interrupt" routine, which is called (with interrupts enabled) when
+// the file descriptor is readable.
+void hal_linux_add_irq(int fd, void (*isr)(void));
+
+// ---------- GPIO ----------
+
+typedef uint8_t hal_port_t;
+
+enum { HAL_PORT_A, HAL_PORT_B, HAL_PORT_C, HAL_PORT_D, HAL_PORT_COUNT };
+
+#define HAL_PORT(x) _HAL_PORT(x)
+#define _HAL_PORT(x) (HAL_PORT_##x)
+
+void hal_gpio_output(hal_port_t port, uint8_t pin);
+void hal_gpio_input(hal_port_t port, uint8_t pin, bool pullup);
+void hal_gpio_write(hal_port_t port, uint8_t pin, bool on);
+bool hal_gpio_read(hal_port_t port, uint8_t pin);
+bool hal_gpio_output_state(hal_port_t port, uint8_t pin);
+
+// Drive an input pin from outside (e.g. a button or a test).
+void hal_linux_gpio_set_input(hal_port_t port, uint8_t pin, bool on);
+
+// ---------- ADC ----------
+
+// Return the simulated ADC value of the channel. Channel 14 (internal 1.1V
+// reference measured against VCC) corresponds to a VCC of 3V.
+uint16_t hal_adc_read(uint8_t channel);
+
+// ---------- UART ----------
+
+void hal_uart_init(uint16_t ubrr_val, bool rx_irq);
+void hal_uart_putc(char c);
+
+// Handler for received bytes, defined by the firmware with HAL_UART_RX_ISR(c) { ... }.
+#define HAL_UART_RX_ISR(c) void hal_uart_rx_isr(uint8_t c)
+
+void hal_uart_rx_isr(uint8_t c);
+
+// ---------- EEPROM ----------
+
+uint8_t hal_eeprom_read_byte(uint16_t addr);
+void hal_eeprom_write_byte(uint16_t addr, uint8_t val);
+
+// ---------- sleep ----------
+
+void hal_power_down(bool bod_disable);
+
+// ---------- reset ----------
+
+// Bits of the MCUSR register.
+#define PORF 0
+#define EXTRF 1
+#define BORF 2
+#define WDRF 3
+
+// Restart the program. hal_reset_reason() returns WDRF afterwards.
+void hal_reset(void);
+uint8_t hal_reset_reason(void);
+
+#endif /* _HAL_LINUX_H */
@@ -0,0 +1,194 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2024 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Portable C implementation of the AES-256 functions, which are implemented in
+// AVR assembler for the firmware (aes_*-asm.S). Used for the host build only.
+
+#include <string.h>
+
+#include "aes_types.h"
+#include "aes256_enc.h"
+#include "aes256_dec.h"
+#include "aes_keyschedule.h"
+
+static const uint8_t sbox[256] = {
+	0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+	0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+	0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+	0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+	0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+	0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+	0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+	0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+	0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+	0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+	0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+	0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+	0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+	0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+	0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+	0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+static uint8_t inv_sbox[256];
+
+// multiplication by x in GF(2^8)
+static uint8_t xtime(uint8_t a)
+{
+	return (a << 1) ^ ((a & 0x80) ? 0x1b : 0x00);
+}
+
+static uint8_t gf256mul(uint8_t a, uint8_t b)
+{
+	uint8_t r = 0;
+
+	while (b)
+	{
+		if (b & 1)
+			r ^= a;
+
+		a = xtime(a);
+		b >>= 1;
+	}
+
+	return r;
+}
+
+void aes256_init(const void *key, aes256_ctx_t *ctx)
+{
+	uint8_t * w = (uint8_t *)ctx->key;
+	uint8_t rcon = 1;
+	uint8_t i;
+
+	if (inv_sbox[0] == 0) // 0x52 after initialization
+	{
+		for (i = 0; i < 255; i++)
+			inv_sbox[sbox[i]] = i;
+
+		inv_sbox[sbox[255]] = 255;
+	}
+
+	// 15 round keys of 16 bytes, the first 32 bytes are the key itself
+	memcpy(w, key, 32);
+
+	for (i = 8; i < 60; i++)
+	{
+		uint8_t t[4];
+
+		memcpy(t, w + (i - 1) * 4, 4);
+
+		if (i % 8 == 0)
+		{
+			uint8_t t0 = t[0];
+
+			t[0] = sbox[t[1]] ^ rcon;
+			t[1] = sbox[t[2]];
+			t[2] = sbox[t[3]];
+			t[3] = sbox[t0];
+			rcon = xtime(rcon);
+		}
+		else if (i % 8 == 4)
+		{
+			t[0] = sbox[t[0]];
+			t[1] = sbox[t[1]];
+			t[2] = sbox[t[2]];
+			t[3] = sbox[t[3]];
+		}
+
+		w[i * 4 + 0] = w[(i - 8) * 4 + 0] ^ t[0];
+		w[i * 4 + 1] = w[(i - 8) * 4 + 1] ^ t[1];
+		w[i * 4 + 2] = w[(i - 8) * 4 + 2] ^ t[2];
+		w[i * 4 + 3] = w[(i - 8) * 4 + 3] ^ t[3];
+	}
+}
+
+static void add_round_key(uint8_t * s, const aes_roundkey_t * k)
+{
+	uint8_t i;
+
+	for (i = 0; i < 16; i++)
+		s[i] ^= k->ks[i];
+}
+
+void aes256_enc(void *buffer, aes256_ctx_t *ctx)
+{
+	uint8_t * s = buffer;
+	uint8_t t[16];
+	uint8_t round, i;
+
+	add_round_key(s, &ctx->key[0]);
+
+	for (round = 1; round <= 14; round++)
+	{
+		// SubBytes and ShiftRows (state is stored column by column)
+		for (i = 0; i < 16; i++)
+			t[i] = sbox[s[(i + 4 * (i % 4)) % 16]];
+
+		// MixColumns
+		if (round < 14)
+		{
+			for (i = 0; i < 16; i += 4)
+			{
+				uint8_t a = t[i], b = t[i + 1], c = t[i + 2], d = t[i + 3];
+				uint8_t e = a ^ b ^ c ^ d;
+
+				t[i]     ^= e ^ xtime(a ^ b);
+				t[i + 1] ^= e ^ xtime(b ^ c);
+				t[i + 2] ^= e ^ xtime(c ^ d);
+				t[i + 3] ^= e ^ xtime(d ^ a);
+			}
+		}
+
+		memcpy(s, t, 16);
+		add_round_key(s, &ctx->key[round]);
+	}
+}
+
+void aes256_dec(void *buffer, aes256_ctx_t *ctx)
+{
+	uint8_t * s = buffer;
+	uint8_t t[16];
+	uint8_t round, i;
+
+	for (round = 14; round >= 1; round--)
+	{
+		add_round_key(s, &ctx->key[round]);
+
+		// InvMixColumns
+		if (round < 14)
+		{
+			for (i = 0; i < 16; i += 4)
+			{
+				uint8_t a = s[i], b = s[i + 1], c = s[i + 2], d = s[i + 3];
+
+				s[i]     = gf256mul(a, 14) ^ gf256mul(b, 11) ^ gf256mul(c, 13) ^ gf256mul(d, 9);
+				s[i + 1] = gf256mul(a, 9) ^ gf256mul(b, 14) ^ gf256mul(c, 11) ^ gf256mul(d, 13);
+				s[i + 2] = gf256mul(a, 13) ^ gf256mul(b, 9) ^ gf256mul(c, 14) ^ gf256mul(d, 11);
+				s[i + 3] = gf256mul(a, 11) ^ gf256mul(b, 13) ^ gf256mul(c, 9) ^ gf256mul(d, 14);
+			}
+		}
+
+		// InvShiftRows and InvSubBytes
+		for (i = 0; i < 16; i++)
+			t[(i + 4 * (i % 4)) % 16] = inv_sbox[s[i]];
+
+		memcpy(s, t, 16);
+	}
+
+	add_round_key(s, &ctx->key[0]);
+}
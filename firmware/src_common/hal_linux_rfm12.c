@@ -0,0 +1,226 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2024 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Replacement of the rfm12 library for the host build. It provides the same API
+// (see rfm12/rfm12.h), but the packets are sent over a local "air" bus instead of
+// the RFM12: Every process binds a unix datagram socket in the directory given in
+// SHC_AIR (default /tmp/shc_air) and sends its packets to all other sockets there.
+// A datagram consists of the type byte followed by the data bytes.
+// The packets are not delayed or disturbed. As with the RFM12, a packet is lost if
+// both receive buffers are full.
+// The rfm12_config.h of the device is used, so it has to be in the include path.
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <dirent.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "hal.h"
+#include "rfm12_config.h"
+#include "../rfm12/rfm12.h"
+
+rf_tx_buffer_t rf_tx_buffer;
+
+#if !(RFM12_TRANSMIT_ONLY)
+rf_rx_buffer_t rf_rx_buffers[2];
+#endif
+
+rfm12_control_t ctrl;
+
+static int air_fd = -1;
+static struct sockaddr_un air_addr;
+static char air_dir[sizeof(air_addr.sun_path) - 16];
+
+#if (RFM12_NORETURNS)
+#define TXRETURN(x)
+#else
+#define TXRETURN(x) (x)
+#endif
+
+#if !(RFM12_TRANSMIT_ONLY)
+// Receive all waiting packets into the free receive buffers.
+static void rfm12_isr(void)
+{
+	uint8_t buf[1 + RFM12_RX_BUFFER_SIZE];
+	ssize_t n;
+
+	while ((n = recv(air_fd, buf, sizeof(buf), 0)) > 0)
+	{
+		if (ctrl.rf_buffer_in->status != STATUS_FREE)
+		{
+			continue; // no free buffer, packet lost
+		}
+
+		ctrl.rf_buffer_in->type = buf[0];
+		ctrl.rf_buffer_in->len = n - 1;
+		memcpy(ctrl.rf_buffer_in->buffer, buf + 1, n - 1);
+		ctrl.rf_buffer_in->status = STATUS_COMPLETE;
+
+		ctrl.buffer_in_num = (ctrl.buffer_in_num + 1) % 2;
+		ctrl.rf_buffer_in = &rf_rx_buffers[ctrl.buffer_in_num];
+	}
+}
+
+void rfm12_rx_clear(void)
+{
+	//mark the current buffer as empty
+	ctrl.rf_buffer_out->status = STATUS_FREE;
+
+	//switch to the other buffer
+	ctrl.buffer_out_num = (ctrl.buffer_out_num + 1) % 2;
+	ctrl.rf_buffer_out = &rf_rx_buffers[ctrl.buffer_out_num];
+}
+#endif
+
+static void air_close(void)
+{
+	unlink(air_addr.sun_path);
+}
+
+void rfm12_init(void)
+{
+	const char * dir = getenv("SHC_AIR");
+
+	if (air_fd >= 0)
+	{
+		return;
+	}
+
+	snprintf(air_dir, sizeof(air_dir), "%s", dir ? dir : "/tmp/shc_air");
+	mkdir(air_dir, 0777);
+
+	air_addr.sun_family = AF_UNIX;
+	snprintf(air_addr.sun_path, sizeof(air_addr.sun_path), "%s/%u", air_dir, (unsigned)getpid());
+
+	air_fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	unlink(air_addr.sun_path);
+
+	if ((air_fd < 0) || bind(air_fd, (struct sockaddr *)&air_addr, sizeof(air_addr)))
+	{
+		perror(air_addr.sun_path);
+		exit(1);
+	}
+
+	atexit(air_close);
+
+	ctrl.txstate = STATUS_FREE;
+
+#if !(RFM12_TRANSMIT_ONLY)
+	ctrl.rf_buffer_in = &rf_rx_buffers[0];
+	ctrl.rf_buffer_out = &rf_rx_buffers[0];
+	ctrl.buffer_in_num = 0;
+	ctrl.buffer_out_num = 0;
+
+	hal_linux_add_irq(air_fd, rfm12_isr);
+#endif
+}
+
+// Send the packet from the tx buffer to all other processes on the air bus.
+static void air_send(void)
+{
+	uint8_t buf[1 + RFM12_TX_BUFFER_SIZE];
+	struct sockaddr_un addr = { AF_UNIX };
+	struct dirent * e;
+	DIR * d = opendir(air_dir);
+
+	if (d == NULL)
+	{
+		return;
+	}
+
+	buf[0] = rf_tx_buffer.type;
+	memcpy(buf + 1, rf_tx_buffer.buffer, rf_tx_buffer.len);
+
+	while ((e = readdir(d)) != NULL)
+	{
+		if ((e->d_name[0] == '.')
+			|| (snprintf(addr.sun_path, sizeof(addr.sun_path), "%s/%s", air_dir, e->d_name) >= (int)sizeof(addr.sun_path))
+			|| (strcmp(addr.sun_path, air_addr.sun_path) == 0))
+		{
+			continue;
+		}
+
+		if ((sendto(air_fd, buf, 1 + rf_tx_buffer.len, 0, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+			&& (errno == ECONNREFUSED))
+		{
+			unlink(addr.sun_path); // process doesn't exist anymore
+		}
+	}
+
+	closedir(d);
+}
+
+// The packet is sent with the next tick, as the library does when the channel is free.
+void rfm12_tick(void)
+{
+	if (ctrl.txstate == STATUS_OCCUPIED)
+	{
+		air_send();
+		ctrl.txstate = STATUS_FREE;
+	}
+}
+
+void rfm12_sw_reset(void)
+{
+	ctrl.txstate = STATUS_FREE;
+}
+
+#if (RFM12_NORETURNS)
+void
+#else
+uint8_t
+#endif
+rfm12_start_tx(uint8_t type, uint8_t length)
+{
+	if (length > RFM12_TX_BUFFER_SIZE) return TXRETURN(RFM12_TX_ERROR);
+
+	if (ctrl.txstate != STATUS_FREE)
+		return TXRETURN(RFM12_TX_OCCUPIED);
+
+	rf_tx_buffer.len = length;
+	rf_tx_buffer.type = type;
+	ctrl.txstate = STATUS_OCCUPIED;
+
+	return TXRETURN(RFM12_TX_ENQUEUED);
+}
+
+#if (RFM12_NORETURNS)
+void
+#else
+uint8_t
+#endif
+rfm12_tx(uint8_t len, uint8_t type, uint8_t *data)
+{
+	if (len > RFM12_TX_BUFFER_SIZE) return TXRETURN(RFM12_TX_ERROR);
+
+	if (ctrl.txstate != STATUS_FREE)
+		return TXRETURN(RFM12_TX_OCCUPIED);
+
+	memcpy(rf_tx_buffer.buffer, data, len);
+
+#if (RFM12_NORETURNS)
+	rfm12_start_tx(type, len);
+#else
+	return rfm12_start_tx(type, len);
+#endif
+}
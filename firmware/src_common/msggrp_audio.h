@@ -58,73 +58,121 @@ typedef enum {
 // Description: This is a message to get/set playback of a continuous tone which doesn't stop until another one is requested.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_audio_tone_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 50);
+  pkg_headerext_get_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_audio_tone_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(50);
-  pkg_headerext_get_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_audio_tone_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Set".
+static inline void pkg_header_ctx_init_audio_tone_set(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 1);
+  pkg_headerext_set_ctx_set_messagegroupid(ctx, 50);
+  pkg_headerext_set_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 1;
+}
+
 static inline void pkg_header_init_audio_tone_set(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(1);
-  pkg_headerext_set_set_messagegroupid(50);
-  pkg_headerext_set_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 1;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_audio_tone_set(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "SetGet".
+static inline void pkg_header_ctx_init_audio_tone_setget(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 2);
+  pkg_headerext_setget_ctx_set_messagegroupid(ctx, 50);
+  pkg_headerext_setget_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 2;
+}
+
 static inline void pkg_header_init_audio_tone_setget(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(2);
-  pkg_headerext_setget_set_messagegroupid(50);
-  pkg_headerext_setget_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 2;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_audio_tone_setget(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_audio_tone_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 50);
+  pkg_headerext_status_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_audio_tone_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(50);
-  pkg_headerext_status_set_messageid(1);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_audio_tone_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Ack".
+static inline void pkg_header_ctx_init_audio_tone_ack(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 9);
+  ctx->headeroffsetbits = 109;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 9;
+}
+
 static inline void pkg_header_init_audio_tone_ack(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(9);
-  __HEADEROFFSETBITS = 109;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 9;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_audio_tone_ack(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_audio_tone_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 50);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_audio_tone_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(50);
-  pkg_headerext_ackstatus_set_messageid(1);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_audio_tone_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Tone (UIntValue)
@@ -132,16 +180,73 @@ static inline void pkg_header_init_audio_tone_ackstatus(void)
 
 // Set Tone (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 7, min val 0, max val 116
+static inline void msg_audio_tone_ctx_set_tone(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 7, val, ctx->buf);
+}
+
 static inline void msg_audio_tone_set_tone(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 7, val, bufx);
+  msg_audio_tone_ctx_set_tone(PKG_CTX_GLOBAL, val);
 }
 
 // Get Tone (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 7, min val 0, max val 116
+static inline uint32_t msg_audio_tone_ctx_get_tone(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 7, 0, 116, ctx->buf);
+}
+
 static inline uint32_t msg_audio_tone_get_tone(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 7, 0, 116, bufx);
+  return msg_audio_tone_ctx_get_tone(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint8_t tone;
+} msg_audio_tone_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_audio_tone_ctx_unpack(const pkg_ctx_t * ctx, msg_audio_tone_t * msg) __attribute__ ((unused));
+static void msg_audio_tone_ctx_unpack(const pkg_ctx_t * ctx, msg_audio_tone_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->tone = bitstream_read_UIntValue32(&bs, 7, 0, 116);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_audio_tone_unpack(const uint8_t * buf, msg_audio_tone_t * msg) __attribute__ ((unused));
+static void msg_audio_tone_unpack(const uint8_t * buf, msg_audio_tone_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_audio_tone_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_audio_tone_ctx_pack(const pkg_ctx_t * ctx, const msg_audio_tone_t * msg) __attribute__ ((unused));
+static void msg_audio_tone_ctx_pack(const pkg_ctx_t * ctx, const msg_audio_tone_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 7, msg->tone);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_audio_tone_pack(const msg_audio_tone_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_audio_tone_pack(const msg_audio_tone_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_audio_tone_ctx_pack(&ctx, msg);
 }
 
 
@@ -156,73 +261,121 @@ static inline uint32_t msg_audio_tone_get_tone(void)
 // Description: This is a message to play a series of tones (set) or get the currently playing one.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_audio_melody_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 50);
+  pkg_headerext_get_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_audio_melody_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(50);
-  pkg_headerext_get_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_audio_melody_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Set".
+static inline void pkg_header_ctx_init_audio_melody_set(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 1);
+  pkg_headerext_set_ctx_set_messagegroupid(ctx, 50);
+  pkg_headerext_set_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 64;
+  ctx->messagetype = 1;
+}
+
 static inline void pkg_header_init_audio_melody_set(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(1);
-  pkg_headerext_set_set_messagegroupid(50);
-  pkg_headerext_set_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 64;
-  __MESSAGETYPE = 1;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_audio_melody_set(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "SetGet".
+static inline void pkg_header_ctx_init_audio_melody_setget(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 2);
+  pkg_headerext_setget_ctx_set_messagegroupid(ctx, 50);
+  pkg_headerext_setget_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 64;
+  ctx->messagetype = 2;
+}
+
 static inline void pkg_header_init_audio_melody_setget(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(2);
-  pkg_headerext_setget_set_messagegroupid(50);
-  pkg_headerext_setget_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 64;
-  __MESSAGETYPE = 2;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_audio_melody_setget(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_audio_melody_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 50);
+  pkg_headerext_status_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 64;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_audio_melody_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(50);
-  pkg_headerext_status_set_messageid(2);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 64;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_audio_melody_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Ack".
+static inline void pkg_header_ctx_init_audio_melody_ack(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 9);
+  ctx->headeroffsetbits = 109;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 9;
+}
+
 static inline void pkg_header_init_audio_melody_ack(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(9);
-  __HEADEROFFSETBITS = 109;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 9;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_audio_melody_ack(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_audio_melody_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 50);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 64;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_audio_melody_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(50);
-  pkg_headerext_ackstatus_set_messageid(2);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 64;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_audio_melody_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Repeat (UIntValue)
@@ -230,16 +383,26 @@ static inline void pkg_header_init_audio_melody_ackstatus(void)
 
 // Set Repeat (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 4, min val 0, max val 15
+static inline void msg_audio_melody_ctx_set_repeat(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 4, val, ctx->buf);
+}
+
 static inline void msg_audio_melody_set_repeat(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 4, val, bufx);
+  msg_audio_melody_ctx_set_repeat(PKG_CTX_GLOBAL, val);
 }
 
 // Get Repeat (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 4, min val 0, max val 15
+static inline uint32_t msg_audio_melody_ctx_get_repeat(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 4, 0, 15, ctx->buf);
+}
+
 static inline uint32_t msg_audio_melody_get_repeat(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 4, 0, 15, bufx);
+  return msg_audio_melody_ctx_get_repeat(PKG_CTX_GLOBAL);
 }
 
 // AutoReverse (BoolValue)
@@ -247,16 +410,26 @@ static inline uint32_t msg_audio_melody_get_repeat(void)
 
 // Set AutoReverse (BoolValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 4, length bits 1
+static inline void msg_audio_melody_ctx_set_autoreverse(const pkg_ctx_t * ctx, bool val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 4, 1, val ? 1 : 0, ctx->buf);
+}
+
 static inline void msg_audio_melody_set_autoreverse(bool val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 4, 1, val ? 1 : 0, bufx);
+  msg_audio_melody_ctx_set_autoreverse(PKG_CTX_GLOBAL, val);
 }
 
 // Get AutoReverse (BoolValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 4, length bits 1
+static inline bool msg_audio_melody_ctx_get_autoreverse(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue8((uint16_t)ctx->headeroffsetbits + 4, 1, 0, 1, ctx->buf) == 1;
+}
+
 static inline bool msg_audio_melody_get_autoreverse(void)
 {
-  return array_read_UIntValue8((uint16_t)__HEADEROFFSETBITS + 4, 1, 0, 1, bufx) == 1;
+  return msg_audio_melody_ctx_get_autoreverse(PKG_CTX_GLOBAL);
 }
 
 // Time (UIntValue[25])
@@ -265,16 +438,26 @@ static inline bool msg_audio_melody_get_autoreverse(void)
 
 // Set Time (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 5 + (uint16_t)index * 15, length bits 5, min val 0, max val 31
+static inline void msg_audio_melody_ctx_set_time(const pkg_ctx_t * ctx, uint8_t index, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 5 + (uint16_t)index * 15, 5, val, ctx->buf);
+}
+
 static inline void msg_audio_melody_set_time(uint8_t index, uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 5 + (uint16_t)index * 15, 5, val, bufx);
+  msg_audio_melody_ctx_set_time(PKG_CTX_GLOBAL, index, val);
 }
 
 // Get Time (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 5 + (uint16_t)index * 15, length bits 5, min val 0, max val 31
+static inline uint32_t msg_audio_melody_ctx_get_time(const pkg_ctx_t * ctx, uint8_t index)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 5 + (uint16_t)index * 15, 5, 0, 31, ctx->buf);
+}
+
 static inline uint32_t msg_audio_melody_get_time(uint8_t index)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 5 + (uint16_t)index * 15, 5, 0, 31, bufx);
+  return msg_audio_melody_ctx_get_time(PKG_CTX_GLOBAL, index);
 }
 
 // Effect (UIntValue[25])
@@ -283,16 +466,26 @@ static inline uint32_t msg_audio_melody_get_time(uint8_t index)
 
 // Set Effect (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 10 + (uint16_t)index * 15, length bits 3, min val 0, max val 1
+static inline void msg_audio_melody_ctx_set_effect(const pkg_ctx_t * ctx, uint8_t index, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 10 + (uint16_t)index * 15, 3, val, ctx->buf);
+}
+
 static inline void msg_audio_melody_set_effect(uint8_t index, uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 10 + (uint16_t)index * 15, 3, val, bufx);
+  msg_audio_melody_ctx_set_effect(PKG_CTX_GLOBAL, index, val);
 }
 
 // Get Effect (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 10 + (uint16_t)index * 15, length bits 3, min val 0, max val 1
+static inline uint32_t msg_audio_melody_ctx_get_effect(const pkg_ctx_t * ctx, uint8_t index)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 10 + (uint16_t)index * 15, 3, 0, 1, ctx->buf);
+}
+
 static inline uint32_t msg_audio_melody_get_effect(uint8_t index)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 10 + (uint16_t)index * 15, 3, 0, 1, bufx);
+  return msg_audio_melody_ctx_get_effect(PKG_CTX_GLOBAL, index);
 }
 
 // Tone (UIntValue[25])
@@ -301,16 +494,95 @@ static inline uint32_t msg_audio_melody_get_effect(uint8_t index)
 
 // Set Tone (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 13 + (uint16_t)index * 15, length bits 7, min val 0, max val 116
+static inline void msg_audio_melody_ctx_set_tone(const pkg_ctx_t * ctx, uint8_t index, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 13 + (uint16_t)index * 15, 7, val, ctx->buf);
+}
+
 static inline void msg_audio_melody_set_tone(uint8_t index, uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 13 + (uint16_t)index * 15, 7, val, bufx);
+  msg_audio_melody_ctx_set_tone(PKG_CTX_GLOBAL, index, val);
 }
 
 // Get Tone (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 13 + (uint16_t)index * 15, length bits 7, min val 0, max val 116
+static inline uint32_t msg_audio_melody_ctx_get_tone(const pkg_ctx_t * ctx, uint8_t index)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 13 + (uint16_t)index * 15, 7, 0, 116, ctx->buf);
+}
+
 static inline uint32_t msg_audio_melody_get_tone(uint8_t index)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 13 + (uint16_t)index * 15, 7, 0, 116, bufx);
+  return msg_audio_melody_ctx_get_tone(PKG_CTX_GLOBAL, index);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint8_t repeat;
+  bool autoreverse;
+  uint8_t time[25];
+  uint8_t effect[25];
+  uint8_t tone[25];
+} msg_audio_melody_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_audio_melody_ctx_unpack(const pkg_ctx_t * ctx, msg_audio_melody_t * msg) __attribute__ ((unused));
+static void msg_audio_melody_ctx_unpack(const pkg_ctx_t * ctx, msg_audio_melody_t * msg)
+{
+  bitstream_t bs;
+  uint8_t i;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->repeat = bitstream_read_bits(&bs, 4);
+  msg->autoreverse = bitstream_read_bits(&bs, 1) == 1;
+
+  for (i = 0; i < 25; i++)
+  {
+    msg->time[i] = bitstream_read_bits(&bs, 5);
+    msg->effect[i] = bitstream_read_UIntValue32(&bs, 3, 0, 1);
+    msg->tone[i] = bitstream_read_UIntValue32(&bs, 7, 0, 116);
+  }
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_audio_melody_unpack(const uint8_t * buf, msg_audio_melody_t * msg) __attribute__ ((unused));
+static void msg_audio_melody_unpack(const uint8_t * buf, msg_audio_melody_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_audio_melody_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_audio_melody_ctx_pack(const pkg_ctx_t * ctx, const msg_audio_melody_t * msg) __attribute__ ((unused));
+static void msg_audio_melody_ctx_pack(const pkg_ctx_t * ctx, const msg_audio_melody_t * msg)
+{
+  bitstream_t bs;
+  uint8_t i;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 4, msg->repeat);
+  bitstream_write_bits(&bs, 1, msg->autoreverse ? 1 : 0);
+
+  for (i = 0; i < 25; i++)
+  {
+    bitstream_write_bits(&bs, 5, msg->time[i]);
+    bitstream_write_bits(&bs, 3, msg->effect[i]);
+    bitstream_write_bits(&bs, 7, msg->tone[i]);
+  }
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_audio_melody_pack(const msg_audio_melody_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_audio_melody_pack(const msg_audio_melody_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_audio_melody_ctx_pack(&ctx, msg);
 }
 
 #endif /* _MSGGRP_AUDIO_H */
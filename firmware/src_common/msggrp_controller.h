@@ -57,85 +57,141 @@ typedef enum {
 // Description: These are the value indexes of selected menu items. It depends on the configuration of a specific controller device which value each index represents. The indexes of selected menu entries should start with 1, and 0 should be treated as 'not updated' (in a Status/AckStatus/Deliver message) or 'not to be updated' (in a Set/SetGet request). This is to allow smaller (16 byte) packets when there are few menu entries.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_controller_menuselection_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 45);
+  pkg_headerext_get_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_controller_menuselection_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(45);
-  pkg_headerext_get_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_controller_menuselection_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Set".
+static inline void pkg_header_ctx_init_controller_menuselection_set(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 1);
+  pkg_headerext_set_ctx_set_messagegroupid(ctx, 45);
+  pkg_headerext_set_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 1;
+}
+
 static inline void pkg_header_init_controller_menuselection_set(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(1);
-  pkg_headerext_set_set_messagegroupid(45);
-  pkg_headerext_set_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 1;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_controller_menuselection_set(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "SetGet".
+static inline void pkg_header_ctx_init_controller_menuselection_setget(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 2);
+  pkg_headerext_setget_ctx_set_messagegroupid(ctx, 45);
+  pkg_headerext_setget_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 2;
+}
+
 static inline void pkg_header_init_controller_menuselection_setget(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(2);
-  pkg_headerext_setget_set_messagegroupid(45);
-  pkg_headerext_setget_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 2;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_controller_menuselection_setget(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Deliver".
+static inline void pkg_header_ctx_init_controller_menuselection_deliver(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 3);
+  pkg_headerext_deliver_ctx_set_messagegroupid(ctx, 45);
+  pkg_headerext_deliver_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 3;
+}
+
 static inline void pkg_header_init_controller_menuselection_deliver(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(3);
-  pkg_headerext_deliver_set_messagegroupid(45);
-  pkg_headerext_deliver_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 3;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_controller_menuselection_deliver(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_controller_menuselection_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 45);
+  pkg_headerext_status_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_controller_menuselection_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(45);
-  pkg_headerext_status_set_messageid(1);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_controller_menuselection_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Ack".
+static inline void pkg_header_ctx_init_controller_menuselection_ack(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 9);
+  ctx->headeroffsetbits = 109;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 9;
+}
+
 static inline void pkg_header_init_controller_menuselection_ack(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(9);
-  __HEADEROFFSETBITS = 109;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 9;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_controller_menuselection_ack(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_controller_menuselection_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 45);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_controller_menuselection_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(45);
-  pkg_headerext_ackstatus_set_messageid(1);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_controller_menuselection_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Index (UIntValue[16])
@@ -143,16 +199,83 @@ static inline void pkg_header_init_controller_menuselection_ackstatus(void)
 
 // Set Index (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 8, length bits 8, min val 0, max val 255
+static inline void msg_controller_menuselection_ctx_set_index(const pkg_ctx_t * ctx, uint8_t index, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0 + (uint16_t)index * 8, 8, val, ctx->buf);
+}
+
 static inline void msg_controller_menuselection_set_index(uint8_t index, uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 8, 8, val, bufx);
+  msg_controller_menuselection_ctx_set_index(PKG_CTX_GLOBAL, index, val);
 }
 
 // Get Index (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 8, length bits 8, min val 0, max val 255
+static inline uint32_t msg_controller_menuselection_ctx_get_index(const pkg_ctx_t * ctx, uint8_t index)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0 + (uint16_t)index * 8, 8, 0, 255, ctx->buf);
+}
+
 static inline uint32_t msg_controller_menuselection_get_index(uint8_t index)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 8, 8, 0, 255, bufx);
+  return msg_controller_menuselection_ctx_get_index(PKG_CTX_GLOBAL, index);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint8_t index[16];
+} msg_controller_menuselection_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_controller_menuselection_ctx_unpack(const pkg_ctx_t * ctx, msg_controller_menuselection_t * msg) __attribute__ ((unused));
+static void msg_controller_menuselection_ctx_unpack(const pkg_ctx_t * ctx, msg_controller_menuselection_t * msg)
+{
+  bitstream_t bs;
+  uint8_t i;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+
+  for (i = 0; i < 16; i++)
+  {
+    msg->index[i] = bitstream_read_bits(&bs, 8);
+  }
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_controller_menuselection_unpack(const uint8_t * buf, msg_controller_menuselection_t * msg) __attribute__ ((unused));
+static void msg_controller_menuselection_unpack(const uint8_t * buf, msg_controller_menuselection_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_controller_menuselection_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_controller_menuselection_ctx_pack(const pkg_ctx_t * ctx, const msg_controller_menuselection_t * msg) __attribute__ ((unused));
+static void msg_controller_menuselection_ctx_pack(const pkg_ctx_t * ctx, const msg_controller_menuselection_t * msg)
+{
+  bitstream_t bs;
+  uint8_t i;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+
+  for (i = 0; i < 16; i++)
+  {
+    bitstream_write_bits(&bs, 8, msg->index[i]);
+  }
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_controller_menuselection_pack(const msg_controller_menuselection_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_controller_menuselection_pack(const msg_controller_menuselection_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_controller_menuselection_ctx_pack(&ctx, msg);
 }
 
 #endif /* _MSGGRP_CONTROLLER_H */
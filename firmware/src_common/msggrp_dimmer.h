@@ -59,73 +59,121 @@ typedef enum {
 // Description: This is to set a fixed brightness.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_dimmer_brightness_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_get_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_dimmer_brightness_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(60);
-  pkg_headerext_get_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_brightness_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Set".
+static inline void pkg_header_ctx_init_dimmer_brightness_set(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 1);
+  pkg_headerext_set_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_set_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 1;
+}
+
 static inline void pkg_header_init_dimmer_brightness_set(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(1);
-  pkg_headerext_set_set_messagegroupid(60);
-  pkg_headerext_set_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 1;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_brightness_set(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "SetGet".
+static inline void pkg_header_ctx_init_dimmer_brightness_setget(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 2);
+  pkg_headerext_setget_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_setget_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 2;
+}
+
 static inline void pkg_header_init_dimmer_brightness_setget(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(2);
-  pkg_headerext_setget_set_messagegroupid(60);
-  pkg_headerext_setget_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 2;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_brightness_setget(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_dimmer_brightness_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_status_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_dimmer_brightness_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(60);
-  pkg_headerext_status_set_messageid(1);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_brightness_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Ack".
+static inline void pkg_header_ctx_init_dimmer_brightness_ack(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 9);
+  ctx->headeroffsetbits = 109;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 9;
+}
+
 static inline void pkg_header_init_dimmer_brightness_ack(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(9);
-  __HEADEROFFSETBITS = 109;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 9;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_brightness_ack(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_dimmer_brightness_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_dimmer_brightness_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(60);
-  pkg_headerext_ackstatus_set_messageid(1);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_brightness_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Brightness (UIntValue)
@@ -133,16 +181,73 @@ static inline void pkg_header_init_dimmer_brightness_ackstatus(void)
 
 // Set Brightness (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 7, min val 0, max val 100
+static inline void msg_dimmer_brightness_ctx_set_brightness(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 7, val, ctx->buf);
+}
+
 static inline void msg_dimmer_brightness_set_brightness(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 7, val, bufx);
+  msg_dimmer_brightness_ctx_set_brightness(PKG_CTX_GLOBAL, val);
 }
 
 // Get Brightness (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 7, min val 0, max val 100
+static inline uint32_t msg_dimmer_brightness_ctx_get_brightness(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 7, 0, 100, ctx->buf);
+}
+
 static inline uint32_t msg_dimmer_brightness_get_brightness(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 7, 0, 100, bufx);
+  return msg_dimmer_brightness_ctx_get_brightness(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint8_t brightness;
+} msg_dimmer_brightness_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_dimmer_brightness_ctx_unpack(const pkg_ctx_t * ctx, msg_dimmer_brightness_t * msg) __attribute__ ((unused));
+static void msg_dimmer_brightness_ctx_unpack(const pkg_ctx_t * ctx, msg_dimmer_brightness_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->brightness = bitstream_read_UIntValue32(&bs, 7, 0, 100);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_dimmer_brightness_unpack(const uint8_t * buf, msg_dimmer_brightness_t * msg) __attribute__ ((unused));
+static void msg_dimmer_brightness_unpack(const uint8_t * buf, msg_dimmer_brightness_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_dimmer_brightness_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_dimmer_brightness_ctx_pack(const pkg_ctx_t * ctx, const msg_dimmer_brightness_t * msg) __attribute__ ((unused));
+static void msg_dimmer_brightness_ctx_pack(const pkg_ctx_t * ctx, const msg_dimmer_brightness_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 7, msg->brightness);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_dimmer_brightness_pack(const msg_dimmer_brightness_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_dimmer_brightness_pack(const msg_dimmer_brightness_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_dimmer_brightness_ctx_pack(&ctx, msg);
 }
 
 
@@ -157,98 +262,157 @@ static inline uint32_t msg_dimmer_brightness_get_brightness(void)
 // Description: This is the state of the dimmer output voltage and its timeout value.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_dimmer_animation_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_get_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_dimmer_animation_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(60);
-  pkg_headerext_get_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_animation_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Set".
+static inline void pkg_header_ctx_init_dimmer_animation_set(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 1);
+  pkg_headerext_set_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_set_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 1;
+}
+
 static inline void pkg_header_init_dimmer_animation_set(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(1);
-  pkg_headerext_set_set_messagegroupid(60);
-  pkg_headerext_set_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 1;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_animation_set(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "SetGet".
+static inline void pkg_header_ctx_init_dimmer_animation_setget(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 2);
+  pkg_headerext_setget_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_setget_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 2;
+}
+
 static inline void pkg_header_init_dimmer_animation_setget(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(2);
-  pkg_headerext_setget_set_messagegroupid(60);
-  pkg_headerext_setget_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 2;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_animation_setget(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_dimmer_animation_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_status_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_dimmer_animation_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(60);
-  pkg_headerext_status_set_messageid(2);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_animation_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Ack".
+static inline void pkg_header_ctx_init_dimmer_animation_ack(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 9);
+  ctx->headeroffsetbits = 109;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 9;
+}
+
 static inline void pkg_header_init_dimmer_animation_ack(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(9);
-  __HEADEROFFSETBITS = 109;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 9;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_animation_ack(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_dimmer_animation_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_dimmer_animation_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(60);
-  pkg_headerext_ackstatus_set_messageid(2);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_animation_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // AnimationMode (EnumValue)
-// Description: If a time is set, use this animation mode to change the brightness over time (none = leave at start state for the whole time and switch to end state at the end).
+// Description: If a time is set, use this animation mode to change the brightness over time (none = leave at start state for the whole time and switch to end state at the end, ease = start and end slowly).
 
 #ifndef _ENUM_AnimationMode
 #define _ENUM_AnimationMode
 typedef enum {
   ANIMATIONMODE_NONE = 0,
-  ANIMATIONMODE_LINEAR = 1
+  ANIMATIONMODE_LINEAR = 1,
+  ANIMATIONMODE_EASE = 2
 } AnimationModeEnum;
 #endif /* _ENUM_AnimationMode */
 
 // Set AnimationMode (EnumValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 2
+static inline void msg_dimmer_animation_ctx_set_animationmode(const pkg_ctx_t * ctx, AnimationModeEnum val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 2, val, ctx->buf);
+}
+
 static inline void msg_dimmer_animation_set_animationmode(AnimationModeEnum val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 2, val, bufx);
+  msg_dimmer_animation_ctx_set_animationmode(PKG_CTX_GLOBAL, val);
 }
 
 // Get AnimationMode (EnumValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 2
+static inline AnimationModeEnum msg_dimmer_animation_ctx_get_animationmode(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 2, 0, 3, ctx->buf);
+}
+
 static inline AnimationModeEnum msg_dimmer_animation_get_animationmode(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 2, 0, 3, bufx);
+  return msg_dimmer_animation_ctx_get_animationmode(PKG_CTX_GLOBAL);
 }
 
 // TimeoutSec (UIntValue)
@@ -256,16 +420,26 @@ static inline AnimationModeEnum msg_dimmer_animation_get_animationmode(void)
 
 // Set TimeoutSec (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 2, length bits 16, min val 0, max val 65535
+static inline void msg_dimmer_animation_ctx_set_timeoutsec(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 2, 16, val, ctx->buf);
+}
+
 static inline void msg_dimmer_animation_set_timeoutsec(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 2, 16, val, bufx);
+  msg_dimmer_animation_ctx_set_timeoutsec(PKG_CTX_GLOBAL, val);
 }
 
 // Get TimeoutSec (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 2, length bits 16, min val 0, max val 65535
+static inline uint32_t msg_dimmer_animation_ctx_get_timeoutsec(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 2, 16, 0, 65535, ctx->buf);
+}
+
 static inline uint32_t msg_dimmer_animation_get_timeoutsec(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 2, 16, 0, 65535, bufx);
+  return msg_dimmer_animation_ctx_get_timeoutsec(PKG_CTX_GLOBAL);
 }
 
 // StartBrightness (UIntValue)
@@ -273,16 +447,26 @@ static inline uint32_t msg_dimmer_animation_get_timeoutsec(void)
 
 // Set StartBrightness (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 18, length bits 7, min val 0, max val 100
+static inline void msg_dimmer_animation_ctx_set_startbrightness(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 18, 7, val, ctx->buf);
+}
+
 static inline void msg_dimmer_animation_set_startbrightness(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 18, 7, val, bufx);
+  msg_dimmer_animation_ctx_set_startbrightness(PKG_CTX_GLOBAL, val);
 }
 
 // Get StartBrightness (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 18, length bits 7, min val 0, max val 100
+static inline uint32_t msg_dimmer_animation_ctx_get_startbrightness(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 18, 7, 0, 100, ctx->buf);
+}
+
 static inline uint32_t msg_dimmer_animation_get_startbrightness(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 18, 7, 0, 100, bufx);
+  return msg_dimmer_animation_ctx_get_startbrightness(PKG_CTX_GLOBAL);
 }
 
 // EndBrightness (UIntValue)
@@ -290,16 +474,82 @@ static inline uint32_t msg_dimmer_animation_get_startbrightness(void)
 
 // Set EndBrightness (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 25, length bits 7, min val 0, max val 100
+static inline void msg_dimmer_animation_ctx_set_endbrightness(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 25, 7, val, ctx->buf);
+}
+
 static inline void msg_dimmer_animation_set_endbrightness(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 25, 7, val, bufx);
+  msg_dimmer_animation_ctx_set_endbrightness(PKG_CTX_GLOBAL, val);
 }
 
 // Get EndBrightness (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 25, length bits 7, min val 0, max val 100
+static inline uint32_t msg_dimmer_animation_ctx_get_endbrightness(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 25, 7, 0, 100, ctx->buf);
+}
+
 static inline uint32_t msg_dimmer_animation_get_endbrightness(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 25, 7, 0, 100, bufx);
+  return msg_dimmer_animation_ctx_get_endbrightness(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  AnimationModeEnum animationmode;
+  uint16_t timeoutsec;
+  uint8_t startbrightness;
+  uint8_t endbrightness;
+} msg_dimmer_animation_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_dimmer_animation_ctx_unpack(const pkg_ctx_t * ctx, msg_dimmer_animation_t * msg) __attribute__ ((unused));
+static void msg_dimmer_animation_ctx_unpack(const pkg_ctx_t * ctx, msg_dimmer_animation_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->animationmode = (AnimationModeEnum)bitstream_read_bits(&bs, 2);
+  msg->timeoutsec = bitstream_read_bits(&bs, 16);
+  msg->startbrightness = bitstream_read_UIntValue32(&bs, 7, 0, 100);
+  msg->endbrightness = bitstream_read_UIntValue32(&bs, 7, 0, 100);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_dimmer_animation_unpack(const uint8_t * buf, msg_dimmer_animation_t * msg) __attribute__ ((unused));
+static void msg_dimmer_animation_unpack(const uint8_t * buf, msg_dimmer_animation_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_dimmer_animation_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_dimmer_animation_ctx_pack(const pkg_ctx_t * ctx, const msg_dimmer_animation_t * msg) __attribute__ ((unused));
+static void msg_dimmer_animation_ctx_pack(const pkg_ctx_t * ctx, const msg_dimmer_animation_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 2, msg->animationmode);
+  bitstream_write_bits(&bs, 16, msg->timeoutsec);
+  bitstream_write_bits(&bs, 7, msg->startbrightness);
+  bitstream_write_bits(&bs, 7, msg->endbrightness);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_dimmer_animation_pack(const msg_dimmer_animation_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_dimmer_animation_pack(const msg_dimmer_animation_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_dimmer_animation_ctx_pack(&ctx, msg);
 }
 
 
@@ -314,73 +564,121 @@ static inline uint32_t msg_dimmer_animation_get_endbrightness(void)
 // Description: This is to set a fixed color.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_dimmer_color_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_get_ctx_set_messageid(ctx, 10);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_dimmer_color_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(60);
-  pkg_headerext_get_set_messageid(10);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_color_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Set".
+static inline void pkg_header_ctx_init_dimmer_color_set(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 1);
+  pkg_headerext_set_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_set_ctx_set_messageid(ctx, 10);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 1;
+}
+
 static inline void pkg_header_init_dimmer_color_set(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(1);
-  pkg_headerext_set_set_messagegroupid(60);
-  pkg_headerext_set_set_messageid(10);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 1;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_color_set(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "SetGet".
+static inline void pkg_header_ctx_init_dimmer_color_setget(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 2);
+  pkg_headerext_setget_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_setget_ctx_set_messageid(ctx, 10);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 2;
+}
+
 static inline void pkg_header_init_dimmer_color_setget(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(2);
-  pkg_headerext_setget_set_messagegroupid(60);
-  pkg_headerext_setget_set_messageid(10);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 2;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_color_setget(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_dimmer_color_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_status_ctx_set_messageid(ctx, 10);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_dimmer_color_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(60);
-  pkg_headerext_status_set_messageid(10);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_color_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Ack".
+static inline void pkg_header_ctx_init_dimmer_color_ack(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 9);
+  ctx->headeroffsetbits = 109;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 9;
+}
+
 static inline void pkg_header_init_dimmer_color_ack(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(9);
-  __HEADEROFFSETBITS = 109;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 9;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_color_ack(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_dimmer_color_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 10);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_dimmer_color_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(60);
-  pkg_headerext_ackstatus_set_messageid(10);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_color_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Color (UIntValue)
@@ -388,16 +686,73 @@ static inline void pkg_header_init_dimmer_color_ackstatus(void)
 
 // Set Color (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 6, min val 0, max val 63
+static inline void msg_dimmer_color_ctx_set_color(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 6, val, ctx->buf);
+}
+
 static inline void msg_dimmer_color_set_color(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 6, val, bufx);
+  msg_dimmer_color_ctx_set_color(PKG_CTX_GLOBAL, val);
 }
 
 // Get Color (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 6, min val 0, max val 63
+static inline uint32_t msg_dimmer_color_ctx_get_color(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 6, 0, 63, ctx->buf);
+}
+
 static inline uint32_t msg_dimmer_color_get_color(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 6, 0, 63, bufx);
+  return msg_dimmer_color_ctx_get_color(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint8_t color;
+} msg_dimmer_color_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_dimmer_color_ctx_unpack(const pkg_ctx_t * ctx, msg_dimmer_color_t * msg) __attribute__ ((unused));
+static void msg_dimmer_color_ctx_unpack(const pkg_ctx_t * ctx, msg_dimmer_color_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->color = bitstream_read_bits(&bs, 6);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_dimmer_color_unpack(const uint8_t * buf, msg_dimmer_color_t * msg) __attribute__ ((unused));
+static void msg_dimmer_color_unpack(const uint8_t * buf, msg_dimmer_color_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_dimmer_color_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_dimmer_color_ctx_pack(const pkg_ctx_t * ctx, const msg_dimmer_color_t * msg) __attribute__ ((unused));
+static void msg_dimmer_color_ctx_pack(const pkg_ctx_t * ctx, const msg_dimmer_color_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 6, msg->color);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_dimmer_color_pack(const msg_dimmer_color_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_dimmer_color_pack(const msg_dimmer_color_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_dimmer_color_ctx_pack(&ctx, msg);
 }
 
 
@@ -412,73 +767,121 @@ static inline uint32_t msg_dimmer_color_get_color(void)
 // Description: This is to set a color animation.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_dimmer_coloranimation_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_get_ctx_set_messageid(ctx, 11);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_dimmer_coloranimation_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(60);
-  pkg_headerext_get_set_messageid(11);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_coloranimation_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Set".
+static inline void pkg_header_ctx_init_dimmer_coloranimation_set(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 1);
+  pkg_headerext_set_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_set_ctx_set_messageid(ctx, 11);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 1;
+}
+
 static inline void pkg_header_init_dimmer_coloranimation_set(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(1);
-  pkg_headerext_set_set_messagegroupid(60);
-  pkg_headerext_set_set_messageid(11);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 1;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_coloranimation_set(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "SetGet".
+static inline void pkg_header_ctx_init_dimmer_coloranimation_setget(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 2);
+  pkg_headerext_setget_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_setget_ctx_set_messageid(ctx, 11);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 2;
+}
+
 static inline void pkg_header_init_dimmer_coloranimation_setget(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(2);
-  pkg_headerext_setget_set_messagegroupid(60);
-  pkg_headerext_setget_set_messageid(11);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 2;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_coloranimation_setget(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_dimmer_coloranimation_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_status_ctx_set_messageid(ctx, 11);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_dimmer_coloranimation_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(60);
-  pkg_headerext_status_set_messageid(11);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_coloranimation_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Ack".
+static inline void pkg_header_ctx_init_dimmer_coloranimation_ack(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 9);
+  ctx->headeroffsetbits = 109;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 9;
+}
+
 static inline void pkg_header_init_dimmer_coloranimation_ack(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(9);
-  __HEADEROFFSETBITS = 109;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 9;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_coloranimation_ack(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_dimmer_coloranimation_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 60);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 11);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_dimmer_coloranimation_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(60);
-  pkg_headerext_ackstatus_set_messageid(11);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_dimmer_coloranimation_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Repeat (UIntValue)
@@ -486,16 +889,26 @@ static inline void pkg_header_init_dimmer_coloranimation_ackstatus(void)
 
 // Set Repeat (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 4, min val 0, max val 15
+static inline void msg_dimmer_coloranimation_ctx_set_repeat(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 4, val, ctx->buf);
+}
+
 static inline void msg_dimmer_coloranimation_set_repeat(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 4, val, bufx);
+  msg_dimmer_coloranimation_ctx_set_repeat(PKG_CTX_GLOBAL, val);
 }
 
 // Get Repeat (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 4, min val 0, max val 15
+static inline uint32_t msg_dimmer_coloranimation_ctx_get_repeat(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 4, 0, 15, ctx->buf);
+}
+
 static inline uint32_t msg_dimmer_coloranimation_get_repeat(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 4, 0, 15, bufx);
+  return msg_dimmer_coloranimation_ctx_get_repeat(PKG_CTX_GLOBAL);
 }
 
 // AutoReverse (BoolValue)
@@ -503,16 +916,26 @@ static inline uint32_t msg_dimmer_coloranimation_get_repeat(void)
 
 // Set AutoReverse (BoolValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 4, length bits 1
+static inline void msg_dimmer_coloranimation_ctx_set_autoreverse(const pkg_ctx_t * ctx, bool val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 4, 1, val ? 1 : 0, ctx->buf);
+}
+
 static inline void msg_dimmer_coloranimation_set_autoreverse(bool val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 4, 1, val ? 1 : 0, bufx);
+  msg_dimmer_coloranimation_ctx_set_autoreverse(PKG_CTX_GLOBAL, val);
 }
 
 // Get AutoReverse (BoolValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 4, length bits 1
+static inline bool msg_dimmer_coloranimation_ctx_get_autoreverse(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue8((uint16_t)ctx->headeroffsetbits + 4, 1, 0, 1, ctx->buf) == 1;
+}
+
 static inline bool msg_dimmer_coloranimation_get_autoreverse(void)
 {
-  return array_read_UIntValue8((uint16_t)__HEADEROFFSETBITS + 4, 1, 0, 1, bufx) == 1;
+  return msg_dimmer_coloranimation_ctx_get_autoreverse(PKG_CTX_GLOBAL);
 }
 
 // Time (UIntValue[10])
@@ -521,16 +944,26 @@ static inline bool msg_dimmer_coloranimation_get_autoreverse(void)
 
 // Set Time (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 5 + (uint16_t)index * 11, length bits 5, min val 0, max val 31
+static inline void msg_dimmer_coloranimation_ctx_set_time(const pkg_ctx_t * ctx, uint8_t index, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 5 + (uint16_t)index * 11, 5, val, ctx->buf);
+}
+
 static inline void msg_dimmer_coloranimation_set_time(uint8_t index, uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 5 + (uint16_t)index * 11, 5, val, bufx);
+  msg_dimmer_coloranimation_ctx_set_time(PKG_CTX_GLOBAL, index, val);
 }
 
 // Get Time (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 5 + (uint16_t)index * 11, length bits 5, min val 0, max val 31
+static inline uint32_t msg_dimmer_coloranimation_ctx_get_time(const pkg_ctx_t * ctx, uint8_t index)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 5 + (uint16_t)index * 11, 5, 0, 31, ctx->buf);
+}
+
 static inline uint32_t msg_dimmer_coloranimation_get_time(uint8_t index)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 5 + (uint16_t)index * 11, 5, 0, 31, bufx);
+  return msg_dimmer_coloranimation_ctx_get_time(PKG_CTX_GLOBAL, index);
 }
 
 // Color (UIntValue[10])
@@ -539,16 +972,92 @@ static inline uint32_t msg_dimmer_coloranimation_get_time(uint8_t index)
 
 // Set Color (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 10 + (uint16_t)index * 11, length bits 6, min val 0, max val 63
+static inline void msg_dimmer_coloranimation_ctx_set_color(const pkg_ctx_t * ctx, uint8_t index, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 10 + (uint16_t)index * 11, 6, val, ctx->buf);
+}
+
 static inline void msg_dimmer_coloranimation_set_color(uint8_t index, uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 10 + (uint16_t)index * 11, 6, val, bufx);
+  msg_dimmer_coloranimation_ctx_set_color(PKG_CTX_GLOBAL, index, val);
 }
 
 // Get Color (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 10 + (uint16_t)index * 11, length bits 6, min val 0, max val 63
+static inline uint32_t msg_dimmer_coloranimation_ctx_get_color(const pkg_ctx_t * ctx, uint8_t index)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 10 + (uint16_t)index * 11, 6, 0, 63, ctx->buf);
+}
+
 static inline uint32_t msg_dimmer_coloranimation_get_color(uint8_t index)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 10 + (uint16_t)index * 11, 6, 0, 63, bufx);
+  return msg_dimmer_coloranimation_ctx_get_color(PKG_CTX_GLOBAL, index);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint8_t repeat;
+  bool autoreverse;
+  uint8_t time[10];
+  uint8_t color[10];
+} msg_dimmer_coloranimation_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_dimmer_coloranimation_ctx_unpack(const pkg_ctx_t * ctx, msg_dimmer_coloranimation_t * msg) __attribute__ ((unused));
+static void msg_dimmer_coloranimation_ctx_unpack(const pkg_ctx_t * ctx, msg_dimmer_coloranimation_t * msg)
+{
+  bitstream_t bs;
+  uint8_t i;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->repeat = bitstream_read_bits(&bs, 4);
+  msg->autoreverse = bitstream_read_bits(&bs, 1) == 1;
+
+  for (i = 0; i < 10; i++)
+  {
+    msg->time[i] = bitstream_read_bits(&bs, 5);
+    msg->color[i] = bitstream_read_bits(&bs, 6);
+  }
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_dimmer_coloranimation_unpack(const uint8_t * buf, msg_dimmer_coloranimation_t * msg) __attribute__ ((unused));
+static void msg_dimmer_coloranimation_unpack(const uint8_t * buf, msg_dimmer_coloranimation_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_dimmer_coloranimation_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_dimmer_coloranimation_ctx_pack(const pkg_ctx_t * ctx, const msg_dimmer_coloranimation_t * msg) __attribute__ ((unused));
+static void msg_dimmer_coloranimation_ctx_pack(const pkg_ctx_t * ctx, const msg_dimmer_coloranimation_t * msg)
+{
+  bitstream_t bs;
+  uint8_t i;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 4, msg->repeat);
+  bitstream_write_bits(&bs, 1, msg->autoreverse ? 1 : 0);
+
+  for (i = 0; i < 10; i++)
+  {
+    bitstream_write_bits(&bs, 5, msg->time[i]);
+    bitstream_write_bits(&bs, 6, msg->color[i]);
+  }
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_dimmer_coloranimation_pack(const msg_dimmer_coloranimation_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_dimmer_coloranimation_pack(const msg_dimmer_coloranimation_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_dimmer_coloranimation_ctx_pack(&ctx, msg);
 }
 
 #endif /* _MSGGRP_DIMMER_H */
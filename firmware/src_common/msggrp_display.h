@@ -58,73 +58,121 @@ typedef enum {
 // Description: This is a message to get/set text content at a specified position.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_display_text_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 40);
+  pkg_headerext_get_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_display_text_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(40);
-  pkg_headerext_get_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_display_text_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Set".
+static inline void pkg_header_ctx_init_display_text_set(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 1);
+  pkg_headerext_set_ctx_set_messagegroupid(ctx, 40);
+  pkg_headerext_set_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 64;
+  ctx->messagetype = 1;
+}
+
 static inline void pkg_header_init_display_text_set(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(1);
-  pkg_headerext_set_set_messagegroupid(40);
-  pkg_headerext_set_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 64;
-  __MESSAGETYPE = 1;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_display_text_set(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "SetGet".
+static inline void pkg_header_ctx_init_display_text_setget(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 2);
+  pkg_headerext_setget_ctx_set_messagegroupid(ctx, 40);
+  pkg_headerext_setget_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 64;
+  ctx->messagetype = 2;
+}
+
 static inline void pkg_header_init_display_text_setget(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(2);
-  pkg_headerext_setget_set_messagegroupid(40);
-  pkg_headerext_setget_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 64;
-  __MESSAGETYPE = 2;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_display_text_setget(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_display_text_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 40);
+  pkg_headerext_status_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 64;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_display_text_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(40);
-  pkg_headerext_status_set_messageid(1);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 64;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_display_text_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Ack".
+static inline void pkg_header_ctx_init_display_text_ack(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 9);
+  ctx->headeroffsetbits = 109;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 9;
+}
+
 static inline void pkg_header_init_display_text_ack(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(9);
-  __HEADEROFFSETBITS = 109;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 9;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_display_text_ack(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_display_text_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 40);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 64;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_display_text_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(40);
-  pkg_headerext_ackstatus_set_messageid(1);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 64;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_display_text_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // PosY (UIntValue)
@@ -132,16 +180,26 @@ static inline void pkg_header_init_display_text_ackstatus(void)
 
 // Set PosY (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 5, min val 0, max val 31
+static inline void msg_display_text_ctx_set_posy(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 5, val, ctx->buf);
+}
+
 static inline void msg_display_text_set_posy(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 5, val, bufx);
+  msg_display_text_ctx_set_posy(PKG_CTX_GLOBAL, val);
 }
 
 // Get PosY (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 5, min val 0, max val 31
+static inline uint32_t msg_display_text_ctx_get_posy(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 5, 0, 31, ctx->buf);
+}
+
 static inline uint32_t msg_display_text_get_posy(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 5, 0, 31, bufx);
+  return msg_display_text_ctx_get_posy(PKG_CTX_GLOBAL);
 }
 
 // PosX (UIntValue)
@@ -149,16 +207,26 @@ static inline uint32_t msg_display_text_get_posy(void)
 
 // Set PosX (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 5, length bits 7, min val 0, max val 79
+static inline void msg_display_text_ctx_set_posx(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 5, 7, val, ctx->buf);
+}
+
 static inline void msg_display_text_set_posx(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 5, 7, val, bufx);
+  msg_display_text_ctx_set_posx(PKG_CTX_GLOBAL, val);
 }
 
 // Get PosX (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 5, length bits 7, min val 0, max val 79
+static inline uint32_t msg_display_text_ctx_get_posx(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 5, 7, 0, 79, ctx->buf);
+}
+
 static inline uint32_t msg_display_text_get_posx(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 5, 7, 0, 79, bufx);
+  return msg_display_text_ctx_get_posx(PKG_CTX_GLOBAL);
 }
 
 // Format (UIntValue)
@@ -166,16 +234,26 @@ static inline uint32_t msg_display_text_get_posx(void)
 
 // Set Format (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 12, length bits 4, min val 0, max val 15
+static inline void msg_display_text_ctx_set_format(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 12, 4, val, ctx->buf);
+}
+
 static inline void msg_display_text_set_format(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 12, 4, val, bufx);
+  msg_display_text_ctx_set_format(PKG_CTX_GLOBAL, val);
 }
 
 // Get Format (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 12, length bits 4, min val 0, max val 15
+static inline uint32_t msg_display_text_ctx_get_format(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 12, 4, 0, 15, ctx->buf);
+}
+
 static inline uint32_t msg_display_text_get_format(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 12, 4, 0, 15, bufx);
+  return msg_display_text_ctx_get_format(PKG_CTX_GLOBAL);
 }
 
 // Text (ByteArray)
@@ -183,16 +261,82 @@ static inline uint32_t msg_display_text_get_format(void)
 
 // Set Text (ByteArray)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 16, length bytes 40
+static inline void msg_display_text_ctx_set_text(const pkg_ctx_t * ctx, void *src)
+{
+  array_write_ByteArray((uint16_t)ctx->headeroffsetbits + 16, 40, src, ctx->buf);
+}
+
 static inline void msg_display_text_set_text(void *src)
 {
-  array_write_ByteArray((uint16_t)__HEADEROFFSETBITS + 16, 40, src, bufx);
+  msg_display_text_ctx_set_text(PKG_CTX_GLOBAL, src);
 }
 
 // Get Text (ByteArray)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 16, length bytes 40
+static inline void msg_display_text_ctx_get_text(const pkg_ctx_t * ctx, void *dst)
+{
+  array_read_ByteArray((uint16_t)ctx->headeroffsetbits + 16, 40, dst, ctx->buf);
+}
+
 static inline void msg_display_text_get_text(void *dst)
 {
-  array_read_ByteArray((uint16_t)__HEADEROFFSETBITS + 16, 40, dst, bufx);
+  msg_display_text_ctx_get_text(PKG_CTX_GLOBAL, dst);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint8_t posy;
+  uint8_t posx;
+  uint8_t format;
+  uint8_t text[40];
+} msg_display_text_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_display_text_ctx_unpack(const pkg_ctx_t * ctx, msg_display_text_t * msg) __attribute__ ((unused));
+static void msg_display_text_ctx_unpack(const pkg_ctx_t * ctx, msg_display_text_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->posy = bitstream_read_bits(&bs, 5);
+  msg->posx = bitstream_read_UIntValue32(&bs, 7, 0, 79);
+  msg->format = bitstream_read_bits(&bs, 4);
+  bitstream_read_ByteArray(&bs, 40, msg->text);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_display_text_unpack(const uint8_t * buf, msg_display_text_t * msg) __attribute__ ((unused));
+static void msg_display_text_unpack(const uint8_t * buf, msg_display_text_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_display_text_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_display_text_ctx_pack(const pkg_ctx_t * ctx, const msg_display_text_t * msg) __attribute__ ((unused));
+static void msg_display_text_ctx_pack(const pkg_ctx_t * ctx, const msg_display_text_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 5, msg->posy);
+  bitstream_write_bits(&bs, 7, msg->posx);
+  bitstream_write_bits(&bs, 4, msg->format);
+  bitstream_write_ByteArray(&bs, 40, msg->text);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_display_text_pack(const msg_display_text_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_display_text_pack(const msg_display_text_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_display_text_ctx_pack(&ctx, msg);
 }
 
 
@@ -207,73 +351,121 @@ static inline void msg_display_text_get_text(void *dst)
 // Description: This is a message to get/set the backlight mode of a display.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_display_backlight_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 40);
+  pkg_headerext_get_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_display_backlight_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(40);
-  pkg_headerext_get_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_display_backlight_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Set".
+static inline void pkg_header_ctx_init_display_backlight_set(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 1);
+  pkg_headerext_set_ctx_set_messagegroupid(ctx, 40);
+  pkg_headerext_set_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 1;
+}
+
 static inline void pkg_header_init_display_backlight_set(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(1);
-  pkg_headerext_set_set_messagegroupid(40);
-  pkg_headerext_set_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 1;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_display_backlight_set(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "SetGet".
+static inline void pkg_header_ctx_init_display_backlight_setget(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 2);
+  pkg_headerext_setget_ctx_set_messagegroupid(ctx, 40);
+  pkg_headerext_setget_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 2;
+}
+
 static inline void pkg_header_init_display_backlight_setget(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(2);
-  pkg_headerext_setget_set_messagegroupid(40);
-  pkg_headerext_setget_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 2;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_display_backlight_setget(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_display_backlight_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 40);
+  pkg_headerext_status_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_display_backlight_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(40);
-  pkg_headerext_status_set_messageid(2);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_display_backlight_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Ack".
+static inline void pkg_header_ctx_init_display_backlight_ack(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 9);
+  ctx->headeroffsetbits = 109;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 9;
+}
+
 static inline void pkg_header_init_display_backlight_ack(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(9);
-  __HEADEROFFSETBITS = 109;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 9;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_display_backlight_ack(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_display_backlight_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 40);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_display_backlight_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(40);
-  pkg_headerext_ackstatus_set_messageid(2);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_display_backlight_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Mode (EnumValue)
@@ -290,16 +482,26 @@ typedef enum {
 
 // Set Mode (EnumValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 4
+static inline void msg_display_backlight_ctx_set_mode(const pkg_ctx_t * ctx, ModeEnum val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 4, val, ctx->buf);
+}
+
 static inline void msg_display_backlight_set_mode(ModeEnum val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 4, val, bufx);
+  msg_display_backlight_ctx_set_mode(PKG_CTX_GLOBAL, val);
 }
 
 // Get Mode (EnumValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 4
+static inline ModeEnum msg_display_backlight_ctx_get_mode(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 4, 0, 15, ctx->buf);
+}
+
 static inline ModeEnum msg_display_backlight_get_mode(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 4, 0, 15, bufx);
+  return msg_display_backlight_ctx_get_mode(PKG_CTX_GLOBAL);
 }
 
 // AutoTimeoutSec (UIntValue)
@@ -307,16 +509,76 @@ static inline ModeEnum msg_display_backlight_get_mode(void)
 
 // Set AutoTimeoutSec (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 4, length bits 8, min val 0, max val 255
+static inline void msg_display_backlight_ctx_set_autotimeoutsec(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 4, 8, val, ctx->buf);
+}
+
 static inline void msg_display_backlight_set_autotimeoutsec(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 4, 8, val, bufx);
+  msg_display_backlight_ctx_set_autotimeoutsec(PKG_CTX_GLOBAL, val);
 }
 
 // Get AutoTimeoutSec (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 4, length bits 8, min val 0, max val 255
+static inline uint32_t msg_display_backlight_ctx_get_autotimeoutsec(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 4, 8, 0, 255, ctx->buf);
+}
+
 static inline uint32_t msg_display_backlight_get_autotimeoutsec(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 4, 8, 0, 255, bufx);
+  return msg_display_backlight_ctx_get_autotimeoutsec(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  ModeEnum mode;
+  uint8_t autotimeoutsec;
+} msg_display_backlight_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_display_backlight_ctx_unpack(const pkg_ctx_t * ctx, msg_display_backlight_t * msg) __attribute__ ((unused));
+static void msg_display_backlight_ctx_unpack(const pkg_ctx_t * ctx, msg_display_backlight_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->mode = (ModeEnum)bitstream_read_bits(&bs, 4);
+  msg->autotimeoutsec = bitstream_read_bits(&bs, 8);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_display_backlight_unpack(const uint8_t * buf, msg_display_backlight_t * msg) __attribute__ ((unused));
+static void msg_display_backlight_unpack(const uint8_t * buf, msg_display_backlight_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_display_backlight_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_display_backlight_ctx_pack(const pkg_ctx_t * ctx, const msg_display_backlight_t * msg) __attribute__ ((unused));
+static void msg_display_backlight_ctx_pack(const pkg_ctx_t * ctx, const msg_display_backlight_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 4, msg->mode);
+  bitstream_write_bits(&bs, 8, msg->autotimeoutsec);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_display_backlight_pack(const msg_display_backlight_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_display_backlight_pack(const msg_display_backlight_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_display_backlight_ctx_pack(&ctx, msg);
 }
 
 #endif /* _MSGGRP_DISPLAY_H */
@@ -58,39 +58,63 @@ typedef enum {
 // Data fields: Brightness
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_environment_brightness_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 11);
+  pkg_headerext_get_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_environment_brightness_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(11);
-  pkg_headerext_get_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_environment_brightness_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_environment_brightness_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 11);
+  pkg_headerext_status_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_environment_brightness_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(11);
-  pkg_headerext_status_set_messageid(1);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_environment_brightness_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_environment_brightness_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 11);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_environment_brightness_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(11);
-  pkg_headerext_ackstatus_set_messageid(1);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_environment_brightness_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Brightness (UIntValue)
@@ -98,16 +122,73 @@ static inline void pkg_header_init_environment_brightness_ackstatus(void)
 
 // Set Brightness (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 7, min val 0, max val 100
+static inline void msg_environment_brightness_ctx_set_brightness(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 7, val, ctx->buf);
+}
+
 static inline void msg_environment_brightness_set_brightness(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 7, val, bufx);
+  msg_environment_brightness_ctx_set_brightness(PKG_CTX_GLOBAL, val);
 }
 
 // Get Brightness (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 7, min val 0, max val 100
+static inline uint32_t msg_environment_brightness_ctx_get_brightness(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 7, 0, 100, ctx->buf);
+}
+
 static inline uint32_t msg_environment_brightness_get_brightness(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 7, 0, 100, bufx);
+  return msg_environment_brightness_ctx_get_brightness(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint8_t brightness;
+} msg_environment_brightness_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_environment_brightness_ctx_unpack(const pkg_ctx_t * ctx, msg_environment_brightness_t * msg) __attribute__ ((unused));
+static void msg_environment_brightness_ctx_unpack(const pkg_ctx_t * ctx, msg_environment_brightness_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->brightness = bitstream_read_UIntValue32(&bs, 7, 0, 100);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_environment_brightness_unpack(const uint8_t * buf, msg_environment_brightness_t * msg) __attribute__ ((unused));
+static void msg_environment_brightness_unpack(const uint8_t * buf, msg_environment_brightness_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_environment_brightness_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_environment_brightness_ctx_pack(const pkg_ctx_t * ctx, const msg_environment_brightness_t * msg) __attribute__ ((unused));
+static void msg_environment_brightness_ctx_pack(const pkg_ctx_t * ctx, const msg_environment_brightness_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 7, msg->brightness);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_environment_brightness_pack(const msg_environment_brightness_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_environment_brightness_pack(const msg_environment_brightness_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_environment_brightness_ctx_pack(&ctx, msg);
 }
 
 
@@ -121,39 +202,63 @@ static inline uint32_t msg_environment_brightness_get_brightness(void)
 // Data fields: Distance
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_environment_distance_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 11);
+  pkg_headerext_get_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_environment_distance_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(11);
-  pkg_headerext_get_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_environment_distance_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_environment_distance_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 11);
+  pkg_headerext_status_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_environment_distance_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(11);
-  pkg_headerext_status_set_messageid(2);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_environment_distance_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_environment_distance_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 11);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_environment_distance_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(11);
-  pkg_headerext_ackstatus_set_messageid(2);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_environment_distance_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Distance (UIntValue)
@@ -161,16 +266,73 @@ static inline void pkg_header_init_environment_distance_ackstatus(void)
 
 // Set Distance (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 14, min val 0, max val 16383
+static inline void msg_environment_distance_ctx_set_distance(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 14, val, ctx->buf);
+}
+
 static inline void msg_environment_distance_set_distance(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 14, val, bufx);
+  msg_environment_distance_ctx_set_distance(PKG_CTX_GLOBAL, val);
 }
 
 // Get Distance (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 14, min val 0, max val 16383
+static inline uint32_t msg_environment_distance_ctx_get_distance(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 14, 0, 16383, ctx->buf);
+}
+
 static inline uint32_t msg_environment_distance_get_distance(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 14, 0, 16383, bufx);
+  return msg_environment_distance_ctx_get_distance(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint16_t distance;
+} msg_environment_distance_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_environment_distance_ctx_unpack(const pkg_ctx_t * ctx, msg_environment_distance_t * msg) __attribute__ ((unused));
+static void msg_environment_distance_ctx_unpack(const pkg_ctx_t * ctx, msg_environment_distance_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->distance = bitstream_read_bits(&bs, 14);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_environment_distance_unpack(const uint8_t * buf, msg_environment_distance_t * msg) __attribute__ ((unused));
+static void msg_environment_distance_unpack(const uint8_t * buf, msg_environment_distance_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_environment_distance_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_environment_distance_ctx_pack(const pkg_ctx_t * ctx, const msg_environment_distance_t * msg) __attribute__ ((unused));
+static void msg_environment_distance_ctx_pack(const pkg_ctx_t * ctx, const msg_environment_distance_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 14, msg->distance);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_environment_distance_pack(const msg_environment_distance_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_environment_distance_pack(const msg_environment_distance_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_environment_distance_ctx_pack(&ctx, msg);
 }
 
 
@@ -184,39 +346,63 @@ static inline uint32_t msg_environment_distance_get_distance(void)
 // Data fields: TypicalParticleSize, Size, MassConcentration, NumberConcentration
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_environment_particulatematter_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 11);
+  pkg_headerext_get_ctx_set_messageid(ctx, 3);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_environment_particulatematter_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(11);
-  pkg_headerext_get_set_messageid(3);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_environment_particulatematter_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_environment_particulatematter_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 11);
+  pkg_headerext_status_ctx_set_messageid(ctx, 3);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_environment_particulatematter_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(11);
-  pkg_headerext_status_set_messageid(3);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_environment_particulatematter_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_environment_particulatematter_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 11);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 3);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 48;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_environment_particulatematter_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(11);
-  pkg_headerext_ackstatus_set_messageid(3);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 48;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_environment_particulatematter_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // TypicalParticleSize (UIntValue)
@@ -224,16 +410,26 @@ static inline void pkg_header_init_environment_particulatematter_ackstatus(void)
 
 // Set TypicalParticleSize (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 10, min val 0, max val 1023
+static inline void msg_environment_particulatematter_ctx_set_typicalparticlesize(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 10, val, ctx->buf);
+}
+
 static inline void msg_environment_particulatematter_set_typicalparticlesize(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 10, val, bufx);
+  msg_environment_particulatematter_ctx_set_typicalparticlesize(PKG_CTX_GLOBAL, val);
 }
 
 // Get TypicalParticleSize (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 10, min val 0, max val 1023
+static inline uint32_t msg_environment_particulatematter_ctx_get_typicalparticlesize(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 10, 0, 1023, ctx->buf);
+}
+
 static inline uint32_t msg_environment_particulatematter_get_typicalparticlesize(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 10, 0, 1023, bufx);
+  return msg_environment_particulatematter_ctx_get_typicalparticlesize(PKG_CTX_GLOBAL);
 }
 
 // Size (UIntValue[5])
@@ -242,16 +438,26 @@ static inline uint32_t msg_environment_particulatematter_get_typicalparticlesize
 
 // Set Size (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 10 + (uint16_t)index * 30, length bits 8, min val 0, max val 255
+static inline void msg_environment_particulatematter_ctx_set_size(const pkg_ctx_t * ctx, uint8_t index, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 10 + (uint16_t)index * 30, 8, val, ctx->buf);
+}
+
 static inline void msg_environment_particulatematter_set_size(uint8_t index, uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 10 + (uint16_t)index * 30, 8, val, bufx);
+  msg_environment_particulatematter_ctx_set_size(PKG_CTX_GLOBAL, index, val);
 }
 
 // Get Size (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 10 + (uint16_t)index * 30, length bits 8, min val 0, max val 255
+static inline uint32_t msg_environment_particulatematter_ctx_get_size(const pkg_ctx_t * ctx, uint8_t index)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 10 + (uint16_t)index * 30, 8, 0, 255, ctx->buf);
+}
+
 static inline uint32_t msg_environment_particulatematter_get_size(uint8_t index)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 10 + (uint16_t)index * 30, 8, 0, 255, bufx);
+  return msg_environment_particulatematter_ctx_get_size(PKG_CTX_GLOBAL, index);
 }
 
 // MassConcentration (UIntValue[5])
@@ -260,16 +466,26 @@ static inline uint32_t msg_environment_particulatematter_get_size(uint8_t index)
 
 // Set MassConcentration (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 18 + (uint16_t)index * 30, length bits 10, min val 0, max val 1023
+static inline void msg_environment_particulatematter_ctx_set_massconcentration(const pkg_ctx_t * ctx, uint8_t index, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 18 + (uint16_t)index * 30, 10, val, ctx->buf);
+}
+
 static inline void msg_environment_particulatematter_set_massconcentration(uint8_t index, uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 18 + (uint16_t)index * 30, 10, val, bufx);
+  msg_environment_particulatematter_ctx_set_massconcentration(PKG_CTX_GLOBAL, index, val);
 }
 
 // Get MassConcentration (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 18 + (uint16_t)index * 30, length bits 10, min val 0, max val 1023
+static inline uint32_t msg_environment_particulatematter_ctx_get_massconcentration(const pkg_ctx_t * ctx, uint8_t index)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 18 + (uint16_t)index * 30, 10, 0, 1023, ctx->buf);
+}
+
 static inline uint32_t msg_environment_particulatematter_get_massconcentration(uint8_t index)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 18 + (uint16_t)index * 30, 10, 0, 1023, bufx);
+  return msg_environment_particulatematter_ctx_get_massconcentration(PKG_CTX_GLOBAL, index);
 }
 
 // NumberConcentration (UIntValue[5])
@@ -278,16 +494,92 @@ static inline uint32_t msg_environment_particulatematter_get_massconcentration(u
 
 // Set NumberConcentration (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 28 + (uint16_t)index * 30, length bits 12, min val 0, max val 4095
+static inline void msg_environment_particulatematter_ctx_set_numberconcentration(const pkg_ctx_t * ctx, uint8_t index, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 28 + (uint16_t)index * 30, 12, val, ctx->buf);
+}
+
 static inline void msg_environment_particulatematter_set_numberconcentration(uint8_t index, uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 28 + (uint16_t)index * 30, 12, val, bufx);
+  msg_environment_particulatematter_ctx_set_numberconcentration(PKG_CTX_GLOBAL, index, val);
 }
 
 // Get NumberConcentration (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 28 + (uint16_t)index * 30, length bits 12, min val 0, max val 4095
+static inline uint32_t msg_environment_particulatematter_ctx_get_numberconcentration(const pkg_ctx_t * ctx, uint8_t index)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 28 + (uint16_t)index * 30, 12, 0, 4095, ctx->buf);
+}
+
 static inline uint32_t msg_environment_particulatematter_get_numberconcentration(uint8_t index)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 28 + (uint16_t)index * 30, 12, 0, 4095, bufx);
+  return msg_environment_particulatematter_ctx_get_numberconcentration(PKG_CTX_GLOBAL, index);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint16_t typicalparticlesize;
+  uint8_t size[5];
+  uint16_t massconcentration[5];
+  uint16_t numberconcentration[5];
+} msg_environment_particulatematter_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_environment_particulatematter_ctx_unpack(const pkg_ctx_t * ctx, msg_environment_particulatematter_t * msg) __attribute__ ((unused));
+static void msg_environment_particulatematter_ctx_unpack(const pkg_ctx_t * ctx, msg_environment_particulatematter_t * msg)
+{
+  bitstream_t bs;
+  uint8_t i;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->typicalparticlesize = bitstream_read_bits(&bs, 10);
+
+  for (i = 0; i < 5; i++)
+  {
+    msg->size[i] = bitstream_read_bits(&bs, 8);
+    msg->massconcentration[i] = bitstream_read_bits(&bs, 10);
+    msg->numberconcentration[i] = bitstream_read_bits(&bs, 12);
+  }
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_environment_particulatematter_unpack(const uint8_t * buf, msg_environment_particulatematter_t * msg) __attribute__ ((unused));
+static void msg_environment_particulatematter_unpack(const uint8_t * buf, msg_environment_particulatematter_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_environment_particulatematter_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_environment_particulatematter_ctx_pack(const pkg_ctx_t * ctx, const msg_environment_particulatematter_t * msg) __attribute__ ((unused));
+static void msg_environment_particulatematter_ctx_pack(const pkg_ctx_t * ctx, const msg_environment_particulatematter_t * msg)
+{
+  bitstream_t bs;
+  uint8_t i;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 10, msg->typicalparticlesize);
+
+  for (i = 0; i < 5; i++)
+  {
+    bitstream_write_bits(&bs, 8, msg->size[i]);
+    bitstream_write_bits(&bs, 10, msg->massconcentration[i]);
+    bitstream_write_bits(&bs, 12, msg->numberconcentration[i]);
+  }
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_environment_particulatematter_pack(const msg_environment_particulatematter_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_environment_particulatematter_pack(const msg_environment_particulatematter_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_environment_particulatematter_ctx_pack(&ctx, msg);
 }
 
 #endif /* _MSGGRP_ENVIRONMENT_H */
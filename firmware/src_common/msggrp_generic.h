@@ -59,39 +59,63 @@ typedef enum {
 // Description: Reports DeviceType and current firmware version. Version information is only available when set in source code, which is usually only done for official builds by the build robot.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_generic_deviceinfo_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 0);
+  pkg_headerext_get_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_generic_deviceinfo_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(0);
-  pkg_headerext_get_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_generic_deviceinfo_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_generic_deviceinfo_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 0);
+  pkg_headerext_status_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_generic_deviceinfo_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(0);
-  pkg_headerext_status_set_messageid(2);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_generic_deviceinfo_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_generic_deviceinfo_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 0);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_generic_deviceinfo_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(0);
-  pkg_headerext_ackstatus_set_messageid(2);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_generic_deviceinfo_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // DeviceType (EnumValue)
@@ -114,16 +138,26 @@ typedef enum {
 
 // Set DeviceType (EnumValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 8
+static inline void msg_generic_deviceinfo_ctx_set_devicetype(const pkg_ctx_t * ctx, DeviceTypeEnum val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 8, val, ctx->buf);
+}
+
 static inline void msg_generic_deviceinfo_set_devicetype(DeviceTypeEnum val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 8, val, bufx);
+  msg_generic_deviceinfo_ctx_set_devicetype(PKG_CTX_GLOBAL, val);
 }
 
 // Get DeviceType (EnumValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 8
+static inline DeviceTypeEnum msg_generic_deviceinfo_ctx_get_devicetype(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 8, 0, 255, ctx->buf);
+}
+
 static inline DeviceTypeEnum msg_generic_deviceinfo_get_devicetype(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 8, 0, 255, bufx);
+  return msg_generic_deviceinfo_ctx_get_devicetype(PKG_CTX_GLOBAL);
 }
 
 // VersionMajor (UIntValue)
@@ -131,16 +165,26 @@ static inline DeviceTypeEnum msg_generic_deviceinfo_get_devicetype(void)
 
 // Set VersionMajor (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 8, length bits 8, min val 0, max val 255
+static inline void msg_generic_deviceinfo_ctx_set_versionmajor(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 8, 8, val, ctx->buf);
+}
+
 static inline void msg_generic_deviceinfo_set_versionmajor(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 8, 8, val, bufx);
+  msg_generic_deviceinfo_ctx_set_versionmajor(PKG_CTX_GLOBAL, val);
 }
 
 // Get VersionMajor (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 8, length bits 8, min val 0, max val 255
+static inline uint32_t msg_generic_deviceinfo_ctx_get_versionmajor(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 8, 8, 0, 255, ctx->buf);
+}
+
 static inline uint32_t msg_generic_deviceinfo_get_versionmajor(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 8, 8, 0, 255, bufx);
+  return msg_generic_deviceinfo_ctx_get_versionmajor(PKG_CTX_GLOBAL);
 }
 
 // VersionMinor (UIntValue)
@@ -148,16 +192,26 @@ static inline uint32_t msg_generic_deviceinfo_get_versionmajor(void)
 
 // Set VersionMinor (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 16, length bits 8, min val 0, max val 255
+static inline void msg_generic_deviceinfo_ctx_set_versionminor(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 16, 8, val, ctx->buf);
+}
+
 static inline void msg_generic_deviceinfo_set_versionminor(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 16, 8, val, bufx);
+  msg_generic_deviceinfo_ctx_set_versionminor(PKG_CTX_GLOBAL, val);
 }
 
 // Get VersionMinor (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 16, length bits 8, min val 0, max val 255
+static inline uint32_t msg_generic_deviceinfo_ctx_get_versionminor(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 16, 8, 0, 255, ctx->buf);
+}
+
 static inline uint32_t msg_generic_deviceinfo_get_versionminor(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 16, 8, 0, 255, bufx);
+  return msg_generic_deviceinfo_ctx_get_versionminor(PKG_CTX_GLOBAL);
 }
 
 // VersionPatch (UIntValue)
@@ -165,16 +219,26 @@ static inline uint32_t msg_generic_deviceinfo_get_versionminor(void)
 
 // Set VersionPatch (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 24, length bits 8, min val 0, max val 255
+static inline void msg_generic_deviceinfo_ctx_set_versionpatch(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 24, 8, val, ctx->buf);
+}
+
 static inline void msg_generic_deviceinfo_set_versionpatch(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 24, 8, val, bufx);
+  msg_generic_deviceinfo_ctx_set_versionpatch(PKG_CTX_GLOBAL, val);
 }
 
 // Get VersionPatch (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 24, length bits 8, min val 0, max val 255
+static inline uint32_t msg_generic_deviceinfo_ctx_get_versionpatch(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 24, 8, 0, 255, ctx->buf);
+}
+
 static inline uint32_t msg_generic_deviceinfo_get_versionpatch(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 24, 8, 0, 255, bufx);
+  return msg_generic_deviceinfo_ctx_get_versionpatch(PKG_CTX_GLOBAL);
 }
 
 // VersionHash (UIntValue)
@@ -182,16 +246,85 @@ static inline uint32_t msg_generic_deviceinfo_get_versionpatch(void)
 
 // Set VersionHash (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 32, length bits 32, min val 0, max val 4294967295
+static inline void msg_generic_deviceinfo_ctx_set_versionhash(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 32, 32, val, ctx->buf);
+}
+
 static inline void msg_generic_deviceinfo_set_versionhash(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 32, 32, val, bufx);
+  msg_generic_deviceinfo_ctx_set_versionhash(PKG_CTX_GLOBAL, val);
 }
 
 // Get VersionHash (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 32, length bits 32, min val 0, max val 4294967295
+static inline uint32_t msg_generic_deviceinfo_ctx_get_versionhash(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 32, 32, 0, 4294967295, ctx->buf);
+}
+
 static inline uint32_t msg_generic_deviceinfo_get_versionhash(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 32, 32, 0, 4294967295, bufx);
+  return msg_generic_deviceinfo_ctx_get_versionhash(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  DeviceTypeEnum devicetype;
+  uint8_t versionmajor;
+  uint8_t versionminor;
+  uint8_t versionpatch;
+  uint32_t versionhash;
+} msg_generic_deviceinfo_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_generic_deviceinfo_ctx_unpack(const pkg_ctx_t * ctx, msg_generic_deviceinfo_t * msg) __attribute__ ((unused));
+static void msg_generic_deviceinfo_ctx_unpack(const pkg_ctx_t * ctx, msg_generic_deviceinfo_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->devicetype = (DeviceTypeEnum)bitstream_read_bits(&bs, 8);
+  msg->versionmajor = bitstream_read_bits(&bs, 8);
+  msg->versionminor = bitstream_read_bits(&bs, 8);
+  msg->versionpatch = bitstream_read_bits(&bs, 8);
+  msg->versionhash = bitstream_read_bits(&bs, 32);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_generic_deviceinfo_unpack(const uint8_t * buf, msg_generic_deviceinfo_t * msg) __attribute__ ((unused));
+static void msg_generic_deviceinfo_unpack(const uint8_t * buf, msg_generic_deviceinfo_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_generic_deviceinfo_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_generic_deviceinfo_ctx_pack(const pkg_ctx_t * ctx, const msg_generic_deviceinfo_t * msg) __attribute__ ((unused));
+static void msg_generic_deviceinfo_ctx_pack(const pkg_ctx_t * ctx, const msg_generic_deviceinfo_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 8, msg->devicetype);
+  bitstream_write_bits(&bs, 8, msg->versionmajor);
+  bitstream_write_bits(&bs, 8, msg->versionminor);
+  bitstream_write_bits(&bs, 8, msg->versionpatch);
+  bitstream_write_bits(&bs, 32, msg->versionhash);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_generic_deviceinfo_pack(const msg_generic_deviceinfo_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_generic_deviceinfo_pack(const msg_generic_deviceinfo_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_generic_deviceinfo_ctx_pack(&ctx, msg);
 }
 
 
@@ -206,15 +339,23 @@ static inline uint32_t msg_generic_deviceinfo_get_versionhash(void)
 // Description: Reports detected problems with the hardware.
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_generic_hardwareerror_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 0);
+  pkg_headerext_status_ctx_set_messageid(ctx, 3);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_generic_hardwareerror_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(0);
-  pkg_headerext_status_set_messageid(3);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_generic_hardwareerror_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // ErrorCode (EnumValue)
@@ -232,16 +373,73 @@ typedef enum {
 
 // Set ErrorCode (EnumValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 8
+static inline void msg_generic_hardwareerror_ctx_set_errorcode(const pkg_ctx_t * ctx, ErrorCodeEnum val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 8, val, ctx->buf);
+}
+
 static inline void msg_generic_hardwareerror_set_errorcode(ErrorCodeEnum val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 8, val, bufx);
+  msg_generic_hardwareerror_ctx_set_errorcode(PKG_CTX_GLOBAL, val);
 }
 
 // Get ErrorCode (EnumValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 8
+static inline ErrorCodeEnum msg_generic_hardwareerror_ctx_get_errorcode(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 8, 0, 255, ctx->buf);
+}
+
 static inline ErrorCodeEnum msg_generic_hardwareerror_get_errorcode(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 8, 0, 255, bufx);
+  return msg_generic_hardwareerror_ctx_get_errorcode(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  ErrorCodeEnum errorcode;
+} msg_generic_hardwareerror_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_generic_hardwareerror_ctx_unpack(const pkg_ctx_t * ctx, msg_generic_hardwareerror_t * msg) __attribute__ ((unused));
+static void msg_generic_hardwareerror_ctx_unpack(const pkg_ctx_t * ctx, msg_generic_hardwareerror_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->errorcode = (ErrorCodeEnum)bitstream_read_bits(&bs, 8);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_generic_hardwareerror_unpack(const uint8_t * buf, msg_generic_hardwareerror_t * msg) __attribute__ ((unused));
+static void msg_generic_hardwareerror_unpack(const uint8_t * buf, msg_generic_hardwareerror_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_generic_hardwareerror_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_generic_hardwareerror_ctx_pack(const pkg_ctx_t * ctx, const msg_generic_hardwareerror_t * msg) __attribute__ ((unused));
+static void msg_generic_hardwareerror_ctx_pack(const pkg_ctx_t * ctx, const msg_generic_hardwareerror_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 8, msg->errorcode);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_generic_hardwareerror_pack(const msg_generic_hardwareerror_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_generic_hardwareerror_pack(const msg_generic_hardwareerror_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_generic_hardwareerror_ctx_pack(&ctx, msg);
 }
 
 
@@ -256,39 +454,63 @@ static inline ErrorCodeEnum msg_generic_hardwareerror_get_errorcode(void)
 // Description: Tells the current battery status in percent. Please note that the "Get" may not be answered because a device does not listen to requests.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_generic_batterystatus_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 0);
+  pkg_headerext_get_ctx_set_messageid(ctx, 5);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_generic_batterystatus_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(0);
-  pkg_headerext_get_set_messageid(5);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_generic_batterystatus_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_generic_batterystatus_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 0);
+  pkg_headerext_status_ctx_set_messageid(ctx, 5);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_generic_batterystatus_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(0);
-  pkg_headerext_status_set_messageid(5);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_generic_batterystatus_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_generic_batterystatus_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 0);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 5);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_generic_batterystatus_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(0);
-  pkg_headerext_ackstatus_set_messageid(5);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_generic_batterystatus_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Percentage (UIntValue)
@@ -296,16 +518,73 @@ static inline void pkg_header_init_generic_batterystatus_ackstatus(void)
 
 // Set Percentage (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 7, min val 0, max val 100
+static inline void msg_generic_batterystatus_ctx_set_percentage(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 7, val, ctx->buf);
+}
+
 static inline void msg_generic_batterystatus_set_percentage(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 7, val, bufx);
+  msg_generic_batterystatus_ctx_set_percentage(PKG_CTX_GLOBAL, val);
 }
 
 // Get Percentage (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 7, min val 0, max val 100
+static inline uint32_t msg_generic_batterystatus_ctx_get_percentage(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 7, 0, 100, ctx->buf);
+}
+
 static inline uint32_t msg_generic_batterystatus_get_percentage(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 7, 0, 100, bufx);
+  return msg_generic_batterystatus_ctx_get_percentage(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint8_t percentage;
+} msg_generic_batterystatus_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_generic_batterystatus_ctx_unpack(const pkg_ctx_t * ctx, msg_generic_batterystatus_t * msg) __attribute__ ((unused));
+static void msg_generic_batterystatus_ctx_unpack(const pkg_ctx_t * ctx, msg_generic_batterystatus_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->percentage = bitstream_read_UIntValue32(&bs, 7, 0, 100);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_generic_batterystatus_unpack(const uint8_t * buf, msg_generic_batterystatus_t * msg) __attribute__ ((unused));
+static void msg_generic_batterystatus_unpack(const uint8_t * buf, msg_generic_batterystatus_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_generic_batterystatus_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_generic_batterystatus_ctx_pack(const pkg_ctx_t * ctx, const msg_generic_batterystatus_t * msg) __attribute__ ((unused));
+static void msg_generic_batterystatus_ctx_pack(const pkg_ctx_t * ctx, const msg_generic_batterystatus_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 7, msg->percentage);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_generic_batterystatus_pack(const msg_generic_batterystatus_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_generic_batterystatus_pack(const msg_generic_batterystatus_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_generic_batterystatus_ctx_pack(&ctx, msg);
 }
 
 #endif /* _MSGGRP_GENERIC_H */
@@ -61,73 +61,121 @@ typedef enum {
 // Description: This is the state of the complete digital port, containing up to 8 pins.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_gpio_digitalport_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_get_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_gpio_digitalport_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(1);
-  pkg_headerext_get_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalport_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Set".
+static inline void pkg_header_ctx_init_gpio_digitalport_set(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 1);
+  pkg_headerext_set_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_set_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 1;
+}
+
 static inline void pkg_header_init_gpio_digitalport_set(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(1);
-  pkg_headerext_set_set_messagegroupid(1);
-  pkg_headerext_set_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 1;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalport_set(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "SetGet".
+static inline void pkg_header_ctx_init_gpio_digitalport_setget(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 2);
+  pkg_headerext_setget_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_setget_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 2;
+}
+
 static inline void pkg_header_init_gpio_digitalport_setget(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(2);
-  pkg_headerext_setget_set_messagegroupid(1);
-  pkg_headerext_setget_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 2;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalport_setget(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_gpio_digitalport_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_status_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_gpio_digitalport_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(1);
-  pkg_headerext_status_set_messageid(1);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalport_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Ack".
+static inline void pkg_header_ctx_init_gpio_digitalport_ack(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 9);
+  ctx->headeroffsetbits = 109;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 9;
+}
+
 static inline void pkg_header_init_gpio_digitalport_ack(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(9);
-  __HEADEROFFSETBITS = 109;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 9;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalport_ack(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_gpio_digitalport_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_gpio_digitalport_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(1);
-  pkg_headerext_ackstatus_set_messageid(1);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalport_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // On (BoolValue[8])
@@ -135,16 +183,83 @@ static inline void pkg_header_init_gpio_digitalport_ackstatus(void)
 
 // Set On (BoolValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 1, length bits 1
+static inline void msg_gpio_digitalport_ctx_set_on(const pkg_ctx_t * ctx, uint8_t index, bool val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0 + (uint16_t)index * 1, 1, val ? 1 : 0, ctx->buf);
+}
+
 static inline void msg_gpio_digitalport_set_on(uint8_t index, bool val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 1, 1, val ? 1 : 0, bufx);
+  msg_gpio_digitalport_ctx_set_on(PKG_CTX_GLOBAL, index, val);
 }
 
 // Get On (BoolValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 1, length bits 1
+static inline bool msg_gpio_digitalport_ctx_get_on(const pkg_ctx_t * ctx, uint8_t index)
+{
+  return array_read_UIntValue8((uint16_t)ctx->headeroffsetbits + 0 + (uint16_t)index * 1, 1, 0, 1, ctx->buf) == 1;
+}
+
 static inline bool msg_gpio_digitalport_get_on(uint8_t index)
 {
-  return array_read_UIntValue8((uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 1, 1, 0, 1, bufx) == 1;
+  return msg_gpio_digitalport_ctx_get_on(PKG_CTX_GLOBAL, index);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  bool on[8];
+} msg_gpio_digitalport_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_gpio_digitalport_ctx_unpack(const pkg_ctx_t * ctx, msg_gpio_digitalport_t * msg) __attribute__ ((unused));
+static void msg_gpio_digitalport_ctx_unpack(const pkg_ctx_t * ctx, msg_gpio_digitalport_t * msg)
+{
+  bitstream_t bs;
+  uint8_t i;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+
+  for (i = 0; i < 8; i++)
+  {
+    msg->on[i] = bitstream_read_bits(&bs, 1) == 1;
+  }
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_gpio_digitalport_unpack(const uint8_t * buf, msg_gpio_digitalport_t * msg) __attribute__ ((unused));
+static void msg_gpio_digitalport_unpack(const uint8_t * buf, msg_gpio_digitalport_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_gpio_digitalport_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_gpio_digitalport_ctx_pack(const pkg_ctx_t * ctx, const msg_gpio_digitalport_t * msg) __attribute__ ((unused));
+static void msg_gpio_digitalport_ctx_pack(const pkg_ctx_t * ctx, const msg_gpio_digitalport_t * msg)
+{
+  bitstream_t bs;
+  uint8_t i;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+
+  for (i = 0; i < 8; i++)
+  {
+    bitstream_write_bits(&bs, 1, msg->on[i] ? 1 : 0);
+  }
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_gpio_digitalport_pack(const msg_gpio_digitalport_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_gpio_digitalport_pack(const msg_gpio_digitalport_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_gpio_digitalport_ctx_pack(&ctx, msg);
 }
 
 
@@ -159,73 +274,121 @@ static inline bool msg_gpio_digitalport_get_on(uint8_t index)
 // Description: This is the state of the complete digital port, containing up to 8 pins, including a timeout value per pin.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_gpio_digitalporttimeout_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_get_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_gpio_digitalporttimeout_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(1);
-  pkg_headerext_get_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalporttimeout_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Set".
+static inline void pkg_header_ctx_init_gpio_digitalporttimeout_set(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 1);
+  pkg_headerext_set_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_set_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 1;
+}
+
 static inline void pkg_header_init_gpio_digitalporttimeout_set(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(1);
-  pkg_headerext_set_set_messagegroupid(1);
-  pkg_headerext_set_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 1;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalporttimeout_set(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "SetGet".
+static inline void pkg_header_ctx_init_gpio_digitalporttimeout_setget(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 2);
+  pkg_headerext_setget_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_setget_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 2;
+}
+
 static inline void pkg_header_init_gpio_digitalporttimeout_setget(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(2);
-  pkg_headerext_setget_set_messagegroupid(1);
-  pkg_headerext_setget_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 2;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalporttimeout_setget(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_gpio_digitalporttimeout_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_status_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_gpio_digitalporttimeout_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(1);
-  pkg_headerext_status_set_messageid(2);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalporttimeout_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Ack".
+static inline void pkg_header_ctx_init_gpio_digitalporttimeout_ack(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 9);
+  ctx->headeroffsetbits = 109;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 9;
+}
+
 static inline void pkg_header_init_gpio_digitalporttimeout_ack(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(9);
-  __HEADEROFFSETBITS = 109;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 9;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalporttimeout_ack(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_gpio_digitalporttimeout_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_gpio_digitalporttimeout_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(1);
-  pkg_headerext_ackstatus_set_messageid(2);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalporttimeout_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // On (BoolValue[8])
@@ -234,16 +397,26 @@ static inline void pkg_header_init_gpio_digitalporttimeout_ackstatus(void)
 
 // Set On (BoolValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 17, length bits 1
+static inline void msg_gpio_digitalporttimeout_ctx_set_on(const pkg_ctx_t * ctx, uint8_t index, bool val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0 + (uint16_t)index * 17, 1, val ? 1 : 0, ctx->buf);
+}
+
 static inline void msg_gpio_digitalporttimeout_set_on(uint8_t index, bool val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 17, 1, val ? 1 : 0, bufx);
+  msg_gpio_digitalporttimeout_ctx_set_on(PKG_CTX_GLOBAL, index, val);
 }
 
 // Get On (BoolValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 17, length bits 1
+static inline bool msg_gpio_digitalporttimeout_ctx_get_on(const pkg_ctx_t * ctx, uint8_t index)
+{
+  return array_read_UIntValue8((uint16_t)ctx->headeroffsetbits + 0 + (uint16_t)index * 17, 1, 0, 1, ctx->buf) == 1;
+}
+
 static inline bool msg_gpio_digitalporttimeout_get_on(uint8_t index)
 {
-  return array_read_UIntValue8((uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 17, 1, 0, 1, bufx) == 1;
+  return msg_gpio_digitalporttimeout_ctx_get_on(PKG_CTX_GLOBAL, index);
 }
 
 // TimeoutSec (UIntValue[8])
@@ -252,16 +425,86 @@ static inline bool msg_gpio_digitalporttimeout_get_on(uint8_t index)
 
 // Set TimeoutSec (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 1 + (uint16_t)index * 17, length bits 16, min val 0, max val 65535
+static inline void msg_gpio_digitalporttimeout_ctx_set_timeoutsec(const pkg_ctx_t * ctx, uint8_t index, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 1 + (uint16_t)index * 17, 16, val, ctx->buf);
+}
+
 static inline void msg_gpio_digitalporttimeout_set_timeoutsec(uint8_t index, uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 1 + (uint16_t)index * 17, 16, val, bufx);
+  msg_gpio_digitalporttimeout_ctx_set_timeoutsec(PKG_CTX_GLOBAL, index, val);
 }
 
 // Get TimeoutSec (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 1 + (uint16_t)index * 17, length bits 16, min val 0, max val 65535
+static inline uint32_t msg_gpio_digitalporttimeout_ctx_get_timeoutsec(const pkg_ctx_t * ctx, uint8_t index)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 1 + (uint16_t)index * 17, 16, 0, 65535, ctx->buf);
+}
+
 static inline uint32_t msg_gpio_digitalporttimeout_get_timeoutsec(uint8_t index)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 1 + (uint16_t)index * 17, 16, 0, 65535, bufx);
+  return msg_gpio_digitalporttimeout_ctx_get_timeoutsec(PKG_CTX_GLOBAL, index);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  bool on[8];
+  uint16_t timeoutsec[8];
+} msg_gpio_digitalporttimeout_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_gpio_digitalporttimeout_ctx_unpack(const pkg_ctx_t * ctx, msg_gpio_digitalporttimeout_t * msg) __attribute__ ((unused));
+static void msg_gpio_digitalporttimeout_ctx_unpack(const pkg_ctx_t * ctx, msg_gpio_digitalporttimeout_t * msg)
+{
+  bitstream_t bs;
+  uint8_t i;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+
+  for (i = 0; i < 8; i++)
+  {
+    msg->on[i] = bitstream_read_bits(&bs, 1) == 1;
+    msg->timeoutsec[i] = bitstream_read_bits(&bs, 16);
+  }
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_gpio_digitalporttimeout_unpack(const uint8_t * buf, msg_gpio_digitalporttimeout_t * msg) __attribute__ ((unused));
+static void msg_gpio_digitalporttimeout_unpack(const uint8_t * buf, msg_gpio_digitalporttimeout_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_gpio_digitalporttimeout_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_gpio_digitalporttimeout_ctx_pack(const pkg_ctx_t * ctx, const msg_gpio_digitalporttimeout_t * msg) __attribute__ ((unused));
+static void msg_gpio_digitalporttimeout_ctx_pack(const pkg_ctx_t * ctx, const msg_gpio_digitalporttimeout_t * msg)
+{
+  bitstream_t bs;
+  uint8_t i;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+
+  for (i = 0; i < 8; i++)
+  {
+    bitstream_write_bits(&bs, 1, msg->on[i] ? 1 : 0);
+    bitstream_write_bits(&bs, 16, msg->timeoutsec[i]);
+  }
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_gpio_digitalporttimeout_pack(const msg_gpio_digitalporttimeout_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_gpio_digitalporttimeout_pack(const msg_gpio_digitalporttimeout_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_gpio_digitalporttimeout_ctx_pack(&ctx, msg);
 }
 
 
@@ -276,73 +519,121 @@ static inline uint32_t msg_gpio_digitalporttimeout_get_timeoutsec(uint8_t index)
 // Description: This represents the state of one pin of the digital port.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_gpio_digitalpin_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_get_ctx_set_messageid(ctx, 5);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_gpio_digitalpin_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(1);
-  pkg_headerext_get_set_messageid(5);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalpin_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Set".
+static inline void pkg_header_ctx_init_gpio_digitalpin_set(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 1);
+  pkg_headerext_set_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_set_ctx_set_messageid(ctx, 5);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 1;
+}
+
 static inline void pkg_header_init_gpio_digitalpin_set(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(1);
-  pkg_headerext_set_set_messagegroupid(1);
-  pkg_headerext_set_set_messageid(5);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 1;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalpin_set(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "SetGet".
+static inline void pkg_header_ctx_init_gpio_digitalpin_setget(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 2);
+  pkg_headerext_setget_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_setget_ctx_set_messageid(ctx, 5);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 2;
+}
+
 static inline void pkg_header_init_gpio_digitalpin_setget(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(2);
-  pkg_headerext_setget_set_messagegroupid(1);
-  pkg_headerext_setget_set_messageid(5);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 2;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalpin_setget(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_gpio_digitalpin_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_status_ctx_set_messageid(ctx, 5);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_gpio_digitalpin_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(1);
-  pkg_headerext_status_set_messageid(5);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalpin_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Ack".
+static inline void pkg_header_ctx_init_gpio_digitalpin_ack(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 9);
+  ctx->headeroffsetbits = 109;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 9;
+}
+
 static inline void pkg_header_init_gpio_digitalpin_ack(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(9);
-  __HEADEROFFSETBITS = 109;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 9;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalpin_ack(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_gpio_digitalpin_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 5);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_gpio_digitalpin_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(1);
-  pkg_headerext_ackstatus_set_messageid(5);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalpin_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Pos (UIntValue)
@@ -350,16 +641,26 @@ static inline void pkg_header_init_gpio_digitalpin_ackstatus(void)
 
 // Set Pos (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 3, min val 0, max val 7
+static inline void msg_gpio_digitalpin_ctx_set_pos(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 3, val, ctx->buf);
+}
+
 static inline void msg_gpio_digitalpin_set_pos(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 3, val, bufx);
+  msg_gpio_digitalpin_ctx_set_pos(PKG_CTX_GLOBAL, val);
 }
 
 // Get Pos (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 3, min val 0, max val 7
+static inline uint32_t msg_gpio_digitalpin_ctx_get_pos(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 3, 0, 7, ctx->buf);
+}
+
 static inline uint32_t msg_gpio_digitalpin_get_pos(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 3, 0, 7, bufx);
+  return msg_gpio_digitalpin_ctx_get_pos(PKG_CTX_GLOBAL);
 }
 
 // On (BoolValue)
@@ -367,16 +668,76 @@ static inline uint32_t msg_gpio_digitalpin_get_pos(void)
 
 // Set On (BoolValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 3, length bits 1
+static inline void msg_gpio_digitalpin_ctx_set_on(const pkg_ctx_t * ctx, bool val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 3, 1, val ? 1 : 0, ctx->buf);
+}
+
 static inline void msg_gpio_digitalpin_set_on(bool val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 3, 1, val ? 1 : 0, bufx);
+  msg_gpio_digitalpin_ctx_set_on(PKG_CTX_GLOBAL, val);
 }
 
 // Get On (BoolValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 3, length bits 1
+static inline bool msg_gpio_digitalpin_ctx_get_on(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue8((uint16_t)ctx->headeroffsetbits + 3, 1, 0, 1, ctx->buf) == 1;
+}
+
 static inline bool msg_gpio_digitalpin_get_on(void)
 {
-  return array_read_UIntValue8((uint16_t)__HEADEROFFSETBITS + 3, 1, 0, 1, bufx) == 1;
+  return msg_gpio_digitalpin_ctx_get_on(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint8_t pos;
+  bool on;
+} msg_gpio_digitalpin_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_gpio_digitalpin_ctx_unpack(const pkg_ctx_t * ctx, msg_gpio_digitalpin_t * msg) __attribute__ ((unused));
+static void msg_gpio_digitalpin_ctx_unpack(const pkg_ctx_t * ctx, msg_gpio_digitalpin_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->pos = bitstream_read_bits(&bs, 3);
+  msg->on = bitstream_read_bits(&bs, 1) == 1;
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_gpio_digitalpin_unpack(const uint8_t * buf, msg_gpio_digitalpin_t * msg) __attribute__ ((unused));
+static void msg_gpio_digitalpin_unpack(const uint8_t * buf, msg_gpio_digitalpin_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_gpio_digitalpin_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_gpio_digitalpin_ctx_pack(const pkg_ctx_t * ctx, const msg_gpio_digitalpin_t * msg) __attribute__ ((unused));
+static void msg_gpio_digitalpin_ctx_pack(const pkg_ctx_t * ctx, const msg_gpio_digitalpin_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 3, msg->pos);
+  bitstream_write_bits(&bs, 1, msg->on ? 1 : 0);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_gpio_digitalpin_pack(const msg_gpio_digitalpin_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_gpio_digitalpin_pack(const msg_gpio_digitalpin_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_gpio_digitalpin_ctx_pack(&ctx, msg);
 }
 
 
@@ -391,73 +752,121 @@ static inline bool msg_gpio_digitalpin_get_on(void)
 // Description: This represents the state of one pin of the digital port, including a timeout value.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_gpio_digitalpintimeout_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_get_ctx_set_messageid(ctx, 6);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_gpio_digitalpintimeout_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(1);
-  pkg_headerext_get_set_messageid(6);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalpintimeout_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Set".
+static inline void pkg_header_ctx_init_gpio_digitalpintimeout_set(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 1);
+  pkg_headerext_set_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_set_ctx_set_messageid(ctx, 6);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 1;
+}
+
 static inline void pkg_header_init_gpio_digitalpintimeout_set(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(1);
-  pkg_headerext_set_set_messagegroupid(1);
-  pkg_headerext_set_set_messageid(6);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 1;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalpintimeout_set(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "SetGet".
+static inline void pkg_header_ctx_init_gpio_digitalpintimeout_setget(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 2);
+  pkg_headerext_setget_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_setget_ctx_set_messageid(ctx, 6);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 2;
+}
+
 static inline void pkg_header_init_gpio_digitalpintimeout_setget(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(2);
-  pkg_headerext_setget_set_messagegroupid(1);
-  pkg_headerext_setget_set_messageid(6);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 2;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalpintimeout_setget(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_gpio_digitalpintimeout_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_status_ctx_set_messageid(ctx, 6);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_gpio_digitalpintimeout_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(1);
-  pkg_headerext_status_set_messageid(6);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalpintimeout_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Ack".
+static inline void pkg_header_ctx_init_gpio_digitalpintimeout_ack(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 9);
+  ctx->headeroffsetbits = 109;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 9;
+}
+
 static inline void pkg_header_init_gpio_digitalpintimeout_ack(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(9);
-  __HEADEROFFSETBITS = 109;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 9;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalpintimeout_ack(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_gpio_digitalpintimeout_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 6);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_gpio_digitalpintimeout_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(1);
-  pkg_headerext_ackstatus_set_messageid(6);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_digitalpintimeout_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Pos (UIntValue)
@@ -465,16 +874,26 @@ static inline void pkg_header_init_gpio_digitalpintimeout_ackstatus(void)
 
 // Set Pos (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 3, min val 0, max val 7
+static inline void msg_gpio_digitalpintimeout_ctx_set_pos(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 3, val, ctx->buf);
+}
+
 static inline void msg_gpio_digitalpintimeout_set_pos(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 3, val, bufx);
+  msg_gpio_digitalpintimeout_ctx_set_pos(PKG_CTX_GLOBAL, val);
 }
 
 // Get Pos (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 3, min val 0, max val 7
+static inline uint32_t msg_gpio_digitalpintimeout_ctx_get_pos(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 3, 0, 7, ctx->buf);
+}
+
 static inline uint32_t msg_gpio_digitalpintimeout_get_pos(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 3, 0, 7, bufx);
+  return msg_gpio_digitalpintimeout_ctx_get_pos(PKG_CTX_GLOBAL);
 }
 
 // On (BoolValue)
@@ -482,16 +901,26 @@ static inline uint32_t msg_gpio_digitalpintimeout_get_pos(void)
 
 // Set On (BoolValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 3, length bits 1
+static inline void msg_gpio_digitalpintimeout_ctx_set_on(const pkg_ctx_t * ctx, bool val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 3, 1, val ? 1 : 0, ctx->buf);
+}
+
 static inline void msg_gpio_digitalpintimeout_set_on(bool val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 3, 1, val ? 1 : 0, bufx);
+  msg_gpio_digitalpintimeout_ctx_set_on(PKG_CTX_GLOBAL, val);
 }
 
 // Get On (BoolValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 3, length bits 1
+static inline bool msg_gpio_digitalpintimeout_ctx_get_on(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue8((uint16_t)ctx->headeroffsetbits + 3, 1, 0, 1, ctx->buf) == 1;
+}
+
 static inline bool msg_gpio_digitalpintimeout_get_on(void)
 {
-  return array_read_UIntValue8((uint16_t)__HEADEROFFSETBITS + 3, 1, 0, 1, bufx) == 1;
+  return msg_gpio_digitalpintimeout_ctx_get_on(PKG_CTX_GLOBAL);
 }
 
 // TimeoutSec (UIntValue)
@@ -499,16 +928,79 @@ static inline bool msg_gpio_digitalpintimeout_get_on(void)
 
 // Set TimeoutSec (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 4, length bits 16, min val 0, max val 65535
+static inline void msg_gpio_digitalpintimeout_ctx_set_timeoutsec(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 4, 16, val, ctx->buf);
+}
+
 static inline void msg_gpio_digitalpintimeout_set_timeoutsec(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 4, 16, val, bufx);
+  msg_gpio_digitalpintimeout_ctx_set_timeoutsec(PKG_CTX_GLOBAL, val);
 }
 
 // Get TimeoutSec (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 4, length bits 16, min val 0, max val 65535
+static inline uint32_t msg_gpio_digitalpintimeout_ctx_get_timeoutsec(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 4, 16, 0, 65535, ctx->buf);
+}
+
 static inline uint32_t msg_gpio_digitalpintimeout_get_timeoutsec(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 4, 16, 0, 65535, bufx);
+  return msg_gpio_digitalpintimeout_ctx_get_timeoutsec(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint8_t pos;
+  bool on;
+  uint16_t timeoutsec;
+} msg_gpio_digitalpintimeout_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_gpio_digitalpintimeout_ctx_unpack(const pkg_ctx_t * ctx, msg_gpio_digitalpintimeout_t * msg) __attribute__ ((unused));
+static void msg_gpio_digitalpintimeout_ctx_unpack(const pkg_ctx_t * ctx, msg_gpio_digitalpintimeout_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->pos = bitstream_read_bits(&bs, 3);
+  msg->on = bitstream_read_bits(&bs, 1) == 1;
+  msg->timeoutsec = bitstream_read_bits(&bs, 16);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_gpio_digitalpintimeout_unpack(const uint8_t * buf, msg_gpio_digitalpintimeout_t * msg) __attribute__ ((unused));
+static void msg_gpio_digitalpintimeout_unpack(const uint8_t * buf, msg_gpio_digitalpintimeout_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_gpio_digitalpintimeout_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_gpio_digitalpintimeout_ctx_pack(const pkg_ctx_t * ctx, const msg_gpio_digitalpintimeout_t * msg) __attribute__ ((unused));
+static void msg_gpio_digitalpintimeout_ctx_pack(const pkg_ctx_t * ctx, const msg_gpio_digitalpintimeout_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 3, msg->pos);
+  bitstream_write_bits(&bs, 1, msg->on ? 1 : 0);
+  bitstream_write_bits(&bs, 16, msg->timeoutsec);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_gpio_digitalpintimeout_pack(const msg_gpio_digitalpintimeout_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_gpio_digitalpintimeout_pack(const msg_gpio_digitalpintimeout_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_gpio_digitalpintimeout_ctx_pack(&ctx, msg);
 }
 
 
@@ -523,73 +1015,121 @@ static inline uint32_t msg_gpio_digitalpintimeout_get_timeoutsec(void)
 // Description: This is the voltage of up to 8 ADC channels. The ATMega328 in the PDIP package has only 6 ADCs and one ADC may be blocked by the battery voltage measurement, so there may be less than 8 ADC values reported depending on the device and configuration.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_gpio_analogport_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_get_ctx_set_messageid(ctx, 10);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_gpio_analogport_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(1);
-  pkg_headerext_get_set_messageid(10);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_analogport_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Set".
+static inline void pkg_header_ctx_init_gpio_analogport_set(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 1);
+  pkg_headerext_set_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_set_ctx_set_messageid(ctx, 10);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 1;
+}
+
 static inline void pkg_header_init_gpio_analogport_set(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(1);
-  pkg_headerext_set_set_messagegroupid(1);
-  pkg_headerext_set_set_messageid(10);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 1;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_analogport_set(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "SetGet".
+static inline void pkg_header_ctx_init_gpio_analogport_setget(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 2);
+  pkg_headerext_setget_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_setget_ctx_set_messageid(ctx, 10);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 2;
+}
+
 static inline void pkg_header_init_gpio_analogport_setget(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(2);
-  pkg_headerext_setget_set_messagegroupid(1);
-  pkg_headerext_setget_set_messageid(10);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 2;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_analogport_setget(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_gpio_analogport_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_status_ctx_set_messageid(ctx, 10);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_gpio_analogport_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(1);
-  pkg_headerext_status_set_messageid(10);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_analogport_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Ack".
+static inline void pkg_header_ctx_init_gpio_analogport_ack(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 9);
+  ctx->headeroffsetbits = 109;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 9;
+}
+
 static inline void pkg_header_init_gpio_analogport_ack(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(9);
-  __HEADEROFFSETBITS = 109;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 9;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_analogport_ack(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_gpio_analogport_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 1);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 10);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_gpio_analogport_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(1);
-  pkg_headerext_ackstatus_set_messageid(10);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_gpio_analogport_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // On (BoolValue[8])
@@ -598,16 +1138,26 @@ static inline void pkg_header_init_gpio_analogport_ackstatus(void)
 
 // Set On (BoolValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 12, length bits 1
+static inline void msg_gpio_analogport_ctx_set_on(const pkg_ctx_t * ctx, uint8_t index, bool val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0 + (uint16_t)index * 12, 1, val ? 1 : 0, ctx->buf);
+}
+
 static inline void msg_gpio_analogport_set_on(uint8_t index, bool val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 12, 1, val ? 1 : 0, bufx);
+  msg_gpio_analogport_ctx_set_on(PKG_CTX_GLOBAL, index, val);
 }
 
 // Get On (BoolValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 12, length bits 1
+static inline bool msg_gpio_analogport_ctx_get_on(const pkg_ctx_t * ctx, uint8_t index)
+{
+  return array_read_UIntValue8((uint16_t)ctx->headeroffsetbits + 0 + (uint16_t)index * 12, 1, 0, 1, ctx->buf) == 1;
+}
+
 static inline bool msg_gpio_analogport_get_on(uint8_t index)
 {
-  return array_read_UIntValue8((uint16_t)__HEADEROFFSETBITS + 0 + (uint16_t)index * 12, 1, 0, 1, bufx) == 1;
+  return msg_gpio_analogport_ctx_get_on(PKG_CTX_GLOBAL, index);
 }
 
 // Voltage (UIntValue[8])
@@ -616,16 +1166,86 @@ static inline bool msg_gpio_analogport_get_on(uint8_t index)
 
 // Set Voltage (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 1 + (uint16_t)index * 12, length bits 11, min val 0, max val 1100
+static inline void msg_gpio_analogport_ctx_set_voltage(const pkg_ctx_t * ctx, uint8_t index, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 1 + (uint16_t)index * 12, 11, val, ctx->buf);
+}
+
 static inline void msg_gpio_analogport_set_voltage(uint8_t index, uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 1 + (uint16_t)index * 12, 11, val, bufx);
+  msg_gpio_analogport_ctx_set_voltage(PKG_CTX_GLOBAL, index, val);
 }
 
 // Get Voltage (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 1 + (uint16_t)index * 12, length bits 11, min val 0, max val 1100
+static inline uint32_t msg_gpio_analogport_ctx_get_voltage(const pkg_ctx_t * ctx, uint8_t index)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 1 + (uint16_t)index * 12, 11, 0, 1100, ctx->buf);
+}
+
 static inline uint32_t msg_gpio_analogport_get_voltage(uint8_t index)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 1 + (uint16_t)index * 12, 11, 0, 1100, bufx);
+  return msg_gpio_analogport_ctx_get_voltage(PKG_CTX_GLOBAL, index);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  bool on[8];
+  uint16_t voltage[8];
+} msg_gpio_analogport_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_gpio_analogport_ctx_unpack(const pkg_ctx_t * ctx, msg_gpio_analogport_t * msg) __attribute__ ((unused));
+static void msg_gpio_analogport_ctx_unpack(const pkg_ctx_t * ctx, msg_gpio_analogport_t * msg)
+{
+  bitstream_t bs;
+  uint8_t i;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+
+  for (i = 0; i < 8; i++)
+  {
+    msg->on[i] = bitstream_read_bits(&bs, 1) == 1;
+    msg->voltage[i] = bitstream_read_UIntValue32(&bs, 11, 0, 1100);
+  }
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_gpio_analogport_unpack(const uint8_t * buf, msg_gpio_analogport_t * msg) __attribute__ ((unused));
+static void msg_gpio_analogport_unpack(const uint8_t * buf, msg_gpio_analogport_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_gpio_analogport_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_gpio_analogport_ctx_pack(const pkg_ctx_t * ctx, const msg_gpio_analogport_t * msg) __attribute__ ((unused));
+static void msg_gpio_analogport_ctx_pack(const pkg_ctx_t * ctx, const msg_gpio_analogport_t * msg)
+{
+  bitstream_t bs;
+  uint8_t i;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+
+  for (i = 0; i < 8; i++)
+  {
+    bitstream_write_bits(&bs, 1, msg->on[i] ? 1 : 0);
+    bitstream_write_bits(&bs, 11, msg->voltage[i]);
+  }
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_gpio_analogport_pack(const msg_gpio_analogport_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_gpio_analogport_pack(const msg_gpio_analogport_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_gpio_analogport_ctx_pack(&ctx, msg);
 }
 
 #endif /* _MSGGRP_GPIO_H */
@@ -60,39 +60,63 @@ typedef enum {
 // Description: This is a message containing temperature only.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_weather_temperature_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 10);
+  pkg_headerext_get_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_weather_temperature_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(10);
-  pkg_headerext_get_set_messageid(1);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_weather_temperature_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_weather_temperature_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 10);
+  pkg_headerext_status_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_weather_temperature_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(10);
-  pkg_headerext_status_set_messageid(1);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_weather_temperature_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_weather_temperature_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 1);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_weather_temperature_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(10);
-  pkg_headerext_ackstatus_set_messageid(1);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_weather_temperature_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Temperature (IntValue)
@@ -100,16 +124,73 @@ static inline void pkg_header_init_weather_temperature_ackstatus(void)
 
 // Set Temperature (IntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 16, min val -32768, max val 32767
+static inline void msg_weather_temperature_ctx_set_temperature(const pkg_ctx_t * ctx, int32_t val)
+{
+  array_write_IntValue((uint16_t)ctx->headeroffsetbits + 0, 16, val, ctx->buf);
+}
+
 static inline void msg_weather_temperature_set_temperature(int32_t val)
 {
-  array_write_IntValue((uint16_t)__HEADEROFFSETBITS + 0, 16, val, bufx);
+  msg_weather_temperature_ctx_set_temperature(PKG_CTX_GLOBAL, val);
 }
 
 // Get Temperature (IntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 16, min val -32768, max val 32767
+static inline int32_t msg_weather_temperature_ctx_get_temperature(const pkg_ctx_t * ctx)
+{
+  return array_read_IntValue32((uint16_t)ctx->headeroffsetbits + 0, 16, -32768, 32767, ctx->buf);
+}
+
 static inline int32_t msg_weather_temperature_get_temperature(void)
 {
-  return array_read_IntValue32((uint16_t)__HEADEROFFSETBITS + 0, 16, -32768, 32767, bufx);
+  return msg_weather_temperature_ctx_get_temperature(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  int16_t temperature;
+} msg_weather_temperature_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_weather_temperature_ctx_unpack(const pkg_ctx_t * ctx, msg_weather_temperature_t * msg) __attribute__ ((unused));
+static void msg_weather_temperature_ctx_unpack(const pkg_ctx_t * ctx, msg_weather_temperature_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->temperature = bitstream_read_IntValue32(&bs, 16, -32768, 32767);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_weather_temperature_unpack(const uint8_t * buf, msg_weather_temperature_t * msg) __attribute__ ((unused));
+static void msg_weather_temperature_unpack(const uint8_t * buf, msg_weather_temperature_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_weather_temperature_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_weather_temperature_ctx_pack(const pkg_ctx_t * ctx, const msg_weather_temperature_t * msg) __attribute__ ((unused));
+static void msg_weather_temperature_ctx_pack(const pkg_ctx_t * ctx, const msg_weather_temperature_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_IntValue(&bs, 16, msg->temperature);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_weather_temperature_pack(const msg_weather_temperature_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_weather_temperature_pack(const msg_weather_temperature_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_weather_temperature_ctx_pack(&ctx, msg);
 }
 
 
@@ -124,39 +205,63 @@ static inline int32_t msg_weather_temperature_get_temperature(void)
 // Description: This is a message containing humidity and temperature.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_weather_humiditytemperature_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 10);
+  pkg_headerext_get_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_weather_humiditytemperature_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(10);
-  pkg_headerext_get_set_messageid(2);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_weather_humiditytemperature_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_weather_humiditytemperature_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 10);
+  pkg_headerext_status_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_weather_humiditytemperature_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(10);
-  pkg_headerext_status_set_messageid(2);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_weather_humiditytemperature_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_weather_humiditytemperature_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 2);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_weather_humiditytemperature_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(10);
-  pkg_headerext_ackstatus_set_messageid(2);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_weather_humiditytemperature_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Humidity (UIntValue)
@@ -164,16 +269,26 @@ static inline void pkg_header_init_weather_humiditytemperature_ackstatus(void)
 
 // Set Humidity (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 10, min val 0, max val 1000
+static inline void msg_weather_humiditytemperature_ctx_set_humidity(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 10, val, ctx->buf);
+}
+
 static inline void msg_weather_humiditytemperature_set_humidity(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 10, val, bufx);
+  msg_weather_humiditytemperature_ctx_set_humidity(PKG_CTX_GLOBAL, val);
 }
 
 // Get Humidity (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 10, min val 0, max val 1000
+static inline uint32_t msg_weather_humiditytemperature_ctx_get_humidity(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 10, 0, 1000, ctx->buf);
+}
+
 static inline uint32_t msg_weather_humiditytemperature_get_humidity(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 10, 0, 1000, bufx);
+  return msg_weather_humiditytemperature_ctx_get_humidity(PKG_CTX_GLOBAL);
 }
 
 // Temperature (IntValue)
@@ -181,16 +296,76 @@ static inline uint32_t msg_weather_humiditytemperature_get_humidity(void)
 
 // Set Temperature (IntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 10, length bits 16, min val -32768, max val 32767
+static inline void msg_weather_humiditytemperature_ctx_set_temperature(const pkg_ctx_t * ctx, int32_t val)
+{
+  array_write_IntValue((uint16_t)ctx->headeroffsetbits + 10, 16, val, ctx->buf);
+}
+
 static inline void msg_weather_humiditytemperature_set_temperature(int32_t val)
 {
-  array_write_IntValue((uint16_t)__HEADEROFFSETBITS + 10, 16, val, bufx);
+  msg_weather_humiditytemperature_ctx_set_temperature(PKG_CTX_GLOBAL, val);
 }
 
 // Get Temperature (IntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 10, length bits 16, min val -32768, max val 32767
+static inline int32_t msg_weather_humiditytemperature_ctx_get_temperature(const pkg_ctx_t * ctx)
+{
+  return array_read_IntValue32((uint16_t)ctx->headeroffsetbits + 10, 16, -32768, 32767, ctx->buf);
+}
+
 static inline int32_t msg_weather_humiditytemperature_get_temperature(void)
 {
-  return array_read_IntValue32((uint16_t)__HEADEROFFSETBITS + 10, 16, -32768, 32767, bufx);
+  return msg_weather_humiditytemperature_ctx_get_temperature(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint16_t humidity;
+  int16_t temperature;
+} msg_weather_humiditytemperature_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_weather_humiditytemperature_ctx_unpack(const pkg_ctx_t * ctx, msg_weather_humiditytemperature_t * msg) __attribute__ ((unused));
+static void msg_weather_humiditytemperature_ctx_unpack(const pkg_ctx_t * ctx, msg_weather_humiditytemperature_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->humidity = bitstream_read_UIntValue32(&bs, 10, 0, 1000);
+  msg->temperature = bitstream_read_IntValue32(&bs, 16, -32768, 32767);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_weather_humiditytemperature_unpack(const uint8_t * buf, msg_weather_humiditytemperature_t * msg) __attribute__ ((unused));
+static void msg_weather_humiditytemperature_unpack(const uint8_t * buf, msg_weather_humiditytemperature_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_weather_humiditytemperature_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_weather_humiditytemperature_ctx_pack(const pkg_ctx_t * ctx, const msg_weather_humiditytemperature_t * msg) __attribute__ ((unused));
+static void msg_weather_humiditytemperature_ctx_pack(const pkg_ctx_t * ctx, const msg_weather_humiditytemperature_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 10, msg->humidity);
+  bitstream_write_IntValue(&bs, 16, msg->temperature);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_weather_humiditytemperature_pack(const msg_weather_humiditytemperature_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_weather_humiditytemperature_pack(const msg_weather_humiditytemperature_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_weather_humiditytemperature_ctx_pack(&ctx, msg);
 }
 
 
@@ -205,39 +380,63 @@ static inline int32_t msg_weather_humiditytemperature_get_temperature(void)
 // Description: This is a message containing barometric pressure and temperature.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_weather_barometricpressuretemperature_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 10);
+  pkg_headerext_get_ctx_set_messageid(ctx, 3);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_weather_barometricpressuretemperature_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(10);
-  pkg_headerext_get_set_messageid(3);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_weather_barometricpressuretemperature_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_weather_barometricpressuretemperature_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 10);
+  pkg_headerext_status_ctx_set_messageid(ctx, 3);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_weather_barometricpressuretemperature_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(10);
-  pkg_headerext_status_set_messageid(3);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_weather_barometricpressuretemperature_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_weather_barometricpressuretemperature_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 3);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_weather_barometricpressuretemperature_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(10);
-  pkg_headerext_ackstatus_set_messageid(3);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_weather_barometricpressuretemperature_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // BarometricPressure (UIntValue)
@@ -245,16 +444,26 @@ static inline void pkg_header_init_weather_barometricpressuretemperature_ackstat
 
 // Set BarometricPressure (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 17, min val 0, max val 131071
+static inline void msg_weather_barometricpressuretemperature_ctx_set_barometricpressure(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 17, val, ctx->buf);
+}
+
 static inline void msg_weather_barometricpressuretemperature_set_barometricpressure(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 17, val, bufx);
+  msg_weather_barometricpressuretemperature_ctx_set_barometricpressure(PKG_CTX_GLOBAL, val);
 }
 
 // Get BarometricPressure (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 17, min val 0, max val 131071
+static inline uint32_t msg_weather_barometricpressuretemperature_ctx_get_barometricpressure(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 17, 0, 131071, ctx->buf);
+}
+
 static inline uint32_t msg_weather_barometricpressuretemperature_get_barometricpressure(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 17, 0, 131071, bufx);
+  return msg_weather_barometricpressuretemperature_ctx_get_barometricpressure(PKG_CTX_GLOBAL);
 }
 
 // Temperature (IntValue)
@@ -262,16 +471,76 @@ static inline uint32_t msg_weather_barometricpressuretemperature_get_barometricp
 
 // Set Temperature (IntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 17, length bits 16, min val -32768, max val 32767
+static inline void msg_weather_barometricpressuretemperature_ctx_set_temperature(const pkg_ctx_t * ctx, int32_t val)
+{
+  array_write_IntValue((uint16_t)ctx->headeroffsetbits + 17, 16, val, ctx->buf);
+}
+
 static inline void msg_weather_barometricpressuretemperature_set_temperature(int32_t val)
 {
-  array_write_IntValue((uint16_t)__HEADEROFFSETBITS + 17, 16, val, bufx);
+  msg_weather_barometricpressuretemperature_ctx_set_temperature(PKG_CTX_GLOBAL, val);
 }
 
 // Get Temperature (IntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 17, length bits 16, min val -32768, max val 32767
+static inline int32_t msg_weather_barometricpressuretemperature_ctx_get_temperature(const pkg_ctx_t * ctx)
+{
+  return array_read_IntValue32((uint16_t)ctx->headeroffsetbits + 17, 16, -32768, 32767, ctx->buf);
+}
+
 static inline int32_t msg_weather_barometricpressuretemperature_get_temperature(void)
 {
-  return array_read_IntValue32((uint16_t)__HEADEROFFSETBITS + 17, 16, -32768, 32767, bufx);
+  return msg_weather_barometricpressuretemperature_ctx_get_temperature(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint32_t barometricpressure;
+  int16_t temperature;
+} msg_weather_barometricpressuretemperature_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_weather_barometricpressuretemperature_ctx_unpack(const pkg_ctx_t * ctx, msg_weather_barometricpressuretemperature_t * msg) __attribute__ ((unused));
+static void msg_weather_barometricpressuretemperature_ctx_unpack(const pkg_ctx_t * ctx, msg_weather_barometricpressuretemperature_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->barometricpressure = bitstream_read_bits(&bs, 17);
+  msg->temperature = bitstream_read_IntValue32(&bs, 16, -32768, 32767);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_weather_barometricpressuretemperature_unpack(const uint8_t * buf, msg_weather_barometricpressuretemperature_t * msg) __attribute__ ((unused));
+static void msg_weather_barometricpressuretemperature_unpack(const uint8_t * buf, msg_weather_barometricpressuretemperature_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_weather_barometricpressuretemperature_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_weather_barometricpressuretemperature_ctx_pack(const pkg_ctx_t * ctx, const msg_weather_barometricpressuretemperature_t * msg) __attribute__ ((unused));
+static void msg_weather_barometricpressuretemperature_ctx_pack(const pkg_ctx_t * ctx, const msg_weather_barometricpressuretemperature_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 17, msg->barometricpressure);
+  bitstream_write_IntValue(&bs, 16, msg->temperature);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_weather_barometricpressuretemperature_pack(const msg_weather_barometricpressuretemperature_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_weather_barometricpressuretemperature_pack(const msg_weather_barometricpressuretemperature_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_weather_barometricpressuretemperature_ctx_pack(&ctx, msg);
 }
 
 
@@ -286,39 +555,63 @@ static inline int32_t msg_weather_barometricpressuretemperature_get_temperature(
 // Description: This is a message containing humidity.
 
 // Function to initialize header for the MessageType "Get".
+static inline void pkg_header_ctx_init_weather_humidity_get(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 0);
+  pkg_headerext_get_ctx_set_messagegroupid(ctx, 10);
+  pkg_headerext_get_ctx_set_messageid(ctx, 4);
+  ctx->headeroffsetbits = 95;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 0;
+}
+
 static inline void pkg_header_init_weather_humidity_get(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(0);
-  pkg_headerext_get_set_messagegroupid(10);
-  pkg_headerext_get_set_messageid(4);
-  __HEADEROFFSETBITS = 95;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 0;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_weather_humidity_get(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "Status".
+static inline void pkg_header_ctx_init_weather_humidity_status(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 8);
+  pkg_headerext_status_ctx_set_messagegroupid(ctx, 10);
+  pkg_headerext_status_ctx_set_messageid(ctx, 4);
+  ctx->headeroffsetbits = 83;
+  ctx->packetsizebytes = 16;
+  ctx->messagetype = 8;
+}
+
 static inline void pkg_header_init_weather_humidity_status(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(8);
-  pkg_headerext_status_set_messagegroupid(10);
-  pkg_headerext_status_set_messageid(4);
-  __HEADEROFFSETBITS = 83;
-  __PACKETSIZEBYTES = 16;
-  __MESSAGETYPE = 8;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_weather_humidity_status(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Function to initialize header for the MessageType "AckStatus".
+static inline void pkg_header_ctx_init_weather_humidity_ackstatus(pkg_ctx_t * ctx)
+{
+  memset(ctx->buf, 0, BUFX_LENGTH);
+  pkg_header_ctx_set_messagetype(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, 10);
+  pkg_headerext_ackstatus_ctx_set_messageid(ctx, 4);
+  ctx->headeroffsetbits = 120;
+  ctx->packetsizebytes = 32;
+  ctx->messagetype = 10;
+}
+
 static inline void pkg_header_init_weather_humidity_ackstatus(void)
 {
-  memset(&bufx[0], 0, sizeof(bufx));
-  pkg_header_set_messagetype(10);
-  pkg_headerext_ackstatus_set_messagegroupid(10);
-  pkg_headerext_ackstatus_set_messageid(4);
-  __HEADEROFFSETBITS = 120;
-  __PACKETSIZEBYTES = 32;
-  __MESSAGETYPE = 10;
+  pkg_ctx_t ctx = { bufx };
+
+  pkg_header_ctx_init_weather_humidity_ackstatus(&ctx);
+  pkg_ctx_store_global(&ctx);
 }
 
 // Humidity (UIntValue)
@@ -326,16 +619,73 @@ static inline void pkg_header_init_weather_humidity_ackstatus(void)
 
 // Set Humidity (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 10, min val 0, max val 1000
+static inline void msg_weather_humidity_ctx_set_humidity(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue((uint16_t)ctx->headeroffsetbits + 0, 10, val, ctx->buf);
+}
+
 static inline void msg_weather_humidity_set_humidity(uint32_t val)
 {
-  array_write_UIntValue((uint16_t)__HEADEROFFSETBITS + 0, 10, val, bufx);
+  msg_weather_humidity_ctx_set_humidity(PKG_CTX_GLOBAL, val);
 }
 
 // Get Humidity (UIntValue)
 // Offset: (uint16_t)__HEADEROFFSETBITS + 0, length bits 10, min val 0, max val 1000
+static inline uint32_t msg_weather_humidity_ctx_get_humidity(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32((uint16_t)ctx->headeroffsetbits + 0, 10, 0, 1000, ctx->buf);
+}
+
 static inline uint32_t msg_weather_humidity_get_humidity(void)
 {
-  return array_read_UIntValue32((uint16_t)__HEADEROFFSETBITS + 0, 10, 0, 1000, bufx);
+  return msg_weather_humidity_ctx_get_humidity(PKG_CTX_GLOBAL);
+}
+
+// Struct containing all data fields, used to unpack / pack the message data in one pass.
+typedef struct {
+  uint16_t humidity;
+} msg_weather_humidity_t;
+
+// Unpack all data fields from the buffer of the context into the struct.
+// The header has to be interpreted before by pkg_header_ctx_adjust_offset().
+static void msg_weather_humidity_ctx_unpack(const pkg_ctx_t * ctx, msg_weather_humidity_t * msg) __attribute__ ((unused));
+static void msg_weather_humidity_ctx_unpack(const pkg_ctx_t * ctx, msg_weather_humidity_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  msg->humidity = bitstream_read_UIntValue32(&bs, 10, 0, 1000);
+}
+
+// Unpack all data fields from the buffer into the struct.
+// The header has to be interpreted before by pkg_header_adjust_offset().
+static void msg_weather_humidity_unpack(const uint8_t * buf, msg_weather_humidity_t * msg) __attribute__ ((unused));
+static void msg_weather_humidity_unpack(const uint8_t * buf, msg_weather_humidity_t * msg)
+{
+  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };
+
+  msg_weather_humidity_ctx_unpack(&ctx, msg);
+}
+
+// Pack all data fields from the struct into the buffer of the context.
+// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.
+static void msg_weather_humidity_ctx_pack(const pkg_ctx_t * ctx, const msg_weather_humidity_t * msg) __attribute__ ((unused));
+static void msg_weather_humidity_ctx_pack(const pkg_ctx_t * ctx, const msg_weather_humidity_t * msg)
+{
+  bitstream_t bs;
+
+  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);
+  bitstream_write_bits(&bs, 10, msg->humidity);
+}
+
+// Pack all data fields from the struct into the buffer.
+// The header has to be initialized before by one of the pkg_header_init_* functions.
+static void msg_weather_humidity_pack(const msg_weather_humidity_t * msg, uint8_t * buf) __attribute__ ((unused));
+static void msg_weather_humidity_pack(const msg_weather_humidity_t * msg, uint8_t * buf)
+{
+  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };
+
+  msg_weather_humidity_ctx_pack(&ctx, msg);
 }
 
 #endif /* _MSGGRP_WEATHER_H */
@@ -0,0 +1,174 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2013..2019 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*
+* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+* ! WARNING: This file is generated by the SHC EEPROM editor and should !
+* ! never be modified manually.                                         !
+* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+*/
+
+#ifndef _PACKET_DISPATCH_H
+#define _PACKET_DISPATCH_H
+
+#include <string.h>
+
+#include "packet_header.h"
+#include "packet_headerext_common.h"
+
+#include "hal.h"
+
+// This file contains a table of all messages, sorted by MessageGroupID and MessageID.
+// A device registers its handler functions in a table indexed by the message slot,
+// so that a received packet is routed without comparing the IDs one after another.
+// The packet length is checked against the header length before the handler is
+// called. The header offset depends only on the MessageType and is set by
+// pkg_header_adjust_offset(), which has to be called before.
+
+// ENUM for the slots of the messages in the dispatch table
+typedef enum {
+  MSGSLOT_GENERIC_DEVICEINFO = 0,
+  MSGSLOT_GENERIC_HARDWAREERROR = 1,
+  MSGSLOT_GENERIC_BATTERYSTATUS = 2,
+  MSGSLOT_GPIO_DIGITALPORT = 3,
+  MSGSLOT_GPIO_DIGITALPORTTIMEOUT = 4,
+  MSGSLOT_GPIO_DIGITALPIN = 5,
+  MSGSLOT_GPIO_DIGITALPINTIMEOUT = 6,
+  MSGSLOT_GPIO_ANALOGPORT = 7,
+  MSGSLOT_WEATHER_TEMPERATURE = 8,
+  MSGSLOT_WEATHER_HUMIDITYTEMPERATURE = 9,
+  MSGSLOT_WEATHER_BAROMETRICPRESSURETEMPERATURE = 10,
+  MSGSLOT_WEATHER_HUMIDITY = 11,
+  MSGSLOT_ENVIRONMENT_BRIGHTNESS = 12,
+  MSGSLOT_ENVIRONMENT_DISTANCE = 13,
+  MSGSLOT_ENVIRONMENT_PARTICULATEMATTER = 14,
+  MSGSLOT_DISPLAY_TEXT = 15,
+  MSGSLOT_DISPLAY_BACKLIGHT = 16,
+  MSGSLOT_CONTROLLER_MENUSELECTION = 17,
+  MSGSLOT_AUDIO_TONE = 18,
+  MSGSLOT_AUDIO_MELODY = 19,
+  MSGSLOT_DIMMER_BRIGHTNESS = 20,
+  MSGSLOT_DIMMER_ANIMATION = 21,
+  MSGSLOT_DIMMER_COLOR = 22,
+  MSGSLOT_DIMMER_COLORANIMATION = 23,
+  MSGSLOT_COUNT = 24
+} MessageSlotEnum;
+
+// Bit mask of the MessageTypes which contain message data.
+#define PKG_MESSAGETYPES_WITH_DATA 0x050e
+
+typedef struct {
+  uint16_t key;          // MessageGroupID << 4 | MessageID
+  uint16_t messagetypes; // bit mask of the possible MessageTypes
+  uint16_t databits;     // length of the message data in bits
+} pkg_dispatch_entry_t;
+
+static const pkg_dispatch_entry_t pkg_dispatch_table[MSGSLOT_COUNT] PROGMEM = {
+  { (0 << 4) | 2, 0x0501, 64 }, // generic_deviceinfo
+  { (0 << 4) | 3, 0x0100, 8 }, // generic_hardwareerror
+  { (0 << 4) | 5, 0x0501, 7 }, // generic_batterystatus
+  { (1 << 4) | 1, 0x0707, 8 }, // gpio_digitalport
+  { (1 << 4) | 2, 0x0707, 136 }, // gpio_digitalporttimeout
+  { (1 << 4) | 5, 0x0707, 4 }, // gpio_digitalpin
+  { (1 << 4) | 6, 0x0707, 20 }, // gpio_digitalpintimeout
+  { (1 << 4) | 10, 0x0707, 96 }, // gpio_analogport
+  { (10 << 4) | 1, 0x0501, 16 }, // weather_temperature
+  { (10 << 4) | 2, 0x0501, 26 }, // weather_humiditytemperature
+  { (10 << 4) | 3, 0x0501, 33 }, // weather_barometricpressuretemperature
+  { (10 << 4) | 4, 0x0501, 10 }, // weather_humidity
+  { (11 << 4) | 1, 0x0501, 7 }, // environment_brightness
+  { (11 << 4) | 2, 0x0501, 14 }, // environment_distance
+  { (11 << 4) | 3, 0x0501, 160 }, // environment_particulatematter
+  { (40 << 4) | 1, 0x0707, 336 }, // display_text
+  { (40 << 4) | 2, 0x0707, 12 }, // display_backlight
+  { (45 << 4) | 1, 0x070f, 128 }, // controller_menuselection
+  { (50 << 4) | 1, 0x0707, 7 }, // audio_tone
+  { (50 << 4) | 2, 0x0707, 380 }, // audio_melody
+  { (60 << 4) | 1, 0x0707, 7 }, // dimmer_brightness
+  { (60 << 4) | 2, 0x0707, 32 }, // dimmer_animation
+  { (60 << 4) | 10, 0x0707, 6 }, // dimmer_color
+  { (60 << 4) | 11, 0x0707, 115 } // dimmer_coloranimation
+};
+
+// Result of pkg_dispatch()
+typedef enum {
+  PKG_DISPATCH_OK = 0,
+  PKG_DISPATCH_UNKNOWN_MESSAGE = 1,
+  PKG_DISPATCH_UNSUPPORTED_MESSAGETYPE = 2,
+  PKG_DISPATCH_PACKET_TOO_SHORT = 3,
+  PKG_DISPATCH_NO_HANDLER = 4
+} PkgDispatchResultEnum;
+
+// Function handling one message, called with the MessageType of the received packet.
+typedef void (*pkg_handler_t)(MessageTypeEnum messagetype);
+
+// Return the slot of the message with the given IDs or MSGSLOT_COUNT if it is unknown.
+static uint8_t pkg_dispatch_find_slot(uint8_t messagegroupid, uint8_t messageid) __attribute__ ((unused));
+static uint8_t pkg_dispatch_find_slot(uint8_t messagegroupid, uint8_t messageid)
+{
+  uint16_t key = ((uint16_t)messagegroupid << 4) | messageid;
+  uint8_t lo = 0;
+  uint8_t hi = MSGSLOT_COUNT;
+
+  while (lo < hi)
+  {
+    uint8_t mid = (lo + hi) / 2;
+    uint16_t k = pgm_read_word(&pkg_dispatch_table[mid].key);
+
+    if (k == key)
+      return mid;
+    else if (k < key)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return MSGSLOT_COUNT;
+}
+
+// Look up the received message in the dispatch table, check the MessageType and the
+// packet length and call the handler from the given table (in PROGMEM, indexed by the
+// message slot, NULL for unsupported messages).
+// Trailing zero bytes are not sent (see rfm12_send_bufx), so the packet only has to
+// contain the header. The bytes after the received length are cleared in bufx to read
+// the missing message data as 0.
+static PkgDispatchResultEnum pkg_dispatch(uint8_t len, const pkg_handler_t * handlers) __attribute__ ((unused));
+static PkgDispatchResultEnum pkg_dispatch(uint8_t len, const pkg_handler_t * handlers)
+{
+  if (len < (__HEADEROFFSETBITS + 7) / 8)
+    return PKG_DISPATCH_PACKET_TOO_SHORT;
+
+  if (len < BUFX_LENGTH)
+    memset(bufx + len, 0, BUFX_LENGTH - len);
+
+  uint8_t slot = pkg_dispatch_find_slot(pkg_headerext_common_get_messagegroupid(), pkg_headerext_common_get_messageid());
+
+  if (slot == MSGSLOT_COUNT)
+    return PKG_DISPATCH_UNKNOWN_MESSAGE;
+
+  if (!(pgm_read_word(&pkg_dispatch_table[slot].messagetypes) & (1 << __MESSAGETYPE)))
+    return PKG_DISPATCH_UNSUPPORTED_MESSAGETYPE;
+
+  pkg_handler_t handler = (pkg_handler_t)pgm_read_ptr(&handlers[slot]);
+
+  if (handler == NULL)
+    return PKG_DISPATCH_NO_HANDLER;
+
+  handler(__MESSAGETYPE);
+  return PKG_DISPATCH_OK;
+}
+
+#endif /* _PACKET_DISPATCH_H */
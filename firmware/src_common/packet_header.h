@@ -40,6 +40,28 @@ uint8_t __PACKETSIZEBYTES;
 // in common header extension access functions.
 uint8_t __MESSAGETYPE;
 
+// Codec context for encoding / decoding a packet in the given buffer (with BUFX_LENGTH
+// bytes) independently of bufx and the global header state above. Every access
+// function has a "_ctx_" variant taking the context as first parameter. The
+// functions without context are kept for compatibility and use the global state.
+typedef struct {
+  uint8_t * buf;
+  uint8_t headeroffsetbits;
+  uint8_t packetsizebytes;
+  uint8_t messagetype;
+} pkg_ctx_t;
+
+// Context representing bufx and the global header state.
+#define PKG_CTX_GLOBAL (&(pkg_ctx_t){ bufx, __HEADEROFFSETBITS, __PACKETSIZEBYTES, __MESSAGETYPE })
+
+// Copy the header state of the given context to the global variables.
+static inline void pkg_ctx_store_global(const pkg_ctx_t * ctx)
+{
+  __HEADEROFFSETBITS = ctx->headeroffsetbits;
+  __PACKETSIZEBYTES = ctx->packetsizebytes;
+  __MESSAGETYPE = ctx->messagetype;
+}
+
 // ENUM MessageGroupID
 typedef enum {
   MESSAGEGROUP_GENERIC = 0,
@@ -57,16 +79,26 @@ typedef enum {
 
 // Set CRC32 (UIntValue)
 // Offset: 0, length bits 32, min val 0, max val 4294967295
+static inline void pkg_header_ctx_set_crc32(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue(0, 32, val, ctx->buf);
+}
+
 static inline void pkg_header_set_crc32(uint32_t val)
 {
-  array_write_UIntValue(0, 32, val, bufx);
+  pkg_header_ctx_set_crc32(PKG_CTX_GLOBAL, val);
 }
 
 // Get CRC32 (UIntValue)
 // Offset: 0, length bits 32, min val 0, max val 4294967295
+static inline uint32_t pkg_header_ctx_get_crc32(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32(0, 32, 0, 4294967295, ctx->buf);
+}
+
 static inline uint32_t pkg_header_get_crc32(void)
 {
-  return array_read_UIntValue32(0, 32, 0, 4294967295, bufx);
+  return pkg_header_ctx_get_crc32(PKG_CTX_GLOBAL);
 }
 
 // SenderID (UIntValue)
@@ -74,16 +106,26 @@ static inline uint32_t pkg_header_get_crc32(void)
 
 // Set SenderID (UIntValue)
 // Offset: 32, length bits 12, min val 0, max val 4095
+static inline void pkg_header_ctx_set_senderid(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue(32, 12, val, ctx->buf);
+}
+
 static inline void pkg_header_set_senderid(uint32_t val)
 {
-  array_write_UIntValue(32, 12, val, bufx);
+  pkg_header_ctx_set_senderid(PKG_CTX_GLOBAL, val);
 }
 
 // Get SenderID (UIntValue)
 // Offset: 32, length bits 12, min val 0, max val 4095
+static inline uint32_t pkg_header_ctx_get_senderid(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32(32, 12, 0, 4095, ctx->buf);
+}
+
 static inline uint32_t pkg_header_get_senderid(void)
 {
-  return array_read_UIntValue32(32, 12, 0, 4095, bufx);
+  return pkg_header_ctx_get_senderid(PKG_CTX_GLOBAL);
 }
 
 // PacketCounter (UIntValue)
@@ -91,16 +133,26 @@ static inline uint32_t pkg_header_get_senderid(void)
 
 // Set PacketCounter (UIntValue)
 // Offset: 44, length bits 24, min val 0, max val 16777215
+static inline void pkg_header_ctx_set_packetcounter(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue(44, 24, val, ctx->buf);
+}
+
 static inline void pkg_header_set_packetcounter(uint32_t val)
 {
-  array_write_UIntValue(44, 24, val, bufx);
+  pkg_header_ctx_set_packetcounter(PKG_CTX_GLOBAL, val);
 }
 
 // Get PacketCounter (UIntValue)
 // Offset: 44, length bits 24, min val 0, max val 16777215
+static inline uint32_t pkg_header_ctx_get_packetcounter(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32(44, 24, 0, 16777215, ctx->buf);
+}
+
 static inline uint32_t pkg_header_get_packetcounter(void)
 {
-  return array_read_UIntValue32(44, 24, 0, 16777215, bufx);
+  return pkg_header_ctx_get_packetcounter(PKG_CTX_GLOBAL);
 }
 
 // MessageType (EnumValue)
@@ -121,25 +173,40 @@ typedef enum {
 
 // Set MessageType (EnumValue)
 // Offset: 68, length bits 4
+static inline void pkg_header_ctx_set_messagetype(const pkg_ctx_t * ctx, MessageTypeEnum val)
+{
+  array_write_UIntValue(68, 4, val, ctx->buf);
+}
+
 static inline void pkg_header_set_messagetype(MessageTypeEnum val)
 {
-  array_write_UIntValue(68, 4, val, bufx);
+  pkg_header_ctx_set_messagetype(PKG_CTX_GLOBAL, val);
 }
 
 // Get MessageType (EnumValue)
 // Offset: 68, length bits 4
+static inline MessageTypeEnum pkg_header_ctx_get_messagetype(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32(68, 4, 0, 15, ctx->buf);
+}
+
 static inline MessageTypeEnum pkg_header_get_messagetype(void)
 {
-  return array_read_UIntValue32(68, 4, 0, 15, bufx);
+  return pkg_header_ctx_get_messagetype(PKG_CTX_GLOBAL);
 }
 
 
 // overall length: 72 bits
 
 // Function to check CRC value against calculated one (after reception).
+static inline bool pkg_header_ctx_check_crc32(const pkg_ctx_t * ctx, uint8_t packet_size_bytes)
+{
+  return array_read_UIntValue32(0, 32, 0, UINT32_MAX, ctx->buf) == crc32(ctx->buf + 4, packet_size_bytes - 4);
+}
+
 static inline bool pkg_header_check_crc32(uint8_t packet_size_bytes)
 {
-  return getBuf32(0) == crc32(bufx + 4, packet_size_bytes - 4);
+  return pkg_header_ctx_check_crc32(PKG_CTX_GLOBAL, packet_size_bytes);
 }
 
 #endif /* _PACKET_HEADER_H */
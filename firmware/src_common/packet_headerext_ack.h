@@ -31,16 +31,26 @@
 
 // Set AckSenderID (UIntValue)
 // Offset: 72, length bits 12, min val 0, max val 4095
+static inline void pkg_headerext_ack_ctx_set_acksenderid(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue(72, 12, val, ctx->buf);
+}
+
 static inline void pkg_headerext_ack_set_acksenderid(uint32_t val)
 {
-  array_write_UIntValue(72, 12, val, bufx);
+  pkg_headerext_ack_ctx_set_acksenderid(PKG_CTX_GLOBAL, val);
 }
 
 // Get AckSenderID (UIntValue)
 // Offset: 72, length bits 12, min val 0, max val 4095
+static inline uint32_t pkg_headerext_ack_ctx_get_acksenderid(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32(72, 12, 0, 4095, ctx->buf);
+}
+
 static inline uint32_t pkg_headerext_ack_get_acksenderid(void)
 {
-  return array_read_UIntValue32(72, 12, 0, 4095, bufx);
+  return pkg_headerext_ack_ctx_get_acksenderid(PKG_CTX_GLOBAL);
 }
 
 // AckPacketCounter (UIntValue)
@@ -48,16 +58,26 @@ static inline uint32_t pkg_headerext_ack_get_acksenderid(void)
 
 // Set AckPacketCounter (UIntValue)
 // Offset: 84, length bits 24, min val 0, max val 16777215
+static inline void pkg_headerext_ack_ctx_set_ackpacketcounter(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue(84, 24, val, ctx->buf);
+}
+
 static inline void pkg_headerext_ack_set_ackpacketcounter(uint32_t val)
 {
-  array_write_UIntValue(84, 24, val, bufx);
+  pkg_headerext_ack_ctx_set_ackpacketcounter(PKG_CTX_GLOBAL, val);
 }
 
 // Get AckPacketCounter (UIntValue)
 // Offset: 84, length bits 24, min val 0, max val 16777215
+static inline uint32_t pkg_headerext_ack_ctx_get_ackpacketcounter(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32(84, 24, 0, 16777215, ctx->buf);
+}
+
 static inline uint32_t pkg_headerext_ack_get_ackpacketcounter(void)
 {
-  return array_read_UIntValue32(84, 24, 0, 16777215, bufx);
+  return pkg_headerext_ack_ctx_get_ackpacketcounter(PKG_CTX_GLOBAL);
 }
 
 // Error (BoolValue)
@@ -65,16 +85,26 @@ static inline uint32_t pkg_headerext_ack_get_ackpacketcounter(void)
 
 // Set Error (BoolValue)
 // Offset: 108, length bits 1
+static inline void pkg_headerext_ack_ctx_set_error(const pkg_ctx_t * ctx, bool val)
+{
+  array_write_UIntValue(108, 1, val ? 1 : 0, ctx->buf);
+}
+
 static inline void pkg_headerext_ack_set_error(bool val)
 {
-  array_write_UIntValue(108, 1, val ? 1 : 0, bufx);
+  pkg_headerext_ack_ctx_set_error(PKG_CTX_GLOBAL, val);
 }
 
 // Get Error (BoolValue)
 // Offset: 108, length bits 1
+static inline bool pkg_headerext_ack_ctx_get_error(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue8(108, 1, 0, 1, ctx->buf) == 1;
+}
+
 static inline bool pkg_headerext_ack_get_error(void)
 {
-  return array_read_UIntValue8(108, 1, 0, 1, bufx) == 1;
+  return pkg_headerext_ack_ctx_get_error(PKG_CTX_GLOBAL);
 }
 
 
@@ -42,69 +42,86 @@
 // WARNING: If you access a field not contained in the received MessageType,
 // you get a wrong value 0!
 
-// Initialize the header offset variable, used to correctly interpret
+// Initialize the header offset of the context, used to correctly interpret
 // contents of the header extension and the message data after reception.
-static void pkg_header_adjust_offset(void) __attribute__ ((unused));
-static void pkg_header_adjust_offset(void)
+static void pkg_header_ctx_adjust_offset(pkg_ctx_t * ctx) __attribute__ ((unused));
+static void pkg_header_ctx_adjust_offset(pkg_ctx_t * ctx)
 {
-  __MESSAGETYPE = pkg_header_get_messagetype();
+  ctx->messagetype = pkg_header_ctx_get_messagetype(ctx);
 
-  switch (__MESSAGETYPE)
+  switch (ctx->messagetype)
   {
     case MESSAGETYPE_ACKSTATUS:
-      __HEADEROFFSETBITS = 120;
+      ctx->headeroffsetbits = 120;
       break;
     case MESSAGETYPE_ACK:
-      __HEADEROFFSETBITS = 109;
+      ctx->headeroffsetbits = 109;
       break;
     case MESSAGETYPE_STATUS:
-      __HEADEROFFSETBITS = 83;
+      ctx->headeroffsetbits = 83;
       break;
     case MESSAGETYPE_DELIVER:
-      __HEADEROFFSETBITS = 95;
+      ctx->headeroffsetbits = 95;
       break;
     case MESSAGETYPE_SETGET:
-      __HEADEROFFSETBITS = 95;
+      ctx->headeroffsetbits = 95;
       break;
     case MESSAGETYPE_SET:
-      __HEADEROFFSETBITS = 95;
+      ctx->headeroffsetbits = 95;
       break;
     case MESSAGETYPE_GET:
-      __HEADEROFFSETBITS = 95;
+      ctx->headeroffsetbits = 95;
       break;
   }
 }
 
+// Initialize the header offset variable, used to correctly interpret
+// contents of the header extension and the message data after reception.
+static void pkg_header_adjust_offset(void) __attribute__ ((unused));
+static void pkg_header_adjust_offset(void)
+{
+  pkg_ctx_t ctx = *PKG_CTX_GLOBAL;
+
+  pkg_header_ctx_adjust_offset(&ctx);
+  pkg_ctx_store_global(&ctx);
+}
+
 // Set AckPacketCounter (UIntValue)
 // Same function for all MessageTypes!
-static void pkg_headerext_common_set_ackpacketcounter(uint32_t val) __attribute__ ((unused));
-static void pkg_headerext_common_set_ackpacketcounter(uint32_t val)
+static void pkg_headerext_common_ctx_set_ackpacketcounter(const pkg_ctx_t * ctx, uint32_t val) __attribute__ ((unused));
+static void pkg_headerext_common_ctx_set_ackpacketcounter(const pkg_ctx_t * ctx, uint32_t val)
 {
-  switch (__MESSAGETYPE)
+  switch (ctx->messagetype)
   {
     case MESSAGETYPE_ACKSTATUS:
-      pkg_headerext_ackstatus_set_ackpacketcounter(val);
+      pkg_headerext_ackstatus_ctx_set_ackpacketcounter(ctx, val);
       break;
     case MESSAGETYPE_ACK:
-      pkg_headerext_ack_set_ackpacketcounter(val);
+      pkg_headerext_ack_ctx_set_ackpacketcounter(ctx, val);
       break;
     default:
       break;
   }
 }
 
+static void pkg_headerext_common_set_ackpacketcounter(uint32_t val) __attribute__ ((unused));
+static void pkg_headerext_common_set_ackpacketcounter(uint32_t val)
+{
+  pkg_headerext_common_ctx_set_ackpacketcounter(PKG_CTX_GLOBAL, val);
+}
+
 // Get AckPacketCounter (UIntValue)
 // Same function for all MessageTypes!
-static uint32_t pkg_headerext_common_get_ackpacketcounter(void) __attribute__ ((unused));
-static uint32_t pkg_headerext_common_get_ackpacketcounter(void)
+static uint32_t pkg_headerext_common_ctx_get_ackpacketcounter(const pkg_ctx_t * ctx) __attribute__ ((unused));
+static uint32_t pkg_headerext_common_ctx_get_ackpacketcounter(const pkg_ctx_t * ctx)
 {
-  switch (__MESSAGETYPE)
+  switch (ctx->messagetype)
   {
     case MESSAGETYPE_ACKSTATUS:
-      return pkg_headerext_ackstatus_get_ackpacketcounter();
+      return pkg_headerext_ackstatus_ctx_get_ackpacketcounter(ctx);
       break;
     case MESSAGETYPE_ACK:
-      return pkg_headerext_ack_get_ackpacketcounter();
+      return pkg_headerext_ack_ctx_get_ackpacketcounter(ctx);
       break;
     default:
       return 0;
@@ -112,60 +129,72 @@ static uint32_t pkg_headerext_common_get_ackpacketcounter(void)
   }
 }
 
+static uint32_t pkg_headerext_common_get_ackpacketcounter(void) __attribute__ ((unused));
+static uint32_t pkg_headerext_common_get_ackpacketcounter(void)
+{
+  return pkg_headerext_common_ctx_get_ackpacketcounter(PKG_CTX_GLOBAL);
+}
+
 // Set MessageID (UIntValue)
 // Same function for all MessageTypes!
-static void pkg_headerext_common_set_messageid(uint32_t val) __attribute__ ((unused));
-static void pkg_headerext_common_set_messageid(uint32_t val)
+static void pkg_headerext_common_ctx_set_messageid(const pkg_ctx_t * ctx, uint32_t val) __attribute__ ((unused));
+static void pkg_headerext_common_ctx_set_messageid(const pkg_ctx_t * ctx, uint32_t val)
 {
-  switch (__MESSAGETYPE)
+  switch (ctx->messagetype)
   {
     case MESSAGETYPE_ACKSTATUS:
-      pkg_headerext_ackstatus_set_messageid(val);
+      pkg_headerext_ackstatus_ctx_set_messageid(ctx, val);
       break;
     case MESSAGETYPE_STATUS:
-      pkg_headerext_status_set_messageid(val);
+      pkg_headerext_status_ctx_set_messageid(ctx, val);
       break;
     case MESSAGETYPE_DELIVER:
-      pkg_headerext_deliver_set_messageid(val);
+      pkg_headerext_deliver_ctx_set_messageid(ctx, val);
       break;
     case MESSAGETYPE_SETGET:
-      pkg_headerext_setget_set_messageid(val);
+      pkg_headerext_setget_ctx_set_messageid(ctx, val);
       break;
     case MESSAGETYPE_SET:
-      pkg_headerext_set_set_messageid(val);
+      pkg_headerext_set_ctx_set_messageid(ctx, val);
       break;
     case MESSAGETYPE_GET:
-      pkg_headerext_get_set_messageid(val);
+      pkg_headerext_get_ctx_set_messageid(ctx, val);
       break;
     default:
       break;
   }
 }
 
+static void pkg_headerext_common_set_messageid(uint32_t val) __attribute__ ((unused));
+static void pkg_headerext_common_set_messageid(uint32_t val)
+{
+  pkg_headerext_common_ctx_set_messageid(PKG_CTX_GLOBAL, val);
+}
+
 // Get MessageID (UIntValue)
 // Same function for all MessageTypes!
-static uint32_t pkg_headerext_common_get_messageid(void) __attribute__ ((unused));
-static uint32_t pkg_headerext_common_get_messageid(void)
+static uint32_t pkg_headerext_common_ctx_get_messageid(const pkg_ctx_t * ctx) __attribute__ ((unused));
+static uint32_t pkg_headerext_common_ctx_get_messageid(const pkg_ctx_t * ctx)
 {
-  switch (__MESSAGETYPE)
+  switch (ctx->messagetype)
   {
     case MESSAGETYPE_ACKSTATUS:
-      return pkg_headerext_ackstatus_get_messageid();
+      return pkg_headerext_ackstatus_ctx_get_messageid(ctx);
       break;
     case MESSAGETYPE_STATUS:
-      return pkg_headerext_status_get_messageid();
+      return pkg_headerext_status_ctx_get_messageid(ctx);
       break;
     case MESSAGETYPE_DELIVER:
-      return pkg_headerext_deliver_get_messageid();
+      return pkg_headerext_deliver_ctx_get_messageid(ctx);
       break;
     case MESSAGETYPE_SETGET:
-      return pkg_headerext_setget_get_messageid();
+      return pkg_headerext_setget_ctx_get_messageid(ctx);
       break;
     case MESSAGETYPE_SET:
-      return pkg_headerext_set_get_messageid();
+      return pkg_headerext_set_ctx_get_messageid(ctx);
       break;
     case MESSAGETYPE_GET:
-      return pkg_headerext_get_get_messageid();
+      return pkg_headerext_get_ctx_get_messageid(ctx);
       break;
     default:
       return 0;
@@ -173,36 +202,48 @@ static uint32_t pkg_headerext_common_get_messageid(void)
   }
 }
 
+static uint32_t pkg_headerext_common_get_messageid(void) __attribute__ ((unused));
+static uint32_t pkg_headerext_common_get_messageid(void)
+{
+  return pkg_headerext_common_ctx_get_messageid(PKG_CTX_GLOBAL);
+}
+
 // Set AckSenderID (UIntValue)
 // Same function for all MessageTypes!
-static void pkg_headerext_common_set_acksenderid(uint32_t val) __attribute__ ((unused));
-static void pkg_headerext_common_set_acksenderid(uint32_t val)
+static void pkg_headerext_common_ctx_set_acksenderid(const pkg_ctx_t * ctx, uint32_t val) __attribute__ ((unused));
+static void pkg_headerext_common_ctx_set_acksenderid(const pkg_ctx_t * ctx, uint32_t val)
 {
-  switch (__MESSAGETYPE)
+  switch (ctx->messagetype)
   {
     case MESSAGETYPE_ACKSTATUS:
-      pkg_headerext_ackstatus_set_acksenderid(val);
+      pkg_headerext_ackstatus_ctx_set_acksenderid(ctx, val);
       break;
     case MESSAGETYPE_ACK:
-      pkg_headerext_ack_set_acksenderid(val);
+      pkg_headerext_ack_ctx_set_acksenderid(ctx, val);
       break;
     default:
       break;
   }
 }
 
+static void pkg_headerext_common_set_acksenderid(uint32_t val) __attribute__ ((unused));
+static void pkg_headerext_common_set_acksenderid(uint32_t val)
+{
+  pkg_headerext_common_ctx_set_acksenderid(PKG_CTX_GLOBAL, val);
+}
+
 // Get AckSenderID (UIntValue)
 // Same function for all MessageTypes!
-static uint32_t pkg_headerext_common_get_acksenderid(void) __attribute__ ((unused));
-static uint32_t pkg_headerext_common_get_acksenderid(void)
+static uint32_t pkg_headerext_common_ctx_get_acksenderid(const pkg_ctx_t * ctx) __attribute__ ((unused));
+static uint32_t pkg_headerext_common_ctx_get_acksenderid(const pkg_ctx_t * ctx)
 {
-  switch (__MESSAGETYPE)
+  switch (ctx->messagetype)
   {
     case MESSAGETYPE_ACKSTATUS:
-      return pkg_headerext_ackstatus_get_acksenderid();
+      return pkg_headerext_ackstatus_ctx_get_acksenderid(ctx);
       break;
     case MESSAGETYPE_ACK:
-      return pkg_headerext_ack_get_acksenderid();
+      return pkg_headerext_ack_ctx_get_acksenderid(ctx);
       break;
     default:
       return 0;
@@ -210,48 +251,60 @@ static uint32_t pkg_headerext_common_get_acksenderid(void)
   }
 }
 
+static uint32_t pkg_headerext_common_get_acksenderid(void) __attribute__ ((unused));
+static uint32_t pkg_headerext_common_get_acksenderid(void)
+{
+  return pkg_headerext_common_ctx_get_acksenderid(PKG_CTX_GLOBAL);
+}
+
 // Set ReceiverID (UIntValue)
 // Same function for all MessageTypes!
-static void pkg_headerext_common_set_receiverid(uint32_t val) __attribute__ ((unused));
-static void pkg_headerext_common_set_receiverid(uint32_t val)
+static void pkg_headerext_common_ctx_set_receiverid(const pkg_ctx_t * ctx, uint32_t val) __attribute__ ((unused));
+static void pkg_headerext_common_ctx_set_receiverid(const pkg_ctx_t * ctx, uint32_t val)
 {
-  switch (__MESSAGETYPE)
+  switch (ctx->messagetype)
   {
     case MESSAGETYPE_DELIVER:
-      pkg_headerext_deliver_set_receiverid(val);
+      pkg_headerext_deliver_ctx_set_receiverid(ctx, val);
       break;
     case MESSAGETYPE_SETGET:
-      pkg_headerext_setget_set_receiverid(val);
+      pkg_headerext_setget_ctx_set_receiverid(ctx, val);
       break;
     case MESSAGETYPE_SET:
-      pkg_headerext_set_set_receiverid(val);
+      pkg_headerext_set_ctx_set_receiverid(ctx, val);
       break;
     case MESSAGETYPE_GET:
-      pkg_headerext_get_set_receiverid(val);
+      pkg_headerext_get_ctx_set_receiverid(ctx, val);
       break;
     default:
       break;
   }
 }
 
+static void pkg_headerext_common_set_receiverid(uint32_t val) __attribute__ ((unused));
+static void pkg_headerext_common_set_receiverid(uint32_t val)
+{
+  pkg_headerext_common_ctx_set_receiverid(PKG_CTX_GLOBAL, val);
+}
+
 // Get ReceiverID (UIntValue)
 // Same function for all MessageTypes!
-static uint32_t pkg_headerext_common_get_receiverid(void) __attribute__ ((unused));
-static uint32_t pkg_headerext_common_get_receiverid(void)
+static uint32_t pkg_headerext_common_ctx_get_receiverid(const pkg_ctx_t * ctx) __attribute__ ((unused));
+static uint32_t pkg_headerext_common_ctx_get_receiverid(const pkg_ctx_t * ctx)
 {
-  switch (__MESSAGETYPE)
+  switch (ctx->messagetype)
   {
     case MESSAGETYPE_DELIVER:
-      return pkg_headerext_deliver_get_receiverid();
+      return pkg_headerext_deliver_ctx_get_receiverid(ctx);
       break;
     case MESSAGETYPE_SETGET:
-      return pkg_headerext_setget_get_receiverid();
+      return pkg_headerext_setget_ctx_get_receiverid(ctx);
       break;
     case MESSAGETYPE_SET:
-      return pkg_headerext_set_get_receiverid();
+      return pkg_headerext_set_ctx_get_receiverid(ctx);
       break;
     case MESSAGETYPE_GET:
-      return pkg_headerext_get_get_receiverid();
+      return pkg_headerext_get_ctx_get_receiverid(ctx);
       break;
     default:
       return 0;
@@ -259,60 +312,72 @@ static uint32_t pkg_headerext_common_get_receiverid(void)
   }
 }
 
+static uint32_t pkg_headerext_common_get_receiverid(void) __attribute__ ((unused));
+static uint32_t pkg_headerext_common_get_receiverid(void)
+{
+  return pkg_headerext_common_ctx_get_receiverid(PKG_CTX_GLOBAL);
+}
+
 // Set MessageGroupID (UIntValue)
 // Same function for all MessageTypes!
-static void pkg_headerext_common_set_messagegroupid(uint32_t val) __attribute__ ((unused));
-static void pkg_headerext_common_set_messagegroupid(uint32_t val)
+static void pkg_headerext_common_ctx_set_messagegroupid(const pkg_ctx_t * ctx, uint32_t val) __attribute__ ((unused));
+static void pkg_headerext_common_ctx_set_messagegroupid(const pkg_ctx_t * ctx, uint32_t val)
 {
-  switch (__MESSAGETYPE)
+  switch (ctx->messagetype)
   {
     case MESSAGETYPE_ACKSTATUS:
-      pkg_headerext_ackstatus_set_messagegroupid(val);
+      pkg_headerext_ackstatus_ctx_set_messagegroupid(ctx, val);
       break;
     case MESSAGETYPE_STATUS:
-      pkg_headerext_status_set_messagegroupid(val);
+      pkg_headerext_status_ctx_set_messagegroupid(ctx, val);
       break;
     case MESSAGETYPE_DELIVER:
-      pkg_headerext_deliver_set_messagegroupid(val);
+      pkg_headerext_deliver_ctx_set_messagegroupid(ctx, val);
       break;
     case MESSAGETYPE_SETGET:
-      pkg_headerext_setget_set_messagegroupid(val);
+      pkg_headerext_setget_ctx_set_messagegroupid(ctx, val);
       break;
     case MESSAGETYPE_SET:
-      pkg_headerext_set_set_messagegroupid(val);
+      pkg_headerext_set_ctx_set_messagegroupid(ctx, val);
       break;
     case MESSAGETYPE_GET:
-      pkg_headerext_get_set_messagegroupid(val);
+      pkg_headerext_get_ctx_set_messagegroupid(ctx, val);
       break;
     default:
       break;
   }
 }
 
+static void pkg_headerext_common_set_messagegroupid(uint32_t val) __attribute__ ((unused));
+static void pkg_headerext_common_set_messagegroupid(uint32_t val)
+{
+  pkg_headerext_common_ctx_set_messagegroupid(PKG_CTX_GLOBAL, val);
+}
+
 // Get MessageGroupID (UIntValue)
 // Same function for all MessageTypes!
-static uint32_t pkg_headerext_common_get_messagegroupid(void) __attribute__ ((unused));
-static uint32_t pkg_headerext_common_get_messagegroupid(void)
+static uint32_t pkg_headerext_common_ctx_get_messagegroupid(const pkg_ctx_t * ctx) __attribute__ ((unused));
+static uint32_t pkg_headerext_common_ctx_get_messagegroupid(const pkg_ctx_t * ctx)
 {
-  switch (__MESSAGETYPE)
+  switch (ctx->messagetype)
   {
     case MESSAGETYPE_ACKSTATUS:
-      return pkg_headerext_ackstatus_get_messagegroupid();
+      return pkg_headerext_ackstatus_ctx_get_messagegroupid(ctx);
       break;
     case MESSAGETYPE_STATUS:
-      return pkg_headerext_status_get_messagegroupid();
+      return pkg_headerext_status_ctx_get_messagegroupid(ctx);
       break;
     case MESSAGETYPE_DELIVER:
-      return pkg_headerext_deliver_get_messagegroupid();
+      return pkg_headerext_deliver_ctx_get_messagegroupid(ctx);
       break;
     case MESSAGETYPE_SETGET:
-      return pkg_headerext_setget_get_messagegroupid();
+      return pkg_headerext_setget_ctx_get_messagegroupid(ctx);
       break;
     case MESSAGETYPE_SET:
-      return pkg_headerext_set_get_messagegroupid();
+      return pkg_headerext_set_ctx_get_messagegroupid(ctx);
       break;
     case MESSAGETYPE_GET:
-      return pkg_headerext_get_get_messagegroupid();
+      return pkg_headerext_get_ctx_get_messagegroupid(ctx);
       break;
     default:
       return 0;
@@ -320,36 +385,48 @@ static uint32_t pkg_headerext_common_get_messagegroupid(void)
   }
 }
 
+static uint32_t pkg_headerext_common_get_messagegroupid(void) __attribute__ ((unused));
+static uint32_t pkg_headerext_common_get_messagegroupid(void)
+{
+  return pkg_headerext_common_ctx_get_messagegroupid(PKG_CTX_GLOBAL);
+}
+
 // Set Error (BoolValue)
 // Same function for all MessageTypes!
-static void pkg_headerext_common_set_error(bool val) __attribute__ ((unused));
-static void pkg_headerext_common_set_error(bool val)
+static void pkg_headerext_common_ctx_set_error(const pkg_ctx_t * ctx, bool val) __attribute__ ((unused));
+static void pkg_headerext_common_ctx_set_error(const pkg_ctx_t * ctx, bool val)
 {
-  switch (__MESSAGETYPE)
+  switch (ctx->messagetype)
   {
     case MESSAGETYPE_ACKSTATUS:
-      pkg_headerext_ackstatus_set_error(val);
+      pkg_headerext_ackstatus_ctx_set_error(ctx, val);
       break;
     case MESSAGETYPE_ACK:
-      pkg_headerext_ack_set_error(val);
+      pkg_headerext_ack_ctx_set_error(ctx, val);
       break;
     default:
       break;
   }
 }
 
+static void pkg_headerext_common_set_error(bool val) __attribute__ ((unused));
+static void pkg_headerext_common_set_error(bool val)
+{
+  pkg_headerext_common_ctx_set_error(PKG_CTX_GLOBAL, val);
+}
+
 // Get Error (BoolValue)
 // Same function for all MessageTypes!
-static bool pkg_headerext_common_get_error(void) __attribute__ ((unused));
-static bool pkg_headerext_common_get_error(void)
+static bool pkg_headerext_common_ctx_get_error(const pkg_ctx_t * ctx) __attribute__ ((unused));
+static bool pkg_headerext_common_ctx_get_error(const pkg_ctx_t * ctx)
 {
-  switch (__MESSAGETYPE)
+  switch (ctx->messagetype)
   {
     case MESSAGETYPE_ACKSTATUS:
-      return pkg_headerext_ackstatus_get_error();
+      return pkg_headerext_ackstatus_ctx_get_error(ctx);
       break;
     case MESSAGETYPE_ACK:
-      return pkg_headerext_ack_get_error();
+      return pkg_headerext_ack_ctx_get_error(ctx);
       break;
     default:
       return 0;
@@ -357,4 +434,10 @@ static bool pkg_headerext_common_get_error(void)
   }
 }
 
+static bool pkg_headerext_common_get_error(void) __attribute__ ((unused));
+static bool pkg_headerext_common_get_error(void)
+{
+  return pkg_headerext_common_ctx_get_error(PKG_CTX_GLOBAL);
+}
+
 #endif /* _PACKET_HEADEREXT_COMMON_H */
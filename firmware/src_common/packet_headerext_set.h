@@ -31,16 +31,26 @@
 
 // Set ReceiverID (UIntValue)
 // Offset: 72, length bits 12, min val 0, max val 4095
+static inline void pkg_headerext_set_ctx_set_receiverid(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue(72, 12, val, ctx->buf);
+}
+
 static inline void pkg_headerext_set_set_receiverid(uint32_t val)
 {
-  array_write_UIntValue(72, 12, val, bufx);
+  pkg_headerext_set_ctx_set_receiverid(PKG_CTX_GLOBAL, val);
 }
 
 // Get ReceiverID (UIntValue)
 // Offset: 72, length bits 12, min val 0, max val 4095
+static inline uint32_t pkg_headerext_set_ctx_get_receiverid(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32(72, 12, 0, 4095, ctx->buf);
+}
+
 static inline uint32_t pkg_headerext_set_get_receiverid(void)
 {
-  return array_read_UIntValue32(72, 12, 0, 4095, bufx);
+  return pkg_headerext_set_ctx_get_receiverid(PKG_CTX_GLOBAL);
 }
 
 // MessageGroupID (UIntValue)
@@ -48,32 +58,52 @@ static inline uint32_t pkg_headerext_set_get_receiverid(void)
 
 // Set MessageGroupID (UIntValue)
 // Offset: 84, length bits 7, min val 0, max val 127
+static inline void pkg_headerext_set_ctx_set_messagegroupid(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue(84, 7, val, ctx->buf);
+}
+
 static inline void pkg_headerext_set_set_messagegroupid(uint32_t val)
 {
-  array_write_UIntValue(84, 7, val, bufx);
+  pkg_headerext_set_ctx_set_messagegroupid(PKG_CTX_GLOBAL, val);
 }
 
 // Get MessageGroupID (UIntValue)
 // Offset: 84, length bits 7, min val 0, max val 127
+static inline uint32_t pkg_headerext_set_ctx_get_messagegroupid(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32(84, 7, 0, 127, ctx->buf);
+}
+
 static inline uint32_t pkg_headerext_set_get_messagegroupid(void)
 {
-  return array_read_UIntValue32(84, 7, 0, 127, bufx);
+  return pkg_headerext_set_ctx_get_messagegroupid(PKG_CTX_GLOBAL);
 }
 
 // MessageID (UIntValue)
 
 // Set MessageID (UIntValue)
 // Offset: 91, length bits 4, min val 0, max val 15
+static inline void pkg_headerext_set_ctx_set_messageid(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue(91, 4, val, ctx->buf);
+}
+
 static inline void pkg_headerext_set_set_messageid(uint32_t val)
 {
-  array_write_UIntValue(91, 4, val, bufx);
+  pkg_headerext_set_ctx_set_messageid(PKG_CTX_GLOBAL, val);
 }
 
 // Get MessageID (UIntValue)
 // Offset: 91, length bits 4, min val 0, max val 15
+static inline uint32_t pkg_headerext_set_ctx_get_messageid(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32(91, 4, 0, 15, ctx->buf);
+}
+
 static inline uint32_t pkg_headerext_set_get_messageid(void)
 {
-  return array_read_UIntValue32(91, 4, 0, 15, bufx);
+  return pkg_headerext_set_ctx_get_messageid(PKG_CTX_GLOBAL);
 }
 
 
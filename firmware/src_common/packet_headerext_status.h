@@ -31,32 +31,52 @@
 
 // Set MessageGroupID (UIntValue)
 // Offset: 72, length bits 7, min val 0, max val 127
+static inline void pkg_headerext_status_ctx_set_messagegroupid(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue(72, 7, val, ctx->buf);
+}
+
 static inline void pkg_headerext_status_set_messagegroupid(uint32_t val)
 {
-  array_write_UIntValue(72, 7, val, bufx);
+  pkg_headerext_status_ctx_set_messagegroupid(PKG_CTX_GLOBAL, val);
 }
 
 // Get MessageGroupID (UIntValue)
 // Offset: 72, length bits 7, min val 0, max val 127
+static inline uint32_t pkg_headerext_status_ctx_get_messagegroupid(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32(72, 7, 0, 127, ctx->buf);
+}
+
 static inline uint32_t pkg_headerext_status_get_messagegroupid(void)
 {
-  return array_read_UIntValue32(72, 7, 0, 127, bufx);
+  return pkg_headerext_status_ctx_get_messagegroupid(PKG_CTX_GLOBAL);
 }
 
 // MessageID (UIntValue)
 
 // Set MessageID (UIntValue)
 // Offset: 79, length bits 4, min val 0, max val 15
+static inline void pkg_headerext_status_ctx_set_messageid(const pkg_ctx_t * ctx, uint32_t val)
+{
+  array_write_UIntValue(79, 4, val, ctx->buf);
+}
+
 static inline void pkg_headerext_status_set_messageid(uint32_t val)
 {
-  array_write_UIntValue(79, 4, val, bufx);
+  pkg_headerext_status_ctx_set_messageid(PKG_CTX_GLOBAL, val);
 }
 
 // Get MessageID (UIntValue)
 // Offset: 79, length bits 4, min val 0, max val 15
+static inline uint32_t pkg_headerext_status_ctx_get_messageid(const pkg_ctx_t * ctx)
+{
+  return array_read_UIntValue32(79, 4, 0, 15, ctx->buf);
+}
+
 static inline uint32_t pkg_headerext_status_get_messageid(void)
 {
-  return array_read_UIntValue32(79, 4, 0, 15, bufx);
+  return pkg_headerext_status_ctx_get_messageid(PKG_CTX_GLOBAL);
 }
 
 
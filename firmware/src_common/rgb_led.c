@@ -17,15 +17,19 @@
 */
 
 #include "rgb_led.h"
-#include <avr/interrupt.h>
-#include <util/delay.h>
 #include "uart.h"
+#include "util_fixedpoint.h"
 
 uint8_t rgb_led_user_brightness_factor = 100; // additional brightness changeable by brightness message
 
 struct rgb_color_t current_col; // The current (mixed) color calculated within an animation.
 uint16_t current_tone_PWM;      // The current PWM value for the (slided) tone calculated within an melody.
 
+// Incremental calculation of the current animation step from color/tone col_pos (index 0)
+// to col_pos + 1 (index 1), so that an animation tick needs no multiplication or division.
+struct dda16_t anim_dda[2][3];  // red, green, blue
+struct dda16_t melody_dda[2];
+
 // Timer0 (8 Bit) and Timer2 (8 Bit) are used for the PWM output for the LEDs
 // and the interrupt that advances the values for the animation.
 // Timer1 (16 Bit) is used for the tone generator (speaker).
@@ -56,9 +60,16 @@ void PWM_init(void)
 	// OC2B (Blue LED):  Phase correct PWM, 8 Bit, TOP = 0xFF = 255, non-inverting output
 	TCCR2A = (1 << WGM20) | (1 << COM2B1);
 
+#ifdef RGBLED_DITHER
+	// Clock source for timer 0 and 2 = I/O clock, 1/8 prescaler -> ~ 1960 Hz at 8 Mhz.
+	// The dithering over 4 PWM cycles results in ~ 490 Hz.
+	TCCR0B = (1 << CS01);
+	TCCR2B = (1 << CS21);
+#else
 	// Clock source for timer 0 and 2 = I/O clock, 1/64 prescaler -> ~ 244 Hz at 8 Mhz, ~ 610 Hz at 20 MHz
 	TCCR0B = (1 << CS01) | (1 << CS00);
 	TCCR2B = (1 << CS21) | (1 << CS20);
+#endif
 
 	// Timer/Counter1 Overflow Interrupt Enable
 	// Timer0 is used for counting of the animation time as well
@@ -81,11 +92,90 @@ void PWM_init(void)
 	// -> 2B ändern bei Controller!
 }
 
+// PWM values of the LEDs (red, green, blue) in 1/4 steps of the 8 bit timer.
+// The upper part is written to the OCR registers, the lower 2 bits are added
+// by rgb_led_dither (if RGBLED_DITHER is defined).
+static uint8_t rgb_led_pwm_hi[3];
+#ifdef RGBLED_DITHER
+static uint8_t rgb_led_pwm_lo[3];
+#endif
+
+// Product of both brightness factors as 1/32768, so that the scaling needs no division.
+// It is recalculated only when one of the factors changed.
+static uint16_t brightness_scale;
+static uint8_t brightness_scale_factor = 0;
+static uint8_t brightness_scale_user_factor = 0;
+
+// Translate the color value by the selected gamma curve and scale it by the brightness.
+// Returns the 10 bit PWM value.
+static uint16_t color_to_pwm(const uint16_t * curve, uint8_t c)
+{
+	// position in the curve as 8.8 fixed point value, c * 32 / 255
+	uint16_t pos = (c << 5) + ((c + 4) >> 3);
+	uint8_t i = pos >> 8;
+	uint16_t a = pgm_read_word(&curve[i]);
+	uint16_t pwm = a;
+
+	if (i < 32)
+	{
+		pwm += ((pgm_read_word(&curve[i + 1]) - a) * (pos & 0xff)) >> 8;
+	}
+
+	return (uint32_t)pwm * brightness_scale >> 15;
+}
+
 void rgb_led_set_PWM(struct rgb_color_t color)
 {
-	OCR0A = (uint32_t)(pgm_read_word(&(rgb_led_pwm_transl[color.r]))) * rgb_led_brightness_factor * rgb_led_user_brightness_factor / 10000;
-	OCR0B = (uint32_t)(pgm_read_word(&(rgb_led_pwm_transl[color.g]))) * rgb_led_brightness_factor * rgb_led_user_brightness_factor / 10000;
-	OCR2B = (uint32_t)(pgm_read_word(&(rgb_led_pwm_transl[color.b]))) * rgb_led_brightness_factor * rgb_led_user_brightness_factor / 10000;
+	const uint16_t * curve;
+	uint16_t pwm[3];
+	uint8_t i;
+
+	if ((brightness_scale_factor != rgb_led_brightness_factor)
+		|| (brightness_scale_user_factor != rgb_led_user_brightness_factor))
+	{
+		brightness_scale_factor = rgb_led_brightness_factor;
+		brightness_scale_user_factor = rgb_led_user_brightness_factor;
+		brightness_scale = (uint32_t)brightness_scale_factor * brightness_scale_user_factor * 32768 / 10000;
+	}
+
+	curve = rgb_led_gamma_curves[rgb_led_gamma_curve < RGBLED_GAMMA_CURVES ? rgb_led_gamma_curve : 0];
+
+	pwm[0] = color_to_pwm(curve, color.r);
+	pwm[1] = color_to_pwm(curve, color.g);
+	pwm[2] = color_to_pwm(curve, color.b);
+
+	for (i = 0; i < 3; i++)
+	{
+#ifdef RGBLED_DITHER
+		rgb_led_pwm_hi[i] = pwm[i] >> 2;
+		rgb_led_pwm_lo[i] = pwm[i] & 3;
+#else
+		rgb_led_pwm_hi[i] = (pwm[i] + 2) >> 2;
+#endif
+	}
+
+	OCR0A = rgb_led_pwm_hi[0];
+	OCR0B = rgb_led_pwm_hi[1];
+	OCR2B = rgb_led_pwm_hi[2];
+}
+
+// Increase the resolution of the 8 bit PWM to 10 bit by adding 1 to the OCR value
+// in 0..3 of 4 subsequent PWM cycles (temporal dithering).
+// Has to be called on every Timer0 overflow.
+void rgb_led_dither(void)
+{
+#ifdef RGBLED_DITHER
+	static uint8_t cnt = 0;
+
+	// order 0, 2, 1, 3 to spread the additional cycles evenly
+	uint8_t phase = ((cnt & 1) << 1) | ((cnt >> 1) & 1);
+
+	cnt++;
+
+	OCR0A = rgb_led_pwm_hi[0] + (rgb_led_pwm_lo[0] > phase);
+	OCR0B = rgb_led_pwm_hi[1] + (rgb_led_pwm_lo[1] > phase);
+	OCR2B = rgb_led_pwm_hi[2] + (rgb_led_pwm_lo[2] > phase);
+#endif
 }
 
 // Switch off speaker on special frequency_index == 0,
@@ -151,18 +241,65 @@ uint16_t index2tonePWM(uint8_t frequency_index)
 	}
 }
 
+// Return from_val * (len - pos) / len + to_val * pos / len (each part rounded down)
+// for the values calculated incrementally by the DDAs.
+static uint16_t dda_blend(uint16_t from_val, const struct dda16_t * from, const struct dda16_t * to)
+{
+	// floor(from_val * (len - pos) / len) = from_val - ceil(from_val * pos / len)
+	return from_val - from->quot - (from->rem != 0) + to->quot;
+}
+
+// Prepare the incremental calculation for the animation step starting at col_pos.
+static void animation_step_init(bool RGB_LED)
+{
+	if (RGB_LED)
+	{
+		struct rgb_color_t from = anim_col[animation.col_pos];
+		struct rgb_color_t to = anim_col[animation.col_pos + 1];
+
+		dda16_init(&anim_dda[0][0], from.r, animation.step_len);
+		dda16_init(&anim_dda[0][1], from.g, animation.step_len);
+		dda16_init(&anim_dda[0][2], from.b, animation.step_len);
+		dda16_init(&anim_dda[1][0], to.r, animation.step_len);
+		dda16_init(&anim_dda[1][1], to.g, animation.step_len);
+		dda16_init(&anim_dda[1][2], to.b, animation.step_len);
+	}
+	else
+	{
+		dda16_init(&melody_dda[0], melody_PWM[melody.col_pos], melody.step_len);
+		dda16_init(&melody_dda[1], melody_PWM[melody.col_pos + 1], melody.step_len);
+	}
+}
+
+// Advance the incremental calculation by one tick (step_pos + 1).
+static void animation_step_next(bool RGB_LED)
+{
+	uint8_t i;
+
+	if (RGB_LED)
+	{
+		for (i = 0; i < 3; i++)
+		{
+			dda16_step(&anim_dda[0][i], animation.step_len);
+			dda16_step(&anim_dda[1][i], animation.step_len);
+		}
+	}
+	else
+	{
+		dda16_step(&melody_dda[0], melody.step_len);
+		dda16_step(&melody_dda[1], melody.step_len);
+	}
+}
+
 // Calculate the color that has to be shown according to the animation settings and counters.
 // Save the color as currently active color in current_col.
 void rgb_led_update_current_col(void)
 {
 	if (animation.step_len != 0) // animation running
 	{
-		current_col.r = (uint8_t)((uint32_t)anim_col[animation.col_pos].r * (animation.step_len - animation.step_pos) / animation.step_len
-			+ (uint32_t)anim_col[animation.col_pos + 1].r * animation.step_pos / animation.step_len);
-		current_col.g = (uint8_t)((uint32_t)anim_col[animation.col_pos].g * (animation.step_len - animation.step_pos) / animation.step_len
-			+ (uint32_t)anim_col[animation.col_pos + 1].g * animation.step_pos / animation.step_len);
-		current_col.b = (uint8_t)((uint32_t)anim_col[animation.col_pos].b * (animation.step_len - animation.step_pos) / animation.step_len
-			+ (uint32_t)anim_col[animation.col_pos + 1].b * animation.step_pos / animation.step_len);
+		current_col.r = dda_blend(anim_col[animation.col_pos].r, &anim_dda[0][0], &anim_dda[1][0]);
+		current_col.g = dda_blend(anim_col[animation.col_pos].g, &anim_dda[0][1], &anim_dda[1][1]);
+		current_col.b = dda_blend(anim_col[animation.col_pos].b, &anim_dda[0][2], &anim_dda[1][2]);
 	}
 
 	//UART_PUTF("animation.col_pos %d, ", animation.col_pos);
@@ -178,8 +315,7 @@ void speaker_update_current_tone(void)
 	if (melody.step_len != 0) // melody playing
 	{
 		if (melody_effect[melody.col_pos] == 1)
-			current_tone_PWM = (uint16_t)((uint32_t)melody_PWM[melody.col_pos] * (melody.step_len - melody.step_pos) / melody.step_len
-				+ (uint32_t)melody_PWM[melody.col_pos + 1] * melody.step_pos / melody.step_len);
+			current_tone_PWM = dda_blend(melody_PWM[melody.col_pos], &melody_dda[0], &melody_dda[1]);
 		else
 			current_tone_PWM = melody_PWM[melody.col_pos + 1];
 	}
@@ -205,6 +341,7 @@ void animation_tick(bool RGB_LED)
 	if (par->step_pos < par->step_len)
 	{
 		par->step_pos++;
+		animation_step_next(RGB_LED);
 	}
 	else
 	{
@@ -224,6 +361,7 @@ void animation_tick(bool RGB_LED)
 			par->col_pos = par->rfirst;
 			par->step_pos = 0;
 			par->step_len = rgb_led_timer_cycles[array_time[par->col_pos] - 1];
+			animation_step_init(RGB_LED);
 		}
 		// When animation step at animation.llast is completed (animation.col_pos = animation.llast) and
 		// animation.repeat = 1, stop animation.
@@ -245,6 +383,7 @@ void animation_tick(bool RGB_LED)
 			par->col_pos++;
 			par->step_pos = 0;
 			par->step_len = rgb_led_timer_cycles[array_time[par->col_pos] - 1];
+			animation_step_init(RGB_LED);
 
 			UART_PUTF2("--- Go to next color, new animation.col_pos: %d. new animation.step_len: %d\r\n", par->col_pos, par->step_len);
 		}
@@ -258,7 +397,7 @@ void animation_tick(bool RGB_LED)
 
 void rgb_led_set_fixed_color(uint8_t color_index)
 {
-	cli();
+	hal_irq_disable();
 
 	animation.step_len = 0;
 	current_col = index2color(color_index);
@@ -268,7 +407,7 @@ void rgb_led_set_fixed_color(uint8_t color_index)
 	//UART_PUTF("Set color nr. %d\r\n", color_index);
 	rgb_led_update_current_col();
 
-	sei();
+	hal_irq_enable();
 }
 
 /* unused DEBUG function
@@ -422,6 +561,7 @@ void init_animation(bool RGB_LED)
 	UART_PUTF("animation.llast: %d\r\n", par->llast); */
 
 	par->step_len = rgb_led_timer_cycles[array_time[0] - 1];
+	animation_step_init(RGB_LED);
 }
 
 // Print out the animation parameters, indexed colors used in the "Set"/"SetGet" message and the
@@ -589,10 +729,10 @@ void test_melody_calculation(void)
 void startup_sound(void)
 {
 	speaker_set_fixed_tone(49);
-	_delay_ms(50);
+	hal_delay_ms(50);
 	speaker_set_fixed_tone(0);
-	_delay_ms(100);
+	hal_delay_ms(100);
 	speaker_set_fixed_tone(49);
-	_delay_ms(50);
+	hal_delay_ms(50);
 	speaker_set_fixed_tone(0);
 }
@@ -19,10 +19,9 @@
 #ifndef _RGB_LED_H
 #define _RGB_LED_H
 
-#include <avr/io.h>
 #include <inttypes.h>
 #include <stdbool.h>
-#include <avr/pgmspace.h>
+#include "hal.h"
 
 // For the given 5 bit animation time, these are the lengths in timer 2 cycles.
 // The input value x means 0.05s * 1.3 ^ x and covers 30ms to 170s. Each timer cycle is 32.768ms.
@@ -34,22 +33,24 @@ static const uint16_t rgb_led_timer_cycles[31] = {
 	78, 102, 132, 172, 223, 290, 377, 490, 637, 828,
 	1077, 1400, 1820, 2366, 3075, 3998, 5197};
 
+// Gamma curves (see GammaCurve in e2p_rgbdimmer.h), which translate the perceptual
+// 8 bit color values to 10 bit PWM values (0..1020). Each curve has 33 values for the
+// color values 0, 255/32, 2 * 255/32, ..., 255. The values in between are interpolated.
 // https://www.nongnu.org/avr-libc/user-manual/pgmspace.html
-static const uint16_t rgb_led_pwm_transl[256] PROGMEM = {
-	0, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 7, 7, 7, 7,
-	8, 8, 8, 9, 9, 9, 9, 10, 10, 10, 11, 11, 11, 11, 12, 12, 12, 13, 13, 13, 14, 14,
-	14, 14, 15, 15, 15, 16, 16, 16, 17, 17, 17, 18, 18, 18, 19, 19, 19, 20, 20, 20,
-	21, 21, 21, 22, 22, 22, 23, 23, 23, 24, 24, 24, 25, 25, 25, 26, 26, 27, 27, 27,
-	28, 28, 28, 29, 29, 30, 30, 30, 31, 31, 32, 32, 32, 33, 33, 34, 34, 34, 35, 35,
-	36, 36, 37, 37, 38, 38, 38, 39, 39, 40, 40, 41, 41, 42, 42, 43, 43, 44, 44, 45,
-	46, 46, 47, 47, 48, 48, 49, 49, 50, 51, 51, 52, 52, 53, 54, 54, 55, 56, 56, 57,
-	58, 58, 59, 60, 60, 61, 62, 63, 63, 64, 65, 66, 67, 67, 68, 69, 70, 71, 72, 73,
-	73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 87, 88, 89, 90, 91, 92, 94,
-	95, 96, 97, 99, 100, 101, 103, 104, 105, 107, 108, 110, 111, 113, 114, 116, 118,
-	119, 121, 123, 124, 126, 128, 130, 132, 134, 135, 137, 139, 141, 144, 146, 148,
-	150, 152, 155, 157, 159, 162, 164, 167, 169, 172, 174, 177, 180, 183, 185, 188,
-	191, 194, 197, 200, 204, 207, 210, 214, 217, 221, 224, 228, 231, 235, 239, 243,
-	247, 251, 255};
+#define RGBLED_GAMMA_CURVES 4
+static const uint16_t rgb_led_gamma_curves[RGBLED_GAMMA_CURVES][33] PROGMEM = {
+	// 0: smarthomatic default (former 8 bit translation table)
+	{ 0, 12, 20, 28, 36, 47, 56, 67, 76, 88, 99, 111, 122, 136, 150, 164, 182,
+	  198, 218, 240, 266, 292, 321, 357, 397, 441, 493, 549, 621, 697, 789, 896, 1020 },
+	// 1: gamma 1.8
+	{ 0, 2, 7, 14, 24, 36, 50, 66, 84, 104, 126, 149, 175, 202, 230, 261, 293,
+	  327, 362, 399, 438, 478, 520, 563, 608, 654, 702, 751, 802, 854, 908, 963, 1020 },
+	// 2: gamma 2.2
+	{ 0, 0, 2, 6, 11, 17, 26, 36, 48, 63, 79, 97, 118, 141, 165, 193, 222,
+	  254, 288, 324, 363, 404, 447, 493, 542, 593, 646, 702, 760, 821, 885, 951, 1020 },
+	// 3: gamma 2.8
+	{ 0, 0, 0, 1, 3, 6, 9, 14, 21, 29, 39, 51, 65, 82, 101, 122, 146,
+	  174, 204, 237, 274, 314, 357, 405, 456, 511, 570, 634, 702, 774, 851, 933, 1020 } };
 
 // PWM TOP values to generate frequencies according calculations in Extra/frequencies.ods
 #if (F_CPU == 8000000)
@@ -106,6 +107,7 @@ struct animation_param_t melody;
 
 uint8_t rgb_led_brightness_factor;           // fixed, from e2p
 uint8_t rgb_led_user_brightness_factor;      // additional brightness changeable by brightness message
+uint8_t rgb_led_gamma_curve;                 // index in rgb_led_gamma_curves, from e2p (RGB dimmer only)
 
 #define ANIM_COL_ORIG_MAX 10                 // animation length
 #define ANIM_COL_MAX 31                      // 3x animation length + 1 to unfold the color sequence
@@ -129,6 +131,7 @@ void init_animation(bool RGB_LED);
 
 // functions for RGB LED
 void rgb_led_set_PWM(struct rgb_color_t color);
+void rgb_led_dither(void);
 struct rgb_color_t index2color(uint8_t color);
 void rgb_led_update_current_col(void);
 void rgb_led_set_fixed_color(uint8_t color_index);
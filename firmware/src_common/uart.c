@@ -16,10 +16,7 @@
 * with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <avr/io.h>
-#include <avr/interrupt.h>
 #include <stdlib.h>
-#include <avr/eeprom.h>
 #include <string.h>
 
 #include "uart.h"
@@ -55,11 +52,11 @@ uint8_t bytes_pos = 0;
 bool send_data_avail = false;
 
 // Store received byte in ringbuffer. No processing.
-ISR(USART_RX_vect)
+HAL_UART_RX_ISR(c)
 {
 	if (rxbuf_count < RXBUF_LENGTH)
 	{
-		rxbuf[(uint8_t)((uint16_t)(rxbuf_startpos + rxbuf_count) % RXBUF_LENGTH)] = UDR0;
+		rxbuf[(uint8_t)((uint16_t)(rxbuf_startpos + rxbuf_count) % RXBUF_LENGTH)] = c;
 		rxbuf_count++;
 	} // else: Buffer overflow (undetected!)
 }
@@ -70,19 +67,11 @@ ISR(USART_RX_vect)
 void uart_init_ubbr(uint16_t ubrr_val)
 {
 #ifdef UART_DEBUG
-	PORTD |= 0x01;                          // switch on pull-up on RXD
-
- 	UCSR0B |= (1 << TXEN0);                 // turn on UART TX
- 	UCSR0C |= (1 << USBS0) | (3 << UCSZ00); // asynchronous mode 8N1
- 	UCSR0B |= (1 << RXEN0 );                // turn on UART RX
-
- 	UBRR0H = (uint8_t)(ubrr_val >> 8);
- 	UBRR0L = (uint8_t)(ubrr_val & 0xFF);
-
 #ifdef UART_RX
-	UCSR0B |= (1 << RXCIE0);                // activate rx IRQ
+	hal_uart_init(ubrr_val, true);          // with rx IRQ
+#else
+	hal_uart_init(ubrr_val, false);
 #endif // UART_RX
-
 #endif // UART_DEBUG
 }
 
@@ -95,8 +84,7 @@ void uart_init(void)
 #ifdef UART_DEBUG
 void uart_putc(char c)
 {
-	while (!(UCSR0A & (1<<UDRE0))); /* warten bis Senden moeglich                   */
-	UDR0 = c;                       /* schreibt das Zeichen x auf die Schnittstelle */
+	hal_uart_putc(c);
 }
 #endif // UART_DEBUG
 
@@ -187,7 +175,7 @@ void process_cmd(void)
 			uint16_t adr = hex_to_uint8((uint8_t *)cmdbuf, 1);
 			uint8_t val = hex_to_uint8((uint8_t *)cmdbuf, 3);
 			UART_PUTF2("Writing data 0x%x to EEPROM pos 0x%x.\r\n", val, adr);
-			eeprom_write_byte((uint8_t *)adr, val);
+			hal_eeprom_write_byte(adr, val);
 		}
 		else
 		{
@@ -197,7 +185,7 @@ void process_cmd(void)
 	else if ((cmdbuf[0] == 'r') && (strlen(cmdbuf) == 3)) // E2P read command
 	{
 		uint16_t adr = hex_to_uint8((uint8_t *)cmdbuf, 1);
-		uint8_t val = eeprom_read_byte((uint8_t *)adr);
+		uint8_t val = hal_eeprom_read_byte(adr);
 		UART_PUTF2("EEPROM value at position 0x%x is 0x%x.\r\n", adr, val);
 	}
 	else if ((cmdbuf[0] == 's') && (strlen(cmdbuf) > 6)) // "send" command
@@ -255,11 +243,11 @@ void process_rxbuf(void)
 		char input;
 
 		// get one char from the ringbuffer and reduce its size without interruption through the UART ISR
-		cli();
+		hal_irq_disable();
 		input = rxbuf[rxbuf_startpos];
 		rxbuf_startpos = (rxbuf_startpos + 1) % RXBUF_LENGTH;
 		rxbuf_count--;
-		sei();
+		hal_irq_enable();
 
 		// process character
 		if (uart_timeout == 0)
@@ -22,7 +22,7 @@
 #include <inttypes.h>
 #include <stdio.h>
 #include <stdbool.h>
-#include <avr/pgmspace.h>
+#include "hal.h"
 
 // http://www.mikrocontroller.net/articles/AVR-GCC-Tutorial/Der_UART#UART_initialisieren
 #ifndef UART_BAUD_RATE
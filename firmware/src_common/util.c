@@ -20,4 +20,6 @@
 #include "util_hw.c"
 #include "util_watchdog.c"
 #include "util_rfm12.c"
+#include "util_fixedpoint.c"
+#include "util_timer.c"
 #include "e2p_access.c"
@@ -20,4 +20,6 @@
 #include "util_hw.h"
 #include "util_watchdog.h"
 #include "util_rfm12.h"
+#include "util_fixedpoint.h"
+#include "util_timer.h"
 #include "e2p_access.h"
@@ -0,0 +1,143 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2024 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "util_fixedpoint.h"
+
+// Convert an IEEE 754 single precision float value, given as its bit pattern
+// (e.g. as received from a sensor), to round(value * scale).
+// Only integer operations are used, so no floating point library is needed.
+// Negative values and NaN are returned as 0, too big values as UINT32_MAX.
+// scale must be < 256, so that mantissa * scale fits into 32 bits.
+uint32_t float_bits_to_fixed(uint32_t bits, uint8_t scale)
+{
+	int16_t exp = (bits >> 23) & 0xff;
+	uint32_t mant = bits & 0x7fffff;
+
+	if (bits & 0x80000000) // negative
+	{
+		return 0;
+	}
+
+	if (exp == 0xff) // infinity or NaN
+	{
+		return mant ? 0 : UINT32_MAX;
+	}
+
+	if (exp == 0) // denormalized number
+	{
+		exp = 1;
+	}
+	else
+	{
+		mant |= 0x800000; // add implicit leading 1
+	}
+
+	// value * scale = mant * scale * 2^(exp - 127 - 23)
+	uint32_t val = mant * scale;
+	exp -= 150;
+
+	if (exp >= 0)
+	{
+		if ((exp >= 32) || (val > (UINT32_MAX >> exp)))
+		{
+			return UINT32_MAX;
+		}
+
+		return val << exp;
+	}
+	else if (exp < -32)
+	{
+		return 0;
+	}
+	else
+	{
+		// shift right with rounding, avoiding overflow when adding 0.5
+		return ((val >> (-exp - 1)) + 1) >> 1;
+	}
+}
+
+// Return the rounded average of count accumulated values, limited to max.
+uint16_t average_round16(uint32_t sum, uint16_t count, uint16_t max)
+{
+	uint32_t avg = (sum + count / 2) / count;
+
+	return avg >= max ? max : (uint16_t)avg;
+}
+
+// Interpolate linearly between two neighbouring entries of an equidistant table.
+// pos is the position in the table in 8.8 fixed point, e.g. 0x0380 is the middle
+// between table[3] and table[4]. The result is rounded down, like the float to
+// integer cast of linear_interpolate_f. The table may be increasing or decreasing.
+uint16_t interpolate_table16(const uint16_t * table, uint16_t pos)
+{
+	uint8_t i = pos >> 8;
+	uint8_t frac = pos & 0xff;
+
+	if (frac == 0)
+	{
+		return table[i];
+	}
+
+	// the arithmetic right shift rounds negative steps down, too
+	return table[i] + (((int32_t)table[i + 1] - table[i]) * frac >> 8);
+}
+
+// Convert a translation table with the values 0..255 to positions in another table
+// with max_index + 1 entries (255 -> max_index), as 8.8 fixed point values rounded
+// to the nearest 1/256 for interpolate_table16.
+void translation_to_pos16(const uint8_t * translation, uint16_t * pos, uint8_t count, uint8_t max_index)
+{
+	uint8_t i;
+	uint16_t max = (uint16_t)max_index << 8;
+
+	for (i = 0; i < count; i++)
+	{
+		pos[i] = average_round16((uint32_t)translation[i] * max, 255, max);
+	}
+}
+
+// Start the incremental calculation of floor(val * pos / len) at pos = 0.
+// The only division is done here, each following dda16_step (pos + 1) only adds.
+void dda16_init(struct dda16_t * dda, uint16_t val, uint16_t len)
+{
+	dda->quot = 0;
+	dda->rem = 0;
+
+	if (len == 0)
+	{
+		dda->step_quot = dda->step_rem = 0;
+		return;
+	}
+
+	dda->step_quot = val / len;
+	dda->step_rem = val % len;
+}
+
+// Advance the calculation started by dda16_init by one position. len has to be
+// the same as for dda16_init and must not be greater than 32768.
+void dda16_step(struct dda16_t * dda, uint16_t len)
+{
+	dda->quot += dda->step_quot;
+	dda->rem += dda->step_rem;
+
+	if (dda->rem >= len)
+	{
+		dda->rem -= len;
+		dda->quot++;
+	}
+}
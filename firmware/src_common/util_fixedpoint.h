@@ -0,0 +1,51 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2024 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Utility functions are split up into util_*.{c|h} files.
+// The util.{c|h} files in the devices directories include all of them.
+// Only one lib is therefore built that contains all functions.
+
+#ifndef _UTIL_FIXEDPOINT_H
+#define _UTIL_FIXEDPOINT_H
+
+#include <inttypes.h>
+
+// ########## Fixed point conversion (avoid software floating point on the AVR)
+
+uint32_t float_bits_to_fixed(uint32_t bits, uint8_t scale);
+uint16_t average_round16(uint32_t sum, uint16_t count, uint16_t max);
+
+// ########## Table interpolation with 8.8 fixed point positions
+
+uint16_t interpolate_table16(const uint16_t * table, uint16_t pos);
+void translation_to_pos16(const uint8_t * translation, uint16_t * pos, uint8_t count, uint8_t max_index);
+
+// ########## Incremental calculation of val * pos / len (DDA)
+
+struct dda16_t
+{
+	uint16_t quot;      // floor(val * pos / len)
+	uint16_t rem;       // (val * pos) % len
+	uint16_t step_quot; // val / len
+	uint16_t step_rem;  // val % len
+};
+
+void dda16_init(struct dda16_t * dda, uint16_t val, uint16_t len);
+void dda16_step(struct dda16_t * dda, uint16_t len);
+
+#endif /* _UTIL_FIXEDPOINT_H */
@@ -143,33 +143,51 @@ http://www.zorc.breitbandkatze.de/crc.html
 Autor: K.Moraw, www.helitron.de, Oktober 2009
 */
 
-static uint32_t reg32; // shift register
-
-static uint32_t crc32_bytecalc(uint8_t byte)
+// The shift register is passed by the caller, so that crc32 is reentrant.
+static void crc32_bytecalc(uint32_t * reg32, uint8_t byte)
 {
 	uint8_t i;
 	uint32_t polynom = 0xEDB88320;		// Generatorpolynom
 
     for (i = 0; i < 8; ++i)
 	{
-        if ((reg32&1) != (byte&1))
-             reg32 = (reg32>>1)^polynom; 
+        if ((*reg32&1) != (byte&1))
+             *reg32 = (*reg32>>1)^polynom; 
         else 
-             reg32 >>= 1;
+             *reg32 >>= 1;
 		byte >>= 1;
 	}
-	return reg32 ^ 0xffffffff;	 		// inverses Ergebnis, MSB zuerst
 }
 
 uint32_t crc32(uint8_t *data, uint8_t len)
 {
 	uint8_t i;
-	reg32 = 0xffffffff;
+	uint32_t reg32 = 0xffffffff; // shift register
 
 	for (i = 0; i < len; i++)
 	{
-		crc32_bytecalc(data[i]);		// Berechne fuer jeweils 8 Bit der Nachricht
+		crc32_bytecalc(&reg32, data[i]);		// Berechne fuer jeweils 8 Bit der Nachricht
 	}
 	
-	return reg32 ^ 0xffffffff;
+	return reg32 ^ 0xffffffff;	 		// inverses Ergebnis, MSB zuerst
+}
+
+// CRC8 with polynomial 0x31 and initial value 0xff (as used by Sensirion sensors).
+// Neither a cleared (0x00) nor an erased (0xff) EEPROM area has a matching CRC.
+uint8_t crc8(uint8_t *data, uint8_t len)
+{
+	uint8_t i, j;
+	uint8_t crc = 0xff;
+
+	for (i = 0; i < len; i++)
+	{
+		crc ^= data[i];
+
+		for (j = 0; j < 8; j++)
+		{
+			crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : crc << 1;
+		}
+	}
+
+	return crc;
 }
@@ -78,4 +78,8 @@ void setBuf16(uint8_t offset, uint16_t val);
 
 uint32_t crc32(uint8_t *data, uint8_t len);
 
+// ########## CRC8
+
+uint8_t crc8(uint8_t *data, uint8_t len);
+
 #endif /* _UTIL_GENERIC_H */
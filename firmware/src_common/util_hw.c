@@ -22,15 +22,11 @@
 * with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <avr/io.h>
-#include <avr/interrupt.h>
 #include <stdlib.h>
-#include <avr/sleep.h>
 #include <string.h>
 #include <stdio.h>
 #define __DELAY_BACKWARD_COMPATIBLE__
-#include <util/delay.h>
-#include <avr/eeprom.h>
+#include "hal.h"
 
 #include "util_generic.h"
 #include "util_hw.h"
@@ -44,10 +40,9 @@
 #include "aes256.h"
 
 #define LED_PIN_DEFAULT  7
-#define LED_PORT_DEFAULT PORTD
-#define LED_DDR_DEFAULT  DDRD
+#define LED_PORT_DEFAULT D
 
-static volatile uint8_t* led_port;
+static hal_port_t led_port;
 static uint8_t led_pin;
 
 // Value has to be volatile, because otherwise the adc_measure function would not
@@ -100,6 +95,24 @@ uint16_t bat_percentage(uint16_t vbat, uint16_t vempty)
 	}
 }
 
+#ifdef SHC_HOST
+
+// The ADC is simulated by the HAL, see hal_adc_read.
+void adc_init(void)
+{
+}
+
+void adc_on(bool on)
+{
+}
+
+uint16_t read_adc(uint8_t adc_input)
+{
+	return hal_adc_read(adc_input);
+}
+
+#else
+
 // Initialize ADV (called once after initial power on).
 void adc_init(void)
 {
@@ -216,6 +229,8 @@ uint16_t read_adc(uint8_t adc_input)
 	return adc_data;
 }
 
+#endif // SHC_HOST
+
 // Calculate current battery voltage by using it as reference voltage and measuring
 // the internal 1.1V reference voltage.
 uint16_t read_battery(void)
@@ -224,41 +239,34 @@ uint16_t read_battery(void)
 	return (uint16_t)((uint32_t)1100 * 1024 / read_adc(14));
 }
 
-void util_init_led(volatile uint8_t* ddr, volatile uint8_t* port, uint8_t pin)
+void util_init_led(hal_port_t port, uint8_t pin)
 {
 	led_port = port;
 	led_pin = pin;
 
-	sbi(*ddr, pin);
+	hal_gpio_output(port, pin);
 }
 
 void util_init(void)
 {
-	util_init_led(&LED_DDR_DEFAULT, &LED_PORT_DEFAULT, LED_PIN_DEFAULT);
+	util_init_led(HAL_PORT(LED_PORT_DEFAULT), LED_PIN_DEFAULT);
 }
 
 void led_dbg(uint8_t ms)
 {
-	sbi(*led_port, led_pin);
-	_delay_ms(ms);
-	cbi(*led_port, led_pin);
+	hal_gpio_write(led_port, led_pin, true);
+	hal_delay_ms(ms);
+	hal_gpio_write(led_port, led_pin, false);
 }
 
 void switch_led(bool b_on)
 {
-	if (b_on)
-	{
-		sbi(*led_port, led_pin);
-	}
-	else
-	{
-		cbi(*led_port, led_pin);
-	}
+	hal_gpio_write(led_port, led_pin, b_on);
 }
 
 bool get_led_on(void)
 {
-	return (*led_port & (1 << led_pin)) ? true : false;
+	return hal_gpio_output_state(led_port, led_pin);
 }
 
 void led_blink(uint16_t on, uint16_t off, uint8_t times)
@@ -267,10 +275,10 @@ void led_blink(uint16_t on, uint16_t off, uint8_t times)
 
 	for (i = 0; i < times; i++)
 	{
-		sbi(*led_port, led_pin);
-		_delay_ms(on);
-		cbi(*led_port, led_pin);
-		_delay_ms(off);
+		hal_gpio_write(led_port, led_pin, true);
+		hal_delay_ms(on);
+		hal_gpio_write(led_port, led_pin, false);
+		hal_delay_ms(off);
 	}
 }
 
@@ -326,15 +334,78 @@ void osccal_init(void)
 
 			for (i = 0; i < 12; i++)
 			{
-				_delay_ms(4990); // _delay_ms can handle only about ~6s
+				hal_delay_ms(4990); // _delay_ms can handle only about ~6s
 			}
 		}
 	}
+#ifndef SHC_HOST // the host clock needs no calibration
 	else if (mode != 0)
 	{
 		float speedup = (float)mode / 1000;
 		OSCCAL = (uint16_t)((float)OSCCAL * (1 + speedup));
 	}
+#endif
+}
+
+uint8_t packetcounter_slot = 0; // slot of the packet counter ring that is written next
+uint8_t packetcounter_seq = 0; // sequence number of the next write
+
+// Write the packet counter to the next slot of the ring (in the background, if supported).
+static void save_packetcounter(void)
+{
+	uint8_t slot[PACKET_COUNTER_SLOT_BYTES];
+
+	slot[0] = packetcounter;
+	slot[1] = packetcounter >> 8;
+	slot[2] = packetcounter >> 16;
+	slot[3] = packetcounter_seq++;
+	slot[4] = crc8(slot, 4);
+
+	e2p_write_block_async(slot, PACKET_COUNTER_RING_ADDR + packetcounter_slot * PACKET_COUNTER_SLOT_BYTES, PACKET_COUNTER_SLOT_BYTES);
+
+	packetcounter_slot = (packetcounter_slot + 1) % PACKET_COUNTER_RING_SLOTS;
+}
+
+// Read the packet counter from the valid slot of the ring with the newest sequence number,
+// increase it by one write cycle and write it back. The values in between may have been
+// used before the last reset. The PacketCounter field is used if it is higher (or if no
+// slot is valid yet).
+void init_packetcounter(void)
+{
+	uint8_t ring[PACKET_COUNTER_RING_BYTES];
+	uint8_t * newest = 0;
+	uint8_t i;
+
+	packetcounter = e2p_generic_get_packetcounter();
+	e2p_generic_get_packetcounterring(ring);
+
+	for (i = 0; i < PACKET_COUNTER_RING_SLOTS; i++)
+	{
+		uint8_t * slot = ring + i * PACKET_COUNTER_SLOT_BYTES;
+
+		// compare the sequence numbers with wrap around
+		if ((slot[4] == crc8(slot, 4)) && (!newest || ((int8_t)(slot[3] - newest[3]) > 0)))
+		{
+			newest = slot;
+			packetcounter_slot = (i + 1) % PACKET_COUNTER_RING_SLOTS;
+		}
+	}
+
+	if (newest)
+	{
+		uint32_t val = newest[0] | ((uint32_t)newest[1] << 8) | ((uint32_t)newest[2] << 16);
+
+		if (val > packetcounter)
+		{
+			packetcounter = val;
+		}
+
+		packetcounter_seq = newest[3] + 1;
+	}
+
+	packetcounter += PACKET_COUNTER_WRITE_CYCLE;
+	save_packetcounter();
+	e2p_wait_async();
 }
 
 void inc_packetcounter(void)
@@ -343,57 +414,53 @@ void inc_packetcounter(void)
 
 	if (packetcounter % PACKET_COUNTER_WRITE_CYCLE == 0)
 	{
-		e2p_generic_set_packetcounter(packetcounter);
+		save_packetcounter();
 	}
 }
 
 // Truncate trailing 0-bytes, round up to packet length of multiple of 16 bytes,
-// set CRC, encode and send packet with RFM12.
-void rfm12_send_bufx(void)
+// set CRC, encode and send the packet in the given buffer with RFM12.
+// Return the packet size used for the CRC.
+uint8_t rfm12_send_buf(uint8_t * buf, uint8_t packet_size_bytes)
 {
-	while ((__PACKETSIZEBYTES > 0) && (bufx[__PACKETSIZEBYTES - 1] == 0))
+	while ((packet_size_bytes > 0) && (buf[packet_size_bytes - 1] == 0))
 	{
-		__PACKETSIZEBYTES--;
+		packet_size_bytes--;
 	}
 
-	__PACKETSIZEBYTES = ((__PACKETSIZEBYTES - 1) / 16 + 1) * 16;
+	packet_size_bytes = ((packet_size_bytes - 1) / 16 + 1) * 16;
 
-	uint32_t crc = crc32(bufx + 4, __PACKETSIZEBYTES - 4);
-	array_write_UIntValue(0, 32, crc, bufx);
+	uint32_t crc = crc32(buf + 4, packet_size_bytes - 4);
+	array_write_UIntValue(0, 32, crc, buf);
 
 	UART_PUTS("Before encryption: ");
-	print_bytearray(bufx, __PACKETSIZEBYTES);
+	print_bytearray(buf, packet_size_bytes);
 
-	uint8_t packet_len = aes256_encrypt_cbc(bufx, __PACKETSIZEBYTES);
+	uint8_t packet_len = aes256_encrypt_cbc(buf, packet_size_bytes);
 
 	// Write to tx buffer and call rfm12_tick to send immediately.
-	rfm12_tx(packet_len, 0, (uint8_t *) bufx);
+	rfm12_tx(packet_len, 0, buf);
 	rfm12_tick();
 	//led_dbg(2);
 
 	// Print to UART after sending to not cause additional delay.
 	UART_PUTS("After encryption:  ");
-	print_bytearray(bufx, packet_len);
+	print_bytearray(buf, packet_len);
+
+	return packet_size_bytes;
+}
+
+void rfm12_send_bufx(void)
+{
+	__PACKETSIZEBYTES = rfm12_send_buf(bufx, __PACKETSIZEBYTES);
 }
 
 // Go to sleep. Wakeup by RFM12 wakeup-interrupt or pin change (if configured).
 // Disable BOD according recommended procedure in sleep.h if selected.
 void power_down(bool bod_disable)
 {
-	set_sleep_mode(SLEEP_MODE_PWR_DOWN);
-	cli();
-	sleep_enable();
+	// the EEPROM ready interrupt can't wake up the MCU from power down mode
+	e2p_wait_async();
 
-// ATMega329 (thermostat) does not support BOD disable.
-#if ! defined (__AVR_ATmega329__)
-	if (bod_disable)
-	{
-		sleep_bod_disable();
-	}
-#endif
-
-	sei();
-	sleep_cpu();
-	sleep_disable();
-	sei();
+	hal_power_down(bod_disable);
 }
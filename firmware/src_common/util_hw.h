@@ -26,17 +26,30 @@
 #include <inttypes.h>
 #include <stdio.h>
 #include <stdbool.h>
-#include <avr/pgmspace.h>
+#include "hal.h"
 #include "e2p_hardware.h"
 
 #define sbi(ADDRESS,BIT) ((ADDRESS) |= (1<<(BIT)))
 #define cbi(ADDRESS,BIT) ((ADDRESS) &= ~(1<<(BIT)))
 
 // How often should the packetcounter_base be increased and written to EEPROM?
-// This should be 2^32 (which is the maximum transmitted packet counter) /
-// 100.000 (which is the maximum amount of possible EEPROM write cycles) or more.
-// Therefore 100 is a good value.
-#define PACKET_COUNTER_WRITE_CYCLE 100
+// Every slot of the packet counter ring should be written at most every
+// 2^24 (which is the maximum stored packet counter) / 100.000 (which is the
+// maximum amount of possible EEPROM write cycles) = ~170 packets. Because the
+// ring distributes the writes over 3 slots, a slot is written every
+// 3 * PACKET_COUNTER_WRITE_CYCLE packets, so the value has to be 57 or more.
+// With 60, each slot is written 2^24 / 180 = ~93.000 times. This is also
+// the number of packet counter values which are skipped at every startup.
+#define PACKET_COUNTER_WRITE_CYCLE 60
+
+// Ring of slots in the generic e2p block the packet counter is written to alternately.
+// Each slot contains the 24 bit counter (LSB first), a sequence number which is increased
+// with every write and a CRC8 over both, so that an interrupted write is detected.
+// The valid slot with the newest sequence number holds the current value.
+#define PACKET_COUNTER_RING_ADDR (128 / 8) // see PacketCounterRing in e2p_generic.h
+#define PACKET_COUNTER_RING_BYTES 16
+#define PACKET_COUNTER_RING_SLOTS 3
+#define PACKET_COUNTER_SLOT_BYTES 5
 
 uint32_t packetcounter;
 
@@ -48,7 +61,7 @@ uint16_t read_adc(uint8_t adc_input);
 uint16_t read_battery(void);
 
 void util_init(void);
-void util_init_led(volatile uint8_t* ddr, volatile uint8_t* port, uint8_t pin);
+void util_init_led(hal_port_t port, uint8_t pin);
 void led_dbg(uint8_t ms);
 void switch_led(bool b_on);
 bool get_led_on(void);
@@ -56,7 +69,9 @@ void led_blink(uint16_t on, uint16_t off, uint8_t times);
 void check_eeprom_compatibility(DeviceTypeEnum deviceType);
 void osccal_info(void);
 void osccal_init(void);
+void init_packetcounter(void);
 void inc_packetcounter(void);
+uint8_t rfm12_send_buf(uint8_t * buf, uint8_t packet_size_bytes);
 void rfm12_send_bufx(void);
 void power_down(bool bod_disable);
 
@@ -16,9 +16,15 @@
 * with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <string.h>
+
 #include "util_rfm12.h"
 #include "util_hw.h"
 #include "util_watchdog.h"
+#include "uart.h"
+#include "aes256.h"
+#include "msggrp_generic.h"
+#include "msggrp_gpio.h"
 #include "../rfm12/rfm12.h"
 
 // Make 20ms delay, call rfm12 tick (4 times, in 5ms cycle) and remember watchdog time.
@@ -28,7 +34,7 @@ void rfm12_delay20(void)
 
 	for (i = 0; i < 4; i++)
 	{
-		_delay_ms(5);
+		hal_delay_ms(5);
 		rfm12_tick();
 	}
 
@@ -39,9 +45,9 @@ void rfm12_delay10_led(void)
 {
 	switch_led(true);
 	rfm12_tick();
-	_delay_ms(5);
+	hal_delay_ms(5);
 	rfm12_tick();
-	_delay_ms(5);
+	hal_delay_ms(5);
 	switch_led(false);
 	rfm_watchdog_count(10);
 }
@@ -62,7 +68,7 @@ uint16_t rfm12_send_wait_led(void)
 	for (i = 1; i <= 60; i++)
 	{
 		rfm12_tick();
-		_delay_ms(5);
+		hal_delay_ms(5);
 
 		// remember when tx packet was sent
 		if ((j == 0) && (rfm12_tx_status() == STATUS_FREE))
@@ -82,3 +88,158 @@ uint16_t rfm12_send_wait_led(void)
 	rfm_watchdog_count(i * 5);
 	return (uint16_t)j * 5;
 }
+
+#if !(RFM12_TRANSMIT_ONLY)
+// Wait until the last packet is sent out and keep the receiver on for the given time
+// afterwards, so that the base station can send queued requests to a device which is
+// sleeping otherwise. Return the length of the received packet as soon as one is complete,
+// 0 if nothing was received within the time.
+uint8_t rfm12_listen_window(uint16_t ms)
+{
+	uint16_t i;
+	uint8_t len = 0;
+
+	// wait max. 300ms for sending out the data
+	for (i = 0; (i < 60) && (rfm12_tx_status() != STATUS_FREE); i++)
+	{
+		rfm12_tick();
+		hal_delay_ms(5);
+	}
+
+	rfm_watchdog_count(i * 5);
+
+	for (i = 0; i < ms / 5; i++)
+	{
+		if (rfm12_rx_status() == STATUS_COMPLETE)
+		{
+			len = rfm12_rx_len();
+			break;
+		}
+
+		rfm12_tick();
+		hal_delay_ms(5);
+	}
+
+	rfm_watchdog_count(i * 5);
+	return len;
+}
+
+#endif
+
+// Request handling of battery powered devices, which switch off the receiver while sleeping.
+#if !(RFM12_TRANSMIT_ONLY) && RFM12_USE_WAKEUP_TIMER
+// Answer a request from the base station. Only "Get" for the DeviceInfo is supported,
+// which is answered with an AckStatus. Other requests are answered with an error Ack.
+static void listen_process_request(uint16_t device_id, void (*prepare_deviceinfo)(bool ackstatus))
+{
+	// remember some values before the packet buffer is destroyed
+	uint32_t acksenderid = pkg_header_get_senderid();
+	uint32_t ackpacketcounter = pkg_header_get_packetcounter();
+	MessageTypeEnum messagetype = pkg_header_get_messagetype();
+	uint32_t messagegroupid = pkg_headerext_common_get_messagegroupid();
+	uint32_t messageid = pkg_headerext_common_get_messageid();
+	bool error = false;
+
+	UART_PUTF3("Request: MessageType %u, MessageGroupID %lu, MessageID %lu\r\n", messagetype, messagegroupid, messageid);
+
+	if ((messagetype == MESSAGETYPE_GET)
+		&& (messagegroupid == MESSAGEGROUP_GENERIC)
+		&& (messageid == MESSAGEID_GENERIC_DEVICEINFO))
+	{
+		prepare_deviceinfo(true);
+	}
+	else
+	{
+		UART_PUTS("ERR: Unsupported request.\r\n");
+		error = true;
+
+		// any message can be used as ack, because they are the same anyway
+		pkg_header_init_gpio_digitalport_ack();
+	}
+
+	inc_packetcounter();
+
+	pkg_header_set_senderid(device_id);
+	pkg_header_set_packetcounter(packetcounter);
+	pkg_headerext_common_set_acksenderid(acksenderid);
+	pkg_headerext_common_set_ackpacketcounter(ackpacketcounter);
+	pkg_headerext_common_set_error(error);
+
+	rfm12_send_bufx();
+}
+
+// Decrypt a received packet and process it if it is a request for this device.
+static void listen_process_packet(uint8_t len, uint16_t device_id, void (*prepare_deviceinfo)(bool ackstatus),
+	uint32_t * station_packetcounter)
+{
+	if ((len == 0) || (len % 16 != 0))
+	{
+		UART_PUTF("Received garbage (%u bytes not multiple of 16).\r\n", len);
+		return;
+	}
+
+	aes256_decrypt_cbc(bufx, len);
+
+	if (!pkg_header_check_crc32(len))
+	{
+		UART_PUTS("Received garbage (CRC wrong after decryption).\r\n");
+		return;
+	}
+
+	pkg_header_adjust_offset();
+
+	MessageTypeEnum messagetype = pkg_header_get_messagetype();
+
+	if ((pkg_header_get_senderid() != 0)
+		|| ((messagetype != MESSAGETYPE_GET) && (messagetype != MESSAGETYPE_SET) && (messagetype != MESSAGETYPE_SETGET))
+		|| (pkg_headerext_common_get_receiverid() != device_id))
+	{
+		return; // not a request from the base station to this device
+	}
+
+	if (station_packetcounter)
+	{
+		*station_packetcounter = pkg_header_get_packetcounter();
+	}
+
+	listen_process_request(device_id, prepare_deviceinfo);
+}
+
+// Keep the receiver on for window_ms after sending, process requests that are received
+// in this time and switch the receiver off again before going to sleep.
+// Every answer sent restarts the window, so the base station can send further queued requests.
+// prepare_deviceinfo has to prepare the DeviceInfo message in bufx (as AckStatus if the
+// parameter is true). The packet counter of a received request is stored in
+// station_packetcounter, if it is not 0. A window_ms of 0 switches the receiver off only.
+void rfm12_listen_after_send(uint16_t device_id, uint16_t window_ms, void (*prepare_deviceinfo)(bool ackstatus),
+	uint32_t * station_packetcounter)
+{
+	uint8_t i;
+
+	for (i = 0; (i < LISTEN_MAX_PACKETS) && (window_ms > 0); i++)
+	{
+		uint8_t len = rfm12_listen_window(window_ms);
+
+		if (len == 0)
+		{
+			break;
+		}
+
+		if (len <= sizeof(bufx))
+		{
+			memcpy(bufx, rfm12_rx_buffer(), len);
+		}
+		else
+		{
+			len = 0;
+		}
+
+		// tell the implementation that the buffer can be reused for the next data.
+		rfm12_rx_clear();
+
+		listen_process_packet(len, device_id, prepare_deviceinfo, station_packetcounter);
+	}
+
+	rfm12_rx_off();
+}
+#endif
@@ -19,8 +19,19 @@
 #ifndef _UTIL_RFM12_H
 #define _UTIL_RFM12_H
 
+#include <inttypes.h>
+#include <stdbool.h>
+
 void rfm12_delay20(void);
 uint16_t rfm12_send_wait_led(void);
 void rfm12_delay10_led(void);
+uint8_t rfm12_listen_window(uint16_t ms);
+
+#define LISTEN_MAX_PACKETS 4 // max. number of requests processed by rfm12_listen_after_send
+#define LISTEN_WINDOW_MS_MAX 1000 // max. value of the e2p setting ListenWindowMs
+#define LISTEN_WINDOW_MS_DEFAULT 250 // used if the e2p setting is out of range (not initialized)
+
+void rfm12_listen_after_send(uint16_t device_id, uint16_t window_ms, void (*prepare_deviceinfo)(bool ackstatus),
+	uint32_t * station_packetcounter);
 
 #endif
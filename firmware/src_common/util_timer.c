@@ -0,0 +1,132 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2024 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "util_timer.h"
+
+void timer_wheel_init(struct timer_wheel_t * wheel)
+{
+	uint8_t i;
+
+	for (i = 0; i < TIMER_WHEEL_SLOTS; i++)
+	{
+		wheel->slot[i] = 0;
+	}
+
+	wheel->now = 0;
+}
+
+// Advance the wheel by one tick and call the callbacks of the timers expiring now.
+// The expired timers are removed from the wheel before the first callback is called,
+// so the callbacks may start and stop any timer.
+void timer_wheel_tick(struct timer_wheel_t * wheel)
+{
+	struct sw_timer_t * t;
+	struct sw_timer_t * expired = 0;
+	struct sw_timer_t ** expired_tail = &expired;
+
+	wheel->now++;
+	t = wheel->slot[wheel->now & (TIMER_WHEEL_SLOTS - 1)];
+
+	while (t != 0)
+	{
+		struct sw_timer_t * next = t->next;
+
+		if (t->expires == wheel->now)
+		{
+			sw_timer_stop(t);
+			t->next = 0;
+			*expired_tail = t;
+			expired_tail = &t->next;
+		}
+
+		t = next;
+	}
+
+	while (expired != 0)
+	{
+		t = expired;
+		expired = t->next;
+		t->callback(t->arg);
+	}
+}
+
+// Set the function to call (with the given argument) when the timer expires.
+// The timer is stopped.
+void sw_timer_init(struct sw_timer_t * timer, void (*callback)(uint8_t arg), uint8_t arg)
+{
+	timer->next = 0;
+	timer->pprev = 0;
+	timer->expires = 0;
+	timer->callback = callback;
+	timer->arg = arg;
+}
+
+// (Re)start the timer to expire after the given number of ticks (1..65535).
+// A running timer is restarted, 0 ticks only stop it.
+void sw_timer_start(struct timer_wheel_t * wheel, struct sw_timer_t * timer, uint16_t ticks)
+{
+	struct sw_timer_t ** head;
+
+	sw_timer_stop(timer);
+
+	if (ticks == 0)
+	{
+		return;
+	}
+
+	timer->expires = wheel->now + ticks;
+	head = &wheel->slot[timer->expires & (TIMER_WHEEL_SLOTS - 1)];
+
+	timer->next = *head;
+	timer->pprev = head;
+
+	if (*head != 0)
+	{
+		(*head)->pprev = &timer->next;
+	}
+
+	*head = timer;
+}
+
+void sw_timer_stop(struct sw_timer_t * timer)
+{
+	if (timer->pprev == 0)
+	{
+		return;
+	}
+
+	*timer->pprev = timer->next;
+
+	if (timer->next != 0)
+	{
+		timer->next->pprev = timer->pprev;
+	}
+
+	timer->pprev = 0;
+}
+
+// Return the number of ticks until the timer expires, 0 if it is stopped.
+uint16_t sw_timer_remaining(struct timer_wheel_t * wheel, struct sw_timer_t * timer)
+{
+	if (timer->pprev == 0)
+	{
+		return 0;
+	}
+
+	return timer->expires - wheel->now;
+}
@@ -0,0 +1,75 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2024 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Utility functions are split up into util_*.{c|h} files.
+// The util.{c|h} files in the devices directories include all of them.
+// Only one lib is therefore built that contains all functions.
+
+#ifndef _UTIL_TIMER_H
+#define _UTIL_TIMER_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+// ########## Software timers (hashed timer wheel)
+//
+// A timer wheel counts ticks, which are given by the caller of timer_wheel_tick.
+// Use one wheel per resolution, e.g. one ticked every second (see the power switch)
+// or one ticked every main loop cycle for timeouts in milliseconds (see TIMER_MS).
+// Timers are kept in TIMER_WHEEL_SLOTS lists by their expiry tick, so starting and
+// stopping a timer doesn't depend on the number of timers. A tick only checks the
+// timers in one slot, which are the expiring ones plus the ones expiring one or more
+// wheel revolutions later.
+// The callback of an expired timer is called within timer_wheel_tick (not from an
+// interrupt), so it can do everything the main loop does.
+
+#ifndef TIMER_WHEEL_SLOTS
+#define TIMER_WHEEL_SLOTS 8 // has to be a power of 2
+#endif
+
+// Convert milliseconds to ticks of a wheel ticked every tick_ms milliseconds (rounded up).
+#define TIMER_MS(ms, tick_ms) (((ms) + (tick_ms) - 1) / (tick_ms))
+
+struct sw_timer_t
+{
+	struct sw_timer_t * next;
+	struct sw_timer_t ** pprev; // pointer to the pointer to this timer, 0 if the timer is stopped
+	uint16_t expires;           // tick at which the timer expires
+	void (*callback)(uint8_t arg);
+	uint8_t arg;
+};
+
+struct timer_wheel_t
+{
+	struct sw_timer_t * slot[TIMER_WHEEL_SLOTS];
+	uint16_t now; // current tick
+};
+
+void timer_wheel_init(struct timer_wheel_t * wheel);
+void timer_wheel_tick(struct timer_wheel_t * wheel);
+void sw_timer_init(struct sw_timer_t * timer, void (*callback)(uint8_t arg), uint8_t arg);
+void sw_timer_start(struct timer_wheel_t * wheel, struct sw_timer_t * timer, uint16_t ticks);
+void sw_timer_stop(struct sw_timer_t * timer);
+uint16_t sw_timer_remaining(struct timer_wheel_t * wheel, struct sw_timer_t * timer);
+
+static inline bool sw_timer_running(struct sw_timer_t * timer)
+{
+	return timer->pprev != 0;
+}
+
+#endif /* _UTIL_TIMER_H */
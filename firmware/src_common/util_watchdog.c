@@ -17,7 +17,7 @@
 */
 
 #include "util_watchdog.h"
-#include <avr/wdt.h>
+#include "hal.h"
 
 #include "../src_common/msggrp_generic.h"
 
@@ -35,39 +35,32 @@ uint8_t _nres_reset_state = 0;
 
 bool _rfm_retry_done = false;
 
-// Setup IO pin connected to RFM NRES pin from floating to high (== no reset).
-void _setup_nres(uint8_t port_nr, uint8_t pin, uint8_t nres_reset_state)
+// Return the port with the given number (0 = B, 1 = C, 2 = D).
+static hal_port_t _nres_port(uint8_t port_nr)
 {
 	switch (port_nr)
 	{
 		case 0:
-			if (nres_reset_state)
-				cbi(PORTB, pin);
-			else
-				sbi(PORTB, pin);
-				
-			sbi(DDRB, pin);
-			break;
+			return HAL_PORT(B);
 		case 1:
-			if (nres_reset_state)
-				cbi(PORTC, pin);
-			else
-				sbi(PORTC, pin);
-
-			sbi(DDRC, pin);
-			break;
-		case 2:
-			if (nres_reset_state)
-				cbi(PORTD, pin);
-			else
-				sbi(PORTD, pin);
-
-			sbi(PORTD, pin);
-			sbi(DDRD, pin);
-			break;
+			return HAL_PORT(C);
+		default:
+			return HAL_PORT(D);
 	}
-	
-	_delay_ms(200);
+}
+
+// Setup IO pin connected to RFM NRES pin from floating to high (== no reset).
+void _setup_nres(uint8_t port_nr, uint8_t pin, uint8_t nres_reset_state)
+{
+	if (port_nr <= 2)
+	{
+		hal_port_t port = _nres_port(port_nr);
+
+		hal_gpio_write(port, pin, !nres_reset_state);
+		hal_gpio_output(port, pin);
+	}
+
+	hal_delay_ms(200);
 }
 
 void rfm_watchdog_init(uint16_t deviceid, uint16_t timeout_10sec, uint8_t nres_port_nr, uint8_t nres_pin, uint8_t nres_reset_state)
@@ -87,37 +80,19 @@ void rfm_watchdog_alive(void)
 	_rfm_retry_done = false;
 }
 
-void _rfm12_pull_nres(volatile uint8_t *port, uint8_t pin, uint8_t nres_reset_state)
+void _rfm12_pull_nres(hal_port_t port, uint8_t pin, uint8_t nres_reset_state)
 {
-	if (nres_reset_state)
-	{
-		*port |= (1 << pin);
-		_delay_ms(500);
-		*port &= ~(1 << pin);
-		_delay_ms(500);
-	}
-	else
-	{
-		*port &= ~(1 << pin);
-		_delay_ms(500);
-		*port |= (1 << pin);
-		_delay_ms(500);
-	}
+	hal_gpio_write(port, pin, nres_reset_state);
+	hal_delay_ms(500);
+	hal_gpio_write(port, pin, !nres_reset_state);
+	hal_delay_ms(500);
 }
 
 void _rfm12_hw_reset(void)
 {
-	switch (_nres_port_nr)
+	if (_nres_port_nr <= 2)
 	{
-		case 0:
-			_rfm12_pull_nres(&PORTB, _nres_pin, _nres_reset_state);
-			break;
-		case 1:
-			_rfm12_pull_nres(&PORTC, _nres_pin, _nres_reset_state);
-			break;
-		case 2:
-			_rfm12_pull_nres(&PORTD, _nres_pin, _nres_reset_state);
-			break;
+		_rfm12_pull_nres(_nres_port(_nres_port_nr), _nres_pin, _nres_reset_state);
 	}
 }
 
@@ -125,10 +100,7 @@ void _rfm12_hw_reset(void)
 // by purpose.
 void _atmega_watchdog_reset(void)
 {
-    wdt_enable(WDTO_15MS);
-
-	while (1)
-	{ }
+	hal_reset();
 }
 
 void _rfm12_recover(void)
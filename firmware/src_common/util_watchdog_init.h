@@ -20,6 +20,21 @@
 // wdt_init is automatically called at startup, saving the MCUSR value.
 // wdt_init must not be called in the main c file!
 
+#ifdef SHC_HOST
+
+#include "hal.h"
+
+uint8_t mcusr_mirror;
+
+void wdt_init(void) __attribute__((constructor));
+
+void wdt_init(void)
+{
+	mcusr_mirror = hal_reset_reason();
+}
+
+#else
+
 #include <avr/wdt.h>
 
 uint8_t mcusr_mirror __attribute__ ((section (".noinit")));
@@ -35,3 +50,5 @@ void wdt_init(void)
 	wdt_disable();
 	return;
 }
+
+#endif // SHC_HOST
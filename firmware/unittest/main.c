@@ -22,17 +22,87 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <pthread.h>
 
 #include "util.h"
 
 #include "../src_common/e2p_access.h"
 #include "../src_common/msggrp_weather.h"
 #include "../src_common/msggrp_gpio.h"
+#include "../src_common/msggrp_dimmer.h"
+#include "../src_common/msggrp_display.h"
+#include "../src_common/packet_dispatch.h"
+#include "../src_common/util_fixedpoint.h"
+#include "../src_common/util_timer.h"
+#include "../src_common/rgb_led.h"
 
 uint8_t res = 0;
 
+extern struct rgb_color_t current_col;
+extern uint16_t current_tone_PWM;
+extern uint8_t OCR0A, OCR0B, OCR2B;
+
 uint8_t testarray[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 255, 254, 253, 252, 251, 250, 249, 248 };
 
+// Recorded SPS30 "read measured values" frames (float format, 10 values with
+// 2 * (2 data bytes + CRC) each). The envsensor takes 4 of them per measurement.
+uint8_t sps30_frames[][60] = {
+	// frame set 1
+	{ 0x40, 0x41, 0x04, 0x33, 0x83, 0x37, 0x40, 0xa7, 0x63, 0x22, 0xcf, 0xed, 0x40, 0xbd, 0xfb, 0x80, 0xce, 0xfa, 0x40, 0xce, 0x50, 0xed, 0xa4, 0x8f, 0x41, 0xac, 0x7d, 0x8a, 0xd2, 0x2a, 0x41, 0xbd, 0x0f, 0xc7, 0xb4, 0xfe, 0x41, 0xbf, 0x6d, 0x06, 0x40, 0xe6, 0x41, 0xd0, 0xf8, 0x67, 0x44, 0x83, 0x41, 0xc5, 0x4e, 0x87, 0x82, 0x14, 0x3f, 0x01, 0x9b, 0x95, 0x5b, 0x2f },
+	{ 0x40, 0x50, 0x76, 0x3b, 0xcd, 0x22, 0x40, 0xa5, 0x01, 0xe7, 0xba, 0x3d, 0x40, 0xc6, 0xe9, 0x75, 0xc6, 0x2c, 0x40, 0xcc, 0x32, 0x50, 0xd3, 0x31, 0x41, 0xac, 0x7d, 0xc5, 0x0c, 0x21, 0x41, 0xbf, 0x6d, 0x77, 0xde, 0x0f, 0x41, 0xcb, 0x51, 0x82, 0x0c, 0x06, 0x41, 0xd1, 0xc9, 0x05, 0x11, 0x84, 0x41, 0xca, 0x60, 0xde, 0x83, 0x01, 0x3f, 0x08, 0x13, 0x54, 0xe0, 0x24 },
+	{ 0x40, 0x49, 0xbd, 0xcd, 0x01, 0x5a, 0x40, 0x9f, 0x1f, 0x25, 0x3e, 0xf0, 0x40, 0xc4, 0x8b, 0xf5, 0x41, 0xe2, 0x40, 0xce, 0x50, 0xaa, 0x6d, 0x67, 0x41, 0xa7, 0x97, 0x03, 0x7b, 0xbe, 0x41, 0xbd, 0x0f, 0x18, 0x64, 0xa7, 0x41, 0xd0, 0xf8, 0x23, 0xc9, 0xbf, 0x41, 0xc9, 0x33, 0x0c, 0xf6, 0x11, 0x41, 0xce, 0xa4, 0xd4, 0x39, 0x8b, 0x3f, 0x0a, 0x71, 0x29, 0xaa, 0xb9 },
+	{ 0x40, 0x4a, 0xee, 0xa5, 0xf9, 0x03, 0x40, 0xad, 0xb8, 0x68, 0x37, 0xb1, 0x40, 0xbd, 0xfb, 0xfb, 0xb9, 0xb4, 0x40, 0xd2, 0x6e, 0xf6, 0x6e, 0x67, 0x41, 0xa9, 0x88, 0x74, 0xd3, 0x6e, 0x41, 0xcf, 0x95, 0x0a, 0xc3, 0x7b, 0x41, 0xd0, 0xf8, 0x68, 0x5b, 0x77, 0x41, 0xc1, 0x8a, 0x7c, 0x14, 0x89, 0x41, 0xc3, 0xe8, 0x08, 0x32, 0x11, 0x3f, 0x01, 0x9b, 0x5a, 0x3f, 0x63 },
+	// frame set 2
+	{ 0x41, 0x54, 0x46, 0xa8, 0x97, 0xe7, 0x41, 0x96, 0x63, 0x3c, 0x1a, 0x1f, 0x41, 0xb5, 0xb6, 0x78, 0x34, 0x8c, 0x41, 0xbc, 0x3e, 0x2e, 0x01, 0x01, 0x42, 0xa8, 0x94, 0x85, 0xa0, 0x29, 0x42, 0xc5, 0x63, 0x1f, 0xca, 0xea, 0x42, 0xc7, 0x01, 0x94, 0x57, 0xa6, 0x42, 0xcc, 0xeb, 0xed, 0xc0, 0xf0, 0x42, 0xcd, 0xda, 0x1d, 0x1a, 0x37, 0x3f, 0x22, 0x4e, 0x78, 0xd6, 0x2f },
+	{ 0x41, 0x4e, 0xde, 0xe5, 0xdb, 0x6e, 0x41, 0x9d, 0x89, 0xaf, 0x87, 0x0a, 0x41, 0xb9, 0xcb, 0x96, 0x32, 0x31, 0x41, 0xc9, 0x33, 0x6d, 0x50, 0xea, 0x42, 0xab, 0xc7, 0x48, 0xc4, 0xbc, 0x42, 0xc0, 0x96, 0xae, 0xa5, 0x1a, 0x42, 0xd1, 0xe4, 0xe8, 0x11, 0xb2, 0x42, 0xd4, 0x11, 0xa4, 0x2f, 0x55, 0x42, 0xd3, 0x86, 0xa1, 0xab, 0x9c, 0x3f, 0x1d, 0xa5, 0x3d, 0x3b, 0x5c },
+	{ 0x41, 0x4f, 0xef, 0x8b, 0x76, 0xe6, 0x41, 0x92, 0xa7, 0xd5, 0x0c, 0x4f, 0x41, 0xb9, 0xcb, 0x24, 0x75, 0xd3, 0x41, 0xc1, 0x8a, 0x69, 0x6d, 0xe0, 0x42, 0xa4, 0xe9, 0xc7, 0x58, 0x42, 0x42, 0xbe, 0x71, 0xb2, 0x06, 0x6f, 0x42, 0xd1, 0xe4, 0xc5, 0x58, 0x9b, 0x42, 0xd5, 0x20, 0x27, 0x22, 0x17, 0x42, 0xc3, 0xc5, 0x07, 0xcc, 0x15, 0x3f, 0x20, 0x2c, 0xda, 0xa6, 0xf1 },
+	{ 0x41, 0x49, 0x49, 0x61, 0x6e, 0x84, 0x41, 0x91, 0xf4, 0xeb, 0x69, 0xde, 0x41, 0xaf, 0x2e, 0x81, 0xac, 0xd7, 0x41, 0xc5, 0x4e, 0x29, 0x2a, 0xc3, 0x42, 0xae, 0x32, 0xad, 0x6a, 0x5e, 0x42, 0xbe, 0x71, 0x4f, 0xa8, 0xd4, 0x42, 0xcc, 0xeb, 0xeb, 0xa1, 0x20, 0x42, 0xc1, 0xa7, 0xf4, 0x04, 0xde, 0x42, 0xcf, 0xb8, 0xd7, 0xd4, 0x2b, 0x3f, 0x19, 0x61, 0x85, 0x2b, 0xb9 },
+	// frame set 3
+	{ 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81 },
+	{ 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81 },
+	{ 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81 },
+	{ 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81, 0x00, 0x00, 0x81 },
+	// frame set 4
+	{ 0x42, 0xc7, 0x01, 0x68, 0x48, 0x67, 0x43, 0x01, 0x14, 0xcf, 0x77, 0xdd, 0x43, 0x22, 0xc1, 0xeb, 0x5e, 0x8c, 0x43, 0x28, 0x1a, 0x6e, 0x08, 0x00, 0x44, 0x25, 0xf8, 0xf3, 0xc7, 0x64, 0x44, 0x42, 0xd4, 0xa3, 0x49, 0xe6, 0x44, 0x39, 0xc6, 0xb1, 0xc8, 0x1a, 0x44, 0x3a, 0x95, 0xf8, 0x12, 0x8f, 0x44, 0x47, 0x21, 0x21, 0xcb, 0x04, 0x3e, 0xf3, 0x8f, 0xc0, 0xd0, 0x2f },
+	{ 0x42, 0xbf, 0x40, 0xff, 0xe6, 0x67, 0x43, 0x01, 0x14, 0xae, 0x54, 0xa9, 0x43, 0x21, 0x92, 0x88, 0x81, 0xde, 0x43, 0x27, 0x34, 0xdf, 0x93, 0xb6, 0x44, 0x20, 0x0d, 0x60, 0x26, 0xf4, 0x44, 0x3a, 0x95, 0x8d, 0x17, 0x36, 0x44, 0x40, 0xb6, 0x75, 0xfa, 0x94, 0x44, 0x45, 0x43, 0x6e, 0xb8, 0xbf, 0x44, 0x3f, 0x60, 0xc8, 0x1b, 0xb5, 0x3e, 0xe6, 0x39, 0x19, 0x2c, 0xd7 },
+	{ 0x42, 0xca, 0x4d, 0x42, 0xd5, 0x20, 0x42, 0xf8, 0xea, 0x2d, 0x22, 0xf9, 0x43, 0x21, 0x92, 0x28, 0x92, 0x31, 0x43, 0x2e, 0xbc, 0xf8, 0x65, 0xe0, 0x44, 0x1f, 0xe6, 0x7f, 0xa5, 0x2a, 0x44, 0x38, 0xf7, 0xd6, 0x6d, 0xe8, 0x44, 0x48, 0x0f, 0xef, 0xe8, 0x16, 0x44, 0x3e, 0x51, 0x73, 0xce, 0xcf, 0x44, 0x3d, 0x02, 0x91, 0xf8, 0x03, 0x3e, 0xe7, 0x08, 0x73, 0x83, 0xbe },
+	{ 0x42, 0xc8, 0x2f, 0xcc, 0xc8, 0x61, 0x42, 0xfa, 0x88, 0x20, 0xc3, 0x49, 0x43, 0x1d, 0x2a, 0x33, 0x58, 0xd9, 0x43, 0x28, 0x1a, 0x1b, 0xa7, 0x9e, 0x44, 0x28, 0xb4, 0x02, 0xab, 0x4e, 0x44, 0x3c, 0x33, 0xf1, 0x26, 0x4d, 0x44, 0x49, 0x3e, 0xf2, 0x25, 0x33, 0x44, 0x3d, 0x02, 0x18, 0x4e, 0xfa, 0x44, 0x40, 0xb6, 0x7d, 0xfc, 0x05, 0x3e, 0xec, 0xe2, 0x75, 0xb6, 0xd4 },
+};
+
+// pwm_lookup of the dimmer
+uint16_t dimmer_pwm_lookup[] = { 119, 199, 265, 325, 376, 421, 462, 498, 528, 559, 584, 607, 629, 650,
+	668, 683, 700, 714, 727, 740, 752, 763, 773, 783, 792, 801, 809, 817, 824, 831, 837, 844, 850, 856,
+	861, 866, 871, 876, 881, 885, 890, 894, 898, 902, 905, 909, 912, 916, 919, 922, 925, 928, 931, 933,
+	936, 938, 941, 943, 946, 948, 950, 952, 954, 956, 958, 960, 962, 964, 966, 967, 969, 971, 972, 974,
+	975, 977, 978, 980, 981, 982, 984, 985, 986, 988, 989, 990, 991, 992, 993, 995, 996, 997, 998, 999,
+	1000, 1001, 1002, 1003, 1004, 1004, 1005 };
+
+// default BrightnessTranslationTable of the dimmer (see e2p_layout.xml)
+// The former 8 bit translation table of the RGB LEDs, used as reference for gamma curve 0.
+uint8_t rgb_led_pwm_transl_ref[] = {
+	0, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 7, 7, 7, 7,
+	8, 8, 8, 9, 9, 9, 9, 10, 10, 10, 11, 11, 11, 11, 12, 12, 12, 13, 13, 13, 14, 14,
+	14, 14, 15, 15, 15, 16, 16, 16, 17, 17, 17, 18, 18, 18, 19, 19, 19, 20, 20, 20,
+	21, 21, 21, 22, 22, 22, 23, 23, 23, 24, 24, 24, 25, 25, 25, 26, 26, 27, 27, 27,
+	28, 28, 28, 29, 29, 30, 30, 30, 31, 31, 32, 32, 32, 33, 33, 34, 34, 34, 35, 35,
+	36, 36, 37, 37, 38, 38, 38, 39, 39, 40, 40, 41, 41, 42, 42, 43, 43, 44, 44, 45,
+	46, 46, 47, 47, 48, 48, 49, 49, 50, 51, 51, 52, 52, 53, 54, 54, 55, 56, 56, 57,
+	58, 58, 59, 60, 60, 61, 62, 63, 63, 64, 65, 66, 67, 67, 68, 69, 70, 71, 72, 73,
+	73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 87, 88, 89, 90, 91, 92, 94,
+	95, 96, 97, 99, 100, 101, 103, 104, 105, 107, 108, 110, 111, 113, 114, 116, 118,
+	119, 121, 123, 124, 126, 128, 130, 132, 134, 135, 137, 139, 141, 144, 146, 148,
+	150, 152, 155, 157, 159, 162, 164, 167, 169, 172, 174, 177, 180, 183, 185, 188,
+	191, 194, 197, 200, 204, 207, 210, 214, 217, 221, 224, 228, 231, 235, 239, 243,
+	247, 251, 255};
+
+uint8_t dimmer_translation[] = { 0x00, 0x11, 0x15, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22,
+	0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33,
+	0x34, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x40, 0x41, 0x42, 0x43, 0x45, 0x46, 0x47, 0x49,
+	0x4A, 0x4B, 0x4C, 0x4E, 0x50, 0x51, 0x53, 0x54, 0x56, 0x58, 0x59, 0x5B, 0x5D, 0x5F, 0x61, 0x63, 0x65, 0x67,
+	0x69, 0x6B, 0x6D, 0x6F, 0x71, 0x73, 0x75, 0x78, 0x7A, 0x7D, 0x80, 0x83, 0x86, 0x89, 0x8B, 0x8F, 0x93, 0x96,
+	0x9A, 0x9F, 0xA3, 0xA7, 0xAB, 0xAF, 0xB4, 0xBC, 0xC2, 0xC9, 0xCF, 0xD4, 0xDB, 0xE6, 0xF1, 0xFF };
+
 
 void compare(uint16_t byte, uint8_t bit, uint16_t length_bits, uint32_t minval, uint32_t maxval, uint32_t assumed_value, uint32_t val)
 {
@@ -77,7 +147,7 @@ void test_array_read_UIntValue8(uint16_t byte, uint8_t bit, uint16_t length_bits
 
 void test_eeprom_value(uint16_t pos, uint8_t assumed_value)
 {
-	uint8_t val = eeprom_read_byte((uint8_t*)(pos + 0));
+	uint8_t val = hal_eeprom_read_byte(pos + 0);
 	
 	printf("Test eeprom value at pos %d. Assumed value: %d, returned value: %d", pos, assumed_value, val);
 	
@@ -134,6 +204,775 @@ void test_bufx(char * assumed_value)
 	}
 }
 
+// Extract the float bits of one value from an SPS30 frame, skipping the CRC bytes.
+uint32_t sps30_frame_value_bits(uint8_t * frame, uint8_t pos)
+{
+	return ((uint32_t)frame[pos * 6] << 24) | ((uint32_t)frame[pos * 6 + 1] << 16)
+		| ((uint32_t)frame[pos * 6 + 3] << 8) | ((uint32_t)frame[pos * 6 + 4] << 0);
+}
+
+// The former float calculation of the envsensor, used as reference.
+uint16_t pm_float2uint(float f, uint16_t max)
+{
+	f += 0.5; // for rounding
+
+	if (f >= max)
+		return max;
+	else
+		return (uint16_t)f;
+}
+
+// Average 4 frames per measurement with the fixed point and the float path
+// (as in the envsensor) and compare the values that would be sent.
+// Rounding single values before averaging may differ by 1 from the float result.
+void test_pm_fixed_point(uint8_t first_frame, uint8_t avgInt)
+{
+	uint8_t pos, f;
+
+	for (pos = 0; pos < 10; pos++)
+	{
+		uint8_t scale = pos == 9 ? 100 : 10;
+		uint16_t max = ((pos >= 4) && (pos <= 8)) ? 4094 : 1022;
+		uint32_t sum_fixed = 0;
+		float sum_float = 0;
+		float2uint32_t float2uint32;
+
+		for (f = first_frame; f < first_frame + 4 * avgInt; f++)
+		{
+			uint32_t bits = sps30_frame_value_bits(sps30_frames[f], pos);
+
+			float2uint32.uint32Val = bits;
+			sum_float += float2uint32.floatVal;
+			sum_fixed += float_bits_to_fixed(bits, scale);
+		}
+
+		uint16_t val_float = pm_float2uint(sum_float / 4 / avgInt * scale, max);
+		uint16_t val_fixed = average_round16(sum_fixed, 4 * avgInt, max);
+
+		printf("Test pm value %u of frames %u..%u. Float value: %u, fixed point value: %u",
+			pos, first_frame, first_frame + 4 * avgInt - 1, val_float, val_fixed);
+
+		if (abs((int)val_float - (int)val_fixed) > 1)
+		{
+			res = 1;
+			printf(" --> NOK\n");
+		}
+		else
+		{
+			printf(" --> OK\n");
+		}
+	}
+}
+
+void test_float_bits_to_fixed(uint32_t bits, uint8_t scale, uint32_t assumed_value)
+{
+	uint32_t val = float_bits_to_fixed(bits, scale);
+
+	printf("Test float_bits_to_fixed(0x%08x, %u). Assumed value: %u, returned value: %u", bits, scale, assumed_value, val);
+
+	if (val != assumed_value)
+	{
+		res = 1;
+		printf(" --> NOK\n");
+	}
+	else
+	{
+		printf(" --> OK\n");
+	}
+}
+
+// The former float calculation of the dimmer (setPWMDutyCyclePercent), used as reference.
+uint16_t dimmer_pwm_float(float percent, uint8_t use_translation)
+{
+	uint8_t index, index2;
+	float modulo;
+
+	if (use_translation)
+	{
+		index = (uint8_t)percent;
+		index2 = index >= 100 ? 100 : index + 1;
+		modulo = percent - index;
+		percent = (dimmer_translation[index] + modulo * (dimmer_translation[index2] - dimmer_translation[index])) * 100 / 255;
+	}
+
+	index = (uint8_t)percent;
+	index2 = index >= 100 ? 100 : index + 1;
+	modulo = percent - index;
+
+	return (uint16_t)(dimmer_pwm_lookup[index] + modulo * (dimmer_pwm_lookup[index2] - dimmer_pwm_lookup[index]));
+}
+
+// Calculate the PWM values for all brightness values from 0% to 100% in 1/256 % steps
+// with the fixed point and the float path (as in the dimmer) and compare them.
+// Rounding the translated position to 1/256 % may lead to a difference of 1.
+void test_dimmer_fixed_point(uint8_t use_translation)
+{
+	uint16_t brightness_pos[101];
+	uint16_t percent;
+	uint16_t max_diff = 0;
+	uint16_t max_diff_percent = 0;
+
+	translation_to_pos16(dimmer_translation, brightness_pos, 101, 100);
+
+	for (percent = 0; percent <= 100 << 8; percent++)
+	{
+		uint16_t pos = use_translation ? interpolate_table16(brightness_pos, percent) : percent;
+		uint16_t pwm_fixed = interpolate_table16(dimmer_pwm_lookup, pos);
+		uint16_t pwm_float = dimmer_pwm_float(percent / 256.0, use_translation);
+		uint16_t diff = abs((int)pwm_float - (int)pwm_fixed);
+
+		if (diff > max_diff)
+		{
+			max_diff = diff;
+			max_diff_percent = percent;
+		}
+	}
+
+	printf("Test dimmer PWM values with%s translation. Max. difference fixed point to float: %u (at %u/256 %%)",
+		use_translation ? "" : "out", max_diff, max_diff_percent);
+
+	if (max_diff > 1)
+	{
+		res = 1;
+		printf(" --> NOK\n");
+	}
+	else
+	{
+		printf(" --> OK\n");
+	}
+}
+
+void test_interpolate_table16(uint16_t pos, uint16_t assumed_value)
+{
+	uint16_t val = interpolate_table16(dimmer_pwm_lookup, pos);
+
+	printf("Test interpolate_table16(pwm_lookup, 0x%04x). Assumed value: %u, returned value: %u", pos, assumed_value, val);
+
+	if (val != assumed_value)
+	{
+		res = 1;
+		printf(" --> NOK\n");
+	}
+	else
+	{
+		printf(" --> OK\n");
+	}
+}
+
+struct timer_wheel_t test_wheel;
+struct sw_timer_t test_timers[8];
+uint16_t test_timer_expired_at[8];
+uint8_t test_timer_expired_cnt[8];
+
+// Remember when the timer expired. Timer 6 restarts itself twice (in the same slot).
+void test_timer_expired(uint8_t num)
+{
+	test_timer_expired_at[num] = test_wheel.now;
+	test_timer_expired_cnt[num]++;
+
+	if ((num == 6) && (test_timer_expired_cnt[num] < 3))
+	{
+		sw_timer_start(&test_wheel, &test_timers[num], TIMER_WHEEL_SLOTS);
+	}
+}
+
+// Start timers with different delays (shorter and longer than one wheel revolution),
+// restart and stop some of them while the wheel is running and check that every
+// timer expires exactly at the expected tick.
+void test_timer_wheel(void)
+{
+	uint16_t delay[8] =       { 1, 7, 8, 9, 100, 65535, 8, 8 };
+	uint16_t assumed_at[8] =  { 1, 7, 8, 25, 100, 65535, 24, 0 };
+	uint8_t assumed_cnt[8] =  { 1, 1, 1, 1, 1, 1, 3, 0 };
+	uint8_t errors = 0;
+	uint32_t tick;
+	uint8_t i;
+
+	timer_wheel_init(&test_wheel);
+
+	for (i = 0; i < 8; i++)
+	{
+		sw_timer_init(&test_timers[i], test_timer_expired, i);
+		sw_timer_start(&test_wheel, &test_timers[i], delay[i]);
+		test_timer_expired_cnt[i] = 0;
+		test_timer_expired_at[i] = 0;
+	}
+
+	for (tick = 1; tick <= 70000; tick++)
+	{
+		timer_wheel_tick(&test_wheel);
+
+		if (tick == 3)
+		{
+			sw_timer_stop(&test_timers[7]);
+		}
+		else if (tick == 5)
+		{
+			sw_timer_start(&test_wheel, &test_timers[3], 20); // restart
+		}
+		else if ((tick == 50) && (sw_timer_remaining(&test_wheel, &test_timers[4]) != 50))
+		{
+			errors++;
+		}
+		else if ((tick == 65534) && (sw_timer_remaining(&test_wheel, &test_timers[5]) != 1))
+		{
+			errors++;
+		}
+	}
+
+	for (i = 0; i < 8; i++)
+	{
+		if ((test_timer_expired_at[i] != assumed_at[i]) || (test_timer_expired_cnt[i] != assumed_cnt[i])
+			|| sw_timer_running(&test_timers[i]))
+		{
+			printf("Timer %u expired %u times, last at tick %u. Assumed %u times, last at tick %u.\n",
+				i, test_timer_expired_cnt[i], test_timer_expired_at[i], assumed_cnt[i], assumed_at[i]);
+			errors++;
+		}
+	}
+
+	printf("Test timer wheel with 8 timers. Errors: %u", errors);
+
+	if (errors != 0)
+	{
+		res = 1;
+		printf(" --> NOK\n");
+	}
+	else
+	{
+		printf(" --> OK\n");
+	}
+}
+
+// The former calculation of rgb_led_update_current_col, used as reference.
+uint8_t rgb_blend_ref(uint8_t from, uint8_t to)
+{
+	return (uint8_t)((uint32_t)from * (animation.step_len - animation.step_pos) / animation.step_len
+		+ (uint32_t)to * animation.step_pos / animation.step_len);
+}
+
+// The former calculation of speaker_update_current_tone, used as reference.
+uint16_t tone_blend_ref(void)
+{
+	if (melody_effect[melody.col_pos] == 1)
+		return (uint16_t)((uint32_t)melody_PWM[melody.col_pos] * (melody.step_len - melody.step_pos) / melody.step_len
+			+ (uint32_t)melody_PWM[melody.col_pos + 1] * melody.step_pos / melody.step_len);
+	else
+		return melody_PWM[melody.col_pos + 1];
+}
+
+// Play a color animation (with the colors and times of test_anim_calculation and some
+// short times) or a melody with the given repeat and autoreverse settings as unfolded by
+// init_animation, and compare the color/tone of every animation tick with the former
+// calculation. Endless animations are stopped after max_ticks.
+void test_animation(bool RGB_LED, uint8_t repeat, bool autoreverse, uint16_t max_ticks)
+{
+	struct animation_param_t* par = RGB_LED ? &animation : &melody;
+	uint8_t times[] = { 10, 16, 1, 16, 2, 15, 9, 5, 0 };
+	uint8_t colors[] = { 0, 48, 12, 12, 3, 51, 1, 63, 0 };
+	uint8_t tones[] = { 25, 29, 32, 37, 1, 116, 37, 70, 0 };
+	uint16_t ticks = 0;
+	uint16_t diffs = 0;
+	uint8_t i;
+
+	par->repeat = repeat;
+	par->autoreverse = autoreverse;
+
+	for (i = 0; i < sizeof(times); i++)
+	{
+		if (RGB_LED)
+		{
+			anim_time[i] = times[i];
+			anim_colors_orig[i] = colors[i];
+		}
+		else
+		{
+			melody_time[i] = times[i];
+			melody_tones_orig[i] = tones[i];
+			melody_effect[i] = i % 3 != 2; // mostly sliding tones
+		}
+	}
+
+	current_col.r = 200;
+	current_col.g = 7;
+	current_col.b = 99;
+	current_tone_PWM = 1000;
+
+	init_animation(RGB_LED);
+
+	if (RGB_LED)
+		rgb_led_update_current_col();
+	else
+		speaker_update_current_tone();
+
+	while ((par->step_len != 0) && (ticks < max_ticks))
+	{
+		if (RGB_LED)
+		{
+			if ((current_col.r != rgb_blend_ref(anim_col[animation.col_pos].r, anim_col[animation.col_pos + 1].r))
+				|| (current_col.g != rgb_blend_ref(anim_col[animation.col_pos].g, anim_col[animation.col_pos + 1].g))
+				|| (current_col.b != rgb_blend_ref(anim_col[animation.col_pos].b, anim_col[animation.col_pos + 1].b)))
+			{
+				diffs++;
+			}
+		}
+		else if (current_tone_PWM != tone_blend_ref())
+		{
+			diffs++;
+		}
+
+		animation_tick(RGB_LED);
+		ticks++;
+	}
+
+	printf("Test %s with repeat %u, autoreverse %u. Ticks: %u, differences to former calculation: %u",
+		RGB_LED ? "color animation" : "melody", repeat, autoreverse, ticks, diffs);
+
+	if (diffs != 0)
+	{
+		res = 1;
+		printf(" --> NOK\n");
+	}
+	else
+	{
+		printf(" --> OK\n");
+	}
+}
+
+// Set all color values with the given gamma curve and brightness factors and check
+// that the (non dithered) PWM output is monotonic and reaches the maximum (255 * both
+// factors). For gamma curve 0, compare the output with the former translation table.
+void test_gamma_curve(uint8_t curve, uint8_t brightness_factor, uint8_t user_brightness_factor)
+{
+	struct rgb_color_t col;
+	uint8_t prev = 0;
+	uint8_t max = (uint32_t)255 * brightness_factor * user_brightness_factor / 10000;
+	uint16_t errors = 0;
+	uint16_t c;
+
+	rgb_led_gamma_curve = curve;
+	rgb_led_brightness_factor = brightness_factor;
+	rgb_led_user_brightness_factor = user_brightness_factor;
+
+	for (c = 0; c < 256; c++)
+	{
+		col.r = c;
+		col.g = c;
+		col.b = c;
+		rgb_led_set_PWM(col);
+
+		if ((OCR0A < prev) || (OCR0A != OCR0B) || (OCR0A != OCR2B))
+		{
+			errors++;
+		}
+
+		if (curve == 0)
+		{
+			int16_t ref = (uint32_t)rgb_led_pwm_transl_ref[c] * brightness_factor * user_brightness_factor / 10000;
+
+			if ((OCR0A < ref - 1) || (OCR0A > ref + 1))
+			{
+				errors++;
+			}
+		}
+
+		prev = OCR0A;
+	}
+
+	if (abs(prev - max) > 1)
+	{
+		errors++;
+	}
+
+	printf("Test gamma curve %u with brightness %u%% * %u%%. Max PWM: %u, errors: %u",
+		curve, brightness_factor, user_brightness_factor, prev, errors);
+
+	if (errors != 0)
+	{
+		res = 1;
+		printf(" --> NOK\n");
+	}
+	else
+	{
+		printf(" --> OK\n");
+	}
+
+	rgb_led_user_brightness_factor = 100;
+}
+
+// Clear the message data behind the header in the given copy of bufx, so that
+// packing has to restore all bits of it.
+void clear_message_data(uint8_t * buf)
+{
+	uint16_t offset = __HEADEROFFSETBITS;
+
+	buf[offset / 8] &= ~(0xff >> (offset % 8));
+	memset(buf + offset / 8 + 1, 0, BUFX_LENGTH - offset / 8 - 1);
+}
+
+void print_unpack_pack_result(char * name, uint8_t ok)
+{
+	printf("Test unpack / pack %s. Assumed value: same as getters, returned value: %s", name, ok ? "same" : "different");
+
+	if (!ok)
+	{
+		res = 1;
+		printf(" --> NOK\n");
+	}
+	else
+	{
+		printf(" --> OK\n");
+	}
+}
+
+// Compare the values unpacked in one pass with the ones read by the getters and
+// check if packing them again results in the same message data.
+void test_unpack_gpio_analogport(void)
+{
+	msg_gpio_analogport_t msg;
+	uint8_t buf[BUFX_LENGTH];
+	uint8_t i;
+	uint8_t ok = 1;
+
+	msg_gpio_analogport_unpack(bufx, &msg);
+
+	for (i = 0; i < 8; i++)
+	{
+		if ((msg.on[i] != msg_gpio_analogport_get_on(i)) || (msg.voltage[i] != msg_gpio_analogport_get_voltage(i)))
+		{
+			ok = 0;
+		}
+	}
+
+	memcpy(buf, bufx, sizeof(buf));
+	clear_message_data(buf);
+	msg_gpio_analogport_pack(&msg, buf);
+
+	if (memcmp(buf, bufx, sizeof(buf)) != 0)
+	{
+		ok = 0;
+	}
+
+	print_unpack_pack_result("gpio_analogport", ok);
+}
+
+// Signed IntValue: the sign has to be restored from the 16 bit field.
+void test_unpack_weather_temperature(int16_t temperature)
+{
+	msg_weather_temperature_t msg;
+	uint8_t buf[BUFX_LENGTH];
+	uint8_t ok = 1;
+
+	pkg_header_init_weather_temperature_status();
+	msg_weather_temperature_set_temperature(temperature);
+	msg_weather_temperature_unpack(bufx, &msg);
+
+	if ((msg.temperature != temperature) || (msg.temperature != msg_weather_temperature_get_temperature()))
+	{
+		ok = 0;
+	}
+
+	memcpy(buf, bufx, sizeof(buf));
+	clear_message_data(buf);
+	msg_weather_temperature_pack(&msg, buf);
+
+	if (memcmp(buf, bufx, sizeof(buf)) != 0)
+	{
+		ok = 0;
+	}
+
+	print_unpack_pack_result("weather_temperature", ok);
+}
+
+// Enum followed by values which are not byte aligned.
+void test_unpack_dimmer_animation(AnimationModeEnum mode)
+{
+	msg_dimmer_animation_t msg;
+	uint8_t buf[BUFX_LENGTH];
+	uint8_t ok = 1;
+
+	pkg_header_init_dimmer_animation_set();
+	msg_dimmer_animation_set_animationmode(mode);
+	msg_dimmer_animation_set_timeoutsec(54321);
+	msg_dimmer_animation_set_startbrightness(3);
+	msg_dimmer_animation_set_endbrightness(100);
+	msg_dimmer_animation_unpack(bufx, &msg);
+
+	if ((msg.animationmode != mode) || (msg.animationmode != msg_dimmer_animation_get_animationmode())
+		|| (msg.timeoutsec != 54321) || (msg.startbrightness != 3) || (msg.endbrightness != 100))
+	{
+		ok = 0;
+	}
+
+	memcpy(buf, bufx, sizeof(buf));
+	clear_message_data(buf);
+	msg_dimmer_animation_pack(&msg, buf);
+
+	if (memcmp(buf, bufx, sizeof(buf)) != 0)
+	{
+		ok = 0;
+	}
+
+	print_unpack_pack_result("dimmer_animation", ok);
+}
+
+// ByteArray starting at a bit position which is not a multiple of 8.
+void test_unpack_display_text(void)
+{
+	msg_display_text_t msg;
+	uint8_t buf[BUFX_LENGTH];
+	uint8_t text[40];
+	uint8_t i;
+	uint8_t ok = 1;
+
+	for (i = 0; i < sizeof(text); i++)
+	{
+		text[i] = 0xff - i * 3;
+	}
+
+	pkg_header_init_display_text_set();
+	msg_display_text_set_posy(17);
+	msg_display_text_set_posx(79);
+	msg_display_text_set_format(5);
+	msg_display_text_set_text(text);
+	msg_display_text_unpack(bufx, &msg);
+
+	if ((msg.posy != 17) || (msg.posx != 79) || (msg.format != 5) || (memcmp(msg.text, text, sizeof(text)) != 0))
+	{
+		ok = 0;
+	}
+
+	memcpy(buf, bufx, sizeof(buf));
+	clear_message_data(buf);
+	msg_display_text_pack(&msg, buf);
+
+	if (memcmp(buf, bufx, sizeof(buf)) != 0)
+	{
+		ok = 0;
+	}
+
+	print_unpack_pack_result("display_text", ok);
+}
+
+// No message in packet_layout.xml contains a Reserved element yet, so use the
+// statements the generator creates for one: 5 bits value, 11 bits Reserved,
+// 12 bits signed value. Packing must not change the reserved bits.
+void test_unpack_reserved_gap(void)
+{
+	uint8_t data[4] = { 0xff, 0xff, 0xff, 0xff };
+	uint8_t assumed[4] = { 0x57, 0xff, 0xff, 0xbf };
+	bitstream_t bs;
+	uint8_t val;
+	int16_t ival;
+	uint8_t ok = 1;
+
+	bitstream_init(&bs, data, 0);
+	bitstream_write_bits(&bs, 5, 10);
+	bitstream_skip(&bs, 11);
+	bitstream_write_IntValue(&bs, 12, -5);
+
+	if (memcmp(data, assumed, sizeof(data)) != 0)
+	{
+		ok = 0;
+	}
+
+	bitstream_init(&bs, data, 0);
+	val = bitstream_read_bits(&bs, 5);
+	bitstream_skip(&bs, 11);
+	ival = bitstream_read_IntValue32(&bs, 12, -2048, 2047);
+
+	if ((val != 10) || (ival != -5))
+	{
+		ok = 0;
+	}
+
+	print_unpack_pack_result("with reserved gap", ok);
+}
+
+// Measure the time to decode the message currently in bufx with the getters and with
+// the single pass unpack function. The result is only printed, not checked.
+void benchmark_unpack_gpio_analogport(uint32_t loops)
+{
+	volatile uint32_t sum = 0;
+	msg_gpio_analogport_t msg;
+	uint32_t l;
+	uint8_t i;
+	clock_t t;
+
+	t = clock();
+
+	for (l = 0; l < loops; l++)
+	{
+		for (i = 0; i < 8; i++)
+		{
+			sum += msg_gpio_analogport_get_on(i) + msg_gpio_analogport_get_voltage(i);
+		}
+	}
+
+	double t_get = (double)(clock() - t) / CLOCKS_PER_SEC;
+	t = clock();
+
+	for (l = 0; l < loops; l++)
+	{
+		msg_gpio_analogport_unpack(bufx, &msg);
+
+		for (i = 0; i < 8; i++)
+		{
+			sum += msg.on[i] + msg.voltage[i];
+		}
+	}
+
+	double t_unpack = (double)(clock() - t) / CLOCKS_PER_SEC;
+
+	printf("Benchmark decoding gpio_analogport %u times: getters %.3fs, unpack %.3fs\n", loops, t_get, t_unpack);
+}
+
+#define CODEC_THREADS 8
+#define CODEC_PACKETS 2000
+
+// Encode and decode packets with the codec context API in an own buffer per thread.
+// Returns the number of packets that were not decoded as encoded (as pointer value).
+void * codec_thread(void * arg)
+{
+	uintptr_t thread_nr = (uintptr_t)arg;
+	uintptr_t errors = 0;
+	uint8_t buf[BUFX_LENGTH];
+	uint16_t p;
+	uint8_t i;
+
+	for (p = 0; p < CODEC_PACKETS; p++)
+	{
+		pkg_ctx_t tx = { buf };
+		pkg_ctx_t rx = { buf };
+
+		pkg_header_ctx_init_gpio_analogport_status(&tx);
+		pkg_header_ctx_set_senderid(&tx, thread_nr);
+		pkg_header_ctx_set_packetcounter(&tx, p);
+
+		for (i = 0; i < 8; i++)
+		{
+			msg_gpio_analogport_ctx_set_on(&tx, i, ((p >> i) & 1) == 1);
+			msg_gpio_analogport_ctx_set_voltage(&tx, i, (p + i * thread_nr) % 1101);
+		}
+
+		// decode with a fresh context, as after reception
+		pkg_header_ctx_adjust_offset(&rx);
+
+		if ((rx.messagetype != MESSAGETYPE_STATUS)
+			|| (rx.headeroffsetbits != tx.headeroffsetbits)
+			|| (pkg_header_ctx_get_senderid(&rx) != thread_nr)
+			|| (pkg_header_ctx_get_packetcounter(&rx) != p)
+			|| (pkg_headerext_common_ctx_get_messagegroupid(&rx) != MESSAGEGROUP_GPIO)
+			|| (pkg_headerext_common_ctx_get_messageid(&rx) != MESSAGEID_GPIO_ANALOGPORT))
+		{
+			errors++;
+			continue;
+		}
+
+		msg_gpio_analogport_t msg;
+		msg_gpio_analogport_ctx_unpack(&rx, &msg);
+
+		for (i = 0; i < 8; i++)
+		{
+			if ((msg.on[i] != (((p >> i) & 1) == 1)) || (msg.voltage[i] != (p + i * thread_nr) % 1101)
+				|| (msg_gpio_analogport_ctx_get_voltage(&rx, i) != msg.voltage[i]))
+			{
+				errors++;
+				break;
+			}
+		}
+	}
+
+	return (void *)errors;
+}
+
+// Encode and decode packets in several threads at the same time. The packet in
+// bufx and the global header state must not be changed by that.
+void test_codec_threads(void)
+{
+	pthread_t threads[CODEC_THREADS];
+	uint8_t bufx_before[BUFX_LENGTH];
+	uint8_t headeroffsetbits = __HEADEROFFSETBITS;
+	uintptr_t errors = 0;
+	uintptr_t t;
+
+	memcpy(bufx_before, bufx, sizeof(bufx));
+
+	for (t = 0; t < CODEC_THREADS; t++)
+	{
+		pthread_create(&threads[t], NULL, codec_thread, (void *)t);
+	}
+
+	for (t = 0; t < CODEC_THREADS; t++)
+	{
+		void * thread_errors;
+
+		pthread_join(threads[t], &thread_errors);
+		errors += (uintptr_t)thread_errors;
+	}
+
+	if ((memcmp(bufx_before, bufx, sizeof(bufx)) != 0) || (headeroffsetbits != __HEADEROFFSETBITS))
+	{
+		errors++;
+	}
+
+	printf("Test codec context with %u threads. Assumed value: 0 errors, returned value: %lu errors", CODEC_THREADS, (unsigned long)errors);
+
+	if (errors != 0)
+	{
+		res = 1;
+		printf(" --> NOK\n");
+	}
+	else
+	{
+		printf(" --> OK\n");
+	}
+}
+
+uint8_t dispatch_handler_calls = 0;
+
+void dispatch_handler(MessageTypeEnum messagetype)
+{
+	dispatch_handler_calls++;
+}
+
+const pkg_handler_t dispatch_handlers[MSGSLOT_COUNT] PROGMEM = {
+	[MSGSLOT_GPIO_ANALOGPORT] = dispatch_handler
+};
+
+// Dispatch the packet in bufx with the given length and check the result, if the
+// handler was called and if the bytes after the packet were cleared for it.
+void test_dispatch(uint8_t len, PkgDispatchResultEnum assumed_value)
+{
+	uint8_t i;
+	uint8_t cleared = 1;
+
+	dispatch_handler_calls = 0;
+	pkg_header_adjust_offset();
+
+	PkgDispatchResultEnum val = pkg_dispatch(len, dispatch_handlers);
+
+	printf("Test dispatch with packet length %u. Assumed value: %u, returned value: %u", len, assumed_value, val);
+
+	for (i = len; (val == PKG_DISPATCH_OK) && (i < BUFX_LENGTH); i++)
+	{
+		if (bufx[i] != 0)
+		{
+			cleared = 0;
+		}
+	}
+
+	if ((val != assumed_value) || (dispatch_handler_calls != (val == PKG_DISPATCH_OK ? 1 : 0)) || !cleared)
+	{
+		res = 1;
+		printf(" --> NOK\n");
+	}
+	else
+	{
+		printf(" --> OK\n");
+	}
+}
+
 int main(int argc , char** argv){
 	printf("smarthomatic unit test\n");
 
@@ -195,6 +1034,16 @@ int main(int argc , char** argv){
 	test_eeprom_value(16, 254);
 	test_eeprom_value(17, 30);
 	test_eeprom_value(18, 29);
+
+	// RAM copy of EEPROM bytes 4 to 11
+	uint8_t shadow[8];
+	e2p_shadow_init(shadow, 4, 8);
+	hal_eeprom_write_byte(6, 0); // change EEPROM behind the RAM copy
+	test_eeprom_read_UIntValue8(6, 0, 8, 0, 255, 204); // value is read from RAM copy
+	eeprom_write_UIntValue(6 * 8 + 0, 8, 77); // write to RAM copy and EEPROM
+	test_eeprom_read_UIntValue8(6, 0, 8, 0, 255, 77);
+	test_eeprom_value(6, 77);
+	e2p_shadow_init(NULL, 0, 0);
 	
 	// write tests within one byte (ARRAY)
 	array_write_UIntValue(5 * 8 + 0, 8, 133, testarray); // normal write
@@ -211,18 +1060,93 @@ int main(int argc , char** argv){
 	pkg_header_set_packetcounter(2345);
 	test_bufx("000000000b10009298142021e000000000000000000000000000000000000000");
 	
-	// write test GPIO analogpin
-	pkg_header_init_gpio_analogpin_status();
-	msg_gpio_analogpin_set_on(1, true);
-	msg_gpio_analogpin_set_on(3, true);
-	msg_gpio_analogpin_set_on(4, true);
-	msg_gpio_analogpin_set_voltage(0, 1100);
-	msg_gpio_analogpin_set_voltage(1, 8);
-	msg_gpio_analogpin_set_voltage(4, 0);
+	// write test GPIO analogport
+	pkg_header_init_gpio_analogport_status();
+	msg_gpio_analogport_set_on(1, true);
+	msg_gpio_analogport_set_on(3, true);
+	msg_gpio_analogport_set_on(4, true);
+	msg_gpio_analogport_set_voltage(0, 1100);
+	msg_gpio_analogport_set_voltage(1, 8);
+	msg_gpio_analogport_set_voltage(4, 0);
 	pkg_header_set_senderid(999);
 	pkg_header_set_packetcounter(65432);
-	test_bufx("000000003e700ff988024b113004000000000000000000000000000000000000");
+	test_bufx("000000003e700ff9880348990100010010000000000000000000000000000000");
+	test_unpack_gpio_analogport();
+	benchmark_unpack_gpio_analogport(100000);
+	test_codec_threads();
+
+	// dispatch table
+	test_dispatch(32, PKG_DISPATCH_OK);
+	memset(bufx + 32, 0xff, BUFX_LENGTH - 32); // stale data of a previous packet
+	test_dispatch(16, PKG_DISPATCH_OK); // trailing zero bytes were not sent
+	test_dispatch(8, PKG_DISPATCH_PACKET_TOO_SHORT); // header incomplete
+	pkg_headerext_status_set_messageid(MESSAGEID_GPIO_DIGITALPORT);
+	test_dispatch(32, PKG_DISPATCH_NO_HANDLER);
+	pkg_headerext_status_set_messageid(15);
+	test_dispatch(32, PKG_DISPATCH_UNKNOWN_MESSAGE);
+	pkg_header_init_gpio_analogport_set();
+	pkg_headerext_set_set_messagegroupid(MESSAGEGROUP_WEATHER);
+	pkg_headerext_set_set_messageid(MESSAGEID_WEATHER_TEMPERATURE);
+	test_dispatch(32, PKG_DISPATCH_UNSUPPORTED_MESSAGETYPE);
+	pkg_header_init_gpio_analogport_ack();
+	test_dispatch(32, PKG_DISPATCH_UNKNOWN_MESSAGE);
+
+	// unpack / pack of other field types (overwrites bufx)
+	test_unpack_weather_temperature(-273);
+	test_unpack_weather_temperature(-32768);
+	test_unpack_weather_temperature(32767);
+	test_unpack_dimmer_animation(ANIMATIONMODE_EASE);
+	test_unpack_dimmer_animation(ANIMATIONMODE_LINEAR);
+	test_unpack_display_text();
+	test_unpack_reserved_gap();
 	
+	// fixed point conversion of float values
+	test_float_bits_to_fixed(0x00000000, 10, 0); // 0.0
+	test_float_bits_to_fixed(0x3f800000, 10, 10); // 1.0
+	test_float_bits_to_fixed(0x3f000000, 1, 1); // 0.5 (round up)
+	test_float_bits_to_fixed(0x3ecccccd, 10, 4); // 0.4
+	test_float_bits_to_fixed(0x42f6e979, 100, 12346); // 123.456
+	test_float_bits_to_fixed(0xbf800000, 10, 0); // -1.0
+	test_float_bits_to_fixed(0x7f800000, 10, UINT32_MAX); // infinity
+	test_float_bits_to_fixed(0x7fc00000, 10, 0); // NaN
+	test_float_bits_to_fixed(0x00000001, 255, 0); // smallest denormalized number
+	test_float_bits_to_fixed(0x4f800000, 10, UINT32_MAX); // 2^32 (overflow)
+
+	// particulate matter averaging with recorded SPS30 frames
+	test_pm_fixed_point(0, 1);
+	test_pm_fixed_point(4, 1);
+	test_pm_fixed_point(8, 1);
+	test_pm_fixed_point(12, 1);
+	test_pm_fixed_point(0, 2);
+	test_pm_fixed_point(8, 2);
+
+	// table interpolation and dimmer brightness
+	test_interpolate_table16(0x0000, 119); // first entry
+	test_interpolate_table16(0x0080, 159); // middle between 119 and 199
+	test_interpolate_table16(0x01ff, 264); // round down
+	test_interpolate_table16(0x6400, 1005); // last entry
+	test_dimmer_fixed_point(0);
+	test_dimmer_fixed_point(1);
+
+	// incremental color and tone calculation of animations
+	for (uint8_t repeat = 0; repeat <= 4; repeat++)
+	{
+		test_animation(true, repeat, false, 20000);
+		test_animation(true, repeat, true, 20000);
+		test_animation(false, repeat, false, 20000);
+		test_animation(false, repeat, true, 20000);
+	}
+
+	// software timers
+	test_timer_wheel();
+
+	// gamma curves of the RGB LEDs
+	for (uint8_t curve = 0; curve < RGBLED_GAMMA_CURVES; curve++)
+	{
+		test_gamma_curve(curve, 100, 100);
+		test_gamma_curve(curve, 60, 75);
+	}
+
 	printf("\r\nOverall result: %s\r\n", res ? "NOK (at least one test failed)" : "OK (all tests ok)");
 	
 	return res;
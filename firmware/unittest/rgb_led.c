@@ -0,0 +1,56 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2024 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// rgb_led.c of the RGB dimmer and the controller, compiled for the unittest.
+// The registers and pins used by it are replaced by variables.
+
+#include <inttypes.h>
+
+uint8_t TCCR0A, TCCR0B, TCCR2A, TCCR2B, TCCR1A, TCCR1B, TIMSK0;
+uint8_t OCR0A, OCR0B, OCR2B;
+uint16_t OCR1A;
+uint8_t DDRB, DDRD;
+
+#define WGM00 0
+#define COM0B1 5
+#define COM0A1 7
+#define CS00 0
+#define CS01 1
+#define WGM20 0
+#define COM2B1 5
+#define CS20 0
+#define CS21 1
+#define TOIE0 0
+#define WGM10 0
+#define WGM11 1
+#define COM1A0 6
+#define CS10 0
+#define WGM12 3
+#define WGM13 4
+
+#define RGBLED_RED_PIN 6
+#define RGBLED_GRN_PIN 5
+#define RGBLED_BLU_PIN 3
+#define SPEAKER_PIN    1
+
+#define RGBLED_RED_DDR DDRD
+#define RGBLED_GRN_DDR DDRD
+#define RGBLED_BLU_DDR DDRD
+#define SPEAKER_DDR    DDRB
+
+#include "../src_common/rgb_led.c"
@@ -17,6 +17,7 @@
 */
 
 #include "util.h"
+#include "../src_common/hal.h"
 
 uint32_t crc32(uint8_t *data, uint8_t len)
 {
@@ -27,3 +28,15 @@ uint32_t getBuf32(uint8_t offset)
 {
 	return 0;
 }
+
+void hal_irq_enable(void)
+{
+}
+
+void hal_irq_disable(void)
+{
+}
+
+void hal_delay_ms(double ms)
+{
+}
@@ -36,9 +36,25 @@ sub SHC_ReadAnswer($$$$);
 sub SHC_Ready($);
 
 sub SHC_SimpleWrite(@);
+sub SHC_SendNext($);
+sub SHC_SendResult($$);
 
 my $clientsSHC = ":SHCdev:BASE:xxx:";
 
+# Maximum length of a line from the base station. The longest regular lines
+# (PKT with maximum message data, "Received ...") have about 250 characters.
+# Longer data without line end is discarded to resynchronize on the next line.
+my $maxLineLengthSHC = 1024;
+
+# Commands to send are queued and written one after another. The next command
+# is written when the base station answered the previous one ("Request added to
+# queue", ...) or after a timeout. If the request queue of the base station is
+# full, the command is repeated later with increasing delay.
+my $sendTimeoutSHC    = 2;     # seconds to wait for the answer to a command
+my $sendBackoffMinSHC = 1;     # seconds before the first retry when the base station queue is full
+my $sendBackoffMaxSHC = 30;    # maximum seconds between retries
+my $sendRetriesSHC    = 6;     # retries before a command is dropped
+
 my %matchListSHC = (
   "1:SHCdev" => "^PKT:SID=([1-9]|[1-9][0-9]|[1-9][0-9][0-9]|[1-3][0-9][0-9][0-9]|40[0-8][0-9]|409[0-6]);",    #1-4096
   "2:xxx"     => "^\\S+\\s+22",
@@ -135,7 +151,7 @@ sub SHC_Set($@)
     #return "\"set SHC $cmd\" needs exactly one parameter" if(@_ != 4);
     #return "Expecting a even length hex number" if((length($arg)&1) == 1 || $arg !~ m/^[\dA-F]{12,}$/ );
     Log3 $name, 4, "$name: set $name $cmd $arg";
-    SHC_SimpleWrite($hash, $arg);
+    SHC_Write($hash, $arg);
 
   } else {
     return "Unknown argument $cmd, choose one of " . $list;
@@ -162,6 +178,18 @@ sub SHC_DoInit($)
 
   $hash->{STATE} = "Initialized";
 
+  # drop incomplete data received before the (re)connect
+  $hash->{PARTIAL} = "";
+  $hash->{PARTIAL_OVERFLOW} = 0;
+
+  # an answer to a command sent before the (re)connect will not arrive
+  if ($hash->{helper}{sendPending}) {
+    RemoveInternalTimer($hash, "SHC_SendTimeout");
+    $hash->{helper}{sendPending} = 0;
+  }
+
+  SHC_SendNext($hash);
+
   return undef;
 }
 
@@ -227,20 +255,114 @@ sub SHC_ReadAnswer($$$$)
 #####################################
 sub SHC_Write($$)
 {
-  # TODO: Not adapted to SHC, copy from 36_JeeLink.pm
   my ($hash, $msg) = @_;
   my $name = $hash->{NAME};
 
-  Log3 $name, 5, "$name: sending $msg";
+  Log3 $name, 5, "$name: queueing $msg";
+
+  push(@{$hash->{helper}{sendQueue}}, {msg => $msg, queued => scalar(gettimeofday()), retries => 0});
+  readingsSingleUpdate($hash, "sendQueueLength", scalar(@{$hash->{helper}{sendQueue}}), 1);
+
+  SHC_SendNext($hash);
+}
+
+#####################################
+# Write the first command of the send queue, if the base station is not busy
+# with the previous one.
+sub SHC_SendNext($)
+{
+  my ($hash) = @_;
+  my $queue = $hash->{helper}{sendQueue};
+
+  return if ($hash->{helper}{sendPending} || $hash->{helper}{sendBackoff});
+  return if (!$queue || !@$queue || ($hash->{STATE} eq "disconnected"));
 
-  SHC_SimpleWrite($hash, $msg);
+  $hash->{helper}{sendPending} = 1;
+  $hash->{helper}{sendEchoed}  = 0;
+
+  SHC_SimpleWrite($hash, $queue->[0]{msg});
+  InternalTimer(gettimeofday() + $sendTimeoutSHC, "SHC_SendTimeout", $hash, 0);
+}
+
+#####################################
+# Process the answer of the base station to the written command.
+# $result is "ok", "full" (request queue full), "crc" (command was
+# corrupted on the serial line), "error" or "timeout".
+sub SHC_SendResult($$)
+{
+  my ($hash, $result) = @_;
+  my $name  = $hash->{NAME};
+  my $queue = $hash->{helper}{sendQueue};
+
+  return if (!$hash->{helper}{sendPending});
+
+  RemoveInternalTimer($hash, "SHC_SendTimeout");
+  $hash->{helper}{sendPending} = 0;
+
+  my $cmd = $queue->[0];
+
+  if ((($result eq "full") || ($result eq "crc")) && ($cmd->{retries} < $sendRetriesSHC)) {
+    $cmd->{retries}++;
+    $hash->{SEND_RETRIES}++;
+
+    if ($result eq "full") {
+      my $delay = $sendBackoffMinSHC * 2**($cmd->{retries} - 1);
+      $delay = $sendBackoffMaxSHC if ($delay > $sendBackoffMaxSHC);
+
+      Log3 $name, 3, "$name: request queue of base station full, retry in $delay s";
+
+      $hash->{helper}{sendBackoff} = 1;
+      InternalTimer(gettimeofday() + $delay, "SHC_SendBackoffEnd", $hash, 0);
+      return;
+    }
+
+    # the base station ignored the command, so it can be written again immediately
+    SHC_SendNext($hash);
+    return;
+  }
+
+  shift(@$queue);
+
+  if ($result eq "ok") {
+    readingsBeginUpdate($hash);
+    readingsBulkUpdate($hash, "sendQueueLength", scalar(@$queue));
+    readingsBulkUpdate($hash, "sendLatency", int((gettimeofday() - $cmd->{queued}) * 1000));
+    readingsEndUpdate($hash, 1);
+  } else {
+    if ($result eq "timeout") {
+      $hash->{SEND_TIMEOUTS}++;
+    } else {
+      $hash->{SEND_DROPPED}++;
+    }
+
+    Log3 $name, 2, "$name: no success sending $cmd->{msg} ($result)";
+    readingsSingleUpdate($hash, "sendQueueLength", scalar(@$queue), 1);
+  }
+
+  SHC_SendNext($hash);
+}
+
+#####################################
+sub SHC_SendTimeout($)
+{
+  my ($hash) = @_;
+
+  SHC_SendResult($hash, "timeout");
+}
+
+#####################################
+sub SHC_SendBackoffEnd($)
+{
+  my ($hash) = @_;
+
+  $hash->{helper}{sendBackoff} = 0;
+  SHC_SendNext($hash);
 }
 
 #####################################
 # called from the global loop, when the select for hash->{FD} reports data
 sub SHC_Read($)
 {
-  # TODO: Verify if partial data handling is required for SHC
   my ($hash) = @_;
 
   my $buf = DevIo_SimpleRead($hash);
@@ -248,19 +370,55 @@ sub SHC_Read($)
 
   my $name = $hash->{NAME};
 
-  my $pandata = $hash->{PARTIAL};
+  # The data arrives in arbitrary chunks. Complete lines are processed, the
+  # remaining partial line is kept in $hash->{PARTIAL} for the next call.
+  my $pandata = defined($hash->{PARTIAL}) ? $hash->{PARTIAL} : "";
   Log3 $name, 5, "$name: SHC/RAW: $pandata/$buf";
   $pandata .= $buf;
 
-  while ($pandata =~ m/\n/) {
-    my $rmsg;
-    ($rmsg, $pandata) = split("\n", $pandata, 2);
-    $rmsg =~ s/\r//;
+  my @lines = split("\n", $pandata, -1);
+  $pandata = pop(@lines);
+
+  foreach my $rmsg (@lines) {
+    $rmsg =~ s/\r//g;
+
+    # rest of a line which was already discarded because it was too long
+    if ($hash->{PARTIAL_OVERFLOW}) {
+      $hash->{PARTIAL_OVERFLOW} = 0;
+      SHC_DiscardFragment($hash, $rmsg);
+      next;
+    }
+
+    if (length($rmsg) > $maxLineLengthSHC) {
+      SHC_DiscardFragment($hash, $rmsg);
+      next;
+    }
+
     SHC_Parse($hash, $hash, $name, $rmsg) if ($rmsg);
   }
+
+  if (length($pandata) > $maxLineLengthSHC) {
+    SHC_DiscardFragment($hash, $pandata);
+    $hash->{PARTIAL_OVERFLOW} = 1;
+    $pandata = "";
+  }
+
   $hash->{PARTIAL} = $pandata;
 }
 
+#####################################
+# Count and log data which is dropped because no line end was found.
+sub SHC_DiscardFragment($$)
+{
+  my ($hash, $fragment) = @_;
+  my $name = $hash->{NAME};
+
+  $hash->{DISCARDED_FRAGMENTS}++;
+  $hash->{DISCARDED_BYTES} += length($fragment);
+
+  Log3 $name, 2, "$name: discarding " . length($fragment) . " bytes without line end: " . substr($fragment, 0, 40) . "...";
+}
+
 #####################################
 sub SHC_Parse($$$$)
 {
@@ -275,6 +433,37 @@ sub SHC_Parse($$$$)
 
   if ($dmsg !~ m/^PKT:SID=/) {
 
+    # Answers to the command written by SHC_SendNext. Packets which don't need
+    # an acknowledge and broadcasts are sent immediately ("Sending took..."),
+    # but this is also printed for acks to received packets, so it only counts
+    # after the base station started processing the command. The same applies
+    # to the answers to EEPROM read / write commands (e.g. from "set raw").
+    if ($hash->{helper}{sendPending}) {
+      my $queue = $hash->{helper}{sendQueue};
+
+      if ($dmsg =~ m/^Processing command: \Q$queue->[0]{msg}\E/) {
+        $hash->{helper}{sendEchoed} = 1;
+      } elsif (
+        $dmsg =~ m/^Request added to queue/
+        || (
+          $hash->{helper}{sendEchoed}
+          && ( $dmsg =~ m/^Sending took/
+            || $dmsg =~ m/^EEPROM value at position/
+            || $dmsg =~ m/^Writing data/
+            || $dmsg =~ m/^Ignoring EEPROM write/)
+        )
+        )
+      {
+        SHC_SendResult($hash, "ok");
+      } elsif ($dmsg =~ m/^Warning! Request queue full/) {
+        SHC_SendResult($hash, "full");
+      } elsif ($dmsg =~ m/^CRC Error!/) {
+        SHC_SendResult($hash, "crc");
+      } elsif ($dmsg =~ m/^Unknown command/) {
+        SHC_SendResult($hash, "error");
+      }
+    }
+
     # Messages just to dipose
     if ( $dmsg =~ m/^\*\*\* Enter data/
       || $dmsg =~ m/^\*\*\* 0x/)
@@ -365,11 +554,8 @@ sub SHC_SimpleWrite(@)
   $hash->{USBDev}->write($msg) if ($hash->{USBDev});
   syswrite($hash->{DIODev}, $msg) if ($hash->{DIODev});
 
-  # Some linux installations are broken with 0.001, T01 returns no answer
-  #select(undef, undef, undef, 0.01);
-
-  # Sleep for 250 milliseconds to make sure the base station can process the command before the next is sent
-  select(undef, undef, undef, 0.25);
+  # No sleep here, all commands are paced by the send queue
+  # (see SHC_SendNext), which waits for the answer of the base station.
 }
 
 1;
@@ -417,7 +603,8 @@ sub SHC_SimpleWrite(@)
   <b>Set</b>
   <ul>
     <li>raw &lt;data&gt;<br>
-        not supported yet
+        Send the command &lt;data&gt; to the base station. It is queued like the
+        commands from the SHCdev devices.
     </li><br>
   </ul>
 
@@ -436,6 +623,20 @@ sub SHC_SimpleWrite(@)
       N/A
     </li><br>
   </ul>
+
+  <a name="SHC_Readings"></a>
+  <b>Readings</b>
+  <ul>
+    Commands from the SHCdev devices and "set raw" are queued and sent to the base station
+    one after another. If the request queue of the base station is full, the
+    command is repeated later.<br><br>
+    <li>sendQueueLength<br>
+        Number of commands waiting to be sent (including the command being sent).
+    </li><br>
+    <li>sendLatency<br>
+        Time in ms from queueing the last command until the base station accepted it.
+    </li><br>
+  </ul>
 </ul>
 
 =end html
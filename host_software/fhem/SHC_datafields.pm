@@ -58,7 +58,7 @@ sub getUInt($$$)
 {
   my ($byteArrayRef, $offset, $length_bits) = @_;
 
-  my $byte = $offset / 8;
+  my $byte = int($offset / 8);
   my $bit  = $offset % 8;
 
   my $byres_read = 0;
@@ -68,7 +68,8 @@ sub getUInt($$$)
   # read the bytes one after another, shift them to the correct position and add them
   while ($length_bits + $bit > $byres_read * 8) {
     $shiftBits = $length_bits + $bit - $byres_read * 8 - 8;
-    my $zz = @$byteArrayRef[$byte + $byres_read];
+    # bytes behind the end of the (truncated) message data are 0
+    my $zz = $$byteArrayRef[$byte + $byres_read] // 0;
 
     if ($shiftBits >= 0) {
       $val += $zz << $shiftBits;
@@ -54,9 +54,18 @@ package SHC_parser;
 
 use strict;
 use feature qw(switch);
-use XML::LibXML;
 use SHC_datafields;
 use Digest::CRC qw(crc32); # linux packet libdigest-crc-perl
+use Digest::MD5;
+use Storable qw(nstore retrieve);
+
+# The packet layout is read from the XML file only if it changed since the last
+# start. Otherwise the data field definitions are loaded from the cache file.
+my $layoutFile = "FHEM/lib/SHC_packet_layout.xml";
+my $cacheFile  = "FHEM/lib/SHC_packet_layout.cache";
+
+# Increase when the structure of the cached data changes.
+my $cacheVersion = 1;
 
 # Hash for data field definitions.
 my %dataFields = ();
@@ -82,7 +91,7 @@ my $offset = 0;
 sub new
 {
   my $class = shift;
-  init_datafield_positions();
+  init_layout();
   my $self = {
     _senderID         => 0,
     _packetCounter    => 0,
@@ -92,6 +101,7 @@ sub new
     _messageID        => 0,
     _messageName      => "",
     _messageData      => "",
+    _messageBytes     => [],
   };
   bless $self, $class;
   return $self;
@@ -221,8 +231,10 @@ sub calc_array_bits_ovr($)
 # Messages and data fields (incl. positions, length).
 sub init_datafield_positions()
 {
+  require XML::LibXML;
+
   my $x = XML::LibXML->new() or die "new on XML::LibXML failed";
-  my $d = $x->parse_file("FHEM/lib/SHC_packet_layout.xml") or die "parsing XML file failed";
+  my $d = $x->parse_file($layoutFile) or die "parsing XML file failed";
 
   for my $element ($d->findnodes("/Packet/Header/EnumValue[ID='MessageType']/Element")) {
     my $value = ($element->findnodes("Value"))[0]->textContent;
@@ -266,6 +278,52 @@ sub init_datafield_positions()
   }
 }
 
+# Load the data field definitions from the cache file if it was created from
+# the current XML file (same MD5 hash). Otherwise read the XML file and write
+# the result to the cache file for the next start.
+sub init_layout()
+{
+  open(my $fh, "<", $layoutFile) or die "opening XML file failed";
+  binmode($fh);
+  my $hash = Digest::MD5->new->addfile($fh)->hexdigest;
+  close($fh);
+
+  my $cache = eval { retrieve($cacheFile) };
+
+  if ($cache && ($cache->{version} == $cacheVersion) && ($cache->{hash} eq $hash)) {
+    %dataFields                      = %{$cache->{dataFields}};
+    %messageTypeID2messageTypeName   = %{$cache->{messageTypeID2messageTypeName}};
+    %messageTypeName2messageTypeID   = %{$cache->{messageTypeName2messageTypeID}};
+    %messageGroupID2messageGroupName = %{$cache->{messageGroupID2messageGroupName}};
+    %messageGroupName2messageGroupID = %{$cache->{messageGroupName2messageGroupID}};
+    %messageID2messageName           = %{$cache->{messageID2messageName}};
+    %messageName2messageID           = %{$cache->{messageName2messageID}};
+    %messageID2bits                  = %{$cache->{messageID2bits}};
+    return;
+  }
+
+  init_datafield_positions();
+
+  # The cache is optional, so ignore errors (e.g. if the directory is not writable).
+  eval {
+    nstore(
+      {
+        version                         => $cacheVersion,
+        hash                            => $hash,
+        dataFields                      => \%dataFields,
+        messageTypeID2messageTypeName   => \%messageTypeID2messageTypeName,
+        messageTypeName2messageTypeID   => \%messageTypeName2messageTypeID,
+        messageGroupID2messageGroupName => \%messageGroupID2messageGroupName,
+        messageGroupName2messageGroupID => \%messageGroupName2messageGroupID,
+        messageID2messageName           => \%messageID2messageName,
+        messageName2messageID           => \%messageName2messageID,
+        messageID2bits                  => \%messageID2bits
+      },
+      $cacheFile
+    );
+  };
+}
+
 sub parse
 {
   my ($self, $msg) = @_;
@@ -292,6 +350,9 @@ sub parse
     $self->{_messageGroupID} = $4;
     $self->{_messageID}      = $5;
     $self->{_messageData}    = $6;
+
+    # decode the message data once for all following getField calls
+    $self->{_messageBytes} = [map hex, $self->{_messageData} =~ /(..)/g];
   }
 
   else {
@@ -359,10 +420,9 @@ sub getField
 
   my $obj = $dataFields{$self->{_messageGroupID} . "-" . $self->{_messageID} . "-" . $fieldName};
 
-  # add 256 "empty" bytes to have enough data in the array because the message may be truncated
-  my @tmpArray = map hex("0x$_"), ($self->{_messageData} . ("00" x 256)) =~ /(..)/g;
-
-  return $obj->getValue(\@tmpArray, $index);
+  # The message may be truncated (trailing 0 bytes are not sent), but reading
+  # bytes behind the end of the array returns 0 (see SHC_util::getUInt).
+  return $obj->getValue($self->{_messageBytes}, $index);
 }
 
 sub initPacket
@@ -0,0 +1,130 @@
+#!/usr/bin/perl -w
+
+##########################################################################
+# This is a benchmark program for the smarthomatic module for FHEM.
+#
+# Copyright (c) 2014..2019 Uwe Freese
+#
+# You can find smarthomatic at www.smarthomatic.org.
+# You can find FHEM at www.fhem.de.
+#
+# This file is free software: you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# This file is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+# Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+##########################################################################
+# Measures the time SHC_parser needs per received packet. All PKT lines of
+# a base station log are parsed and the same data fields are read as in
+# SHCdev_Parse (37_SHCdev.pm).
+#
+# Usage: perl -I. SHC_parser_bench.pl [logfile] [--legacy]
+#
+# The default log file is ../testdata/shc_basestation.log. With --legacy,
+# getField converts the message data to a byte array (padded with 256 zero
+# bytes) on every call, as SHC_parser did before the byte array was cached
+# in parse(). This allows to compare both versions on the same log.
+##########################################################################
+
+use strict;
+use Time::HiRes qw(time);
+use SHC_parser;
+
+my $logfile = "../testdata/shc_basestation.log";
+my $legacy  = 0;
+
+foreach (@ARGV) {
+  if ($_ eq "--legacy") {
+    $legacy = 1;
+  } else {
+    $logfile = $_;
+  }
+}
+
+# Data fields read by SHCdev_Parse per message ("Name" or ["Name", array length]).
+my %fieldsRead = (
+  "Generic-DeviceInfo"                  => ["DeviceType", "VersionMajor", "VersionMinor", "VersionPatch", "VersionHash"],
+  "Generic-HardwareError"               => ["ErrorCode"],
+  "Generic-BatteryStatus"               => ["Percentage"],
+  "GPIO-DigitalPortTimeout"             => [["On", 8], ["TimeoutSec", 8]],
+  "GPIO-DigitalPort"                    => [["On", 8]],
+  "GPIO-AnalogPort"                     => [["On", 8], ["Voltage", 8]],
+  "Weather-Temperature"                 => ["Temperature"],
+  "Weather-HumidityTemperature"         => ["Humidity", "Temperature"],
+  "Weather-BarometricPressureTemperature" => ["BarometricPressure", "Temperature"],
+  "Weather-Humidity"                    => ["Humidity"],
+  "Environment-Brightness"              => ["Brightness"],
+  "Environment-Distance"                => ["Distance"],
+  "Environment-ParticulateMatter"       => ["TypicalParticleSize", ["Size", 5], ["MassConcentration", 5], ["NumberConcentration", 5]],
+  "Controller-MenuSelection"            => [["Index", 16]],
+  "Audio-Tone"                          => ["Tone"],
+  "Audio-Melody"                        => ["Repeat", "AutoReverse", ["Time", 25], ["Effect", 25], ["Tone", 25]],
+  "Dimmer-Brightness"                   => ["Brightness"],
+  "Dimmer-Color"                        => ["Color"],
+  "Dimmer-ColorAnimation"               => ["Repeat", "AutoReverse", ["Time", 10], ["Color", 10]],
+  "Display-Backlight"                   => ["Mode", "AutoTimeoutSec"],
+);
+
+my $parser = new SHC_parser();
+
+if ($legacy) {
+  my $getField = \&SHC_parser::getField;
+
+  no warnings 'redefine';
+  *SHC_parser::getField = sub {
+    my ($self) = @_;
+    $self->{_messageBytes} = [map hex("0x$_"), ($self->{_messageData} . ("00" x 256)) =~ /(..)/g];
+    return $getField->(@_);
+  };
+}
+
+open(my $fh, "<", $logfile) or die "Can't open $logfile: $!";
+my @lines = grep { /^PKT:/ } <$fh>;
+close($fh);
+
+my $packets = 0;
+my $fields  = 0;
+my %timePerMessage  = ();
+my %countPerMessage = ();
+
+my $start = time();
+
+foreach my $line (@lines) {
+  my $t = time();
+
+  next if (!defined $parser->parse($line));
+
+  my $key = $parser->getMessageGroupName() . "-" . $parser->getMessageName();
+
+  foreach my $field (@{$fieldsRead{$key} || []}) {
+    my ($name, $length) = ref($field) ? @$field : ($field, 1);
+
+    for (my $i = 0; $i < $length; $i++) {
+      my $value = $parser->getField($name, $i);
+      $fields++;
+    }
+  }
+
+  $packets++;
+  $timePerMessage{$key} += time() - $t;
+  $countPerMessage{$key}++;
+}
+
+my $duration = time() - $start;
+
+printf("%s: %d PKT lines, %d packets parsed, %d fields read%s\n",
+  $logfile, scalar(@lines), $packets, $fields, $legacy ? " (legacy getField)" : "");
+printf("%.1f us per packet, %.0f packets/s\n\n", $duration / $packets * 1e6, $packets / $duration);
+
+printf("%-40s %8s %12s\n", "Message", "Packets", "us/packet");
+
+foreach my $key (sort { $timePerMessage{$b} <=> $timePerMessage{$a} } keys %timePerMessage) {
+  printf("%-40s %8d %12.1f\n", $key, $countPerMessage{$key}, $timePerMessage{$key} / $countPerMessage{$key} * 1e6);
+}
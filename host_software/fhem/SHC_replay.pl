@@ -0,0 +1,179 @@
+#!/usr/bin/perl -w
+
+##########################################################################
+# This is a benchmark program for the smarthomatic module for FHEM.
+#
+# Copyright (c) 2014..2019 Uwe Freese
+#
+# You can find smarthomatic at www.smarthomatic.org.
+# You can find FHEM at www.fhem.de.
+#
+# This file is free software: you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# This file is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+# Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+##########################################################################
+# Replays a captured log of the base station (PKT lines, "Detected" lines,
+# garbage, ...) through the complete host pipeline: SHC_Read (37_SHC.pm)
+# splits the data into lines, SHC_Parse checks the CRC and SHCdev_Parse
+# (37_SHCdev.pm) decodes the packets and updates the readings. FHEM itself
+# is replaced by the stubs in the directory "stub".
+#
+# Usage: perl SHC_replay.pl [options] [logfile]
+#
+#   --repeat <n>   replay the log n times (default 1)
+#   --chunk <n>    pass the log in chunks of n bytes to SHC_Read (default 256)
+#   --verbose <n>  print log messages up to level n
+#
+# The default log file is ../testdata/shc_basestation.log. Like the parser
+# test, it needs the packet layout in FHEM/lib/SHC_packet_layout.xml.
+##########################################################################
+
+use strict;
+use FindBin;
+use lib "$FindBin::Bin", "$FindBin::Bin/stub";
+use Time::HiRes qw(time);
+
+use FHEM_stub;
+use DevIo;
+
+my $logfile = "../testdata/shc_basestation.log";
+my $repeat  = 1;
+my $chunk   = 256;
+
+while (@ARGV) {
+  my $arg = shift(@ARGV);
+
+  if ($arg eq "--repeat") {
+    $repeat = shift(@ARGV);
+  } elsif ($arg eq "--chunk") {
+    $chunk = shift(@ARGV);
+  } elsif ($arg eq "--verbose") {
+    $main::logLevel = shift(@ARGV);
+  } else {
+    $logfile = $arg;
+  }
+}
+
+die "FHEM/lib/SHC_packet_layout.xml not found, please copy lib/SHC_packet_layout.xml there\n"
+  if (!-f "FHEM/lib/SHC_packet_layout.xml");
+
+# current memory usage (resident set size) in kB, if available
+sub memoryUsage()
+{
+  open(my $fh, "<", "/proc/self/status") or return undef;
+
+  while (<$fh>) {
+    return $1 if (m/^VmRSS:\s+(\d+)/);
+  }
+
+  return undef;
+}
+
+my $memStart = memoryUsage();
+
+LoadModule("$FindBin::Bin/37_SHC.pm",    "SHC");
+LoadModule("$FindBin::Bin/37_SHCdev.pm", "SHCdev");
+CommandDefine(undef, "shc SHC /dev/null");
+
+my $shc = $main::defs{shc};
+
+# count CRC errors of PKT lines with data separately from PKT lines without CRC (Ack)
+@main::logFilter = ("CRC Error .* PKT:.*;MD=", "CRC Error", "Parser error");
+
+open(my $fh, "<", $logfile) or die "Can't open $logfile: $!";
+binmode($fh);
+my $log = do { local $/; <$fh> };
+close($fh);
+
+my $lines    = () = $log =~ m/\n/g;
+my $pktLines = () = $log =~ m/^PKT:/mg;
+
+# Measure the time of each dispatched message by wrapping Dispatch.
+my %dispatchTime  = ();
+my %dispatchCount = ();
+my $dispatchTotal = 0;
+my $dispatch = \&main::Dispatch;
+
+my $nameParser = new SHC_parser();
+
+{
+  no warnings "redefine";
+
+  *main::Dispatch = sub($$$) {
+    my $t   = time();
+    my $ret = $dispatch->(@_);
+    $t = time() - $t;
+
+    my $key = "other";
+
+    if ($nameParser->parse($_[1])) {
+      $key = $nameParser->getMessageTypeName() . " " . $nameParser->getMessageGroupName() . "." . $nameParser->getMessageName();
+    }
+
+    $dispatchTime{$key} += $t;
+    $dispatchCount{$key}++;
+    $dispatchTotal += $t;
+
+    return $ret;
+  };
+}
+
+my $memLoaded = memoryUsage();
+my @memAfterRun = ();
+my $readTotal = 0;
+
+for (my $r = 0; $r < $repeat; $r++) {
+  for (my $i = 0; $i < length($log); $i += $chunk) {
+    push(@main::devIoReadQueue, substr($log, $i, $chunk));
+  }
+
+  my $t = time();
+  SHC_Read($shc) while (@main::devIoReadQueue);
+  $readTotal += time() - $t;
+
+  push(@memAfterRun, memoryUsage());
+}
+
+my $totalLines = $lines * $repeat;
+
+printf("%s: %d lines, %d PKT lines, replayed %d times in chunks of %d bytes\n\n", $logfile, $lines, $pktLines, $repeat, $chunk);
+
+printf("Total time:             %8.3f s (%.0f lines/s)\n", $readTotal, $totalLines / $readTotal);
+printf("  SHCdev_Parse:         %8.3f s (%.1f us per dispatched packet)\n", $dispatchTotal,
+  $dispatchTotal / (sum(values %dispatchCount) || 1) * 1e6);
+printf("  SHC_Read/SHC_Parse:   %8.3f s (%.1f us per line)\n\n", $readTotal - $dispatchTotal,
+  ($readTotal - $dispatchTotal) / $totalLines * 1e6);
+
+printf("Dispatched packets:     %8d\n", sum(values %dispatchCount));
+printf("CRC errors:             %8d\n", $main::logCount{$main::logFilter[0]} || 0);
+printf("PKT lines without CRC:  %8d\n", ($main::logCount{$main::logFilter[1]} || 0) - ($main::logCount{$main::logFilter[0]} || 0));
+printf("Parser errors:          %8d\n", $main::logCount{$main::logFilter[2]} || 0);
+printf("Discarded fragments:    %8d\n", $shc->{DISCARDED_FRAGMENTS} || 0);
+printf("Defined devices:        %8d\n\n", scalar(grep { $main::defs{$_}{TYPE} eq "SHCdev" } keys %main::defs));
+
+if (defined($memStart)) {
+  printf("Memory (RSS): %d kB at start, %d kB after loading, %s kB after each run\n\n",
+    $memStart, $memLoaded, join(", ", @memAfterRun));
+}
+
+printf("%-50s %8s %12s\n", "Message", "Packets", "us/packet");
+
+foreach my $key (sort { $dispatchTime{$b} <=> $dispatchTime{$a} } keys %dispatchTime) {
+  printf("%-50s %8d %12.1f\n", $key, $dispatchCount{$key}, $dispatchTime{$key} / $dispatchCount{$key} * 1e6);
+}
+
+sub sum
+{
+  my $s = 0;
+  $s += $_ foreach (@_);
+  return $s;
+}
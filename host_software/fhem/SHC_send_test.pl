@@ -0,0 +1,158 @@
+#!/usr/bin/perl -w
+
+##########################################################################
+# This is a test program for the smarthomatic module for FHEM.
+#
+# Copyright (c) 2014..2019 Uwe Freese
+#
+# You can find smarthomatic at www.smarthomatic.org.
+# You can find FHEM at www.fhem.de.
+#
+# This file is free software: you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# This file is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+# Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+##########################################################################
+# Tests the send queue of 37_SHC.pm: commands are written to the stub of
+# the serial port and the answers of the base station (as printed by the
+# firmware) are replayed through SHC_Read. FHEM itself is replaced by the
+# stubs in the directory "stub", timers are only fired by the test.
+#
+# Usage: perl SHC_send_test.pl
+##########################################################################
+
+use strict;
+use FindBin;
+use lib "$FindBin::Bin", "$FindBin::Bin/stub";
+
+use FHEM_stub;
+use DevIo;
+
+LoadModule("$FindBin::Bin/37_SHC.pm", "SHC");
+CommandDefine(undef, "shc SHC /dev/null");
+
+my $shc = $main::defs{shc};
+my $res = 0;
+
+# commands as created by SHC_parser->getSendString()
+my $cmdBroadcast = "cfff0040a0000b7d4e2f6";
+my $cmdSet       = "c03d0010102ff71e9b4c5";
+my $cmdSetGet    = "c03d0020102ff1c3f0a77";
+
+sub check($$$)
+{
+  my ($desc, $assumed, $returned) = @_;
+
+  $assumed  = "undef" if (!defined($assumed));
+  $returned = "undef" if (!defined($returned));
+
+  printf("Test %s. Assumed value: %s, returned value: %s", $desc, $assumed, $returned);
+
+  if ($assumed ne $returned) {
+    $res = 1;
+    print " --> NOK\n";
+  } else {
+    print " --> OK\n";
+  }
+}
+
+# Pass the lines printed by the base station to SHC_Read.
+sub answer(@)
+{
+  push(@main::devIoReadQueue, join("", map { "$_\r\n" } @_));
+  SHC_Read($shc) while (@main::devIoReadQueue);
+}
+
+# Call the functions of the timers with the given name, like FHEM does when they are due.
+sub fireTimers($)
+{
+  my ($fn) = @_;
+  my @due = grep { $_->[1] eq $fn } @main::internalTimers;
+
+  @main::internalTimers = grep { $_->[1] ne $fn } @main::internalTimers;
+
+  no strict "refs";
+  &{$_->[1]}($_->[2]) foreach (@due);
+}
+
+sub written()
+{
+  my $w = join(",", map { my $s = $_; $s =~ s/\r$//; $s } @main::devIoWritten);
+  @main::devIoWritten = ();
+  return $w;
+}
+
+sub pending()
+{
+  return scalar(@{$shc->{helper}{sendQueue} || []});
+}
+
+sub timeoutTimers()
+{
+  return scalar(grep { $_->[1] eq "SHC_SendTimeout" } @main::internalTimers);
+}
+
+# A broadcast is sent by the base station immediately without using its request
+# queue. Only "Sending took" follows the command echo.
+SHC_Write($shc, $cmdBroadcast);
+SHC_Write($shc, $cmdSet);
+check("only the first command is written", $cmdBroadcast, written());
+
+answer("Processing command: $cmdBroadcast", "Sending broadcast request without using queue.", "Sending took 14ms");
+check("broadcast accepted after Sending took", 1, pending());
+check("next command written", $cmdSet, written());
+check("no timeout counted for the broadcast", undef, $shc->{SEND_TIMEOUTS});
+check("one timeout timer running", 1, timeoutTimers());
+
+# An ack to a received packet printed before the command is processed doesn't
+# complete the command.
+answer("PKT:SID=61;PC=1234;MT=8;MGID=1;MID=1;MD=80;", "Sending took 9ms");
+check("Sending took before the command echo ignored", 1, pending());
+
+answer("Processing command: $cmdSet", "Request added to queue (32 bytes packet).");
+check("request accepted", 0, pending());
+check("sendLatency set", 1, defined(ReadingsVal("shc", "sendLatency", undef)) ? 1 : 0);
+check("no timeout timer running", 0, timeoutTimers());
+
+# A full request queue of the base station delays the command.
+SHC_Write($shc, $cmdSetGet);
+written();
+answer("Processing command: $cmdSetGet", "Warning! Request queue full. Packet will not be sent.");
+check("command kept after queue full", 1, pending());
+check("retry counted", 1, $shc->{SEND_RETRIES});
+check("nothing written during backoff", "", written());
+
+fireTimers("SHC_SendBackoffEnd");
+check("command repeated after backoff", $cmdSetGet, written());
+answer("Processing command: $cmdSetGet", "Request added to queue (32 bytes packet).");
+check("repeated request accepted", 0, pending());
+
+# "set raw" uses the send queue, too.
+SHC_Write($shc, $cmdSet);
+written();
+SHC_Set($shc, "shc", "raw", "r05");
+check("set raw waits for the previous command", "", written());
+
+answer("Processing command: $cmdSet", "Request added to queue (32 bytes packet).");
+check("set raw written", "r05", written());
+
+answer("Processing command: r05", "EEPROM value at position 0x5 is 0x1f.");
+check("EEPROM read accepted", 0, pending());
+
+# Without any answer, the command is dropped after the timeout.
+SHC_Write($shc, $cmdSet);
+written();
+fireTimers("SHC_SendTimeout");
+check("command dropped after timeout", 0, pending());
+check("timeout counted", 1, $shc->{SEND_TIMEOUTS});
+
+print "\nOverall result: " . ($res ? "NOK (at least one test failed)" : "OK (all tests ok)") . "\n";
+exit($res);
@@ -0,0 +1,70 @@
+##########################################################################
+# Minimal replacement of FHEM's DevIo.pm for SHC_replay.pl. The data read
+# from the "serial port" is taken from @main::devIoReadQueue, written data
+# is collected in @main::devIoWritten.
+#
+# Copyright (c) 2014..2019 Uwe Freese
+#
+# You can find smarthomatic at www.smarthomatic.org.
+# You can find FHEM at www.fhem.de.
+#
+# This file is free software: you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# This file is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+# Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+##########################################################################
+
+package main;
+
+use strict;
+use warnings;
+
+use vars qw(@devIoReadQueue @devIoWritten);
+
+sub DevIo_OpenDev($$$)
+{
+  my ($hash, $reopen, $initfn) = @_;
+
+  $hash->{STATE}  = "opened";
+  $hash->{USBDev} = bless({}, "DevIo_StubPort");
+  no strict "refs";
+  &$initfn($hash) if ($initfn);
+  return undef;
+}
+
+sub DevIo_CloseDev($)
+{
+  my ($hash) = @_;
+  $hash->{STATE} = "closed";
+}
+
+sub DevIo_SimpleRead($)
+{
+  return shift(@devIoReadQueue);
+}
+
+sub DevIo_Disconnected($)
+{
+  my ($hash) = @_;
+  $hash->{STATE} = "disconnected";
+}
+
+# Replacement of the serial port object, collects the written data.
+package DevIo_StubPort;
+
+sub write($$)
+{
+  my ($port, $data) = @_;
+  push(@main::devIoWritten, $data);
+  return length($data);
+}
+
+1;
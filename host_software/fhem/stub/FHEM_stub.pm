@@ -0,0 +1,181 @@
+##########################################################################
+# Minimal replacement of the fhem.pl functions used by the smarthomatic
+# modules, so that 37_SHC.pm and 37_SHCdev.pm can be run without FHEM
+# (see SHC_replay.pl). Only the behaviour needed by these modules is
+# implemented: readings are stored in the device hash, log messages are
+# counted and optionally printed, timers are only remembered.
+#
+# Copyright (c) 2014..2019 Uwe Freese
+#
+# You can find smarthomatic at www.smarthomatic.org.
+# You can find FHEM at www.fhem.de.
+#
+# This file is free software: you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# This file is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+# Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+##########################################################################
+
+package main;
+
+use strict;
+use warnings;
+
+use vars qw(%defs %modules %attr $readingFnAttributes $reread_active $init_done);
+use vars qw(%logCount $logLevel @logFilter @internalTimers);
+
+$readingFnAttributes = "event-on-change-reading event-on-update-reading stateFormat";
+$reread_active       = 0;
+$init_done           = 1;
+$logLevel            = 0;    # print log messages up to this level
+@logFilter           = ();   # count log messages matching these regular expressions
+
+# Load a FHEM module and call its Initialize function.
+sub LoadModule($$)
+{
+  my ($file, $type) = @_;
+
+  require $file;
+
+  no strict "refs";
+  $modules{$type} = {};
+  &{"${type}_Initialize"}($modules{$type});
+}
+
+# Define a device like the FHEM "define" command.
+sub CommandDefine($$)
+{
+  my ($cl, $def) = @_;
+  my ($name, $type, @args) = split("[ \t]+", $def);
+
+  my $hash = {NAME => $name, TYPE => $type, DEF => join(" ", @args), STATE => "???", READINGS => {}};
+  $defs{$name} = $hash;
+
+  no strict "refs";
+  my $ret = &{$modules{$type}{DefFn}}($hash, $def);
+  return $ret;
+}
+
+sub Log3($$$)
+{
+  my ($dev, $loglevel, $text) = @_;
+
+  $logCount{$loglevel}++;
+
+  foreach my $filter (@logFilter) {
+    $logCount{$filter}++ if ($text =~ m/$filter/);
+  }
+
+  print "$loglevel: $text\n" if ($loglevel <= $logLevel);
+}
+
+sub AttrVal($$$)
+{
+  my ($d, $n, $default) = @_;
+
+  return $attr{$d}{$n} if (defined($attr{$d}) && defined($attr{$d}{$n}));
+  return $default;
+}
+
+sub ReadingsVal($$$)
+{
+  my ($d, $n, $default) = @_;
+
+  return $defs{$d}{READINGS}{$n}{VAL} if (defined($defs{$d}) && defined($defs{$d}{READINGS}{$n}));
+  return $default;
+}
+
+sub TimeNow()
+{
+  my @t = localtime();
+  return sprintf("%04d-%02d-%02d %02d:%02d:%02d", $t[5] + 1900, $t[4] + 1, $t[3], $t[2], $t[1], $t[0]);
+}
+
+sub readingsBeginUpdate($)
+{
+  my ($hash) = @_;
+  $hash->{".updateTime"} = TimeNow();
+}
+
+sub readingsBulkUpdate($$$@)
+{
+  my ($hash, $reading, $value) = @_;
+
+  $hash->{READINGS}{$reading}{VAL}  = $value;
+  $hash->{READINGS}{$reading}{TIME} = $hash->{".updateTime"};
+  $hash->{STATE} = $value if ($reading eq "state");
+}
+
+sub readingsEndUpdate($$)
+{
+  my ($hash, $dotrigger) = @_;
+  delete $hash->{".updateTime"};
+}
+
+sub readingsSingleUpdate($$$$)
+{
+  my ($hash, $reading, $value, $dotrigger) = @_;
+
+  readingsBeginUpdate($hash);
+  readingsBulkUpdate($hash, $reading, $value);
+  readingsEndUpdate($hash, $dotrigger);
+}
+
+sub InternalTimer($$$;$)
+{
+  my ($tim, $fn, $arg, $waitIfInitNotDone) = @_;
+  push(@internalTimers, [$tim, $fn, $arg]);
+}
+
+sub RemoveInternalTimer($;$)
+{
+  my ($arg, $fn) = @_;
+  @internalTimers = grep { !(($_->[2] eq $arg) && (!defined($fn) || ($_->[1] eq $fn))) } @internalTimers;
+}
+
+sub AssignIoPort($;$)
+{
+  my ($hash, $proposed) = @_;
+
+  foreach my $d (sort keys %defs) {
+    if ($defs{$d}{Clients} && ($defs{$d}{Clients} =~ m/:$hash->{TYPE}:/)) {
+      $hash->{IODev} = $defs{$d};
+      return;
+    }
+  }
+}
+
+# Pass a message from the IO device to the matching logical module (like
+# fhem.pl, but without MatchList handling). Unknown devices are defined
+# automatically, as autocreate does.
+sub Dispatch($$$)
+{
+  my ($hash, $dmsg, $addvals) = @_;
+
+  foreach my $type (sort keys %modules) {
+    next if (!$modules{$type}{Match} || ($dmsg !~ m/$modules{$type}{Match}/));
+
+    no strict "refs";
+    my @found = &{$modules{$type}{ParseFn}}($hash, $dmsg);
+
+    if (@found && $found[0] && ($found[0] =~ m/^UNDEFINED ([^ ]+) (.*)$/)) {
+      CommandDefine(undef, "$1 $2");
+      @found = &{$modules{$type}{ParseFn}}($hash, $dmsg);
+    }
+
+    return \@found;
+  }
+
+  Log3 $hash->{NAME}, 3, "$hash->{NAME}: Unknown code $dmsg, help me!";
+  return undef;
+}
+
+1;
@@ -0,0 +1,35 @@
+##########################################################################
+# Minimal replacement of FHEM's SetExtensions.pm for SHC_replay.pl.
+#
+# Copyright (c) 2014..2019 Uwe Freese
+#
+# You can find smarthomatic at www.smarthomatic.org.
+# You can find FHEM at www.fhem.de.
+#
+# This file is free software: you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# This file is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+# Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+##########################################################################
+
+package main;
+
+use strict;
+use warnings;
+
+sub SetExtensions($$@)
+{
+  my ($hash, $list, $name, $cmd, @a) = @_;
+
+  return "Unknown argument $cmd, choose one of $list";
+}
+
+1;
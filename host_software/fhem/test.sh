@@ -1,3 +1,4 @@
 #!/bin/bash
 
 perl -I. SHC_parser_test.pl
+perl -I. SHC_send_test.pl
@@ -0,0 +1,286 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2013..2019 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Thin Perl binding for libshcpacket. The SHC_parser compatible methods are
+// implemented in lib/SHCPacket.pm on top of these functions.
+
+#include "EXTERN.h"
+#include "perl.h"
+#include "XSUB.h"
+
+#include "shcpacket.h"
+
+typedef struct {
+	shc_packet_t pkt;
+	bool send_mode; // set by init_packet, cleared by parse
+} shcpacket_obj_t;
+
+typedef shcpacket_obj_t * SHCPacket;
+
+static const shc_field_t * find_field(SHCPacket self, const char * name)
+{
+	return shc_find_field(self->pkt.message, name);
+}
+
+MODULE = SHCPacket		PACKAGE = SHCPacket
+
+PROTOTYPES: DISABLE
+
+SHCPacket
+new(class)
+		const char * class
+	CODE:
+		Newxz(RETVAL, 1, shcpacket_obj_t);
+	OUTPUT:
+		RETVAL
+
+void
+DESTROY(self)
+		SHCPacket self
+	CODE:
+		Safefree(self);
+
+int
+parse_line(self, line, check_crc = 0)
+		SHCPacket self
+		const char * line
+		int check_crc
+	CODE:
+		self->send_mode = false;
+		RETVAL = shc_parse_line(line, check_crc, &self->pkt);
+	OUTPUT:
+		RETVAL
+
+bool
+send_mode(self)
+		SHCPacket self
+	CODE:
+		RETVAL = self->send_mode;
+	OUTPUT:
+		RETVAL
+
+unsigned int
+sender_id(self)
+		SHCPacket self
+	CODE:
+		RETVAL = self->pkt.sender_id;
+	OUTPUT:
+		RETVAL
+
+unsigned long
+packet_counter(self)
+		SHCPacket self
+	CODE:
+		RETVAL = self->pkt.packet_counter;
+	OUTPUT:
+		RETVAL
+
+unsigned int
+message_type_id(self)
+		SHCPacket self
+	CODE:
+		RETVAL = self->pkt.message_type;
+	OUTPUT:
+		RETVAL
+
+const char *
+message_type_name(self)
+		SHCPacket self
+	CODE:
+		RETVAL = shc_message_type_names[self->pkt.message_type];
+	OUTPUT:
+		RETVAL
+
+SV *
+message_group_id(self)
+		SHCPacket self
+	CODE:
+		RETVAL = self->pkt.has_message ? newSVuv(self->pkt.message_group_id) : &PL_sv_undef;
+	OUTPUT:
+		RETVAL
+
+SV *
+message_id(self)
+		SHCPacket self
+	CODE:
+		RETVAL = self->pkt.has_message ? newSVuv(self->pkt.message_id) : &PL_sv_undef;
+	OUTPUT:
+		RETVAL
+
+const char *
+message_group_name(self)
+		SHCPacket self
+	CODE:
+		RETVAL = self->pkt.message ? self->pkt.message->message_group_name : NULL;
+	OUTPUT:
+		RETVAL
+
+const char *
+message_name(self)
+		SHCPacket self
+	CODE:
+		RETVAL = self->pkt.message ? self->pkt.message->name : NULL;
+	OUTPUT:
+		RETVAL
+
+SV *
+get_field(self, name, index = 0)
+		SHCPacket self
+		const char * name
+		unsigned int index
+	PREINIT:
+		const shc_field_t * field;
+		uint8_t bytes[SHC_DATA_BYTES];
+	CODE:
+		field = find_field(self, name);
+
+		if (field == NULL)
+		{
+			RETVAL = &PL_sv_undef;
+		}
+		else if (field->type == SHC_FIELD_BYTEARRAY)
+		{
+			uint8_t len = shc_get_bytes(&self->pkt, field, bytes);
+			RETVAL = newSVpvn((const char *)bytes, len);
+		}
+		else if (field->type == SHC_FIELD_FLOAT)
+		{
+			RETVAL = newSVnv(shc_get_float(&self->pkt, field, index));
+		}
+		else if (field->type == SHC_FIELD_ENUM)
+		{
+			// like SHC_parser, unknown values are returned as undef
+			const char * s = shc_enum_name(field, shc_get_value(&self->pkt, field, index));
+			RETVAL = s ? newSVpv(s, 0) : &PL_sv_undef;
+		}
+		else
+		{
+			RETVAL = newSViv(shc_get_value(&self->pkt, field, index));
+		}
+	OUTPUT:
+		RETVAL
+
+bool
+init_packet(self, message_group_name, message_name, message_type_name)
+		SHCPacket self
+		const char * message_group_name
+		const char * message_name
+		const char * message_type_name
+	PREINIT:
+		const shc_message_t * message;
+		int message_type;
+	CODE:
+		message = shc_find_message_by_name(message_group_name, message_name);
+		message_type = shc_find_message_type(message_type_name);
+		RETVAL = (message != NULL) && (message_type >= 0);
+
+		if (RETVAL)
+		{
+			shc_init_packet(&self->pkt, message, message_type);
+			self->send_mode = true;
+		}
+	OUTPUT:
+		RETVAL
+
+bool
+set_field(self, name, value, index = 0)
+		SHCPacket self
+		const char * name
+		SV * value
+		unsigned int index
+	PREINIT:
+		const shc_field_t * field;
+		int64_t val;
+		STRLEN len;
+		const char * s;
+	CODE:
+		field = find_field(self, name);
+		RETVAL = field != NULL;
+
+		if (!RETVAL)
+		{
+			// unknown field
+		}
+		else if (field->type == SHC_FIELD_BYTEARRAY)
+		{
+			s = SvPV(value, len);
+			shc_set_bytes(&self->pkt, field, (const uint8_t *)s, len > SHC_DATA_BYTES ? SHC_DATA_BYTES : len);
+		}
+		else if (field->type == SHC_FIELD_FLOAT)
+		{
+			shc_set_float(&self->pkt, field, index, SvNV(value));
+		}
+		else if ((field->type == SHC_FIELD_ENUM) && !looks_like_number(value))
+		{
+			RETVAL = shc_enum_value(field, SvPV_nolen(value), &val);
+
+			if (RETVAL)
+				shc_set_value(&self->pkt, field, index, val);
+		}
+		else
+		{
+			shc_set_value(&self->pkt, field, index, SvIV(value));
+		}
+	OUTPUT:
+		RETVAL
+
+SV *
+data(self)
+		SHCPacket self
+	PREINIT:
+		char buf[SHC_DATA_BYTES * 2 + 1];
+	CODE:
+		shc_format_data(&self->pkt, buf, sizeof(buf));
+		RETVAL = newSVpv(buf, 0);
+	OUTPUT:
+		RETVAL
+
+SV *
+command(self, receiver_id, aes_key_nr = 0)
+		SHCPacket self
+		unsigned int receiver_id
+		unsigned int aes_key_nr
+	PREINIT:
+		char buf[32 + SHC_DATA_BYTES * 2];
+	CODE:
+		shc_format_command(&self->pkt, receiver_id, aes_key_nr, buf, sizeof(buf));
+		RETVAL = newSVpv(buf, 0);
+	OUTPUT:
+		RETVAL
+
+SV *
+json(self)
+		SHCPacket self
+	PREINIT:
+		char buf[4096];
+	CODE:
+		shc_format_json(&self->pkt, buf, sizeof(buf));
+		RETVAL = newSVpv(buf, 0);
+	OUTPUT:
+		RETVAL
+
+SV *
+text(self)
+		SHCPacket self
+	PREINIT:
+		char buf[4096];
+	CODE:
+		shc_format_text(&self->pkt, buf, sizeof(buf));
+		RETVAL = newSVpv(buf, 0);
+	OUTPUT:
+		RETVAL
@@ -0,0 +1,140 @@
+##########################################################################
+# Perl binding for libshcpacket.
+#
+# Copyright (c) 2014..2019 Uwe Freese
+#
+# You can find smarthomatic at www.smarthomatic.org.
+#
+# This file is free software: you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# This file is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+# Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+##########################################################################
+# SHCPacket provides the same methods as SHC_parser, so it can be used
+# as drop-in replacement:
+#
+# my $parser = new SHCPacket();
+# $parser->parse("PKT:SID=22;...");
+# $val = $parser->getField("Temperature");
+#
+# $parser->initPacket("PowerSwitch", "SwitchState", "Set");
+# $parser->setField("PowerSwitch", "SwitchState", "TimeoutSec", 8);
+# $str = $parser->getSendString($receiverID);
+#
+# Additionally, the C functions are available directly, e.g.
+# $parser->parse_line($line, 1) (returns 0 if ok, 2 if the CRC is wrong),
+# $parser->json() and $parser->text().
+##########################################################################
+
+package SHCPacket;
+
+use strict;
+use XSLoader;
+
+our $VERSION = '1.0';
+
+XSLoader::load('SHCPacket', $VERSION);
+
+use constant {
+  OK              => 0,
+  ERR_FORMAT      => 1,
+  ERR_CRC         => 2,
+  UNKNOWN_MESSAGE => 3
+};
+
+# Parse a received packet. Like SHC_parser, the CRC is not checked and
+# only packets with message data are accepted.
+sub parse
+{
+  my ($self, $msg) = @_;
+
+  return undef if ($self->parse_line($msg, 0) == ERR_FORMAT);
+  return undef if (!defined $self->message_group_id());
+
+  return 1;
+}
+
+sub getSenderID
+{
+  my ($self) = @_;
+  return $self->sender_id();
+}
+
+sub getPacketCounter
+{
+  my ($self) = @_;
+  return $self->packet_counter();
+}
+
+sub getMessageTypeName
+{
+  my ($self) = @_;
+  return $self->message_type_name();
+}
+
+sub getMessageGroupName
+{
+  my ($self) = @_;
+  return $self->message_group_name();
+}
+
+sub getMessageName
+{
+  my ($self) = @_;
+  return $self->message_name();
+}
+
+sub getMessageData
+{
+  my ($self) = @_;
+
+  my $res = $self->data();
+
+  if ($self->send_mode()) {
+    $res = uc($res);
+
+    # strip trailing zeros (pairwise)
+    $res =~ s/(00)+$//;
+  }
+
+  return $res;
+}
+
+sub getField
+{
+  my ($self, $fieldName, $index) = @_;
+
+  return $self->get_field($fieldName, defined $index ? $index : 0);
+}
+
+sub initPacket
+{
+  my ($self, $messageGroupName, $messageName, $messageTypeName) = @_;
+
+  $self->init_packet($messageGroupName, $messageName, $messageTypeName);
+}
+
+sub setField
+{
+  my ($self, $messageGroupName, $messageName, $fieldName, $value, $index) = @_;
+
+  $self->set_field($fieldName, $value, defined $index ? $index : 0);
+}
+
+# cKK01RRRRGGMMDD{CRC32}
+sub getSendString
+{
+  my ($self, $receiverID, $aesKeyNr) = @_;
+
+  return $self->command($receiverID, defined $aesKeyNr ? $aesKeyNr : 0);
+}
+
+1;
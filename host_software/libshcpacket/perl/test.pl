@@ -0,0 +1,98 @@
+#!/usr/bin/perl -w
+
+##########################################################################
+# Test program for the Perl binding of libshcpacket ("make test").
+#
+# Copyright (c) 2014..2019 Uwe Freese
+#
+# You can find smarthomatic at www.smarthomatic.org.
+#
+# This file is free software: you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# This file is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+# Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+##########################################################################
+
+use strict;
+use SHCPacket;
+
+my @tests = ();
+
+sub check($$$)
+{
+  my ($name, $result, $expected) = @_;
+
+  $result = "undef" if (!defined $result);
+  push(@tests, [$name, $result eq $expected, $result, $expected]);
+}
+
+my $parser = new SHCPacket();
+
+# received packets
+
+check("parse", $parser->parse("PKT:SID=22;PC=101;MT=8;MGID=10;MID=2;MD=7f434040;b13af1b9"), 1);
+check("SenderID", $parser->getSenderID(), 22);
+check("PacketCounter", $parser->getPacketCounter(), 101);
+check("MessageTypeName", $parser->getMessageTypeName(), "Status");
+check("MessageGroupName", $parser->getMessageGroupName(), "Weather");
+check("MessageName", $parser->getMessageName(), "HumidityTemperature");
+check("MessageData", $parser->getMessageData(), "7f434040");
+check("Humidity", $parser->getField("Humidity"), 509);
+check("Temperature", $parser->getField("Temperature"), 3329);
+check("unknown field", $parser->getField("Foo"), "undef");
+
+check("CRC ok", $parser->parse_line("PKT:SID=22;PC=101;MT=8;MGID=10;MID=2;MD=7f434040;b13af1b9\r\n", 1), SHCPacket::OK);
+check("CRC wrong", $parser->parse_line("PKT:SID=22;PC=101;MT=8;MGID=10;MID=2;MD=7f434041;b13af1b9", 1), SHCPacket::ERR_CRC);
+check("no PKT", $parser->parse("Received (AES key 1): 00 01"), "undef");
+
+check("truncated array", $parser->parse("PKT:SID=30;PC=5;MT=10;ASID=0;APC=77;E=0;MGID=1;MID=1;MD=60;0"), 1);
+check("On[1]", $parser->getField("On", 1), 1);
+check("On[3]", $parser->getField("On", 3), 0);
+
+$parser->parse("PKT:SID=37;PC=3;MT=8;MGID=0;MID=2;MD=28;0");
+check("enum", $parser->getField("DeviceType"), "PowerSwitch");
+
+check("JSON", $parser->parse("PKT:SID=27;PC=301;MT=8;MGID=1;MID=5;MD=38;0") && $parser->json(),
+  '{"SenderID":27,"PacketCounter":301,"MessageTypeID":8,"MessageType":"Status","MessageGroupID":1,"MessageID":5,'
+  . '"MessageGroup":"GPIO","Message":"DigitalPin","MessageData":"38","Data":{"Pos":1,"On":1}}');
+check("text", $parser->text(), "Status GPIO.DigitalPin SID=27 PC=301: Pos=1 On=1");
+
+# packets to send
+
+$parser->initPacket("Dimmer", "Brightness", "Set");
+$parser->setField("Dimmer", "Brightness", "Brightness", 50);
+check("send Brightness", $parser->getSendString(40), "c000100283C01642fc39fbd");
+
+$parser->initPacket("Display", "Text", "Set");
+$parser->setField("Display", "Text", "Text", "Hi");
+check("send Text", $parser->getSendString(5, 1), "c01010005280100004869307cbcb3");
+check("get Text", $parser->getField("Text"), "Hi");
+
+$parser->initPacket("GPIO", "DigitalPort", "Get");
+check("send Get", $parser->getSendString(12), "c0000000C0101ab515d34");
+
+# result
+
+my $failed = 0;
+
+foreach (@tests) {
+  my ($name, $ok, $result, $expected) = @$_;
+
+  if (!$ok) {
+    print "FAILED: $name: got \"$result\", expected \"$expected\"\n";
+    $failed++;
+  }
+}
+
+print scalar(@tests) - $failed . " of " . scalar(@tests) . " tests OK\n";
+print "Overall result: " . ($failed ? "FAILED" : "OK") . "\n";
+
+exit($failed ? 1 : 0);
@@ -0,0 +1,726 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2013..2019 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "shcpacket.h"
+#include "e2p_access.h"
+
+/* ---------- CRC32 ---------- */
+
+// CRC32 (polynom 0xEDB88320) calculated per half byte, which gives the same result
+// as crc32() in util_generic.c, but is much faster than the bitwise calculation.
+static const uint32_t crc32_nibble_table[16] = {
+	0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+	0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+};
+
+uint32_t shc_crc32(const uint8_t * data, size_t len)
+{
+	uint32_t crc = 0xffffffff;
+
+	while (len--)
+	{
+		crc ^= *data++;
+		crc = (crc >> 4) ^ crc32_nibble_table[crc & 0x0f];
+		crc = (crc >> 4) ^ crc32_nibble_table[crc & 0x0f];
+	}
+
+	return crc ^ 0xffffffff;
+}
+
+/* ---------- parsing ---------- */
+
+static int8_t hex_digit(char c)
+{
+	if ((c >= '0') && (c <= '9'))
+		return c - '0';
+	else if ((c >= 'a') && (c <= 'f'))
+		return c - 'a' + 10;
+	else if ((c >= 'A') && (c <= 'F'))
+		return c - 'A' + 10;
+	else
+		return -1;
+}
+
+// If the text at *p starts with the given key (e.g. "SID="), move *p behind it.
+static bool read_key(const char ** p, const char * key)
+{
+	size_t len = strlen(key);
+
+	if (strncmp(*p, key, len) != 0)
+	{
+		return false;
+	}
+
+	*p += len;
+	return true;
+}
+
+// Read a decimal number terminated by ';' and move *p behind the ';'.
+static bool read_number(const char ** p, uint32_t max, uint32_t * val)
+{
+	const char * s = *p;
+	uint64_t v = 0;
+
+	if ((*s < '0') || (*s > '9'))
+	{
+		return false;
+	}
+
+	while ((*s >= '0') && (*s <= '9'))
+	{
+		v = v * 10 + (*s - '0');
+
+		if (v > max)
+		{
+			return false;
+		}
+
+		s++;
+	}
+
+	if (*s != ';')
+	{
+		return false;
+	}
+
+	*val = (uint32_t)v;
+	*p = s + 1;
+	return true;
+}
+
+static bool read_field(const char ** p, const char * key, uint32_t max, uint32_t * val)
+{
+	return read_key(p, key) && read_number(p, max, val);
+}
+
+// Read the hex encoded message data terminated by ';'.
+static bool read_data(const char ** p, shc_packet_t * pkt)
+{
+	const char * s = *p;
+	uint8_t len = 0;
+
+	while (*s != ';')
+	{
+		int8_t h = hex_digit(s[0]);
+		int8_t l = h < 0 ? -1 : hex_digit(s[1]);
+
+		if ((l < 0) || (len == SHC_DATA_BYTES))
+		{
+			return false;
+		}
+
+		pkt->data[len++] = (h << 4) | l;
+		s += 2;
+	}
+
+	pkt->data_len = len;
+	*p = s + 1;
+	return true;
+}
+
+shc_result_t shc_parse_line(const char * line, bool check_crc, shc_packet_t * pkt)
+{
+	const char * p = line;
+	uint32_t v1, v2, v3;
+
+	memset(pkt, 0, sizeof(shc_packet_t));
+
+	if (!read_key(&p, "PKT:")
+		|| !read_field(&p, "SID=", 4095, &v1)
+		|| !read_field(&p, "PC=", UINT32_MAX, &v2)
+		|| !read_field(&p, "MT=", SHC_MESSAGETYPE_COUNT - 1, &v3))
+	{
+		return SHC_ERR_FORMAT;
+	}
+
+	pkt->sender_id = v1;
+	pkt->packet_counter = v2;
+	pkt->message_type = v3;
+
+	if (read_key(&p, "RID="))
+	{
+		if (!read_number(&p, 4095, &v1))
+			return SHC_ERR_FORMAT;
+
+		pkt->has_receiver = true;
+		pkt->receiver_id = v1;
+	}
+
+	if (read_key(&p, "ASID="))
+	{
+		if (!read_number(&p, 4095, &v1)
+			|| !read_field(&p, "APC=", UINT32_MAX, &v2)
+			|| !read_field(&p, "E=", 1, &v3))
+		{
+			return SHC_ERR_FORMAT;
+		}
+
+		pkt->has_ack = true;
+		pkt->ack_sender_id = v1;
+		pkt->ack_packet_counter = v2;
+		pkt->error = v3;
+	}
+
+	if (read_key(&p, "MGID="))
+	{
+		if (!read_number(&p, 127, &v1)
+			|| !read_field(&p, "MID=", 15, &v2))
+		{
+			return SHC_ERR_FORMAT;
+		}
+
+		pkt->has_message = true;
+		pkt->message_group_id = v1;
+		pkt->message_id = v2;
+	}
+
+	if (read_key(&p, "MD="))
+	{
+		if (!read_data(&p, pkt))
+			return SHC_ERR_FORMAT;
+	}
+
+	// The CRC32 of the text between "PKT:" and the CRC follows. Packets without data
+	// (Get, Ack) are printed without CRC and without line end by the base station.
+	if (check_crc)
+	{
+		const char * crc_start = p;
+		uint32_t crc = 0;
+		uint8_t digits = 0;
+
+		while (hex_digit(*p) >= 0)
+		{
+			crc = (crc << 4) | hex_digit(*p++);
+			digits++;
+		}
+
+		if ((*p == '\r') || (*p == '\n'))
+		{
+			p++;
+
+			if (*p == '\n')
+				p++;
+		}
+
+		if ((digits != 8) || (*p != 0)
+			|| (crc != shc_crc32((const uint8_t *)line + 4, crc_start - line - 4)))
+		{
+			return SHC_ERR_CRC;
+		}
+	}
+
+	if (pkt->has_message)
+	{
+		pkt->message = shc_find_message(pkt->message_group_id, pkt->message_id);
+
+		if (pkt->message == NULL)
+			return SHC_ERR_UNKNOWN_MESSAGE;
+	}
+
+	return SHC_OK;
+}
+
+/* ---------- layout lookup ---------- */
+
+const shc_message_t * shc_find_message(uint8_t message_group_id, uint8_t message_id)
+{
+	uint16_t key = ((uint16_t)message_group_id << 8) | message_id;
+	int16_t low = 0;
+	int16_t high = shc_message_count - 1;
+
+	// binary search, the table is sorted by MessageGroupID and MessageID
+	while (low <= high)
+	{
+		int16_t mid = (low + high) / 2;
+		const shc_message_t * m = &shc_messages[mid];
+		uint16_t k = ((uint16_t)m->message_group_id << 8) | m->message_id;
+
+		if (k == key)
+			return m;
+		else if (k < key)
+			low = mid + 1;
+		else
+			high = mid - 1;
+	}
+
+	return NULL;
+}
+
+const shc_message_t * shc_find_message_by_name(const char * message_group_name, const char * message_name)
+{
+	uint8_t i;
+
+	for (i = 0; i < shc_message_count; i++)
+	{
+		if ((strcmp(shc_messages[i].message_group_name, message_group_name) == 0)
+			&& (strcmp(shc_messages[i].name, message_name) == 0))
+		{
+			return &shc_messages[i];
+		}
+	}
+
+	return NULL;
+}
+
+const shc_field_t * shc_find_field(const shc_message_t * message, const char * name)
+{
+	uint8_t i;
+
+	if (message == NULL)
+	{
+		return NULL;
+	}
+
+	for (i = 0; i < message->field_count; i++)
+	{
+		if (strcmp(message->fields[i].name, name) == 0)
+			return &message->fields[i];
+	}
+
+	return NULL;
+}
+
+int shc_find_message_type(const char * name)
+{
+	int i;
+
+	for (i = 0; i < SHC_MESSAGETYPE_COUNT; i++)
+	{
+		if ((shc_message_type_names[i] != NULL) && (strcmp(shc_message_type_names[i], name) == 0))
+			return i;
+	}
+
+	return -1;
+}
+
+const char * shc_enum_name(const shc_field_t * field, int64_t value)
+{
+	uint8_t i;
+
+	for (i = 0; i < field->element_count; i++)
+	{
+		if (field->elements[i].value == value)
+			return field->elements[i].name;
+	}
+
+	return NULL;
+}
+
+bool shc_enum_value(const shc_field_t * field, const char * name, int64_t * value)
+{
+	uint8_t i;
+
+	for (i = 0; i < field->element_count; i++)
+	{
+		if (strcmp(field->elements[i].name, name) == 0)
+		{
+			*value = field->elements[i].value;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* ---------- data field access ---------- */
+
+// The e2p_access functions take a non-const array, but only read from it here.
+#define DATA(pkt) ((uint8_t *)(pkt)->data)
+
+static inline uint16_t field_bit(const shc_field_t * field, uint8_t index)
+{
+	return field->offset + (uint16_t)index * field->stride;
+}
+
+int64_t shc_get_value(const shc_packet_t * pkt, const shc_field_t * field, uint8_t index)
+{
+	if (index >= field->count)
+	{
+		return 0;
+	}
+
+	switch (field->type)
+	{
+		case SHC_FIELD_INT:
+			return array_read_IntValue32(field_bit(field, index), field->bits, INT32_MIN, INT32_MAX, DATA(pkt));
+		case SHC_FIELD_BYTEARRAY:
+			return 0;
+		default:
+			return array_read_UIntValue32(field_bit(field, index), field->bits, 0, UINT32_MAX, DATA(pkt));
+	}
+}
+
+float shc_get_float(const shc_packet_t * pkt, const shc_field_t * field, uint8_t index)
+{
+	if ((index >= field->count) || (field->type != SHC_FIELD_FLOAT))
+	{
+		return 0;
+	}
+
+	return array_read_FloatValue(field_bit(field, index), DATA(pkt));
+}
+
+uint8_t shc_get_bytes(const shc_packet_t * pkt, const shc_field_t * field, uint8_t * dst)
+{
+	uint8_t bytes = field->bits / 8;
+	uint8_t len;
+
+	array_read_ByteArray(field->offset, bytes, dst, DATA(pkt));
+
+	for (len = 0; (len < bytes) && (dst[len] != 0); len++)
+		;
+
+	return len;
+}
+
+void shc_init_packet(shc_packet_t * pkt, const shc_message_t * message, uint8_t message_type)
+{
+	memset(pkt, 0, sizeof(shc_packet_t));
+
+	pkt->message_type = message_type;
+	pkt->has_message = true;
+	pkt->message_group_id = message->message_group_id;
+	pkt->message_id = message->message_id;
+	pkt->message = message;
+	pkt->data_len = (message->data_bits + 7) / 8;
+}
+
+void shc_set_value(shc_packet_t * pkt, const shc_field_t * field, uint8_t index, int64_t val)
+{
+	if ((index >= field->count) || (field->type == SHC_FIELD_BYTEARRAY))
+	{
+		return;
+	}
+
+	if (field->type == SHC_FIELD_INT)
+		array_write_IntValue(field_bit(field, index), field->bits, (int32_t)val, pkt->data);
+	else if (field->type == SHC_FIELD_BOOL)
+		array_write_UIntValue(field_bit(field, index), 1, val != 0, pkt->data);
+	else
+		array_write_UIntValue(field_bit(field, index), field->bits, (uint32_t)val, pkt->data);
+}
+
+void shc_set_float(shc_packet_t * pkt, const shc_field_t * field, uint8_t index, float val)
+{
+	if ((index >= field->count) || (field->type != SHC_FIELD_FLOAT))
+	{
+		return;
+	}
+
+	array_write_FloatValue(field_bit(field, index), val, pkt->data);
+}
+
+void shc_set_bytes(shc_packet_t * pkt, const shc_field_t * field, const uint8_t * src, uint8_t len)
+{
+	uint8_t bytes = field->bits / 8;
+	uint8_t i;
+
+	if (field->type != SHC_FIELD_BYTEARRAY)
+	{
+		return;
+	}
+
+	// fill up the rest of the bytes with 0
+	for (i = 0; i < bytes; i++)
+	{
+		array_write_UIntValue(field->offset + i * 8, 8, i < len ? src[i] : 0, pkt->data);
+	}
+}
+
+/* ---------- output ---------- */
+
+// Output buffer with snprintf semantics.
+typedef struct {
+	char * buf;
+	size_t size;
+	size_t len;
+} out_t;
+
+static void out_printf(out_t * out, const char * fmt, ...)
+{
+	va_list ap;
+	size_t avail = out->len < out->size ? out->size - out->len : 0;
+
+	va_start(ap, fmt);
+	int n = vsnprintf(avail ? out->buf + out->len : NULL, avail, fmt, ap);
+	va_end(ap);
+
+	if (n > 0)
+	{
+		out->len += n;
+	}
+}
+
+static void out_char(out_t * out, char c)
+{
+	if (out->len + 1 < out->size)
+	{
+		out->buf[out->len] = c;
+		out->buf[out->len + 1] = 0;
+	}
+
+	out->len++;
+}
+
+static void out_string(out_t * out, const char * s)
+{
+	while (*s)
+	{
+		out_char(out, *s++);
+	}
+}
+
+static void out_hex(out_t * out, const uint8_t * data, uint8_t len, bool uppercase)
+{
+	const char * digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+	uint8_t i;
+
+	for (i = 0; i < len; i++)
+	{
+		out_char(out, digits[data[i] >> 4]);
+		out_char(out, digits[data[i] & 0x0f]);
+	}
+}
+
+// Length of the message data without trailing 0 bytes, but at least min_len.
+static uint8_t data_len_stripped(const shc_packet_t * pkt, uint8_t min_len)
+{
+	uint8_t len = pkt->data_len;
+
+	while ((len > min_len) && (pkt->data[len - 1] == 0))
+	{
+		len--;
+	}
+
+	return len;
+}
+
+static size_t out_finish(out_t * out)
+{
+	if ((out->size > 0) && (out->len == 0))
+	{
+		out->buf[0] = 0;
+	}
+
+	return out->len;
+}
+
+size_t shc_format_command(const shc_packet_t * pkt, uint16_t receiver_id, uint8_t aes_key_nr, char * buf, size_t size)
+{
+	char cmd[16 + SHC_DATA_BYTES * 2];
+	out_t out = { cmd, sizeof(cmd), 0 };
+
+	out_printf(&out, "c%02X%02X%04X%02X%02X", aes_key_nr, pkt->message_type, receiver_id, pkt->message_group_id, pkt->message_id);
+	out_hex(&out, pkt->data, data_len_stripped(pkt, 0), true);
+
+	return snprintf(buf, size, "%s%08x", cmd, shc_crc32((const uint8_t *)cmd, out.len));
+}
+
+size_t shc_format_data(const shc_packet_t * pkt, char * buf, size_t size)
+{
+	out_t out = { buf, size, 0 };
+
+	out_hex(&out, pkt->data, data_len_stripped(pkt, 1), false);
+
+	return out_finish(&out);
+}
+
+// Write a byte array as JSON string, stopping at the first 0 byte.
+static void out_json_string(out_t * out, const uint8_t * s, uint8_t len)
+{
+	uint8_t i;
+
+	out_char(out, '"');
+
+	for (i = 0; i < len; i++)
+	{
+		if ((s[i] == '"') || (s[i] == '\\'))
+		{
+			out_char(out, '\\');
+			out_char(out, s[i]);
+		}
+		else if ((s[i] < 0x20) || (s[i] >= 0x7f))
+		{
+			out_printf(out, "\\u%04x", s[i]);
+		}
+		else
+		{
+			out_char(out, s[i]);
+		}
+	}
+
+	out_char(out, '"');
+}
+
+// Write one value of a field in JSON or text format.
+static void out_value(out_t * out, const shc_packet_t * pkt, const shc_field_t * field, uint8_t index, bool json)
+{
+	if (field->type == SHC_FIELD_BYTEARRAY)
+	{
+		uint8_t bytes[SHC_DATA_BYTES];
+		uint8_t len = shc_get_bytes(pkt, field, bytes);
+
+		out_json_string(out, bytes, len);
+	}
+	else if (field->type == SHC_FIELD_FLOAT)
+	{
+		float f = shc_get_float(pkt, field, index);
+
+		if (isfinite(f))
+			out_printf(out, "%.9g", f);
+		else
+			out_string(out, "null");
+	}
+	else
+	{
+		int64_t val = shc_get_value(pkt, field, index);
+		const char * name = field->type == SHC_FIELD_ENUM ? shc_enum_name(field, val) : NULL;
+
+		if (name == NULL)
+			out_printf(out, "%lld", (long long)val);
+		else if (json)
+			out_json_string(out, (const uint8_t *)name, strlen(name));
+		else
+			out_string(out, name);
+	}
+}
+
+size_t shc_format_json(const shc_packet_t * pkt, char * buf, size_t size)
+{
+	out_t out = { buf, size, 0 };
+	const char * mt = shc_message_type_names[pkt->message_type];
+	uint8_t f, i;
+
+	out_printf(&out, "{\"SenderID\":%u,\"PacketCounter\":%lu,\"MessageTypeID\":%u",
+		pkt->sender_id, (unsigned long)pkt->packet_counter, pkt->message_type);
+
+	if (mt != NULL)
+		out_printf(&out, ",\"MessageType\":\"%s\"", mt);
+
+	if (pkt->has_receiver)
+		out_printf(&out, ",\"ReceiverID\":%u", pkt->receiver_id);
+
+	if (pkt->has_ack)
+		out_printf(&out, ",\"AckSenderID\":%u,\"AckPacketCounter\":%lu,\"Error\":%u",
+			pkt->ack_sender_id, (unsigned long)pkt->ack_packet_counter, pkt->error);
+
+	if (pkt->has_message)
+	{
+		out_printf(&out, ",\"MessageGroupID\":%u,\"MessageID\":%u", pkt->message_group_id, pkt->message_id);
+
+		if (pkt->message != NULL)
+			out_printf(&out, ",\"MessageGroup\":\"%s\",\"Message\":\"%s\"", pkt->message->message_group_name, pkt->message->name);
+
+		out_string(&out, ",\"MessageData\":\"");
+		out_hex(&out, pkt->data, data_len_stripped(pkt, 1), false);
+		out_char(&out, '"');
+	}
+
+	if (pkt->message != NULL)
+	{
+		out_string(&out, ",\"Data\":{");
+
+		for (f = 0; f < pkt->message->field_count; f++)
+		{
+			const shc_field_t * field = &pkt->message->fields[f];
+
+			out_printf(&out, "%s\"%s\":", f ? "," : "", field->name);
+
+			if (field->count == 1)
+			{
+				out_value(&out, pkt, field, 0, true);
+				continue;
+			}
+
+			out_char(&out, '[');
+
+			for (i = 0; i < field->count; i++)
+			{
+				if (i)
+					out_char(&out, ',');
+
+				out_value(&out, pkt, field, i, true);
+			}
+
+			out_char(&out, ']');
+		}
+
+		out_char(&out, '}');
+	}
+
+	out_char(&out, '}');
+
+	return out_finish(&out);
+}
+
+size_t shc_format_text(const shc_packet_t * pkt, char * buf, size_t size)
+{
+	out_t out = { buf, size, 0 };
+	const char * mt = shc_message_type_names[pkt->message_type];
+	uint8_t f, i;
+
+	if (mt != NULL)
+		out_string(&out, mt);
+	else
+		out_printf(&out, "MessageType%u", pkt->message_type);
+
+	if (pkt->message != NULL)
+		out_printf(&out, " %s.%s", pkt->message->message_group_name, pkt->message->name);
+	else if (pkt->has_message)
+		out_printf(&out, " %u.%u", pkt->message_group_id, pkt->message_id);
+
+	out_printf(&out, " SID=%u PC=%lu", pkt->sender_id, (unsigned long)pkt->packet_counter);
+
+	if (pkt->has_receiver)
+		out_printf(&out, " RID=%u", pkt->receiver_id);
+
+	if (pkt->has_ack)
+		out_printf(&out, " ASID=%u APC=%lu E=%u", pkt->ack_sender_id, (unsigned long)pkt->ack_packet_counter, pkt->error);
+
+	if (pkt->message != NULL)
+	{
+		out_char(&out, ':');
+
+		for (f = 0; f < pkt->message->field_count; f++)
+		{
+			const shc_field_t * field = &pkt->message->fields[f];
+
+			out_printf(&out, " %s=", field->name);
+
+			for (i = 0; i < field->count; i++)
+			{
+				if (i)
+					out_char(&out, ',');
+
+				out_value(&out, pkt, field, i, false);
+			}
+		}
+	}
+	else if (pkt->has_message)
+	{
+		out_string(&out, ": MD=");
+		out_hex(&out, pkt->data, data_len_stripped(pkt, 1), false);
+	}
+
+	return out_finish(&out);
+}
@@ -0,0 +1,164 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2013..2019 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// libshcpacket - decode and encode smarthomatic packets on the PC.
+//
+// The library works on the lines the base station prints for received packets
+// ("PKT:SID=22;PC=101;MT=8;MGID=0;MID=5;MD=b40000000000;3c3e6d43") and creates the
+// commands the base station accepts for sending packets ("c0001003D3C0164...").
+// The positions and types of the data fields are generated from packet_layout.xml
+// by the SHC EEPROM editor (shcpacket_layout.c). The bits are read and written by
+// the same functions the firmware uses (src_common/e2p_access.c, built with UNITTEST).
+//
+// All functions only work on the given packet struct and are therefore reentrant.
+
+#ifndef _SHCPACKET_H
+#define _SHCPACKET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define SHC_MESSAGETYPE_COUNT 16
+
+// Maximum length of the message data in bytes.
+#define SHC_DATA_BYTES 64
+
+typedef enum {
+	SHC_FIELD_UINT = 0,
+	SHC_FIELD_INT = 1,
+	SHC_FIELD_BOOL = 2,
+	SHC_FIELD_FLOAT = 3,
+	SHC_FIELD_ENUM = 4,
+	SHC_FIELD_BYTEARRAY = 5
+} shc_field_type_t;
+
+typedef struct {
+	int32_t value;
+	const char * name;
+} shc_enum_element_t;
+
+// Description of one data field. Fields within arrays are described once with
+// the number of array elements and the distance between them.
+typedef struct {
+	const char * name;
+	uint8_t type;         // shc_field_type_t
+	uint16_t offset;      // bit position of the (first) value within the message data
+	uint16_t bits;        // length of one value in bits (bytes * 8 for ByteArray)
+	uint8_t count;        // number of array elements, 1 if the field is not in an array
+	uint16_t stride;      // bits from one array element to the next
+	int64_t min;
+	int64_t max;
+	const shc_enum_element_t * elements;
+	uint8_t element_count;
+} shc_field_t;
+
+typedef struct {
+	uint8_t message_group_id;
+	uint8_t message_id;
+	const char * message_group_name;
+	const char * name;
+	uint16_t data_bits;
+	uint8_t field_count;
+	const shc_field_t * fields;
+} shc_message_t;
+
+// Generated tables (shcpacket_layout.c).
+extern const char * const shc_message_type_names[SHC_MESSAGETYPE_COUNT];
+extern const shc_message_t shc_messages[];
+extern const uint8_t shc_message_count;
+
+typedef enum {
+	SHC_OK = 0,
+	SHC_ERR_FORMAT = 1,          // not a valid "PKT:" line
+	SHC_ERR_CRC = 2,             // CRC at the end of the line doesn't match
+	SHC_ERR_UNKNOWN_MESSAGE = 3  // MessageGroupID / MessageID not known, the header fields are valid
+} shc_result_t;
+
+// A received packet (as printed by the base station) or a packet to send.
+// The header extension fields are only valid if the corresponding has_* flag is set.
+typedef struct {
+	uint16_t sender_id;
+	uint32_t packet_counter;
+	uint8_t message_type;
+	bool has_receiver;
+	uint16_t receiver_id;
+	bool has_ack;
+	uint16_t ack_sender_id;
+	uint32_t ack_packet_counter;
+	uint8_t error;
+	bool has_message;
+	uint8_t message_group_id;
+	uint8_t message_id;
+	const shc_message_t * message;  // NULL if not known
+	uint8_t data_len;               // length of the message data in bytes
+	uint8_t data[SHC_DATA_BYTES + 8]; // message data, filled up with 0 to allow reading over the end
+} shc_packet_t;
+
+// CRC32 as used by the base station for the "PKT:" lines and the commands.
+uint32_t shc_crc32(const uint8_t * data, size_t len);
+
+// Parse a "PKT:" line. If check_crc is set, the line has to end with the CRC32 of
+// the characters between "PKT:" and the CRC (and an optional "\r\n"). Otherwise
+// everything after the last field is ignored, like in SHC_parser.pm.
+shc_result_t shc_parse_line(const char * line, bool check_crc, shc_packet_t * pkt);
+
+// Look up messages, fields and MessageTypes. Return NULL / -1 if not found.
+const shc_message_t * shc_find_message(uint8_t message_group_id, uint8_t message_id);
+const shc_message_t * shc_find_message_by_name(const char * message_group_name, const char * message_name);
+const shc_field_t * shc_find_field(const shc_message_t * message, const char * name);
+int shc_find_message_type(const char * name);
+const char * shc_enum_name(const shc_field_t * field, int64_t value);
+bool shc_enum_value(const shc_field_t * field, const char * name, int64_t * value);
+
+// Read a value of the message data. The values are not limited to min / max, so
+// that they are returned as sent. Index values outside of the array return 0.
+// shc_get_value returns the raw bits for FloatValue and 0 for ByteArray fields.
+int64_t shc_get_value(const shc_packet_t * pkt, const shc_field_t * field, uint8_t index);
+float shc_get_float(const shc_packet_t * pkt, const shc_field_t * field, uint8_t index);
+
+// Copy the bytes of a ByteArray field to dst (field->bits / 8 bytes) and return
+// the number of bytes before the first 0 byte (the string length).
+uint8_t shc_get_bytes(const shc_packet_t * pkt, const shc_field_t * field, uint8_t * dst);
+
+// Initialize a packet to be sent by the base station.
+void shc_init_packet(shc_packet_t * pkt, const shc_message_t * message, uint8_t message_type);
+
+// Write a value into the message data.
+void shc_set_value(shc_packet_t * pkt, const shc_field_t * field, uint8_t index, int64_t val);
+void shc_set_float(shc_packet_t * pkt, const shc_field_t * field, uint8_t index, float val);
+void shc_set_bytes(shc_packet_t * pkt, const shc_field_t * field, const uint8_t * src, uint8_t len);
+
+// The following functions write a 0-terminated string to buf and return its
+// length. Like snprintf, the output is truncated to size - 1 characters and the
+// length of the complete string is returned.
+
+// Base station command to send the packet ("cKKTTRRRRGGMMDD..." + CRC32).
+size_t shc_format_command(const shc_packet_t * pkt, uint16_t receiver_id, uint8_t aes_key_nr, char * buf, size_t size);
+
+// Message data as hex string with trailing 0 bytes removed, as in the "MD=" part.
+size_t shc_format_data(const shc_packet_t * pkt, char * buf, size_t size);
+
+// All header fields and data fields as JSON object.
+size_t shc_format_json(const shc_packet_t * pkt, char * buf, size_t size);
+
+// All header fields and data fields as readable text, e.g.
+// "Status GPIO.DigitalPin SID=27 PC=301: Pos=3 On=1".
+size_t shc_format_text(const shc_packet_t * pkt, char * buf, size_t size);
+
+#endif /* _SHCPACKET_H */
@@ -0,0 +1,232 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2013..2019 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Throughput benchmark for libshcpacket.
+//
+// Usage: shcpacket_bench <logfile> [min_lines] [-v]
+//
+// Reads the "PKT:" lines of a base station log and decodes them repeatedly until
+// at least min_lines (default 2000000) lines were processed per test. With -v, the
+// decoded packets are printed once as text and JSON. Lines without CRC (Get, Ack) and
+// lines with a wrong CRC are counted as rejected when checking the CRC.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "shcpacket.h"
+
+typedef struct {
+	char ** lines;
+	size_t count;
+} logfile_t;
+
+static bool read_log(const char * filename, logfile_t * log)
+{
+	FILE * f = fopen(filename, "r");
+	char line[1024];
+	size_t size = 0;
+
+	if (f == NULL)
+	{
+		perror(filename);
+		return false;
+	}
+
+	log->lines = NULL;
+	log->count = 0;
+
+	while (fgets(line, sizeof(line), f))
+	{
+		if (strncmp(line, "PKT:", 4) != 0)
+			continue;
+
+		if (log->count == size)
+		{
+			size = size ? size * 2 : 1024;
+			log->lines = realloc(log->lines, size * sizeof(char *));
+		}
+
+		// remove line end
+		line[strcspn(line, "\r\n")] = 0;
+		log->lines[log->count++] = strdup(line);
+	}
+
+	fclose(f);
+	return true;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Sum up all decoded values, so that the compiler can't optimize away the decoding.
+static int64_t decode_fields(const shc_packet_t * pkt)
+{
+	int64_t sum = 0;
+	uint8_t f, i;
+
+	if (pkt->message == NULL)
+		return 0;
+
+	for (f = 0; f < pkt->message->field_count; f++)
+	{
+		const shc_field_t * field = &pkt->message->fields[f];
+
+		for (i = 0; i < field->count; i++)
+		{
+			sum += shc_get_value(pkt, field, i);
+		}
+	}
+
+	return sum;
+}
+
+typedef enum {
+	TEST_PARSE,
+	TEST_PARSE_CRC,
+	TEST_DECODE,
+	TEST_TEXT,
+	TEST_JSON
+} test_t;
+
+static const char * test_names[] = {
+	"parse without CRC check",
+	"parse with CRC check",
+	"parse + decode all fields",
+	"parse + format text",
+	"parse + format JSON"
+};
+
+static void run_test(const logfile_t * log, test_t test, size_t min_lines)
+{
+	shc_packet_t pkt;
+	char buf[4096];
+	size_t lines = 0;
+	size_t errors = 0;
+	int64_t sum = 0;
+	double start = now();
+
+	while (lines < min_lines)
+	{
+		size_t l;
+
+		for (l = 0; l < log->count; l++)
+		{
+			shc_result_t res = shc_parse_line(log->lines[l], test != TEST_PARSE, &pkt);
+
+			if (res != SHC_OK)
+			{
+				errors++;
+				continue;
+			}
+
+			switch (test)
+			{
+				case TEST_DECODE:
+					sum += decode_fields(&pkt);
+					break;
+				case TEST_TEXT:
+					sum += shc_format_text(&pkt, buf, sizeof(buf));
+					break;
+				case TEST_JSON:
+					sum += shc_format_json(&pkt, buf, sizeof(buf));
+					break;
+				default:
+					sum += pkt.sender_id;
+					break;
+			}
+		}
+
+		lines += log->count;
+	}
+
+	double sec = now() - start;
+
+	printf("%-28s %10.0f lines/s  (%zu lines, %zu rejected, %.3fs, checksum %lld)\n",
+		test_names[test], lines / sec, lines, errors, sec, (long long)sum);
+}
+
+int main(int argc, char ** argv)
+{
+	logfile_t log;
+	size_t min_lines = 2000000;
+	bool verbose = false;
+	int i;
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: %s <logfile> [min_lines] [-v]\n", argv[0]);
+		return 1;
+	}
+
+	for (i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-v") == 0)
+			verbose = true;
+		else
+			min_lines = strtoul(argv[i], NULL, 10);
+	}
+
+	if (!read_log(argv[1], &log))
+		return 1;
+
+	if (log.count == 0)
+	{
+		fprintf(stderr, "No PKT lines found in %s\n", argv[1]);
+		return 1;
+	}
+
+	printf("%zu PKT lines read from %s\n", log.count, argv[1]);
+
+	if (verbose)
+	{
+		shc_packet_t pkt;
+		char buf[4096];
+		size_t l;
+
+		for (l = 0; l < log.count; l++)
+		{
+			// packets without data (Get, Ack) are printed without CRC
+			bool check_crc = strstr(log.lines[l], ";MD=") != NULL;
+			shc_result_t res = shc_parse_line(log.lines[l], check_crc, &pkt);
+
+			if (res == SHC_ERR_FORMAT || res == SHC_ERR_CRC)
+			{
+				printf("%s -> %s\n", log.lines[l], res == SHC_ERR_CRC ? "CRC error" : "format error");
+				continue;
+			}
+
+			shc_format_text(&pkt, buf, sizeof(buf));
+			printf("%s\n", buf);
+			shc_format_json(&pkt, buf, sizeof(buf));
+			printf("%s\n", buf);
+		}
+	}
+
+	for (i = TEST_PARSE; i <= TEST_JSON; i++)
+	{
+		run_test(&log, i, min_lines);
+	}
+
+	return 0;
+}
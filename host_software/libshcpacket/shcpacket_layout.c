@@ -0,0 +1,249 @@
+/*
+* This file is part of smarthomatic, http://www.smarthomatic.org.
+* Copyright (c) 2013..2019 Uwe Freese
+*
+* smarthomatic is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* smarthomatic is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+* Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with smarthomatic. If not, see <http://www.gnu.org/licenses/>.
+*
+* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+* ! WARNING: This file is generated by the SHC EEPROM editor and should !
+* ! never be modified manually.                                         !
+* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+*/
+
+#include <stddef.h>
+#include "shcpacket.h"
+
+// Names of the MessageTypes, indexed by the MessageType.
+const char * const shc_message_type_names[SHC_MESSAGETYPE_COUNT] = {
+  [0] = "Get",
+  [1] = "Set",
+  [2] = "SetGet",
+  [3] = "Deliver",
+  [8] = "Status",
+  [9] = "Ack",
+  [10] = "AckStatus"
+};
+
+// Elements of enum "DeviceType"
+static const shc_enum_element_t enum_generic_deviceinfo_devicetype[] = {
+  { 0, "BaseStation" },
+  { 20, "EnvSensor" },
+  { 40, "PowerSwitch" },
+  { 45, "Controller" },
+  { 50, "RGBDimmer" },
+  { 60, "Dimmer" },
+  { 70, "SoilMoistureMeter" },
+  { 80, "Thermostat" },
+  { 90, "TeaMaker" }
+};
+
+// Data fields of message "Generic" / "DeviceInfo"
+static const shc_field_t fields_generic_deviceinfo[] = {
+  { "DeviceType", SHC_FIELD_ENUM, 0, 8, 1, 0, 0, 255, enum_generic_deviceinfo_devicetype, 9 },
+  { "VersionMajor", SHC_FIELD_UINT, 8, 8, 1, 0, 0, 255, NULL, 0 },
+  { "VersionMinor", SHC_FIELD_UINT, 16, 8, 1, 0, 0, 255, NULL, 0 },
+  { "VersionPatch", SHC_FIELD_UINT, 24, 8, 1, 0, 0, 255, NULL, 0 },
+  { "VersionHash", SHC_FIELD_UINT, 32, 32, 1, 0, 0, 4294967295, NULL, 0 }
+};
+
+// Elements of enum "ErrorCode"
+static const shc_enum_element_t enum_generic_hardwareerror_errorcode[] = {
+  { 0, "ExternalReset" },
+  { 1, "BrownOutReset" },
+  { 2, "WatchdogReset" },
+  { 3, "TransceiverWatchdogReset" }
+};
+
+// Data fields of message "Generic" / "HardwareError"
+static const shc_field_t fields_generic_hardwareerror[] = {
+  { "ErrorCode", SHC_FIELD_ENUM, 0, 8, 1, 0, 0, 255, enum_generic_hardwareerror_errorcode, 4 }
+};
+
+// Data fields of message "Generic" / "BatteryStatus"
+static const shc_field_t fields_generic_batterystatus[] = {
+  { "Percentage", SHC_FIELD_UINT, 0, 7, 1, 0, 0, 100, NULL, 0 }
+};
+
+// Data fields of message "GPIO" / "DigitalPort"
+static const shc_field_t fields_gpio_digitalport[] = {
+  { "On", SHC_FIELD_BOOL, 0, 1, 8, 1, 0, 1, NULL, 0 }
+};
+
+// Data fields of message "GPIO" / "DigitalPortTimeout"
+static const shc_field_t fields_gpio_digitalporttimeout[] = {
+  { "On", SHC_FIELD_BOOL, 0, 1, 8, 17, 0, 1, NULL, 0 },
+  { "TimeoutSec", SHC_FIELD_UINT, 1, 16, 8, 17, 0, 65535, NULL, 0 }
+};
+
+// Data fields of message "GPIO" / "DigitalPin"
+static const shc_field_t fields_gpio_digitalpin[] = {
+  { "Pos", SHC_FIELD_UINT, 0, 3, 1, 0, 0, 7, NULL, 0 },
+  { "On", SHC_FIELD_BOOL, 3, 1, 1, 0, 0, 1, NULL, 0 }
+};
+
+// Data fields of message "GPIO" / "DigitalPinTimeout"
+static const shc_field_t fields_gpio_digitalpintimeout[] = {
+  { "Pos", SHC_FIELD_UINT, 0, 3, 1, 0, 0, 7, NULL, 0 },
+  { "On", SHC_FIELD_BOOL, 3, 1, 1, 0, 0, 1, NULL, 0 },
+  { "TimeoutSec", SHC_FIELD_UINT, 4, 16, 1, 0, 0, 65535, NULL, 0 }
+};
+
+// Data fields of message "GPIO" / "AnalogPort"
+static const shc_field_t fields_gpio_analogport[] = {
+  { "On", SHC_FIELD_BOOL, 0, 1, 8, 12, 0, 1, NULL, 0 },
+  { "Voltage", SHC_FIELD_UINT, 1, 11, 8, 12, 0, 1100, NULL, 0 }
+};
+
+// Data fields of message "Weather" / "Temperature"
+static const shc_field_t fields_weather_temperature[] = {
+  { "Temperature", SHC_FIELD_INT, 0, 16, 1, 0, -32768, 32767, NULL, 0 }
+};
+
+// Data fields of message "Weather" / "HumidityTemperature"
+static const shc_field_t fields_weather_humiditytemperature[] = {
+  { "Humidity", SHC_FIELD_UINT, 0, 10, 1, 0, 0, 1000, NULL, 0 },
+  { "Temperature", SHC_FIELD_INT, 10, 16, 1, 0, -32768, 32767, NULL, 0 }
+};
+
+// Data fields of message "Weather" / "BarometricPressureTemperature"
+static const shc_field_t fields_weather_barometricpressuretemperature[] = {
+  { "BarometricPressure", SHC_FIELD_UINT, 0, 17, 1, 0, 0, 131071, NULL, 0 },
+  { "Temperature", SHC_FIELD_INT, 17, 16, 1, 0, -32768, 32767, NULL, 0 }
+};
+
+// Data fields of message "Weather" / "Humidity"
+static const shc_field_t fields_weather_humidity[] = {
+  { "Humidity", SHC_FIELD_UINT, 0, 10, 1, 0, 0, 1000, NULL, 0 }
+};
+
+// Data fields of message "Environment" / "Brightness"
+static const shc_field_t fields_environment_brightness[] = {
+  { "Brightness", SHC_FIELD_UINT, 0, 7, 1, 0, 0, 100, NULL, 0 }
+};
+
+// Data fields of message "Environment" / "Distance"
+static const shc_field_t fields_environment_distance[] = {
+  { "Distance", SHC_FIELD_UINT, 0, 14, 1, 0, 0, 16383, NULL, 0 }
+};
+
+// Data fields of message "Environment" / "ParticulateMatter"
+static const shc_field_t fields_environment_particulatematter[] = {
+  { "TypicalParticleSize", SHC_FIELD_UINT, 0, 10, 1, 0, 0, 1023, NULL, 0 },
+  { "Size", SHC_FIELD_UINT, 10, 8, 5, 30, 0, 255, NULL, 0 },
+  { "MassConcentration", SHC_FIELD_UINT, 18, 10, 5, 30, 0, 1023, NULL, 0 },
+  { "NumberConcentration", SHC_FIELD_UINT, 28, 12, 5, 30, 0, 4095, NULL, 0 }
+};
+
+// Data fields of message "Display" / "Text"
+static const shc_field_t fields_display_text[] = {
+  { "PosY", SHC_FIELD_UINT, 0, 5, 1, 0, 0, 31, NULL, 0 },
+  { "PosX", SHC_FIELD_UINT, 5, 7, 1, 0, 0, 79, NULL, 0 },
+  { "Format", SHC_FIELD_UINT, 12, 4, 1, 0, 0, 15, NULL, 0 },
+  { "Text", SHC_FIELD_BYTEARRAY, 16, 320, 1, 0, 0, 0, NULL, 0 }
+};
+
+// Elements of enum "Mode"
+static const shc_enum_element_t enum_display_backlight_mode[] = {
+  { 0, "On" },
+  { 1, "Off" },
+  { 2, "Auto" }
+};
+
+// Data fields of message "Display" / "Backlight"
+static const shc_field_t fields_display_backlight[] = {
+  { "Mode", SHC_FIELD_ENUM, 0, 4, 1, 0, 0, 15, enum_display_backlight_mode, 3 },
+  { "AutoTimeoutSec", SHC_FIELD_UINT, 4, 8, 1, 0, 0, 255, NULL, 0 }
+};
+
+// Data fields of message "Controller" / "MenuSelection"
+static const shc_field_t fields_controller_menuselection[] = {
+  { "Index", SHC_FIELD_UINT, 0, 8, 16, 8, 0, 255, NULL, 0 }
+};
+
+// Data fields of message "Audio" / "Tone"
+static const shc_field_t fields_audio_tone[] = {
+  { "Tone", SHC_FIELD_UINT, 0, 7, 1, 0, 0, 116, NULL, 0 }
+};
+
+// Data fields of message "Audio" / "Melody"
+static const shc_field_t fields_audio_melody[] = {
+  { "Repeat", SHC_FIELD_UINT, 0, 4, 1, 0, 0, 15, NULL, 0 },
+  { "AutoReverse", SHC_FIELD_BOOL, 4, 1, 1, 0, 0, 1, NULL, 0 },
+  { "Time", SHC_FIELD_UINT, 5, 5, 25, 15, 0, 31, NULL, 0 },
+  { "Effect", SHC_FIELD_UINT, 10, 3, 25, 15, 0, 1, NULL, 0 },
+  { "Tone", SHC_FIELD_UINT, 13, 7, 25, 15, 0, 116, NULL, 0 }
+};
+
+// Data fields of message "Dimmer" / "Brightness"
+static const shc_field_t fields_dimmer_brightness[] = {
+  { "Brightness", SHC_FIELD_UINT, 0, 7, 1, 0, 0, 100, NULL, 0 }
+};
+
+// Elements of enum "AnimationMode"
+static const shc_enum_element_t enum_dimmer_animation_animationmode[] = {
+  { 0, "none" },
+  { 1, "linear" },
+  { 2, "ease" }
+};
+
+// Data fields of message "Dimmer" / "Animation"
+static const shc_field_t fields_dimmer_animation[] = {
+  { "AnimationMode", SHC_FIELD_ENUM, 0, 2, 1, 0, 0, 3, enum_dimmer_animation_animationmode, 3 },
+  { "TimeoutSec", SHC_FIELD_UINT, 2, 16, 1, 0, 0, 65535, NULL, 0 },
+  { "StartBrightness", SHC_FIELD_UINT, 18, 7, 1, 0, 0, 100, NULL, 0 },
+  { "EndBrightness", SHC_FIELD_UINT, 25, 7, 1, 0, 0, 100, NULL, 0 }
+};
+
+// Data fields of message "Dimmer" / "Color"
+static const shc_field_t fields_dimmer_color[] = {
+  { "Color", SHC_FIELD_UINT, 0, 6, 1, 0, 0, 63, NULL, 0 }
+};
+
+// Data fields of message "Dimmer" / "ColorAnimation"
+static const shc_field_t fields_dimmer_coloranimation[] = {
+  { "Repeat", SHC_FIELD_UINT, 0, 4, 1, 0, 0, 15, NULL, 0 },
+  { "AutoReverse", SHC_FIELD_BOOL, 4, 1, 1, 0, 0, 1, NULL, 0 },
+  { "Time", SHC_FIELD_UINT, 5, 5, 10, 11, 0, 31, NULL, 0 },
+  { "Color", SHC_FIELD_UINT, 10, 6, 10, 11, 0, 63, NULL, 0 }
+};
+
+// All messages, sorted by MessageGroupID and MessageID.
+const shc_message_t shc_messages[] = {
+  { 0, 2, "Generic", "DeviceInfo", 64, 5, fields_generic_deviceinfo },
+  { 0, 3, "Generic", "HardwareError", 8, 1, fields_generic_hardwareerror },
+  { 0, 5, "Generic", "BatteryStatus", 7, 1, fields_generic_batterystatus },
+  { 1, 1, "GPIO", "DigitalPort", 8, 1, fields_gpio_digitalport },
+  { 1, 2, "GPIO", "DigitalPortTimeout", 136, 2, fields_gpio_digitalporttimeout },
+  { 1, 5, "GPIO", "DigitalPin", 4, 2, fields_gpio_digitalpin },
+  { 1, 6, "GPIO", "DigitalPinTimeout", 20, 3, fields_gpio_digitalpintimeout },
+  { 1, 10, "GPIO", "AnalogPort", 96, 2, fields_gpio_analogport },
+  { 10, 1, "Weather", "Temperature", 16, 1, fields_weather_temperature },
+  { 10, 2, "Weather", "HumidityTemperature", 26, 2, fields_weather_humiditytemperature },
+  { 10, 3, "Weather", "BarometricPressureTemperature", 33, 2, fields_weather_barometricpressuretemperature },
+  { 10, 4, "Weather", "Humidity", 10, 1, fields_weather_humidity },
+  { 11, 1, "Environment", "Brightness", 7, 1, fields_environment_brightness },
+  { 11, 2, "Environment", "Distance", 14, 1, fields_environment_distance },
+  { 11, 3, "Environment", "ParticulateMatter", 160, 4, fields_environment_particulatematter },
+  { 40, 1, "Display", "Text", 336, 4, fields_display_text },
+  { 40, 2, "Display", "Backlight", 12, 2, fields_display_backlight },
+  { 45, 1, "Controller", "MenuSelection", 128, 1, fields_controller_menuselection },
+  { 50, 1, "Audio", "Tone", 7, 1, fields_audio_tone },
+  { 50, 2, "Audio", "Melody", 380, 5, fields_audio_melody },
+  { 60, 1, "Dimmer", "Brightness", 7, 1, fields_dimmer_brightness },
+  { 60, 2, "Dimmer", "Animation", 32, 4, fields_dimmer_animation },
+  { 60, 10, "Dimmer", "Color", 6, 1, fields_dimmer_color },
+  { 60, 11, "Dimmer", "ColorAnimation", 115, 4, fields_dimmer_coloranimation }
+};
+
+const uint8_t shc_message_count = sizeof(shc_messages) / sizeof(shc_messages[0]);
@@ -357,7 +357,7 @@ public class SourceCodeGeneratorE2P
 				
 				sb.append("static inline void " + functionPrefix + "_set_" + ID.toLowerCase() + "(" + funcParam + "void *src)" + newline);
 				sb.append("{" + newline);
-				sb.append("  eeprom_write_block(src, (uint8_t *)((" + accessStr + ") / 8), " + bytes + ");" + newline);
+				sb.append("  e2p_write_block(src, (" + accessStr + ") / 8, " + bytes + ");" + newline);
 				sb.append("}" + newline);
 				sb.append(newline);
 				
@@ -369,7 +369,7 @@ public class SourceCodeGeneratorE2P
 				// TODO: Return minimal type uint8_t, ...
 				sb.append("static inline void " + functionPrefix + "_get_" + ID.toLowerCase() + "(" + funcParam + "void *dst)" + newline);
 				sb.append("{" + newline);
-				sb.append("  eeprom_read_block(dst, (uint8_t *)((" + accessStr + ") / 8), " + bytes + ");" + newline);
+				sb.append("  e2p_read_block(dst, (" + accessStr + ") / 8, " + bytes + ");" + newline);
 				sb.append("}" + newline);
 				sb.append(newline);
 
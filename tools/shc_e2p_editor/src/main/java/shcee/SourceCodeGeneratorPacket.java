@@ -23,6 +23,8 @@ import java.io.FileWriter;
 import java.io.IOException;
 import java.io.PrintWriter;
 import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Comparator;
 import java.util.Hashtable;
 
 import javax.swing.JOptionPane;
@@ -43,6 +45,19 @@ public class SourceCodeGeneratorPacket
 	private static String newline = System.getProperty("line.separator");
 	private Hashtable<String, Integer> headerExtOffset = new Hashtable<String, Integer>();
 	private Hashtable<String, Integer> headerExtFieldOccurrences = new Hashtable<String, Integer>();
+	private ArrayList<MessageInfo> messageInfos = new ArrayList<MessageInfo>();
+
+	/**
+	 * The information about one message which is needed for the dispatch table.
+	 */
+	private static class MessageInfo
+	{
+		int messageGroupID;
+		int messageID;
+		String name;
+		int dataBits;
+		ArrayList<Integer> messageTypes;
+	}
 
 	public SourceCodeGeneratorPacket() throws Exception
 	{
@@ -79,6 +94,10 @@ public class SourceCodeGeneratorPacket
 		generateMessageGroupFiles(xmlRoot, messageTypes);
 
 		generateHeaderExtensionCommonFile(xmlRoot, messageTypes);
+
+		generateDispatchFile(xmlRoot, messageTypes);
+
+		generateHostLayoutFile(xmlRoot, messageTypes);
 	}
 
 	/**
@@ -130,6 +149,28 @@ public class SourceCodeGeneratorPacket
 		outHeader.println("// in common header extension access functions.");
 		outHeader.println("uint8_t __MESSAGETYPE;");
 		outHeader.println("");
+		outHeader.println("// Codec context for encoding / decoding a packet in the given buffer (with BUFX_LENGTH");
+		outHeader.println("// bytes) independently of bufx and the global header state above. Every access");
+		outHeader.println("// function has a \"_ctx_\" variant taking the context as first parameter. The");
+		outHeader.println("// functions without context are kept for compatibility and use the global state.");
+		outHeader.println("typedef struct {");
+		outHeader.println("  uint8_t * buf;");
+		outHeader.println("  uint8_t headeroffsetbits;");
+		outHeader.println("  uint8_t packetsizebytes;");
+		outHeader.println("  uint8_t messagetype;");
+		outHeader.println("} pkg_ctx_t;");
+		outHeader.println("");
+		outHeader.println("// Context representing bufx and the global header state.");
+		outHeader.println("#define PKG_CTX_GLOBAL (&(pkg_ctx_t){ bufx, __HEADEROFFSETBITS, __PACKETSIZEBYTES, __MESSAGETYPE })");
+		outHeader.println("");
+		outHeader.println("// Copy the header state of the given context to the global variables.");
+		outHeader.println("static inline void pkg_ctx_store_global(const pkg_ctx_t * ctx)");
+		outHeader.println("{");
+		outHeader.println("  __HEADEROFFSETBITS = ctx->headeroffsetbits;");
+		outHeader.println("  __PACKETSIZEBYTES = ctx->packetsizebytes;");
+		outHeader.println("  __MESSAGETYPE = ctx->messagetype;");
+		outHeader.println("}");
+		outHeader.println("");
 
 		// MessageGroupID enum
 
@@ -166,9 +207,14 @@ public class SourceCodeGeneratorPacket
 		// additional helper functions
 
 		outHeader.println("// Function to check CRC value against calculated one (after reception).");
+		outHeader.println("static inline bool pkg_header_ctx_check_crc32(const pkg_ctx_t * ctx, uint8_t packet_size_bytes)");
+		outHeader.println("{");
+		outHeader.println("  return array_read_UIntValue32(0, 32, 0, UINT32_MAX, ctx->buf) == crc32(ctx->buf + 4, packet_size_bytes - 4);");
+		outHeader.println("}");
+		outHeader.println("");
 		outHeader.println("static inline bool pkg_header_check_crc32(uint8_t packet_size_bytes)");
 		outHeader.println("{");
-		outHeader.println("  return getBuf32(0) == crc32(bufx + 4, packet_size_bytes - 4);");
+		outHeader.println("  return pkg_header_ctx_check_crc32(PKG_CTX_GLOBAL, packet_size_bytes);");
 		outHeader.println("}");
 		outHeader.println("");
 
@@ -211,14 +257,14 @@ public class SourceCodeGeneratorPacket
 
 		// "adjust offset" function
 
-		outHeader.println("// Initialize the header offset variable, used to correctly interpret");
+		outHeader.println("// Initialize the header offset of the context, used to correctly interpret");
 		outHeader.println("// contents of the header extension and the message data after reception.");
-		outHeader.println("static void pkg_header_adjust_offset(void) __attribute__ ((unused));");
-		outHeader.println("static void pkg_header_adjust_offset(void)");
+		outHeader.println("static void pkg_header_ctx_adjust_offset(pkg_ctx_t * ctx) __attribute__ ((unused));");
+		outHeader.println("static void pkg_header_ctx_adjust_offset(pkg_ctx_t * ctx)");
 		outHeader.println("{");
-		outHeader.println("  __MESSAGETYPE = pkg_header_get_messagetype();");
+		outHeader.println("  ctx->messagetype = pkg_header_ctx_get_messagetype(ctx);");
 		outHeader.println("");
-		outHeader.println("  switch (__MESSAGETYPE)");
+		outHeader.println("  switch (ctx->messagetype)");
 		outHeader.println("  {");
 
 		for (Integer messageTypeID : messageTypes.keySet())
@@ -226,13 +272,24 @@ public class SourceCodeGeneratorPacket
 			String messageTypeName = messageTypes.get(messageTypeID);
 
 			outHeader.println("    case MESSAGETYPE_" + messageTypeName.toUpperCase() + ":");
-			outHeader.println("      __HEADEROFFSETBITS = " + headerExtOffset.get(messageTypeName) + ";");
+			outHeader.println("      ctx->headeroffsetbits = " + headerExtOffset.get(messageTypeName) + ";");
 			outHeader.println("      break;");
 		}
 
 		outHeader.println("  }");
 		outHeader.println("}");
 		outHeader.println("");
+		outHeader.println("// Initialize the header offset variable, used to correctly interpret");
+		outHeader.println("// contents of the header extension and the message data after reception.");
+		outHeader.println("static void pkg_header_adjust_offset(void) __attribute__ ((unused));");
+		outHeader.println("static void pkg_header_adjust_offset(void)");
+		outHeader.println("{");
+		outHeader.println("  pkg_ctx_t ctx = *PKG_CTX_GLOBAL;");
+		outHeader.println("");
+		outHeader.println("  pkg_header_ctx_adjust_offset(&ctx);");
+		outHeader.println("  pkg_ctx_store_global(&ctx);");
+		outHeader.println("}");
+		outHeader.println("");
 
 		// common access function for header extension fields
 
@@ -245,10 +302,10 @@ public class SourceCodeGeneratorPacket
 
 			outHeader.println("// Set " + name + " (" + shcType + ")");
 			outHeader.println("// Same function for all MessageTypes!");
-			outHeader.println("static void pkg_headerext_common_set_" + name.toLowerCase() + "(" + cType + " val) __attribute__ ((unused));");
-			outHeader.println("static void pkg_headerext_common_set_" + name.toLowerCase() + "(" + cType + " val)");
+			outHeader.println("static void pkg_headerext_common_ctx_set_" + name.toLowerCase() + "(const pkg_ctx_t * ctx, " + cType + " val) __attribute__ ((unused));");
+			outHeader.println("static void pkg_headerext_common_ctx_set_" + name.toLowerCase() + "(const pkg_ctx_t * ctx, " + cType + " val)");
 			outHeader.println("{");
-			outHeader.println("  switch (__MESSAGETYPE)");
+			outHeader.println("  switch (ctx->messagetype)");
 			outHeader.println("  {");
 
 			for (Integer messageTypeID : messageTypes.keySet())
@@ -258,7 +315,7 @@ public class SourceCodeGeneratorPacket
 				if (headerExtensionContainsField(xmlRoot, messageTypeID, name))
 				{
 					outHeader.println("    case MESSAGETYPE_" + messageTypeName.toUpperCase() + ":");
-					outHeader.println("      pkg_headerext_" + messageTypeName.toLowerCase() + "_set_" + name.toLowerCase() + "(val);");
+					outHeader.println("      pkg_headerext_" + messageTypeName.toLowerCase() + "_ctx_set_" + name.toLowerCase() + "(ctx, val);");
 					outHeader.println("      break;");
 				}
 			}
@@ -270,14 +327,21 @@ public class SourceCodeGeneratorPacket
 			outHeader.println("}");
 			outHeader.println("");
 
+			outHeader.println("static void pkg_headerext_common_set_" + name.toLowerCase() + "(" + cType + " val) __attribute__ ((unused));");
+			outHeader.println("static void pkg_headerext_common_set_" + name.toLowerCase() + "(" + cType + " val)");
+			outHeader.println("{");
+			outHeader.println("  pkg_headerext_common_ctx_set_" + name.toLowerCase() + "(PKG_CTX_GLOBAL, val);");
+			outHeader.println("}");
+			outHeader.println("");
+
 			// GET
 
 			outHeader.println("// Get " + name + " (" + shcType + ")");
 			outHeader.println("// Same function for all MessageTypes!");
-			outHeader.println("static " + cType + " pkg_headerext_common_get_" + name.toLowerCase() + "(void) __attribute__ ((unused));");
-			outHeader.println("static " + cType + " pkg_headerext_common_get_" + name.toLowerCase() + "(void)");
+			outHeader.println("static " + cType + " pkg_headerext_common_ctx_get_" + name.toLowerCase() + "(const pkg_ctx_t * ctx) __attribute__ ((unused));");
+			outHeader.println("static " + cType + " pkg_headerext_common_ctx_get_" + name.toLowerCase() + "(const pkg_ctx_t * ctx)");
 			outHeader.println("{");
-			outHeader.println("  switch (__MESSAGETYPE)");
+			outHeader.println("  switch (ctx->messagetype)");
 			outHeader.println("  {");
 
 			for (Integer messageTypeID : messageTypes.keySet())
@@ -287,7 +351,7 @@ public class SourceCodeGeneratorPacket
 				if (headerExtensionContainsField(xmlRoot, messageTypeID, name))
 				{
 					outHeader.println("    case MESSAGETYPE_" + messageTypeName.toUpperCase() + ":");
-					outHeader.println("      return pkg_headerext_" + messageTypeName.toLowerCase() + "_get_" + name.toLowerCase() + "();");
+					outHeader.println("      return pkg_headerext_" + messageTypeName.toLowerCase() + "_ctx_get_" + name.toLowerCase() + "(ctx);");
 					outHeader.println("      break;");
 				}
 			}
@@ -299,6 +363,13 @@ public class SourceCodeGeneratorPacket
 			outHeader.println("  }");
 			outHeader.println("}");
 			outHeader.println("");
+
+			outHeader.println("static " + cType + " pkg_headerext_common_get_" + name.toLowerCase() + "(void) __attribute__ ((unused));");
+			outHeader.println("static " + cType + " pkg_headerext_common_get_" + name.toLowerCase() + "(void)");
+			outHeader.println("{");
+			outHeader.println("  return pkg_headerext_common_ctx_get_" + name.toLowerCase() + "(PKG_CTX_GLOBAL);");
+			outHeader.println("}");
+			outHeader.println("");
 		}
 
 		outHeader.println("#endif /* _PACKET_HEADEREXT_COMMON_H */");
@@ -306,6 +377,430 @@ public class SourceCodeGeneratorPacket
 		outHeader.close();
 	}
 
+	/**
+	 * Generate the source code (.c) file of the host library libshcpacket, which contains
+	 * the names, positions and types of the data fields of all messages. The positions are
+	 * relative to the start of the message data, as printed in the "MD=" part of the
+	 * "PKT:" lines of the base station.
+	 * @param xmlRoot
+	 * @param messageTypes
+	 * @throws Exception
+	 */
+	private void generateHostLayoutFile(Node xmlRoot, Hashtable<Integer, String> messageTypes) throws Exception
+	{
+		PrintWriter out = new PrintWriter(new FileWriter("../../host_software/libshcpacket/shcpacket_layout.c"));
+
+		out.println(genCopyrightNotice());
+		out.println("#include <stddef.h>");
+		out.println("#include \"shcpacket.h\"");
+		out.println("");
+
+		// MessageType names
+
+		ArrayList<Integer> messageTypeIDs = new ArrayList<Integer>(messageTypes.keySet());
+		Collections.sort(messageTypeIDs);
+
+		out.println("// Names of the MessageTypes, indexed by the MessageType.");
+		out.println("const char * const shc_message_type_names[SHC_MESSAGETYPE_COUNT] = {");
+
+		for (int i = 0; i < messageTypeIDs.size(); i++)
+		{
+			String suffix = i == messageTypeIDs.size() - 1 ? "" : ",";
+			out.println("  [" + messageTypeIDs.get(i) + "] = \"" + messageTypes.get(messageTypeIDs.get(i)) + "\"" + suffix);
+		}
+
+		out.println("};");
+		out.println("");
+
+		// field tables of all messages
+
+		ArrayList<MessageInfo> infos = new ArrayList<MessageInfo>();
+		Hashtable<MessageInfo, String> rows = new Hashtable<MessageInfo, String>();
+		NodeList msgGroupNodes = XPathAPI.selectNodeList(xmlRoot, "MessageGroup");
+
+		for (int g = 0; g < msgGroupNodes.getLength(); g++)
+		{
+			Node msgGroupNode = msgGroupNodes.item(g);
+			String messageGroupName = Util.getChildNodeValue(msgGroupNode, "Name");
+			int messageGroupID = Integer.parseInt(Util.getChildNodeValue(msgGroupNode, "MessageGroupID"));
+			NodeList msgNodes = XPathAPI.selectNodeList(msgGroupNode, "Message");
+
+			for (int m = 0; m < msgNodes.getLength(); m++)
+			{
+				Node msgNode = msgNodes.item(m);
+				String messageName = Util.getChildNodeValue(msgNode, "Name");
+				int messageID = Integer.parseInt(Util.getChildNodeValue(msgNode, "MessageID"));
+				String varName = messageGroupName.toLowerCase() + "_" + messageName.toLowerCase().replace(' ', '_');
+
+				StringBuilder enums = new StringBuilder();
+				ArrayList<String> fields = new ArrayList<String>();
+				generateHostFieldDefs(msgNode, varName, 0, 1, 0, enums, fields);
+				int fieldCount = fields.size();
+				int dataBits = getHostDataBits(msgNode);
+
+				out.print(enums.toString());
+
+				if (fieldCount > 0)
+				{
+					out.println("// Data fields of message \"" + messageGroupName + "\" / \"" + messageName + "\"");
+					out.println("static const shc_field_t fields_" + varName + "[] = {");
+
+					for (int i = 0; i < fieldCount; i++)
+					{
+						String suffix = i == fieldCount - 1 ? "" : ",";
+						out.println(fields.get(i) + suffix);
+					}
+
+					out.println("};");
+					out.println("");
+				}
+
+				MessageInfo info = new MessageInfo();
+				info.messageGroupID = messageGroupID;
+				info.messageID = messageID;
+				infos.add(info);
+				rows.put(info, "  { " + messageGroupID + ", " + messageID + ", \"" + messageGroupName + "\", \"" + messageName + "\", "
+						+ dataBits + ", " + fieldCount + ", " + (fieldCount > 0 ? "fields_" + varName : "NULL") + " }");
+			}
+		}
+
+		// message table, sorted like the dispatch table for binary search
+
+		Collections.sort(infos, new Comparator<MessageInfo>() {
+			public int compare(MessageInfo a, MessageInfo b)
+			{
+				return ((a.messageGroupID << 8) + a.messageID) - ((b.messageGroupID << 8) + b.messageID);
+			}
+		});
+
+		out.println("// All messages, sorted by MessageGroupID and MessageID.");
+		out.println("const shc_message_t shc_messages[] = {");
+
+		for (int i = 0; i < infos.size(); i++)
+		{
+			String suffix = i == infos.size() - 1 ? "" : ",";
+			out.println(rows.get(infos.get(i)) + suffix);
+		}
+
+		out.println("};");
+		out.println("");
+		out.println("const uint8_t shc_message_count = sizeof(shc_messages) / sizeof(shc_messages[0]);");
+
+		out.close();
+	}
+
+	/**
+	 * Generate the rows of the field table and the enum element tables for the data fields
+	 * of the given node. Arrays are handled by a recursive call.
+	 */
+	private void generateHostFieldDefs(Node dataNode, String varName, int offset, int count, int stride, StringBuilder enums, ArrayList<String> fields) throws TransformerException
+	{
+		NodeList childs = dataNode.getChildNodes();
+
+		for (int e = 0; e < childs.getLength(); e++)
+		{
+			Node element = childs.item(e);
+			String nodeName = element.getNodeName();
+
+			if (nodeName.equals("Reserved"))
+			{
+				offset += Integer.parseInt(Util.getChildNodeValue(element, "Bits"));
+				continue;
+			}
+			else if (nodeName.equals("Array"))
+			{
+				int length = Integer.parseInt(Util.getChildNodeValue(element, "Length"));
+				int structLen = getOvrArrayStructLen(element);
+
+				generateHostFieldDefs(element, varName, offset, length, structLen, enums, fields);
+				offset += length * structLen;
+				continue;
+			}
+
+			String ID;
+			String type;
+			int bits;
+			String minVal = "0";
+			String maxVal = "0";
+			String elements = "NULL, 0";
+
+			if (nodeName.equals("UIntValue") || nodeName.equals("IntValue"))
+			{
+				ID = Util.getChildNodeValue(element, "ID");
+				type = nodeName.equals("UIntValue") ? "SHC_FIELD_UINT" : "SHC_FIELD_INT";
+				bits = Integer.parseInt(Util.getChildNodeValue(element, "Bits"));
+				minVal = Util.getChildNodeValue(element, "MinVal");
+				maxVal = Util.getChildNodeValue(element, "MaxVal");
+			}
+			else if (nodeName.equals("BoolValue"))
+			{
+				ID = Util.getChildNodeValue(element, "ID");
+				type = "SHC_FIELD_BOOL";
+				bits = 1;
+				maxVal = "1";
+			}
+			else if (nodeName.equals("FloatValue"))
+			{
+				ID = Util.getChildNodeValue(element, "ID");
+				type = "SHC_FIELD_FLOAT";
+				bits = 32;
+			}
+			else if (nodeName.equals("ByteArray"))
+			{
+				ID = Util.getChildNodeValue(element, "ID");
+				type = "SHC_FIELD_BYTEARRAY";
+				bits = Integer.parseInt(Util.getChildNodeValue(element, "Bytes")) * 8;
+			}
+			else if (nodeName.equals("EnumValue"))
+			{
+				ID = Util.getChildNodeValue(element, "ID");
+				type = "SHC_FIELD_ENUM";
+				bits = Integer.parseInt(Util.getChildNodeValue(element, "Bits"));
+				maxVal = Integer.toString((1 << bits) - 1);
+
+				String enumName = "enum_" + varName + "_" + ID.toLowerCase();
+				NodeList enumNodes = XPathAPI.selectNodeList(element, "Element");
+
+				enums.append("// Elements of enum \"" + ID + "\"" + newline);
+				enums.append("static const shc_enum_element_t " + enumName + "[] = {" + newline);
+
+				for (int i = 0; i < enumNodes.getLength(); i++)
+				{
+					Node enumNode = enumNodes.item(i);
+					String suffix = i == enumNodes.getLength() - 1 ? "" : ",";
+
+					enums.append("  { " + Util.getChildNodeValue(enumNode, "Value") + ", \"" + Util.getChildNodeValue(enumNode, "Name") + "\" }" + suffix + newline);
+				}
+
+				enums.append("};" + newline);
+				enums.append(newline);
+
+				elements = enumName + ", " + enumNodes.getLength();
+			}
+			else
+			{
+				continue;
+			}
+
+			fields.add("  { \"" + ID + "\", " + type + ", " + offset + ", " + bits + ", " + count + ", " + stride + ", "
+					+ minVal + ", " + maxVal + ", " + elements + " }");
+
+			offset += bits;
+		}
+	}
+
+	/**
+	 * Return the length of the message data in bits.
+	 */
+	private int getHostDataBits(Node dataNode) throws TransformerException
+	{
+		int bits = 0;
+		NodeList childs = dataNode.getChildNodes();
+
+		for (int e = 0; e < childs.getLength(); e++)
+		{
+			Node element = childs.item(e);
+			String nodeName = element.getNodeName();
+
+			if (nodeName.equals("Array"))
+			{
+				bits += Integer.parseInt(Util.getChildNodeValue(element, "Length")) * getOvrArrayStructLen(element);
+			}
+			else if (nodeName.equals("Reserved") || nodeName.equals("UIntValue") || nodeName.equals("IntValue") || nodeName.equals("EnumValue"))
+			{
+				bits += Integer.parseInt(Util.getChildNodeValue(element, "Bits"));
+			}
+			else if (nodeName.equals("FloatValue"))
+			{
+				bits += 32;
+			}
+			else if (nodeName.equals("ByteArray"))
+			{
+				bits += Integer.parseInt(Util.getChildNodeValue(element, "Bytes")) * 8;
+			}
+			else if (nodeName.equals("BoolValue"))
+			{
+				bits += 1;
+			}
+		}
+
+		return bits;
+	}
+
+	/**
+	 * Generate the source code (.h) file containing a table of all messages, sorted by
+	 * MessageGroupID and MessageID, and the functions to dispatch a received packet to
+	 * the handler function a device registered for the message.
+	 * @param xmlRoot
+	 * @param messageTypes
+	 * @throws Exception
+	 */
+	private void generateDispatchFile(Node xmlRoot, Hashtable<Integer, String> messageTypes) throws Exception
+	{
+		Node messageIDBitsNode = XPathAPI.selectSingleNode(xmlRoot, "HeaderExtension/UIntValue[ID=\"MessageID\"]/Bits");
+		int messageIDBits = Integer.parseInt(messageIDBitsNode.getFirstChild().getNodeValue());
+
+		ArrayList<MessageInfo> infos = new ArrayList<MessageInfo>(messageInfos);
+
+		Collections.sort(infos, new Comparator<MessageInfo>() {
+			public int compare(MessageInfo a, MessageInfo b)
+			{
+				return ((a.messageGroupID << 8) + a.messageID) - ((b.messageGroupID << 8) + b.messageID);
+			}
+		});
+
+		int messageTypesWithData = 0;
+
+		for (Integer messageTypeID : messageTypes.keySet())
+		{
+			if (containsMessageData(xmlRoot, messageTypeID))
+			{
+				messageTypesWithData |= 1 << messageTypeID;
+			}
+		}
+
+		PrintWriter out = new PrintWriter(new FileWriter("../../firmware/src_common/packet_dispatch.h"));
+
+		out.println(genCopyrightNotice());
+		out.println("#ifndef _PACKET_DISPATCH_H");
+		out.println("#define _PACKET_DISPATCH_H");
+		out.println("");
+		out.println("#include <string.h>");
+		out.println("");
+		out.println("#include \"packet_header.h\"");
+		out.println("#include \"packet_headerext_common.h\"");
+		out.println("");
+		out.println("#include \"hal.h\"");
+		out.println("");
+		out.println("// This file contains a table of all messages, sorted by MessageGroupID and MessageID.");
+		out.println("// A device registers its handler functions in a table indexed by the message slot,");
+		out.println("// so that a received packet is routed without comparing the IDs one after another.");
+		out.println("// The packet length is checked against the header length before the handler is");
+		out.println("// called. The header offset depends only on the MessageType and is set by");
+		out.println("// pkg_header_adjust_offset(), which has to be called before.");
+		out.println("");
+
+		out.println("// ENUM for the slots of the messages in the dispatch table");
+		out.println("typedef enum {");
+
+		for (int i = 0; i < infos.size(); i++)
+		{
+			out.println("  MSGSLOT_" + infos.get(i).name.toUpperCase() + " = " + i + ",");
+		}
+
+		out.println("  MSGSLOT_COUNT = " + infos.size());
+		out.println("} MessageSlotEnum;");
+		out.println("");
+
+		out.println("// Bit mask of the MessageTypes which contain message data.");
+		out.println("#define PKG_MESSAGETYPES_WITH_DATA 0x" + String.format("%04x", messageTypesWithData));
+		out.println("");
+
+		out.println("typedef struct {");
+		out.println("  uint16_t key;          // MessageGroupID << " + messageIDBits + " | MessageID");
+		out.println("  uint16_t messagetypes; // bit mask of the possible MessageTypes");
+		out.println("  uint16_t databits;     // length of the message data in bits");
+		out.println("} pkg_dispatch_entry_t;");
+		out.println("");
+
+		out.println("static const pkg_dispatch_entry_t pkg_dispatch_table[MSGSLOT_COUNT] PROGMEM = {");
+
+		for (int i = 0; i < infos.size(); i++)
+		{
+			MessageInfo info = infos.get(i);
+			int mask = 0;
+
+			for (Integer messageTypeID : info.messageTypes)
+			{
+				mask |= 1 << messageTypeID;
+			}
+
+			String suffix = i == infos.size() - 1 ? "" : ",";
+
+			out.println("  { (" + info.messageGroupID + " << " + messageIDBits + ") | " + info.messageID + ", 0x" + String.format("%04x", mask)
+					+ ", " + info.dataBits + " }" + suffix + " // " + info.name);
+		}
+
+		out.println("};");
+		out.println("");
+
+		out.println("// Result of pkg_dispatch()");
+		out.println("typedef enum {");
+		out.println("  PKG_DISPATCH_OK = 0,");
+		out.println("  PKG_DISPATCH_UNKNOWN_MESSAGE = 1,");
+		out.println("  PKG_DISPATCH_UNSUPPORTED_MESSAGETYPE = 2,");
+		out.println("  PKG_DISPATCH_PACKET_TOO_SHORT = 3,");
+		out.println("  PKG_DISPATCH_NO_HANDLER = 4");
+		out.println("} PkgDispatchResultEnum;");
+		out.println("");
+
+		out.println("// Function handling one message, called with the MessageType of the received packet.");
+		out.println("typedef void (*pkg_handler_t)(MessageTypeEnum messagetype);");
+		out.println("");
+
+		out.println("// Return the slot of the message with the given IDs or MSGSLOT_COUNT if it is unknown.");
+		out.println("static uint8_t pkg_dispatch_find_slot(uint8_t messagegroupid, uint8_t messageid) __attribute__ ((unused));");
+		out.println("static uint8_t pkg_dispatch_find_slot(uint8_t messagegroupid, uint8_t messageid)");
+		out.println("{");
+		out.println("  uint16_t key = ((uint16_t)messagegroupid << " + messageIDBits + ") | messageid;");
+		out.println("  uint8_t lo = 0;");
+		out.println("  uint8_t hi = MSGSLOT_COUNT;");
+		out.println("");
+		out.println("  while (lo < hi)");
+		out.println("  {");
+		out.println("    uint8_t mid = (lo + hi) / 2;");
+		out.println("    uint16_t k = pgm_read_word(&pkg_dispatch_table[mid].key);");
+		out.println("");
+		out.println("    if (k == key)");
+		out.println("      return mid;");
+		out.println("    else if (k < key)");
+		out.println("      lo = mid + 1;");
+		out.println("    else");
+		out.println("      hi = mid;");
+		out.println("  }");
+		out.println("");
+		out.println("  return MSGSLOT_COUNT;");
+		out.println("}");
+		out.println("");
+
+		out.println("// Look up the received message in the dispatch table, check the MessageType and the");
+		out.println("// packet length and call the handler from the given table (in PROGMEM, indexed by the");
+		out.println("// message slot, NULL for unsupported messages).");
+		out.println("// Trailing zero bytes are not sent (see rfm12_send_bufx), so the packet only has to");
+		out.println("// contain the header. The bytes after the received length are cleared in bufx to read");
+		out.println("// the missing message data as 0.");
+		out.println("static PkgDispatchResultEnum pkg_dispatch(uint8_t len, const pkg_handler_t * handlers) __attribute__ ((unused));");
+		out.println("static PkgDispatchResultEnum pkg_dispatch(uint8_t len, const pkg_handler_t * handlers)");
+		out.println("{");
+		out.println("  if (len < (__HEADEROFFSETBITS + 7) / 8)");
+		out.println("    return PKG_DISPATCH_PACKET_TOO_SHORT;");
+		out.println("");
+		out.println("  if (len < BUFX_LENGTH)");
+		out.println("    memset(bufx + len, 0, BUFX_LENGTH - len);");
+		out.println("");
+		out.println("  uint8_t slot = pkg_dispatch_find_slot(pkg_headerext_common_get_messagegroupid(), pkg_headerext_common_get_messageid());");
+		out.println("");
+		out.println("  if (slot == MSGSLOT_COUNT)");
+		out.println("    return PKG_DISPATCH_UNKNOWN_MESSAGE;");
+		out.println("");
+		out.println("  if (!(pgm_read_word(&pkg_dispatch_table[slot].messagetypes) & (1 << __MESSAGETYPE)))");
+		out.println("    return PKG_DISPATCH_UNSUPPORTED_MESSAGETYPE;");
+		out.println("");
+		out.println("  pkg_handler_t handler = (pkg_handler_t)pgm_read_ptr(&handlers[slot]);");
+		out.println("");
+		out.println("  if (handler == NULL)");
+		out.println("    return PKG_DISPATCH_NO_HANDLER;");
+		out.println("");
+		out.println("  handler(__MESSAGETYPE);");
+		out.println("  return PKG_DISPATCH_OK;");
+		out.println("}");
+		out.println("");
+
+		out.println("#endif /* _PACKET_DISPATCH_H */");
+
+		out.close();
+	}
+
 	/**
 	 * Generate one source code (.h) file for every packet header extension.
 	 * @param xmlRoot
@@ -480,6 +975,14 @@ public class SourceCodeGeneratorPacket
 
 				int offset2 = generateDataFieldDefs(msgNode, true, 0, "msg_" + fullMessageName, funcDefs, dataFields, 0, 0);
 
+				MessageInfo info = new MessageInfo();
+				info.messageGroupID = Integer.parseInt(messageGroupID);
+				info.messageID = Integer.parseInt(messageID);
+				info.name = fullMessageName;
+				info.dataBits = offset2;
+				info.messageTypes = possibleMessageTypes;
+				messageInfos.add(info);
+
 				out.println("");
 
 				String h2 = "// Message \"" + fullMessageName + "\"";
@@ -503,16 +1006,18 @@ public class SourceCodeGeneratorPacket
 					int messageTypeID = possibleMessageTypes.get(p);
 					String messageTypeName = messageTypes.get(messageTypeID);
 
+					String initName = fullMessageName + "_" + messageTypeName.toLowerCase();
+
 					out.println("// Function to initialize header for the MessageType \"" + messageTypeName + "\".");
-					out.println("static inline void pkg_header_init_" + fullMessageName + "_" + messageTypeName.toLowerCase() + "(void)");
+					out.println("static inline void pkg_header_ctx_init_" + initName + "(pkg_ctx_t * ctx)");
 					out.println("{");
-					out.println("  memset(&bufx[0], 0, sizeof(bufx));");
-					out.println("  pkg_header_set_messagetype(" + messageTypeID + ");");
+					out.println("  memset(ctx->buf, 0, BUFX_LENGTH);");
+					out.println("  pkg_header_ctx_set_messagetype(ctx, " + messageTypeID + ");");
 
 					if (headerExtensionContainsField(xmlRoot, messageTypeID, "MessageID"))
 					{
-						out.println("  pkg_headerext_" + messageTypeName.toLowerCase() + "_set_messagegroupid(" + messageGroupID + ");");
-						out.println("  pkg_headerext_" + messageTypeName.toLowerCase() + "_set_messageid(" + messageID + ");");
+						out.println("  pkg_headerext_" + messageTypeName.toLowerCase() + "_ctx_set_messagegroupid(ctx, " + messageGroupID + ");");
+						out.println("  pkg_headerext_" + messageTypeName.toLowerCase() + "_ctx_set_messageid(ctx, " + messageID + ");");
 					}
 
 					int hdrBits = headerExtOffset.get(messageTypeName);
@@ -520,16 +1025,27 @@ public class SourceCodeGeneratorPacket
 					int neededBytes = (ovrBits - 1) / 8 + 1;
 					int packetBytes = ((neededBytes - 1) / 16 + 1) * 16;
 
-					out.println("  __HEADEROFFSETBITS = " + hdrBits + ";");
-					out.println("  __PACKETSIZEBYTES = " + packetBytes + ";");
-					out.println("  __MESSAGETYPE = " + messageTypeID + ";");
+					out.println("  ctx->headeroffsetbits = " + hdrBits + ";");
+					out.println("  ctx->packetsizebytes = " + packetBytes + ";");
+					out.println("  ctx->messagetype = " + messageTypeID + ";");
+					out.println("}");
+					out.println("");
+					out.println("static inline void pkg_header_init_" + initName + "(void)");
+					out.println("{");
+					out.println("  pkg_ctx_t ctx = { bufx };");
+					out.println("");
+					out.println("  pkg_header_ctx_init_" + initName + "(&ctx);");
+					out.println("  pkg_ctx_store_global(&ctx);");
 					out.println("}");
 					out.println("");
-
 				}
 
 				out.print(funcDefs.toString());
 
+				if (dataFields.size() > 0)
+				{
+					generateStructDefs(msgNode, "msg_" + fullMessageName, out);
+				}
 			}
 
 			out.println("#endif /* " + defineStr + " */");
@@ -711,28 +1227,21 @@ public class SourceCodeGeneratorPacket
 				EnumDuplicateChecker.checkEnumDefinition(ID1, enumDefs);
 
 				String offsetStr = calcAccessStr(useHeaderOffset, offset, structLengthBits, isArray);
+				String offsetStrCtx = calcAccessStr(useHeaderOffset, offset, structLengthBits, isArray, true);
 
 				// SET
 
 				sb.append("// Set " + ID1 + " (EnumValue)" + newline);
 				sb.append("// Offset: " + offsetStr + ", length bits " + bits + newline);
 
-				sb.append("static inline void " + functionPrefix + "_set_" + ID1.toLowerCase() + "(" + funcParam + ID1 + "Enum val)" + newline);
-				sb.append("{" + newline);
-				sb.append("  array_write_UIntValue(" + offsetStr + ", " + bits + ", val, bufx);" + newline);
-				sb.append("}" + newline);
-				sb.append(newline);
+				appendAccessFunctions(sb, "void", functionPrefix, "set_" + ID1.toLowerCase(), funcParam + ID1 + "Enum val", "array_write_UIntValue(" + offsetStrCtx + ", " + bits + ", val, ctx->buf);");
 
 				// GET
 
 				sb.append("// Get " + ID1 + " (EnumValue)" + newline);
 				sb.append("// Offset: " + offsetStr + ", length bits " + bits + newline);
 
-				sb.append("static inline " + ID1 + "Enum " + functionPrefix + "_get_" + ID1.toLowerCase() + "(" + funcParam2 + ")" + newline);
-				sb.append("{" + newline);
-				sb.append("  return array_read_UIntValue32(" + offsetStr + ", " + bits + ", 0, " + ((1 << bits) - 1) + ", bufx);" + newline);
-				sb.append("}" + newline);
-				sb.append(newline);
+				appendAccessFunctions(sb, ID1 + "Enum", functionPrefix, "get_" + ID1.toLowerCase(), funcParam2, "return array_read_UIntValue32(" + offsetStrCtx + ", " + bits + ", 0, " + ((1 << bits) - 1) + ", ctx->buf);");
 
 				offset += bits;
 			}
@@ -762,17 +1271,14 @@ public class SourceCodeGeneratorPacket
 				sb.append(newline);
 
 				String offsetStr = calcAccessStr(useHeaderOffset, offset, structLengthBits, isArray);
+				String offsetStrCtx = calcAccessStr(useHeaderOffset, offset, structLengthBits, isArray, true);
 
 				// SET
 
 				sb.append("// Set " + ID + " (UIntValue)" + newline);
 				sb.append("// Offset: " + offsetStr + ", length bits " + bits + ", min val " + minVal + ", max val " + maxVal + newline);
 
-				sb.append("static inline void " + functionPrefix + "_set_" + ID.toLowerCase() + "(" + funcParam + "uint32_t val)" + newline);
-				sb.append("{" + newline);
-				sb.append("  array_write_UIntValue(" + offsetStr + ", " + bits + ", val, bufx);" + newline);
-				sb.append("}" + newline);
-				sb.append(newline);
+				appendAccessFunctions(sb, "void", functionPrefix, "set_" + ID.toLowerCase(), funcParam + "uint32_t val", "array_write_UIntValue(" + offsetStrCtx + ", " + bits + ", val, ctx->buf);");
 
 				// GET
 
@@ -780,11 +1286,7 @@ public class SourceCodeGeneratorPacket
 				sb.append("// Offset: " + offsetStr + ", length bits " + bits + ", min val " + minVal + ", max val " + maxVal + newline);
 
 				// TODO: Return minimal type uint8_t, ...
-				sb.append("static inline uint32_t " + functionPrefix + "_get_" + ID.toLowerCase() + "(" + funcParam2 + ")" + newline);
-				sb.append("{" + newline);
-				sb.append("  return array_read_UIntValue32(" + offsetStr + ", " + bits + ", " + minVal + ", " + maxVal + ", bufx);" + newline);
-				sb.append("}" + newline);
-				sb.append(newline);
+				appendAccessFunctions(sb, "uint32_t", functionPrefix, "get_" + ID.toLowerCase(), funcParam2, "return array_read_UIntValue32(" + offsetStrCtx + ", " + bits + ", " + minVal + ", " + maxVal + ", ctx->buf);");
 
 				offset += bits;
 
@@ -815,17 +1317,14 @@ public class SourceCodeGeneratorPacket
 				sb.append(newline);
 
 				String offsetStr = calcAccessStr(useHeaderOffset, offset, structLengthBits, isArray);
+				String offsetStrCtx = calcAccessStr(useHeaderOffset, offset, structLengthBits, isArray, true);
 
 				// SET
 
 				sb.append("// Set " + ID + " (IntValue)" + newline);
 				sb.append("// Offset: " + offsetStr + ", length bits " + bits + ", min val " + minVal + ", max val " + maxVal + newline);
 
-				sb.append("static inline void " + functionPrefix + "_set_" + ID.toLowerCase() + "(" + funcParam + "int32_t val)" + newline);
-				sb.append("{" + newline);
-				sb.append("  array_write_IntValue(" + offsetStr + ", " + bits + ", val, bufx);" + newline);
-				sb.append("}" + newline);
-				sb.append(newline);
+				appendAccessFunctions(sb, "void", functionPrefix, "set_" + ID.toLowerCase(), funcParam + "int32_t val", "array_write_IntValue(" + offsetStrCtx + ", " + bits + ", val, ctx->buf);");
 
 				// GET
 
@@ -833,11 +1332,7 @@ public class SourceCodeGeneratorPacket
 				sb.append("// Offset: " + offsetStr + ", length bits " + bits + ", min val " + minVal + ", max val " + maxVal + newline);
 
 				// TODO: Return minimal type uint8_t, ...
-				sb.append("static inline int32_t " + functionPrefix + "_get_" + ID.toLowerCase() + "(" + funcParam2 + ")" + newline);
-				sb.append("{" + newline);
-				sb.append("  return array_read_IntValue32(" + offsetStr + ", " + bits + ", " + minVal + ", " + maxVal + ", bufx);" + newline);
-				sb.append("}" + newline);
-				sb.append(newline);
+				appendAccessFunctions(sb, "int32_t", functionPrefix, "get_" + ID.toLowerCase(), funcParam2, "return array_read_IntValue32(" + offsetStrCtx + ", " + bits + ", " + minVal + ", " + maxVal + ", ctx->buf);");
 
 				offset += bits;
 			}
@@ -865,28 +1360,21 @@ public class SourceCodeGeneratorPacket
 				sb.append(newline);
 
 				String offsetStr = calcAccessStr(useHeaderOffset, offset, structLengthBits, isArray);
+				String offsetStrCtx = calcAccessStr(useHeaderOffset, offset, structLengthBits, isArray, true);
 
 				// SET
 
 				sb.append("// Set " + ID + " (FloatValue)" + newline);
 				sb.append("// Offset: " + offsetStr + ", length bits " + bits + newline);
 
-				sb.append("static inline void " + functionPrefix + "_set_" + ID.toLowerCase() + "(" + funcParam + "float val)" + newline);
-				sb.append("{" + newline);
-				sb.append("  array_write_FloatValue(" + offsetStr + ", val, bufx);" + newline);
-				sb.append("}" + newline);
-				sb.append(newline);
+				appendAccessFunctions(sb, "void", functionPrefix, "set_" + ID.toLowerCase(), funcParam + "float val", "array_write_FloatValue(" + offsetStrCtx + ", val, ctx->buf);");
 
 				// GET
 
 				sb.append("// Get " + ID + " (FloatValue)" + newline);
 				sb.append("// Offset: " + offsetStr + ", length bits " + bits + newline);
 
-				sb.append("static inline float " + functionPrefix + "_get_" + ID.toLowerCase() + "(" + funcParam2 + ")" + newline);
-				sb.append("{" + newline);
-				sb.append("  return array_read_FloatValue(" + offsetStr + ", bufx);" + newline);
-				sb.append("}" + newline);
-				sb.append(newline);
+				appendAccessFunctions(sb, "float", functionPrefix, "get_" + ID.toLowerCase(), funcParam2, "return array_read_FloatValue(" + offsetStrCtx + ", ctx->buf);");
 
 				offset += bits;
 			}
@@ -916,28 +1404,21 @@ public class SourceCodeGeneratorPacket
 				sb.append(newline);
 
 				String offsetStr = calcAccessStr(useHeaderOffset, offset, structLengthBits, isArray);
+				String offsetStrCtx = calcAccessStr(useHeaderOffset, offset, structLengthBits, isArray, true);
 
 				// SET
 
 				sb.append("// Set " + ID + " (ByteArray)" + newline);
 				sb.append("// Offset: " + offsetStr + ", length bytes " + bytes + newline);
 
-				sb.append("static inline void " + functionPrefix + "_set_" + ID.toLowerCase() + "(void *src)" + newline);
-				sb.append("{" + newline);
-				sb.append("  array_write_ByteArray(" + offsetStr + ", " + bytes + ", src, bufx);" + newline);
-				sb.append("}" + newline);
-				sb.append(newline);
+				appendAccessFunctions(sb, "void", functionPrefix, "set_" + ID.toLowerCase(), "void *src", "array_write_ByteArray(" + offsetStrCtx + ", " + bytes + ", src, ctx->buf);");
 
 				// GET
 
 				sb.append("// Get " + ID + " (ByteArray)" + newline);
 				sb.append("// Offset: " + offsetStr + ", length bytes " + bytes + newline);
 
-				sb.append("static inline void " + functionPrefix + "_get_" + ID.toLowerCase() + "(" + funcParam + "void *dst)" + newline);
-				sb.append("{" + newline);
-				sb.append("  array_read_ByteArray(" + offsetStr + ", " + bytes + ", dst, bufx);" + newline);
-				sb.append("}" + newline);
-				sb.append(newline);
+				appendAccessFunctions(sb, "void", functionPrefix, "get_" + ID.toLowerCase(), funcParam + "void *dst", "array_read_ByteArray(" + offsetStrCtx + ", " + bytes + ", dst, ctx->buf);");
 
 				offset += Integer.parseInt(bytes) * 8;
 			}
@@ -964,17 +1445,14 @@ public class SourceCodeGeneratorPacket
 				sb.append(newline);
 
 				String offsetStr = calcAccessStr(useHeaderOffset, offset, structLengthBits, isArray);
+				String offsetStrCtx = calcAccessStr(useHeaderOffset, offset, structLengthBits, isArray, true);
 
 				// SET
 
 				sb.append("// Set " + ID + " (BoolValue)" + newline);
 				sb.append("// Offset: " + offsetStr + ", length bits 1" + newline);
 
-				sb.append("static inline void " + functionPrefix + "_set_" + ID.toLowerCase() + "(" + funcParam + "bool val)" + newline);
-				sb.append("{" + newline);
-				sb.append("  array_write_UIntValue(" + offsetStr + ", " + 1 + ", val ? 1 : 0, bufx);" + newline);
-				sb.append("}" + newline);
-				sb.append(newline);
+				appendAccessFunctions(sb, "void", functionPrefix, "set_" + ID.toLowerCase(), funcParam + "bool val", "array_write_UIntValue(" + offsetStrCtx + ", " + 1 + ", val ? 1 : 0, ctx->buf);");
 
 				// GET
 
@@ -982,11 +1460,7 @@ public class SourceCodeGeneratorPacket
 				sb.append("// Offset: " + offsetStr + ", length bits 1" + newline);
 
 				// TODO: Return minimal type uint8_t, ...
-				sb.append("static inline bool " + functionPrefix + "_get_" + ID.toLowerCase() + "(" + funcParam2 + ")" + newline);
-				sb.append("{" + newline);
-				sb.append("  return array_read_UIntValue8(" + offsetStr + ", 1, 0, 1, bufx) == 1;" + newline);
-				sb.append("}" + newline);
-				sb.append(newline);
+				appendAccessFunctions(sb, "bool", functionPrefix, "get_" + ID.toLowerCase(), funcParam2, "return array_read_UIntValue8(" + offsetStrCtx + ", 1, 0, 1, ctx->buf) == 1;");
 
 				offset += bits;
 			}
@@ -1013,6 +1487,209 @@ public class SourceCodeGeneratorPacket
 		return offset;
 	}
 
+	/**
+	 * Generate a struct containing all data fields of the given message and functions
+	 * to unpack / pack the complete message data in one pass over the bit stream.
+	 * This is much faster than calling the getters / setters for every field, which
+	 * calculate the position of every value separately.
+	 * @param msgNode
+	 * @param functionPrefix
+	 * @param out
+	 * @throws TransformerException
+	 */
+	private void generateStructDefs(Node msgNode, String functionPrefix, PrintWriter out) throws TransformerException
+	{
+		StringBuilder members = new StringBuilder();
+		StringBuilder unpack = new StringBuilder();
+		StringBuilder pack = new StringBuilder();
+
+		boolean containsArray = generateStructFieldDefs(msgNode, "  ", "", members, unpack, pack);
+		String typeName = functionPrefix + "_t";
+
+		out.println("// Struct containing all data fields, used to unpack / pack the message data in one pass.");
+		out.println("typedef struct {");
+		out.print(members.toString());
+		out.println("} " + typeName + ";");
+		out.println("");
+
+		out.println("// Unpack all data fields from the buffer of the context into the struct.");
+		out.println("// The header has to be interpreted before by pkg_header_ctx_adjust_offset().");
+		out.println("static void " + functionPrefix + "_ctx_unpack(const pkg_ctx_t * ctx, " + typeName + " * msg) __attribute__ ((unused));");
+		out.println("static void " + functionPrefix + "_ctx_unpack(const pkg_ctx_t * ctx, " + typeName + " * msg)");
+		out.println("{");
+		out.println("  bitstream_t bs;");
+		if (containsArray)
+			out.println("  uint8_t i;");
+		out.println("");
+		out.println("  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);");
+		out.print(unpack.toString());
+		out.println("}");
+		out.println("");
+
+		out.println("// Unpack all data fields from the buffer into the struct.");
+		out.println("// The header has to be interpreted before by pkg_header_adjust_offset().");
+		out.println("static void " + functionPrefix + "_unpack(const uint8_t * buf, " + typeName + " * msg) __attribute__ ((unused));");
+		out.println("static void " + functionPrefix + "_unpack(const uint8_t * buf, " + typeName + " * msg)");
+		out.println("{");
+		out.println("  pkg_ctx_t ctx = { (uint8_t *)buf, __HEADEROFFSETBITS };");
+		out.println("");
+		out.println("  " + functionPrefix + "_ctx_unpack(&ctx, msg);");
+		out.println("}");
+		out.println("");
+
+		out.println("// Pack all data fields from the struct into the buffer of the context.");
+		out.println("// The header has to be initialized before by one of the pkg_header_ctx_init_* functions.");
+		out.println("static void " + functionPrefix + "_ctx_pack(const pkg_ctx_t * ctx, const " + typeName + " * msg) __attribute__ ((unused));");
+		out.println("static void " + functionPrefix + "_ctx_pack(const pkg_ctx_t * ctx, const " + typeName + " * msg)");
+		out.println("{");
+		out.println("  bitstream_t bs;");
+		if (containsArray)
+			out.println("  uint8_t i;");
+		out.println("");
+		out.println("  bitstream_init(&bs, ctx->buf, ctx->headeroffsetbits);");
+		out.print(pack.toString());
+		out.println("}");
+		out.println("");
+
+		out.println("// Pack all data fields from the struct into the buffer.");
+		out.println("// The header has to be initialized before by one of the pkg_header_init_* functions.");
+		out.println("static void " + functionPrefix + "_pack(const " + typeName + " * msg, uint8_t * buf) __attribute__ ((unused));");
+		out.println("static void " + functionPrefix + "_pack(const " + typeName + " * msg, uint8_t * buf)");
+		out.println("{");
+		out.println("  pkg_ctx_t ctx = { buf, __HEADEROFFSETBITS };");
+		out.println("");
+		out.println("  " + functionPrefix + "_ctx_pack(&ctx, msg);");
+		out.println("}");
+		out.println("");
+	}
+
+	/**
+	 * Generate the struct members and the statements to unpack / pack them for the
+	 * data fields of the given node. Arrays are handled by a recursive call, so that
+	 * the elements of structured arrays are accessed in the order they are stored.
+	 * @return true if the node contains an array
+	 */
+	private boolean generateStructFieldDefs(Node dataNode, String indent, String arraySuffix, StringBuilder members, StringBuilder unpack, StringBuilder pack) throws TransformerException
+	{
+		boolean containsArray = false;
+		String index = arraySuffix.equals("") ? "" : "[i]";
+		NodeList childs = dataNode.getChildNodes();
+
+		for (int e = 0; e < childs.getLength(); e++)
+		{
+			Node element = childs.item(e);
+			String nodeName = element.getNodeName();
+
+			if (nodeName.equals("Reserved"))
+			{
+				String bits = Util.getChildNodeValue(element, "Bits");
+				unpack.append(indent + "bitstream_skip(&bs, " + bits + ");" + newline);
+				pack.append(indent + "bitstream_skip(&bs, " + bits + ");" + newline);
+				continue;
+			}
+			else if (nodeName.equals("Array"))
+			{
+				String length = Util.getChildNodeValue(element, "Length");
+
+				unpack.append(newline + indent + "for (i = 0; i < " + length + "; i++)" + newline + indent + "{" + newline);
+				pack.append(newline + indent + "for (i = 0; i < " + length + "; i++)" + newline + indent + "{" + newline);
+
+				generateStructFieldDefs(element, indent + "  ", "[" + length + "]", members, unpack, pack);
+
+				unpack.append(indent + "}" + newline);
+				pack.append(indent + "}" + newline);
+				containsArray = true;
+				continue;
+			}
+			else if (!(nodeName.equals("EnumValue") || nodeName.equals("UIntValue") || nodeName.equals("IntValue")
+					|| nodeName.equals("FloatValue") || nodeName.equals("ByteArray") || nodeName.equals("BoolValue")))
+			{
+				continue;
+			}
+
+			String ID = Util.getChildNodeValue(element, "ID");
+			String var = "msg->" + ID.toLowerCase() + index;
+
+			if (nodeName.equals("EnumValue"))
+			{
+				String bits = Util.getChildNodeValue(element, "Bits");
+
+				members.append("  " + ID + "Enum " + ID.toLowerCase() + arraySuffix + ";" + newline);
+				unpack.append(indent + var + " = (" + ID + "Enum)bitstream_read_bits(&bs, " + bits + ");" + newline);
+				pack.append(indent + "bitstream_write_bits(&bs, " + bits + ", " + var + ");" + newline);
+			}
+			else if (nodeName.equals("UIntValue"))
+			{
+				int bits = Integer.parseInt(Util.getChildNodeValue(element, "Bits"));
+				String minVal = Util.getChildNodeValue(element, "MinVal");
+				String maxVal = Util.getChildNodeValue(element, "MaxVal");
+
+				members.append("  " + minimalCType(bits, false) + " " + ID.toLowerCase() + arraySuffix + ";" + newline);
+
+				// limiting the value is only necessary if not the full range of the bits is allowed
+				if (minVal.equals("0") && maxVal.equals(Long.toString((1L << bits) - 1)))
+					unpack.append(indent + var + " = bitstream_read_bits(&bs, " + bits + ");" + newline);
+				else
+					unpack.append(indent + var + " = bitstream_read_UIntValue32(&bs, " + bits + ", " + minVal + ", " + maxVal + ");" + newline);
+
+				pack.append(indent + "bitstream_write_bits(&bs, " + bits + ", " + var + ");" + newline);
+			}
+			else if (nodeName.equals("IntValue"))
+			{
+				int bits = Integer.parseInt(Util.getChildNodeValue(element, "Bits"));
+				String minVal = Util.getChildNodeValue(element, "MinVal");
+				String maxVal = Util.getChildNodeValue(element, "MaxVal");
+
+				members.append("  " + minimalCType(bits, true) + " " + ID.toLowerCase() + arraySuffix + ";" + newline);
+				unpack.append(indent + var + " = bitstream_read_IntValue32(&bs, " + bits + ", " + minVal + ", " + maxVal + ");" + newline);
+				pack.append(indent + "bitstream_write_IntValue(&bs, " + bits + ", " + var + ");" + newline);
+			}
+			else if (nodeName.equals("FloatValue"))
+			{
+				members.append("  float " + ID.toLowerCase() + arraySuffix + ";" + newline);
+				unpack.append(indent + var + " = bitstream_read_FloatValue(&bs);" + newline);
+				pack.append(indent + "bitstream_write_FloatValue(&bs, " + var + ");" + newline);
+			}
+			else if (nodeName.equals("ByteArray"))
+			{
+				if (!arraySuffix.equals(""))
+					throw new TransformerException("Arrays are not supported for ByteArray elements!");
+
+				String bytes = Util.getChildNodeValue(element, "Bytes");
+
+				members.append("  uint8_t " + ID.toLowerCase() + "[" + bytes + "];" + newline);
+				unpack.append(indent + "bitstream_read_ByteArray(&bs, " + bytes + ", " + var + ");" + newline);
+				pack.append(indent + "bitstream_write_ByteArray(&bs, " + bytes + ", " + var + ");" + newline);
+			}
+			else if (nodeName.equals("BoolValue"))
+			{
+				members.append("  bool " + ID.toLowerCase() + arraySuffix + ";" + newline);
+				unpack.append(indent + var + " = bitstream_read_bits(&bs, 1) == 1;" + newline);
+				pack.append(indent + "bitstream_write_bits(&bs, 1, " + var + " ? 1 : 0);" + newline);
+			}
+		}
+
+		return containsArray;
+	}
+
+	/**
+	 * Return the smallest C integer type that can hold a value with the given number of bits.
+	 * @param bits
+	 * @param signed
+	 * @return
+	 */
+	private String minimalCType(int bits, boolean signed)
+	{
+		String prefix = signed ? "int" : "uint";
+
+		if (bits <= 8)
+			return prefix + "8_t";
+		else if (bits <= 16)
+			return prefix + "16_t";
+		else
+			return prefix + "32_t";
+	}
+
 	/**
 	 * For the given array node, go through all sub-elements and calculate the
 	 * overall number of bits one set of elements takes.
@@ -1061,11 +1738,61 @@ public class SourceCodeGeneratorPacket
 	 */
 	private String calcAccessStr(boolean useHeaderOffset, int offset, int bits, boolean isArray)
 	{
-		String additionalOffsetPrefix = useHeaderOffset ? "(uint16_t)__HEADEROFFSETBITS + " : "";
+		return calcAccessStr(useHeaderOffset, offset, bits, isArray, false);
+	}
+
+	/**
+	 * Like calcAccessStr, but optionally use the header offset of the codec context "ctx".
+	 */
+	private String calcAccessStr(boolean useHeaderOffset, int offset, int bits, boolean isArray, boolean useContext)
+	{
+		String headerOffset = useContext ? "ctx->headeroffsetbits" : "__HEADEROFFSETBITS";
+		String additionalOffsetPrefix = useHeaderOffset ? "(uint16_t)" + headerOffset + " + " : "";
 
 		return Util.calcAccessStr(additionalOffsetPrefix, offset, bits, isArray);
 	}
 
+	/**
+	 * Generate an access function working on the codec context given as first parameter
+	 * and a wrapper with the original name and parameters, which uses the global packet
+	 * buffer bufx and the global header state.
+	 * @param sb
+	 * @param returnType
+	 * @param functionPrefix  E.g. "msg_gpio_digitalport".
+	 * @param functionName    E.g. "get_on".
+	 * @param params          The parameters without context, e.g. "uint8_t index, bool val" or "void".
+	 * @param body            The statement of the function body, accessing "ctx".
+	 */
+	private void appendAccessFunctions(StringBuilder sb, String returnType, String functionPrefix, String functionName, String params, String body)
+	{
+		String ctxParams = "const pkg_ctx_t * ctx";
+		String args = "PKG_CTX_GLOBAL";
+
+		if (!params.equals("void"))
+		{
+			ctxParams += ", " + params;
+
+			// the argument names are the last words of the parameters
+			for (String param : params.split(", "))
+			{
+				String[] parts = param.split("[ *]+");
+				args += ", " + parts[parts.length - 1];
+			}
+		}
+
+		sb.append("static inline " + returnType + " " + functionPrefix + "_ctx_" + functionName + "(" + ctxParams + ")" + newline);
+		sb.append("{" + newline);
+		sb.append("  " + body + newline);
+		sb.append("}" + newline);
+		sb.append(newline);
+
+		sb.append("static inline " + returnType + " " + functionPrefix + "_" + functionName + "(" + params + ")" + newline);
+		sb.append("{" + newline);
+		sb.append("  " + (returnType.equals("void") ? "" : "return ") + functionPrefix + "_ctx_" + functionName + "(" + args + ");" + newline);
+		sb.append("}" + newline);
+		sb.append(newline);
+	}
+
 	public static String genCopyrightNotice()
 	{
 		return "/*" + newline +